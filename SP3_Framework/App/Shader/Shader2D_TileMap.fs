@@ -0,0 +1,12 @@
+#version 330 core
+out vec4 FragColour;
+
+in vec3 TexCoord;
+
+// texture samplers
+uniform sampler2DArray imageTextureArray;
+
+void main()
+{
+	FragColour = texture(imageTextureArray, TexCoord);
+}
\ No newline at end of file
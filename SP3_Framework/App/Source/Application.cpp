@@ -21,6 +21,8 @@
 #include "GameControl\Settings.h"
 // Include CShaderManager which manages the shaders used in this App
 #include "RenderControl\ShaderManager.h"
+// Include CImageLoader which caches the textures used in this App
+#include "System\ImageLoader.h"
 
 // Inputs
 #include "Inputs\KeyboardController.h"
@@ -235,6 +237,7 @@ bool Application::Init(void)
 	// Add the shaders to the ShaderManager
 	CShaderManager::GetInstance()->Add("Shader2D", "Shader//Shader2D.vs", "Shader//Shader2D.fs");
 	CShaderManager::GetInstance()->Add("Shader2D_Colour", "Shader//Shader2D_Colour.vs", "Shader//Shader2D_Colour.fs");
+	CShaderManager::GetInstance()->Add("Shader2D_TileMap", "Shader//Shader2D_TileMap.vs", "Shader//Shader2D_TileMap.fs");
 
 	//CShaderManager::GetInstance()->Add("Shader3D", "Shader//Shader3D.vs", "Shader//Shader3D.fs");
 	//CShaderManager::GetInstance()->Add("Shader3D_Line", "Shader//Shader3D_LineShader.vs", "Shader//Shader3D_LineShader.fs");
@@ -381,6 +384,9 @@ void Application::Destroy(void)
 		cFPSCounter = NULL;
 	}
 
+	// Destroy the CImageLoader instance, which deletes the cached textures, while OpenGL is still running
+	CImageLoader::GetInstance()->Destroy();
+
 	//Close OpenGL window and terminate GLFW
 	glfwDestroyWindow(cSettings->pWindow);
 	//Finalize and clean up GLFW
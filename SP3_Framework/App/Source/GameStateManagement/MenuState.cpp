@@ -233,6 +233,10 @@ void CMenuState::Destroy(void)
 		background = NULL;
 	}
 
+	// Release the images for buttons
+	CImageLoader::GetInstance()->ReleaseTexture(play2DButtonData.textureID);
+	CImageLoader::GetInstance()->ReleaseTexture(exitButtonData.textureID);
+
 	// Cleanup
 	ImGui_ImplOpenGL3_Shutdown();
 	ImGui_ImplGlfw_Shutdown();
@@ -233,5 +233,8 @@ void COptions::Render(void)
  */
 void COptions::Destroy(void)
 {
+	// Release the images for buttons
+	CImageLoader::GetInstance()->ReleaseTexture(BackButtonData.textureID);
+
 	// cout << "COptions::Destroy()\n" << endl;
 }
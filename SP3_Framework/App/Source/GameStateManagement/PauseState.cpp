@@ -188,5 +188,11 @@ void CPauseState::Render(void)
  */
 void CPauseState::Destroy(void)
 {
+	// Release the images for buttons
+	CImageLoader* il = CImageLoader::GetInstance();
+	il->ReleaseTexture(ResumeButtonData.textureID);
+	il->ReleaseTexture(OptionsButtonData.textureID);
+	il->ReleaseTexture(ExitButtonData.textureID);
+
 	// cout << "CPauseState::Destroy()\n" << endl;
 }
@@ -0,0 +1,147 @@
+/**
+ AStarContext
+ @brief The scratch data of an A* Path Finding search, and the heuristics which it can use.
+		Each caller keeps its own context, so searches never share state and can run at the
+		same time. The node records are stamped with the number of the search which last
+		wrote them, so starting a new search does not need to clear them.
+ */
+#pragma once
+
+// Include GLM
+#include <includes/glm.hpp>
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+// A structure storing the record of a map grid during A* Path Finding.
+// The record is only valid while uiGeneration matches the search which is running
+struct AStarNode {
+	AStarNode()
+		: uiGeneration(0), uiParent(0), g(0), f(0), bClosed(false) {}
+
+	unsigned int uiGeneration;
+	unsigned int uiParent;
+	unsigned int g;
+	unsigned int f;
+	bool bClosed;
+};
+
+// A structure storing an entry of the open list during A* Path Finding
+struct AStarOpenEntry {
+	AStarOpenEntry(unsigned int f, unsigned int uiIndex)
+		: f(f), uiIndex(uiIndex) {}
+
+	unsigned int f;
+	unsigned int uiIndex;
+};
+
+// Order the open list with the smallest f value on top
+inline bool operator< (const AStarOpenEntry& a, const AStarOpenEntry& b) { return b.f < a.f; }
+
+// A structure storing the scratch data of an A* Path Finding search.
+// It is kept apart from the tile values, so it can be reused between searches.
+// The lists only grow, so once they are the size of the map, a search does not allocate memory
+struct AStarContext {
+	// The number of the search which is running
+	unsigned int uiGeneration;
+	// The node records, indexed by the 1D position of a grid
+	std::vector<AStarNode> m_nodes;
+	// The open list, stored as a binary heap
+	std::vector<AStarOpenEntry> m_openList;
+	// The number of nodes which the last search expanded
+	unsigned int uiNumExpanded;
+
+	AStarContext()
+		: uiGeneration(0), uiNumExpanded(0) {}
+
+	// Start a new search over a map with a number of grids
+	void Begin(const unsigned int uiNumGrids)
+	{
+		if (m_nodes.size() < uiNumGrids)
+			m_nodes.resize(uiNumGrids);
+		m_openList.clear();
+		uiNumExpanded = 0;
+
+		// When the counter wraps around, old records could look valid again, so clear them once
+		if (++uiGeneration == 0)
+		{
+			for (size_t i = 0; i < m_nodes.size(); i++)
+				m_nodes[i].uiGeneration = 0;
+			uiGeneration = 1;
+		}
+	}
+
+	// Get the record of a grid, resetting it if it was written by an earlier search
+	AStarNode& GetNode(const unsigned int uiIndex)
+	{
+		AStarNode& sNode = m_nodes[uiIndex];
+		if (sNode.uiGeneration != uiGeneration)
+		{
+			sNode.uiGeneration = uiGeneration;
+			sNode.uiParent = uiIndex;
+			sNode.g = 0;
+			sNode.f = 0;
+			sNode.bClosed = false;
+		}
+		return sNode;
+	}
+
+	// Check if a grid has been reached by the search which is running
+	bool IsVisited(const unsigned int uiIndex) const
+	{
+		return m_nodes[uiIndex].uiGeneration == uiGeneration;
+	}
+
+	// Add a grid to the open list
+	void PushOpen(const unsigned int f, const unsigned int uiIndex)
+	{
+		m_openList.push_back(AStarOpenEntry(f, uiIndex));
+		std::push_heap(m_openList.begin(), m_openList.end());
+	}
+
+	// Remove the grid with the smallest f value from the open list
+	unsigned int PopOpen(void)
+	{
+		std::pop_heap(m_openList.begin(), m_openList.end());
+		const unsigned int uiIndex = m_openList.back().uiIndex;
+		m_openList.pop_back();
+		return uiIndex;
+	}
+};
+
+namespace heuristic
+{
+	// The manhattan distance, for searches without diagonal movements
+	struct Manhattan
+	{
+		unsigned int operator()(const glm::vec2& v1, const glm::vec2& v2, const int weight) const
+		{
+			const glm::vec2 delta = v2 - v1;
+			return static_cast<unsigned int>(weight * (std::fabs(delta.x) + std::fabs(delta.y)));
+		}
+	};
+
+	// The chebyshev distance, for searches with diagonal movements which cost the same as
+	// straight ones. It never overestimates, so the paths are as short as possible
+	struct Chebyshev
+	{
+		unsigned int operator()(const glm::vec2& v1, const glm::vec2& v2, const int weight) const
+		{
+			const float fDistX = std::fabs(v2.x - v1.x);
+			const float fDistY = std::fabs(v2.y - v1.y);
+			return static_cast<unsigned int>(weight * ((fDistX > fDistY) ? fDistX : fDistY));
+		}
+	};
+
+	// The euclidean distance. It overestimates the cost of diagonal movements which cost the
+	// same as straight ones, so it finds paths faster, but not always the shortest ones
+	struct Euclidean
+	{
+		unsigned int operator()(const glm::vec2& v1, const glm::vec2& v2, const int weight) const
+		{
+			const glm::vec2 delta = v2 - v1;
+			return static_cast<unsigned int>(weight * std::sqrt((delta.x * delta.x) + (delta.y * delta.y)));
+		}
+	};
+}
@@ -34,22 +34,11 @@ CBloodDeer::CBloodDeer(void)
 	, cMap2D(NULL)
 	, cSettings(NULL)
 	, cPlayer2D(NULL)
-	, sCurrentFSM(FSM::IDLE)
-	, iFSMCounter(0)
 	, quadMesh(NULL)
 	, deerAnimationSprites(NULL)
 {
 	transform = glm::mat4(1.0f);	// make sure to initialize matrix to identity matrix first
 
-	// Initialise vecIndex
-	vec2Index = glm::i32vec2(0);
-
-	// Initialise vecNumMicroSteps
-	i32vec2NumMicroSteps = glm::i32vec2(0);
-
-	// Initialise vec2UVCoordinate
-	vec2UVCoordinate = glm::vec2(0.0f);
-
 	i32vec2Destination = glm::i32vec2(0, 0);	// Initialise the iDestination
 	i32vec2Direction = glm::i32vec2(0, 0);		// Initialise the iDirection
 
@@ -103,9 +92,9 @@ bool CBloodDeer::Init(void)
 	cMap2D->SetMapInfo(uiRow, uiCol, 0);
 
 	// Set the start position of the Player to iRow and iCol
-	vec2Index = glm::i32vec2(uiCol, uiRow);
+	SetIndex(glm::vec2(uiCol, uiRow));
 	// By default, microsteps should be zero
-	i32vec2NumMicroSteps = glm::i32vec2(0, 0);
+	MicroSteps() = glm::i32vec2(0, 0);
 
 	glGenVertexArrays(1, &VAO);
 	glBindVertexArray(VAO);
@@ -138,8 +127,8 @@ bool CBloodDeer::Init(void)
 	runtimeColour = glm::vec4(1.0, 1.0, 1.0, 1.0);
 
 	// Set the Physics to fall status by default
-	cPhysics2D.Init();
-	cPhysics2D.SetStatus(CPhysics2D::STATUS::FALL);
+	cSimulation->ResetPhysics(uiBody);
+	cSimulation->SetStatus(uiBody, CPhysics2D::STATUS::FALL);
 
 	// If this class is initialised properly, then set the bIsActive to true
 	bIsActive = true;
@@ -150,7 +139,7 @@ bool CBloodDeer::Init(void)
 
 	rageCounter = 0;
 	rage_runtime = 0;
-	hitIntervals = 4.0f;
+	AttackTimer() = 4.0f;
 
 	rage = false;
 	hit = false;
@@ -198,8 +187,8 @@ bool CBloodDeer::Init2(void)
 	runtimeColour = glm::vec4(1.0, 1.0, 1.0, 1.0);
 
 	// Set the Physics to fall status by default
-	cPhysics2D.Init();
-	cPhysics2D.SetStatus(CPhysics2D::STATUS::FALL);
+	cSimulation->ResetPhysics(uiBody);
+	cSimulation->SetStatus(uiBody, CPhysics2D::STATUS::FALL);
 
 	// If this class is initialised properly, then set the bIsActive to true
 	bIsActive = true;
@@ -210,7 +199,7 @@ bool CBloodDeer::Init2(void)
 
 	rageCounter = 0;
 	rage_runtime = 0;
-	hitIntervals = 4.0f;
+	AttackTimer() = 4.0f;
 
 	rage = false;
 	hit = false;
@@ -231,39 +220,39 @@ void CBloodDeer::Update(const double dElapsedTime)
 	}
 	if (hit)
 	{
-		hitIntervals -= dElapsedTime;
-		if (hitIntervals <= 0.f)
+		AttackTimer() -= dElapsedTime;
+		if (AttackTimer() <= 0.f)
 		{
-			hitIntervals = 4.0f * buffAtkSpeed;
+			AttackTimer() = 4.0f * buffAtkSpeed;
 			hit = false;
 
 		}
 	}
 	//cout << hitIntervals << endl;
 	
-	switch (sCurrentFSM)
+	switch (CurrentFSM())
 	{
 	case IDLE:
 		deerAnimationSprites->PlayAnimation("Idle", -1, 5);
-		if (iFSMCounter > iMaxFSMCounter)
+		if (FSMCounter() > iMaxFSMCounter)
 		{
-			sCurrentFSM = PATROL;
-			iFSMCounter = 0;
+			CurrentFSM() = PATROL;
+			FSMCounter() = 0;
 			//cout << "Switching to Patrol State" << endl;
 		}
-		iFSMCounter++;
+		FSMCounter()++;
 		break;
 	case PATROL:
-		if (iFSMCounter > iMaxFSMCounter)
+		if (FSMCounter() > iMaxFSMCounter)
 		{
-			sCurrentFSM = IDLE;
-			iFSMCounter = 0;
+			CurrentFSM() = IDLE;
+			FSMCounter() = 0;
 			//cout << "Switching to Idle State" << endl;
 		}
-		else if (cPhysics2D.CalculateDistance(vec2Index, cPlayer2D->vec2Index) < 10.0f)
+		else if (CalculateDistance(Index(), cPlayer2D->vec2Index) < 10.0f)
 		{
-			sCurrentFSM = ATTACK;
-			iFSMCounter = 0;
+			CurrentFSM() = ATTACK;
+			FSMCounter() = 0;
 		}
 		else
 		{
@@ -271,25 +260,22 @@ void CBloodDeer::Update(const double dElapsedTime)
 			// Update the Enemy2D's position for patrol
 			UpdatePosition();
 		}
-		iFSMCounter++;
+		FSMCounter()++;
 		break;
 	case ATTACK:
-		if (cPhysics2D.CalculateDistance(vec2Index, cPlayer2D->vec2Index) < 10.0f)
+		if (CalculateDistance(Index(), cPlayer2D->vec2Index) < 10.0f)
 		{
 			// Calculate a path to the player
 			//cMap2D->PrintSelf();
 			//cout << "StartPos: " << vec2Index.x << ", " << vec2Index.y << endl;
 			//cout << "TargetPos: " << cPlayer2D->vec2Index.x << ", " 
 			//		<< cPlayer2D->vec2Index.y << endl;
-			auto path = cMap2D->PathFind(	vec2Index, 
-											cPlayer2D->vec2Index, 
-											heuristic::euclidean, 
-											10);
+			cMap2D->GetPlatformPath(Index(), cSimulation->GetStatus(uiBody) != CPhysics2D::STATUS::IDLE, vPath);
 			//cout << "=== Printing out the path ===" << endl;
 
 			// Calculate new destination
 			bool bFirstPosition = true;
-			for (const auto& coord : path)
+			for (const auto& coord : vPath)
 			{
 				//std::cout << coord.x << "," << coord.y << "\n";
 				if (bFirstPosition == true)
@@ -297,7 +283,7 @@ void CBloodDeer::Update(const double dElapsedTime)
 					// Set a destination
 					i32vec2Destination = coord;
 					// Calculate the direction between enemy2D and this destination
-					i32vec2Direction = i32vec2Destination - vec2Index;
+					i32vec2Direction = i32vec2Destination - Index();
 					bFirstPosition = false;
 				}
 				else
@@ -328,19 +314,19 @@ void CBloodDeer::Update(const double dElapsedTime)
 		}
 		else
 		{
-			if (iFSMCounter > iMaxFSMCounter)
+			if (FSMCounter() > iMaxFSMCounter)
 			{
-				sCurrentFSM = PATROL;
+				CurrentFSM() = PATROL;
 				rageCounter = 0.f;
-				iFSMCounter = 0;
+				FSMCounter() = 0;
 				//cout << "ATTACK : Reset counter: " << iFSMCounter << endl;
 			}
-			iFSMCounter++;
+			FSMCounter()++;
 		}
 		if (rage)
 		{
 			//cout << "Boss Mad \n";
-			sCurrentFSM = RAGE;
+			CurrentFSM() = RAGE;
 		}
 		break;
 
@@ -363,25 +349,22 @@ void CBloodDeer::Update(const double dElapsedTime)
 			rageCounter = 0.f; // Resets the rage counter
 			buffDamage = buffSpeed = buffAtkSpeed = 1.0f;
 			//cout << "Switch from Rage State to Attack State" << endl;
-			sCurrentFSM = ATTACK;
+			CurrentFSM() = ATTACK;
 		}
 
-		if (cPhysics2D.CalculateDistance(vec2Index, cPlayer2D->vec2Index) < 10.0f)
+		if (CalculateDistance(Index(), cPlayer2D->vec2Index) < 10.0f)
 		{
 			// Calculate a path to the player
 			//cMap2D->PrintSelf();
 			//cout << "StartPos: " << vec2Index.x << ", " << vec2Index.y << endl;
 			//cout << "TargetPos: " << cPlayer2D->vec2Index.x << ", " 
 			//		<< cPlayer2D->vec2Index.y << endl;
-			auto path = cMap2D->PathFind(vec2Index,
-				cPlayer2D->vec2Index,
-				heuristic::euclidean,
-				10);
+			cMap2D->GetPlatformPath(Index(), cSimulation->GetStatus(uiBody) != CPhysics2D::STATUS::IDLE, vPath);
 			//cout << "=== Printing out the path ===" << endl;
 
 			// Calculate new destination
 			bool bFirstPosition = true;
-			for (const auto& coord : path)
+			for (const auto& coord : vPath)
 			{
 				//std::cout << coord.x << "," << coord.y << "\n";
 				if (bFirstPosition == true)
@@ -389,7 +372,7 @@ void CBloodDeer::Update(const double dElapsedTime)
 					// Set a destination
 					i32vec2Destination = coord;
 					// Calculate the direction between enemy2D and this destination
-					i32vec2Direction = i32vec2Destination - vec2Index;
+					i32vec2Direction = i32vec2Destination - Index();
 					bFirstPosition = false;
 				}
 				else
@@ -418,26 +401,22 @@ void CBloodDeer::Update(const double dElapsedTime)
 		}
 		else
 		{
-			if (iFSMCounter > iMaxFSMCounter)
+			if (FSMCounter() > iMaxFSMCounter)
 			{
-				sCurrentFSM = PATROL;
-				iFSMCounter = 0;
-				cout << "ATTACK : Reset counter: " << iFSMCounter << endl;
+				CurrentFSM() = PATROL;
+				FSMCounter() = 0;
+				cout << "ATTACK : Reset counter: " << FSMCounter() << endl;
 			}
-			iFSMCounter++;
+			FSMCounter()++;
 		}
 
 	default:
 		break;
 	}
 
-	// Update Jump or Fall
-	UpdateJumpFall(dElapsedTime);
 	deerAnimationSprites->Update(dElapsedTime);
 
-	// Update the UV Coordinates
-	vec2UVCoordinate.x = cSettings->ConvertIndexToUVSpace(cSettings->x, vec2Index.x, false, i32vec2NumMicroSteps.x*cSettings->MICRO_STEP_XAXIS);
-	vec2UVCoordinate.y = cSettings->ConvertIndexToUVSpace(cSettings->y, vec2Index.y, false, i32vec2NumMicroSteps.y*cSettings->MICRO_STEP_YAXIS);
+	// The jump or fall, and the UV Coordinates, are updated by CEnemySimulation for all enemies at once
 }
 
 /**
@@ -474,8 +453,8 @@ void CBloodDeer::Render(void)
 	glUniformMatrix4fv(transformLoc, 1, GL_FALSE, glm::value_ptr(transform));
 
 	transform = glm::mat4(1.0f); // make sure to initialize matrix to identity matrix first
-	transform = glm::translate(transform, glm::vec3(vec2UVCoordinate.x,
-		vec2UVCoordinate.y,
+	transform = glm::translate(transform, glm::vec3(UVCoordinate().x,
+		UVCoordinate().y,
 		0.0f));
 	// Update the shaders with the latest transform
 	glUniformMatrix4fv(transformLoc, 1, GL_FALSE, glm::value_ptr(transform));
@@ -513,8 +492,7 @@ void CBloodDeer::PostRender(void)
 */
 void CBloodDeer::Seti32vec2Index(const int iIndex_XAxis, const int iIndex_YAxis)
 {
-	this->vec2Index.x = iIndex_XAxis;
-	this->vec2Index.y = iIndex_YAxis;
+	SetIndex(glm::vec2(iIndex_XAxis, iIndex_YAxis));
 }
 
 /**
@@ -524,8 +502,7 @@ void CBloodDeer::Seti32vec2Index(const int iIndex_XAxis, const int iIndex_YAxis)
 */
 void CBloodDeer::Seti32vec2NumMicroSteps(const int iNumMicroSteps_XAxis, const int iNumMicroSteps_YAxis)
 {
-	this->i32vec2NumMicroSteps.x = iNumMicroSteps_XAxis;
-	this->i32vec2NumMicroSteps.y = iNumMicroSteps_YAxis;
+	MicroSteps() = glm::vec2(iNumMicroSteps_XAxis, iNumMicroSteps_YAxis);
 }
 
 /**
@@ -561,291 +538,6 @@ void CBloodDeer::setMaxHP(float maxHealth)
 }
 
 
-/**
- @brief Constraint the enemy2D's position within a boundary
- @param eDirection A DIRECTION enumerated data type which indicates the direction to check
- */
-void CBloodDeer::Constraint(DIRECTION eDirection)
-{
-	if (eDirection == LEFT)
-	{
-		if (vec2Index.x < 0)
-		{
-			vec2Index.x = 0;
-			i32vec2NumMicroSteps.x = 0;
-		}
-	}
-	else if (eDirection == RIGHT)
-	{
-		if (vec2Index.x >= (int)cSettings->NUM_TILES_XAXIS - 1)
-		{
-			vec2Index.x = ((int)cSettings->NUM_TILES_XAXIS) - 1;
-			i32vec2NumMicroSteps.x = 0;
-		}
-	}
-	else if (eDirection == UP)
-	{
-		if (vec2Index.y >= (int)cSettings->NUM_TILES_YAXIS - 1)
-		{
-			vec2Index.y = ((int)cSettings->NUM_TILES_YAXIS) - 1;
-			i32vec2NumMicroSteps.y = 0;
-		}
-	}
-	else if (eDirection == DOWN)
-	{
-		if (vec2Index.y < 0)
-		{
-			vec2Index.y = 0;
-			i32vec2NumMicroSteps.y = 0;
-		}
-	}
-	else
-	{
-		cout << "CBloodDeer::Constraint: Unknown direction." << endl;
-	}
-}
-
-/**
- @brief Check if a position is possible to move into
- @param eDirection A DIRECTION enumerated data type which indicates the direction to check
- */
-bool CBloodDeer::CheckPosition(DIRECTION eDirection)
-{
-	if (eDirection == LEFT)
-	{
-		// If the new position is fully within a row, then check this row only
-		if (i32vec2NumMicroSteps.y == 0)
-		{
-			// If the grid is not accessible, then return false
-			if (cMap2D->GetMapInfo(vec2Index.y, vec2Index.x) >= 100)
-			{
-				return false;
-			}
-		}
-		// If the new position is between 2 rows, then check both rows as well
-		else if (i32vec2NumMicroSteps.y != 0)
-		{
-			// If the 2 grids are not accessible, then return false
-			if ((cMap2D->GetMapInfo(vec2Index.y, vec2Index.x) >= 100) ||
-				(cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x) >= 100))
-			{
-				return false;
-			}
-		}
-	}
-	else if (eDirection == RIGHT)
-	{
-		// If the new position is at the top row, then return true
-		if (vec2Index.x >= cSettings->NUM_TILES_XAXIS - 1)
-		{
-			i32vec2NumMicroSteps.x = 0;
-			return true;
-		}
-
-		// If the new position is fully within a row, then check this row only
-		if (i32vec2NumMicroSteps.y == 0)
-		{
-			// If the grid is not accessible, then return false
-			if (cMap2D->GetMapInfo(vec2Index.y, vec2Index.x + 1) >= 100)
-			{
-				return false;
-			}
-		}
-		// If the new position is between 2 rows, then check both rows as well
-		else if (i32vec2NumMicroSteps.y != 0)
-		{
-			// If the 2 grids are not accessible, then return false
-			if ((cMap2D->GetMapInfo(vec2Index.y, vec2Index.x + 1) >= 100) ||
-				(cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x + 1) >= 100))
-			{
-				return false;
-			}
-		}
-
-	}
-	else if (eDirection == UP)
-	{
-		// If the new position is at the top row, then return true
-		if (vec2Index.y >= cSettings->NUM_TILES_YAXIS - 1)
-		{
-			i32vec2NumMicroSteps.y = 0;
-			return true;
-		}
-
-		// If the new position is fully within a column, then check this column only
-		if (i32vec2NumMicroSteps.x == 0)
-		{
-			// If the grid is not accessible, then return false
-			if (cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x) >= 100)
-			{
-				return false;
-			}
-		}
-		// If the new position is between 2 columns, then check both columns as well
-		else if (i32vec2NumMicroSteps.x != 0)
-		{
-			// If the 2 grids are not accessible, then return false
-			if ((cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x) >= 100) ||
-				(cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x + 1) >= 100))
-			{
-				return false;
-			}
-		}
-	}
-	else if (eDirection == DOWN)
-	{
-		// If the new position is fully within a column, then check this column only
-		if (i32vec2NumMicroSteps.x == 0)
-		{
-			// If the grid is not accessible, then return false
-			if (cMap2D->GetMapInfo(vec2Index.y, vec2Index.x) >= 100)
-			{
-				return false;
-			}
-		}
-		// If the new position is between 2 columns, then check both columns as well
-		else if (i32vec2NumMicroSteps.x != 0)
-		{
-			// If the 2 grids are not accessible, then return false
-			if ((cMap2D->GetMapInfo(vec2Index.y, vec2Index.x) >= 100) ||
-				(cMap2D->GetMapInfo(vec2Index.y, vec2Index.x + 1) >= 100))
-			{
-				return false;
-			}
-		}
-	}
-	else
-	{
-		cout << "CBloodDeer::CheckPosition: Unknown direction." << endl;
-	}
-
-	return true;
-}
-
-// Check if the enemy2D is in mid-air
-bool CBloodDeer::IsMidAir(void)
-{
-	// if the player is at the bottom row, then he is not in mid-air for sure
-	if (vec2Index.y == 0)
-		return false;
-
-	// Check if the tile below the player's current position is empty
-	if ((i32vec2NumMicroSteps.x == 0) &&
-		(cMap2D->GetMapInfo(vec2Index.y - 1, vec2Index.x) == 0))
-	{
-		return true;
-	}
-
-	return false;
-}
-
-// Update Jump or Fall
-void CBloodDeer::UpdateJumpFall(const double dElapsedTime)
-{
-	if (cPhysics2D.GetStatus() == CPhysics2D::STATUS::JUMP)
-	{
-		// Update the elapsed time to the physics engine
-		cPhysics2D.AddElapsedTime((float)dElapsedTime);
-		// Call the physics engine update method to calculate the final velocity and displacement
-		cPhysics2D.Update();
-		// Get the displacement from the physics engine
-		glm::vec2 v2Displacement = cPhysics2D.GetDisplacement();
-
-		// Store the current vec2Index.y
-		int iIndex_YAxis_OLD = vec2Index.y;
-
-		int iDisplacement_MicroSteps = (int)(v2Displacement.y / cSettings->MICRO_STEP_YAXIS); //DIsplacement divide by distance for 1 microstep
-		if (vec2Index.y < (int)cSettings->NUM_TILES_YAXIS)
-		{
-			i32vec2NumMicroSteps.y += iDisplacement_MicroSteps;
-			if (i32vec2NumMicroSteps.y > cSettings->NUM_STEPS_PER_TILE_YAXIS)
-			{
-				i32vec2NumMicroSteps.y -= cSettings->NUM_STEPS_PER_TILE_YAXIS;
-				if (i32vec2NumMicroSteps.y < 0)
-					i32vec2NumMicroSteps.y = 0;
-				vec2Index.y++;
-			}
-		}
-
-		// Constraint the player's position within the screen boundary
-		Constraint(UP);
-
-		// Iterate through all rows until the proposed row
-		// Check if the player will hit a tile; stop jump if so.
-		int iIndex_YAxis_Proposed = vec2Index.y;
-		for (int i = iIndex_YAxis_OLD; i <= iIndex_YAxis_Proposed; i++)
-		{
-			// Change the player's index to the current i value
-			vec2Index.y = i;
-			// If the new position is not feasible, then revert to old position
-			if (CheckPosition(UP) == false)
-			{
-				// Align with the row
-				i32vec2NumMicroSteps.y = 0;
-				// Set the Physics to fall status
-				cPhysics2D.SetStatus(CPhysics2D::STATUS::FALL);
-				break;
-			}
-		}
-
-		// If the player is still jumping and the initial velocity has reached zero or below zero, 
-		// then it has reach the peak of its jump
-		if ((cPhysics2D.GetStatus() == CPhysics2D::STATUS::JUMP) && (cPhysics2D.GetInitialVelocity().y <= 0.0f))
-		{
-			// Set status to fall
-			cPhysics2D.SetStatus(CPhysics2D::STATUS::FALL);
-		}
-	}
-	else if (cPhysics2D.GetStatus() == CPhysics2D::STATUS::FALL)
-	{
-		// Update the elapsed time to the physics engine
-		cPhysics2D.AddElapsedTime((float)dElapsedTime);
-		// Call the physics engine update method to calculate the final velocity and displacement
-		cPhysics2D.Update();
-		// Get the displacement from the physics engine
-		glm::vec2 v2Displacement = cPhysics2D.GetDisplacement();
-
-		// Store the current vec2Index.y
-		int iIndex_YAxis_OLD = vec2Index.y;
-
-		// Translate the displacement from pixels to indices
-		int iDisplacement_MicroSteps = (int)(v2Displacement.y / cSettings->MICRO_STEP_YAXIS);
-
-		if (vec2Index.y >= 0)
-		{
-			i32vec2NumMicroSteps.y -= fabs(iDisplacement_MicroSteps);
-			if (i32vec2NumMicroSteps.y < 0)
-			{
-				i32vec2NumMicroSteps.y = ((int)cSettings->NUM_STEPS_PER_TILE_YAXIS) - 1;
-				vec2Index.y--;
-			}
-		}
-
-		// Constraint the player's position within the screen boundary
-		Constraint(DOWN);
-
-		// Iterate through all rows until the proposed row
-		// Check if the player will hit a tile; stop fall if so.
-		int iIndex_YAxis_Proposed = vec2Index.y;
-		for (int i = iIndex_YAxis_OLD; i >= iIndex_YAxis_Proposed; i--)
-		{
-			// Change the player's index to the current i value
-			vec2Index.y = i;
-			// If the new position is not feasible, then revert to old position
-			if (CheckPosition(DOWN) == false)
-			{
-				// Revert to the previous position
-				if (i != iIndex_YAxis_OLD)
-					vec2Index.y = i + 1;
-				// Set the Physics to idle status
-				cPhysics2D.SetStatus(CPhysics2D::STATUS::IDLE);
-				i32vec2NumMicroSteps.y = 0;
-				break;
-			}
-		}
-	}
-}
-
 /**
  @brief Let enemy2D interact with the player.
  */
@@ -854,11 +546,11 @@ bool CBloodDeer::InteractWithPlayer(void)
 	glm::i32vec2 i32vec2PlayerPos = cPlayer2D->vec2Index;
 	
 	// Check if the enemy2D is within 1.5 indices of the player2D
-	if (((vec2Index.x >= i32vec2PlayerPos.x - 0.5) && 
-		(vec2Index.x <= i32vec2PlayerPos.x + 0.5))
+	if (((Index().x >= i32vec2PlayerPos.x - 0.5) && 
+		(Index().x <= i32vec2PlayerPos.x + 0.5))
 		&& 
-		((vec2Index.y >= i32vec2PlayerPos.y - 0.5) &&
-		(vec2Index.y <= i32vec2PlayerPos.y + 0.5))
+		((Index().y >= i32vec2PlayerPos.y - 0.5) &&
+		(Index().y <= i32vec2PlayerPos.y + 0.5))
 		&& !hit)
 	{
 		/*damageOnPlayer = cPlayer2D->returnPlayerHealth();
@@ -889,8 +581,8 @@ bool CBloodDeer::InteractWithPlayer(void)
 			}
 		}
 		// Since the player has been caught, then reset the FSM
-		iFSMCounter = 0;
-		sCurrentFSM = IDLE;
+		FSMCounter() = 0;
+		CurrentFSM() = IDLE;
 		return true;
 	}
 	return false;
@@ -905,10 +597,10 @@ void CBloodDeer::UpdateDirection(void)
 	i32vec2Destination = cPlayer2D->vec2Index;
 
 	// Calculate the direction between enemy2D and player2D
-	i32vec2Direction = i32vec2Destination - vec2Index;
+	i32vec2Direction = i32vec2Destination - Index();
 
 	// Calculate the distance between enemy2D and player2D
-	float fDistance = cPhysics2D.CalculateDistance(vec2Index, i32vec2Destination);
+	float fDistance = CalculateDistance(Index(), i32vec2Destination);
 	if (fDistance >= 0.01f)
 	{
 		// Calculate direction vector.
@@ -937,20 +629,20 @@ void CBloodDeer::FlipHorizontalDirection(void)
 void CBloodDeer::UpdatePosition(void)
 {
 	// Store the old position
-	i32vec2OldIndex = vec2Index;
+	i32vec2OldIndex = Index();
 
 	// if the player is to the left or right of the enemy2D, then jump to attack
 	if (i32vec2Direction.x < 0)
 	{
 		// Move left
-		const int iOldIndex = vec2Index.x;
-		if (vec2Index.x >= 0)
+		const int iOldIndex = Index().x;
+		if (Index().x >= 0)
 		{
-			i32vec2NumMicroSteps.x-= (1 / buffSpeed);
-			if (i32vec2NumMicroSteps.x < 0)
+			MicroSteps().x-= (1 / buffSpeed);
+			if (MicroSteps().x < 0)
 			{
-				i32vec2NumMicroSteps.x = ((int)cSettings->NUM_STEPS_PER_TILE_XAXIS) - 1;
-				vec2Index.x--;
+				MicroSteps().x = ((int)cSettings->NUM_STEPS_PER_TILE_XAXIS) - 1;
+				Index().x--;
 			}
 		}
 
@@ -961,14 +653,14 @@ void CBloodDeer::UpdatePosition(void)
 		if (CheckPosition(LEFT) == false)
 		{
 			FlipHorizontalDirection();
-			vec2Index = i32vec2OldIndex;
-			i32vec2NumMicroSteps.x = 0;
+			Index() = i32vec2OldIndex;
+			MicroSteps().x = 0;
 		}
 
 		// Check if enemy2D is in mid-air, such as walking off a platform
 		if (IsMidAir() == true)
 		{
-			cPhysics2D.SetStatus(CPhysics2D::STATUS::FALL);
+			cSimulation->SetStatus(uiBody, CPhysics2D::STATUS::FALL);
 		}
 
 		if (rage)
@@ -987,15 +679,15 @@ void CBloodDeer::UpdatePosition(void)
 	else if (i32vec2Direction.x > 0)
 	{
 		// Move right
-		const int iOldIndex = vec2Index.x;
-		if (vec2Index.x < (int)cSettings->NUM_TILES_XAXIS)
+		const int iOldIndex = Index().x;
+		if (Index().x < (int)cSettings->NUM_TILES_XAXIS)
 		{
-			i32vec2NumMicroSteps.x += (1 / buffSpeed);
+			MicroSteps().x += (1 / buffSpeed);
 
-			if (i32vec2NumMicroSteps.x >= cSettings->NUM_STEPS_PER_TILE_XAXIS)
+			if (MicroSteps().x >= cSettings->NUM_STEPS_PER_TILE_XAXIS)
 			{
-				i32vec2NumMicroSteps.x = 0;
-				vec2Index.x++;
+				MicroSteps().x = 0;
+				Index().x++;
 			}
 		}
 
@@ -1007,13 +699,13 @@ void CBloodDeer::UpdatePosition(void)
 		{
 			FlipHorizontalDirection();
 			//vec2Index = i32vec2OldIndex;
-			i32vec2NumMicroSteps.x = 0;
+			MicroSteps().x = 0;
 		}
 
 		// Check if enemy2D is in mid-air, such as walking off a platform
 		if (IsMidAir() == true)
 		{
-			cPhysics2D.SetStatus(CPhysics2D::STATUS::FALL);
+			cSimulation->SetStatus(uiBody, CPhysics2D::STATUS::FALL);
 		}
 		if (rage)
 		{
@@ -1032,15 +724,15 @@ void CBloodDeer::UpdatePosition(void)
 	// if the player is above the enemy2D, then jump to attack
 	if (i32vec2Direction.y > 0)
 	{
-		if (cPhysics2D.GetStatus() == CPhysics2D::STATUS::IDLE)
+		if (cSimulation->GetStatus(uiBody) == CPhysics2D::STATUS::IDLE)
 		{
-			cPhysics2D.SetStatus(CPhysics2D::STATUS::JUMP);
-			cPhysics2D.SetInitialVelocity(glm::vec2(0.0f, 3.5f));
+			cSimulation->SetStatus(uiBody, CPhysics2D::STATUS::JUMP);
+			cSimulation->SetVelocity(uiBody, glm::vec2(0.0f, 3.5f));
 		}
 	}
 	else
 	{
-		cPhysics2D.SetStatus(CPhysics2D::STATUS::FALL);
+		cSimulation->SetStatus(uiBody, CPhysics2D::STATUS::FALL);
 
 	}
 }
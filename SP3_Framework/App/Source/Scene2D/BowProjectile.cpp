@@ -22,6 +22,8 @@ using namespace std;
 
 // Include the Map2D as we will use it to check the player's movements and actions
 #include "Map2D.h"
+// Include TileProperties
+#include "TileProperties.h"
 // Include math.h
 #include <math.h>
 
@@ -63,6 +65,13 @@ CBowProjectile::~CBowProjectile(void)
 		quadMesh = NULL;
 	}
 
+	// Delete the arrowAnimation
+	if (arrowAnimation)
+	{
+		delete arrowAnimation;
+		arrowAnimation = NULL;
+	}
+
 	cPlayer2D = NULL;
 
 	// We won't delete this since it was created elsewhere
@@ -75,7 +84,8 @@ CBowProjectile::~CBowProjectile(void)
 }
 
 /**
-  @brief Initialise this instance without reading from the map (won't be necessary)
+  @brief Initialise the things which do not change between shots, such as the meshes and the
+		texture. This is done once, when the projectile pool is created, and Fire() starts each shot
   */
 bool CBowProjectile::Init(void)
 {
@@ -85,13 +95,6 @@ bool CBowProjectile::Init(void)
 	// Get the handler to the CMap2D instance
 	cMap2D = CMap2D::GetInstance();
 
-	// By default, microsteps should be zero
-	i32vec2NumMicroSteps = glm::i32vec2(0, 0);
-	// By default, microsteps should be zero
-	i32vec2NumMicroSteps = glm::i32vec2(0, 0);
-
-	//i32vec2Direction = glm::i32vec2(0, 0);
-
 	glGenVertexArrays(1, &VAO);
 	glBindVertexArray(VAO);
 
@@ -110,6 +113,22 @@ bool CBowProjectile::Init(void)
 	arrowAnimation->AddAnimation("Left", 0, 3);
 	arrowAnimation->AddAnimation("Right", 4, 7);
 
+	arrowDamage = 20;
+
+	// The arrow is not active until it is fired
+	bIsActive = false;
+
+	return true;
+}
+
+/**
+ @brief Start a shot from the indices and direction which have been set. The distance which
+		the arrow flies depends on how long the player has charged the bow
+ */
+void CBowProjectile::Fire(void)
+{
+	// By default, microsteps should be zero
+	i32vec2NumMicroSteps = glm::i32vec2(0, 0);
 
 	//CS: Init the color to white
 	runtimeColour = glm::vec4(1.0, 1.0, 1.0, 1.0);
@@ -118,10 +137,6 @@ bool CBowProjectile::Init(void)
 	cPhysics2D.Init();
 	cPhysics2D.SetStatus(CPhysics2D::STATUS::FALL);
 
-	arrowStorage = CScene2D::GetInstance()->getLiveArrowVector();
-
-	arrowDamage = 20;
-
 	amountOfCharge = cPlayer2D->returnCharge();
 
 	maxDistance = amountOfCharge * 5.0f;
@@ -137,10 +152,7 @@ bool CBowProjectile::Init(void)
 
 	hitEnemy = false;
 
-	// If this class is initialised properly, then set the bIsActive to true
 	bIsActive = true;
-
-	return true;
 }
 
 /**
@@ -152,10 +164,9 @@ void CBowProjectile::Update(const double dElapsedTime)
 		return;
 	
 	UpdatePosition();
-	if (arrowStorage.size() != 0)
-	{
-		CheckForInteraction();
-	}
+	CheckForInteraction();
+	if (!bIsActive)
+		return;
 	arrowAnimation->Update(dElapsedTime);
 	
 
@@ -172,17 +183,6 @@ void CBowProjectile::SetPlayer2D(CPlayer2D* cPlayer2D)
 	//UpdateDirection();
 }
 
-void CBowProjectile::setBulletVector(vector<CEntity2D*>& newBulletVector)
-{
-	arrowStorage = newBulletVector;
-}
-
-vector<CEntity2D*>& CBowProjectile::getBulletVector(void)
-{
-	// TODO: insert return statement here
-	return arrowStorage;
-}
-
 void CBowProjectile::setMaxDistance(float charge)
 {
 	maxDistance *= charge;
@@ -340,7 +340,7 @@ bool CBowProjectile::CheckPosition(DIRECTION eDirection)
 		if (i32vec2NumMicroSteps.y == 0)
 		{
 			// If the grid is not accessible, then return false
-			if (cMap2D->GetMapInfo(vec2Index.y, vec2Index.x) >= 100)
+			if (cMap2D->IsSolid(vec2Index.y, vec2Index.x))
 			{
 				return false;
 			}
@@ -349,8 +349,8 @@ bool CBowProjectile::CheckPosition(DIRECTION eDirection)
 		else if (i32vec2NumMicroSteps.y != 0)
 		{
 			// If the 2 grids are not accessible, then return false
-			if ((cMap2D->GetMapInfo(vec2Index.y, vec2Index.x) >= 100) ||
-				(cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x) >= 100))
+			if (cMap2D->IsSolid(vec2Index.y, vec2Index.x) ||
+				cMap2D->IsSolid(vec2Index.y + 1, vec2Index.x))
 			{
 				return false;
 			}
@@ -369,7 +369,7 @@ bool CBowProjectile::CheckPosition(DIRECTION eDirection)
 		if (i32vec2NumMicroSteps.y == 0)
 		{
 			// If the grid is not accessible, then return false
-			if (cMap2D->GetMapInfo(vec2Index.y, vec2Index.x + 1) >= 100)
+			if (cMap2D->IsSolid(vec2Index.y, vec2Index.x + 1))
 			{
 				return false;
 			}
@@ -378,8 +378,8 @@ bool CBowProjectile::CheckPosition(DIRECTION eDirection)
 		else if (i32vec2NumMicroSteps.y != 0)
 		{
 			// If the 2 grids are not accessible, then return false
-			if ((cMap2D->GetMapInfo(vec2Index.y, vec2Index.x + 1) >= 100) ||
-				(cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x + 1) >= 100))
+			if (cMap2D->IsSolid(vec2Index.y, vec2Index.x + 1) ||
+				cMap2D->IsSolid(vec2Index.y + 1, vec2Index.x + 1))
 			{
 				return false;
 			}
@@ -399,7 +399,7 @@ bool CBowProjectile::CheckPosition(DIRECTION eDirection)
 		if (i32vec2NumMicroSteps.x == 0)
 		{
 			// If the grid is not accessible, then return false
-			if (cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x) >= 100)
+			if (cMap2D->IsSolid(vec2Index.y + 1, vec2Index.x))
 			{
 				return false;
 			}
@@ -408,8 +408,7 @@ bool CBowProjectile::CheckPosition(DIRECTION eDirection)
 		else if (i32vec2NumMicroSteps.x != 0)
 		{
 			// If the 2 grids are not accessible, then return false
-			if ((cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x) >= 100) ||
-				(cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x + 1) >= 100))
+			if (cMap2D->AnySolid(vec2Index.y + 1, vec2Index.x, vec2Index.x + 1))
 			{
 				return false;
 			}
@@ -421,7 +420,7 @@ bool CBowProjectile::CheckPosition(DIRECTION eDirection)
 		if (i32vec2NumMicroSteps.x == 0)
 		{
 			// If the grid is not accessible, then return false
-			if (cMap2D->GetMapInfo(vec2Index.y, vec2Index.x) >= 100)
+			if (cMap2D->IsSolid(vec2Index.y, vec2Index.x))
 			{
 				return false;
 			}
@@ -430,8 +429,7 @@ bool CBowProjectile::CheckPosition(DIRECTION eDirection)
 		else if (i32vec2NumMicroSteps.x != 0)
 		{
 			// If the 2 grids are not accessible, then return false
-			if ((cMap2D->GetMapInfo(vec2Index.y, vec2Index.x) >= 100) ||
-				(cMap2D->GetMapInfo(vec2Index.y, vec2Index.x + 1) >= 100))
+			if (cMap2D->AnySolid(vec2Index.y, vec2Index.x, vec2Index.x + 1))
 			{
 				return false;
 			}
@@ -449,8 +447,8 @@ bool CBowProjectile::CheckPos(DIRECTION eDirection)
 {
 	if (eDirection == LEFT)
 	{
-		if ((cMap2D->GetMapInfo(vec2Index.y, vec2Index.x) >= 100) ||
-			(cMap2D->GetMapInfo(vec2Index.y, vec2Index.x - 1) >= 100) ||
+		// Check the tile and the tile to its left together
+		if (cMap2D->AnySolid(vec2Index.y, (vec2Index.x > 0) ? vec2Index.x - 1 : 0, vec2Index.x) ||
 			vec2Index.x < 0)
 		{
 			if (i32vec2NumMicroSteps.x == 0)
@@ -463,8 +461,8 @@ bool CBowProjectile::CheckPos(DIRECTION eDirection)
 	}
 	else if (eDirection == RIGHT)
 	{
-		if ((cMap2D->GetMapInfo(vec2Index.y, vec2Index.x) >= 100) ||
-			(cMap2D->GetMapInfo(vec2Index.y, vec2Index.x + 1) >= 100) ||
+		// Check the tile and the tile to its right together
+		if (cMap2D->AnySolid(vec2Index.y, vec2Index.x, vec2Index.x + 1) ||
 			vec2Index.x >= (int)cSettings->NUM_TILES_XAXIS - 1)
 		{
 			if (i32vec2NumMicroSteps.x == 0)
@@ -489,7 +487,7 @@ bool CBowProjectile::IsMidAir(void)
 
 	// Check if the tile below the player's current position is empty
 	if ((i32vec2NumMicroSteps.x == 0) &&
-		(cMap2D->GetMapInfo(vec2Index.y - 1, vec2Index.x) == 0))
+		TileProperties::IsEmpty(cMap2D->GetMapInfo(vec2Index.y - 1, vec2Index.x)))
 	{
 		return true;
 	}
@@ -503,25 +501,23 @@ bool CBowProjectile::IsMidAir(void)
  */
 bool CBowProjectile::InteractWithEnemies(void)
 {
-	vector<CEntity2D*>enemyList = CScene2D::GetInstance()->returnEnemyVector();
-	for (int enemyIndex = 0; enemyIndex != enemyList.size(); ++enemyIndex)
+	CEntityRegistry& cEnemies = CScene2D::GetInstance()->GetEnemies();
+	// Only the enemies in the arrow's row and within half a tile of it can be hit
+	CScene2D::GetInstance()->GetEnemySpatialHash().QueryRow(vec2Index.y, vec2Index.x - 0.5f, vec2Index.x + 0.5f, vNearbyEnemies);
+	for (unsigned int enemyIndex = 0; enemyIndex != vNearbyEnemies.size(); ++enemyIndex)
 	{
-		// Check if the enemy2D is within 1.5 indices of the player2D
-		if (((vec2Index.x >= enemyList[enemyIndex]->vec2Index.x - 0.5) &&
-			(vec2Index.x <= enemyList[enemyIndex]->vec2Index.x + 0.5))
-			&&
-			(vec2Index.y == enemyList[enemyIndex]->vec2Index.y))
+		CEntity2D* enemy = cEnemies.Get(vNearbyEnemies[enemyIndex]);
+		if (enemy)
 		{
 			//cout << "HEADSHOT!\n";
 			hitEnemy = true;
-			enemyList[enemyIndex]->health -= static_cast<int>(arrowDamage * amountOfCharge);
-			std::cout << enemyList[enemyIndex]->health << endl;
-			if (enemyList[enemyIndex]->health <= 0)
+			enemy->health -= static_cast<int>(arrowDamage * amountOfCharge);
+			std::cout << enemy->health << endl;
+			if (enemy->health <= 0)
 			{
-				enemyList[enemyIndex]->~CEntity2D();
-				enemyList.erase(enemyList.begin() + enemyIndex);
-				CScene2D::GetInstance()->setNewEnemyVector(enemyList);
-				cPlayer2D->addPlayerKills(1);
+				// The enemy is deleted at the end of the frame
+				if (cEnemies.Remove(vNearbyEnemies[enemyIndex]))
+					cPlayer2D->addPlayerKills(1);
 			}
 			// Since the player has been caught, then reset the FSM
 			return true;
@@ -631,69 +627,17 @@ void CBowProjectile::UpdatePosition(void)
 
 }
 
+/**
+ @brief Stop the arrow when it reaches a wall, has flown its full distance or hits an enemy.
+		The arrow is then inactive, and the projectile pool puts it back on the free list
+ */
 void CBowProjectile::CheckForInteraction(void)
 {
-	for (int i = 0; i < arrowStorage.size(); i++)
+	if (((i32vec2Direction.x > 0) && (CheckPos(RIGHT) || (vec2Index.x >= arrowDestination))) ||
+		((i32vec2Direction.x < 0) && (CheckPos(LEFT) || (vec2Index.x <= arrowDestination))) ||
+		hitEnemy)
 	{
-		if (i32vec2Direction.x > 0)
-		{
-			if (CheckPos(RIGHT))
-			{
-				arrowStorage[i]->~CEntity2D();
-				vector <CEntity2D*> temp = CScene2D::GetInstance()->getLiveArrowVector();
-				temp.erase(temp.begin() + i);
-				CScene2D::GetInstance()->setLiveArrowVector(temp);
-				arrowStorage = temp;
-				//cout << arrowStorage.size() << endl;
-				break;
-			}
-			else if (vec2Index.x >= arrowDestination)
-			{
-				arrowStorage[i]->~CEntity2D();
-				vector <CEntity2D*> temp = CScene2D::GetInstance()->getLiveArrowVector();
-				temp.erase(temp.begin() + i);
-				CScene2D::GetInstance()->setLiveArrowVector(temp);
-				arrowStorage = temp;
-				//cout << arrowStorage.size() << endl;
-				break;
-			}
-				    
-		}
-		else if (i32vec2Direction.x < 0)
-		{
-			if (CheckPos(LEFT))
-			{			
-				arrowStorage[i]->~CEntity2D();
-				vector <CEntity2D*> temp = CScene2D::GetInstance()->getLiveArrowVector();
-				temp.erase(temp.begin() + i);
-				CScene2D::GetInstance()->setLiveArrowVector(temp);
-				arrowStorage = temp;
-				//cout << arrowStorage.size() << endl;
-				break;	
-			}
-			else if (vec2Index.x <= arrowDestination)
-			{
-				arrowStorage[i]->~CEntity2D();
-				vector <CEntity2D*> temp = CScene2D::GetInstance()->getLiveArrowVector();
-				temp.erase(temp.begin() + i);
-				CScene2D::GetInstance()->setLiveArrowVector(temp);
-				arrowStorage = temp;
-				//cout << arrowStorage.size() << endl;
-				break;
-			}
-			
-		}
-		
-		if (hitEnemy)
-		{
-			arrowStorage[i]->~CEntity2D();
-			vector <CEntity2D*> temp = CScene2D::GetInstance()->getLiveArrowVector();
-			temp.erase(temp.begin() + i);
-			CScene2D::GetInstance()->setLiveArrowVector(temp);
-			arrowStorage = temp;
-			//cout << arrowStorage.size() << endl;
-			break;
-		}
-
+		hitEnemy = false;
+		bIsActive = false;
 	}
 }
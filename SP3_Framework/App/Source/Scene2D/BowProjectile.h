@@ -46,9 +46,12 @@ public:
 	// Destructor
 	virtual ~CBowProjectile(void);
 
-	// Init
+	// Init the things which do not change between shots
 	bool Init(void);
 
+	// Start a shot from the indices and direction which have been set
+	void Fire(void);
+
 	// Update
 	void Update(const double dElapsedTime);
 
@@ -85,12 +88,6 @@ public:
 	// Set the handle to cPlayer to this class instance
 	void SetPlayer2D(CPlayer2D* cPlayer2D);
 
-	// Set the size of the current bullet vector
-	void setBulletVector(vector<CEntity2D*>&newBulletVector);
-
-
-	vector<CEntity2D*>& getBulletVector(void);
-
 	// Sets the max distance of the arrow depending on the charge
 	void setMaxDistance(float charge);
 
@@ -108,8 +105,6 @@ protected:
 		NUM_DIRECTIONS
 	};
 
-	vector <CEntity2D*> arrowStorage;
-
 	glm::vec2 i32vec2OldIndex;
 
 	//CS: The quadMesh for drawing the tiles
@@ -166,6 +161,8 @@ protected:
 
 	bool hitEnemy;
 
+	// The enemies which the arrow could hit, which are kept between frames to reuse the memory
+	vector<CEntityRegistry::Handle> vNearbyEnemies;
 
 
 	// Constraint the enemy2D's position within a boundary
@@ -0,0 +1,294 @@
+/**
+ CConnectivityRegions
+ @brief A class which labels the connected regions of open tiles in a level with union-find,
+		and keeps them up to date as tiles change, so that unreachable path searches are
+		turned down at once.
+ */
+#include "ConnectivityRegions.h"
+
+// Include TileProperties
+#include "TileProperties.h"
+
+const unsigned int CConnectivityRegions::NO_NODE;
+
+// The tiles around a tile, in order around it, as (column, row) offsets
+static const int RING_OFFSETS[8][2] = {	{ 1, 0 }, { 1, 1 }, { 0, 1 }, { -1, 1 },
+										{ -1, 0 }, { -1, -1 }, { 0, -1 }, { 1, -1 } };
+
+/**
+ @brief Constructor
+ */
+CConnectivityRegions::CConnectivityRegions(void)
+	: uiNumRows(0)
+	, uiNumCols(0)
+	, uiNumDirections(4)
+	, uiNumBuilds(0)
+{
+}
+
+/**
+ @brief Destructor
+ */
+CConnectivityRegions::~CConnectivityRegions(void)
+{
+}
+
+/**
+ @brief Build the regions from the tiles of a level
+ @param arrTiles A const unsigned short* variable containing the tiles of the level
+ @param uiNumRows A const unsigned int variable containing the number of rows
+ @param uiNumCols A const unsigned int variable containing the number of columns
+ @param uiNumDirections A const unsigned int variable containing 4 to join tiles orthogonally,
+			or 8 to join them diagonally as well
+ */
+void CConnectivityRegions::Build(	const unsigned short* arrTiles,
+									const unsigned int uiNumRows,
+									const unsigned int uiNumCols,
+									const unsigned int uiNumDirections)
+{
+	this->uiNumRows = uiNumRows;
+	this->uiNumCols = uiNumCols;
+	this->uiNumDirections = (uiNumDirections == 8) ? 8 : 4;
+	uiNumBuilds++;
+
+	// Every open tile starts as a region of its own, using its index as its node
+	const unsigned int uiNumTiles = uiNumRows * uiNumCols;
+	vTileNodes.assign(uiNumTiles, NO_NODE);
+	vParents.resize(uiNumTiles);
+	vSizes.assign(uiNumTiles, 1);
+	for (unsigned int i = 0; i < uiNumTiles; i++)
+	{
+		vParents[i] = i;
+		if (IsOpenValue(arrTiles[i]))
+			vTileNodes[i] = i;
+	}
+
+	for (int iRow = 0; iRow < (int)uiNumRows; iRow++)
+	{
+		for (int iCol = 0; iCol < (int)uiNumCols; iCol++)
+		{
+			if (vTileNodes[iRow * uiNumCols + iCol] != NO_NODE)
+				JoinNeighbours(arrTiles, iRow, iCol);
+		}
+	}
+}
+
+/**
+ @brief Update the regions after the value of a tile has changed. A tile which opens is joined
+		to the regions around it. A tile which becomes solid is only a problem if it was the
+		one link between some of its neighbours, and then the regions are built again
+ @param arrTiles A const unsigned short* variable containing the tiles of the level, with the new value
+ @param uiRow A const unsigned int variable containing the row of the tile, where row 0 is the bottom row
+ @param uiCol A const unsigned int variable containing the column of the tile
+ */
+void CConnectivityRegions::Update(const unsigned short* arrTiles, const unsigned int uiRow, const unsigned int uiCol)
+{
+	if ((uiRow >= uiNumRows) || (uiCol >= uiNumCols))
+		return;
+
+	const unsigned int uiIndex = uiRow * uiNumCols + uiCol;
+	const bool bOpen = IsOpenValue(arrTiles[uiIndex]);
+	if (bOpen == (vTileNodes[uiIndex] != NO_NODE))
+		return;
+
+	if (bOpen)
+	{
+		// Start the tile in a new node, and build again if the nodes have grown too many
+		if (vParents.size() >= 2 * vTileNodes.size())
+		{
+			Build(arrTiles, uiNumRows, uiNumCols, uiNumDirections);
+			return;
+		}
+		vTileNodes[uiIndex] = (unsigned int)vParents.size();
+		vParents.push_back(vTileNodes[uiIndex]);
+		vSizes.push_back(1);
+		JoinNeighbours(arrTiles, uiRow, uiCol);
+	}
+	else
+	{
+		// The tile's old node stays in its region, which the tile has just left
+		vTileNodes[uiIndex] = NO_NODE;
+		if (MaySplit(arrTiles, uiRow, uiCol))
+			Build(arrTiles, uiNumRows, uiNumCols, uiNumDirections);
+	}
+}
+
+/**
+ @brief Check if there is a path of open tiles between two tiles
+ @param uiRowA A const unsigned int variable containing the row of the first tile, where row 0 is the bottom row
+ @param uiColA A const unsigned int variable containing the column of the first tile
+ @param uiRowB A const unsigned int variable containing the row of the second tile
+ @param uiColB A const unsigned int variable containing the column of the second tile
+ @return true if both tiles are open and in the same region, otherwise false
+ */
+bool CConnectivityRegions::IsConnected(	const unsigned int uiRowA, const unsigned int uiColA,
+										const unsigned int uiRowB, const unsigned int uiColB) const
+{
+	if ((uiRowA >= uiNumRows) || (uiColA >= uiNumCols) || (uiRowB >= uiNumRows) || (uiColB >= uiNumCols))
+		return false;
+
+	const unsigned int uiNodeA = vTileNodes[uiRowA * uiNumCols + uiColA];
+	const unsigned int uiNodeB = vTileNodes[uiRowB * uiNumCols + uiColB];
+	if ((uiNodeA == NO_NODE) || (uiNodeB == NO_NODE))
+		return false;
+
+	return FindRoot(uiNodeA) == FindRoot(uiNodeB);
+}
+
+/**
+ @brief Get the number of times the regions were built, including the rebuilds after a split
+ */
+unsigned int CConnectivityRegions::GetNumBuilds(void) const
+{
+	return uiNumBuilds;
+}
+
+/**
+ @brief Swap the contents with other regions
+ @param cOther A CConnectivityRegions& variable containing the regions to swap with
+ */
+void CConnectivityRegions::Swap(CConnectivityRegions& cOther)
+{
+	std::swap(uiNumRows, cOther.uiNumRows);
+	std::swap(uiNumCols, cOther.uiNumCols);
+	std::swap(uiNumDirections, cOther.uiNumDirections);
+	vTileNodes.swap(cOther.vTileNodes);
+	vParents.swap(cOther.vParents);
+	vSizes.swap(cOther.vSizes);
+	std::swap(uiNumBuilds, cOther.uiNumBuilds);
+}
+
+/**
+ @brief Check if a tile value does not block, the same as CGridSearch
+ */
+bool CConnectivityRegions::IsOpenValue(const unsigned short usValue)
+{
+	return !TileProperties::IsSolid(usValue);
+}
+
+/**
+ @brief Check if a tile is inside the level and open
+ */
+bool CConnectivityRegions::IsOpen(const unsigned short* arrTiles, const int iRow, const int iCol) const
+{
+	if ((iRow < 0) || (iRow >= (int)uiNumRows) || (iCol < 0) || (iCol >= (int)uiNumCols))
+		return false;
+	return IsOpenValue(arrTiles[iRow * uiNumCols + iCol]);
+}
+
+/**
+ @brief Get the root of a node, pointing every other node on the way at its grandparent
+ */
+unsigned int CConnectivityRegions::Find(unsigned int uiNode)
+{
+	while (vParents[uiNode] != uiNode)
+	{
+		vParents[uiNode] = vParents[vParents[uiNode]];
+		uiNode = vParents[uiNode];
+	}
+	return uiNode;
+}
+
+/**
+ @brief Get the root of a node without changing the nodes. The regions are joined by size,
+		so the way to the root is never longer than log2 of the number of tiles
+ */
+unsigned int CConnectivityRegions::FindRoot(unsigned int uiNode) const
+{
+	while (vParents[uiNode] != uiNode)
+		uiNode = vParents[uiNode];
+	return uiNode;
+}
+
+/**
+ @brief Join the regions of two nodes, putting the smaller region under the larger one
+ */
+void CConnectivityRegions::Union(const unsigned int uiNodeA, const unsigned int uiNodeB)
+{
+	unsigned int uiRootA = Find(uiNodeA);
+	unsigned int uiRootB = Find(uiNodeB);
+	if (uiRootA == uiRootB)
+		return;
+
+	if (vSizes[uiRootA] < vSizes[uiRootB])
+	{
+		const unsigned int uiTemp = uiRootA;
+		uiRootA = uiRootB;
+		uiRootB = uiTemp;
+	}
+	vParents[uiRootB] = uiRootA;
+	vSizes[uiRootA] += vSizes[uiRootB];
+}
+
+/**
+ @brief Join an open tile to the regions of its open neighbours
+ */
+void CConnectivityRegions::JoinNeighbours(const unsigned short* arrTiles, const int iRow, const int iCol)
+{
+	const unsigned int uiNode = vTileNodes[iRow * uiNumCols + iCol];
+	for (unsigned int i = 0; i < 8; i++)
+	{
+		// The odd offsets are the diagonal ones
+		if ((uiNumDirections == 4) && (i % 2 == 1))
+			continue;
+
+		const int iNeighbourRow = iRow + RING_OFFSETS[i][1];
+		const int iNeighbourCol = iCol + RING_OFFSETS[i][0];
+		if (IsOpen(arrTiles, iNeighbourRow, iNeighbourCol))
+			Union(uiNode, vTileNodes[iNeighbourRow * uiNumCols + iNeighbourCol]);
+	}
+}
+
+/**
+ @brief Check if making a tile solid could split its region. The region cannot split if all
+		the tile's open neighbours are still joined to each other through the ring of tiles
+		around it. Otherwise they may only have been joined through the tile, which can only
+		be told by building the regions again
+ */
+bool CConnectivityRegions::MaySplit(const unsigned short* arrTiles, const int iRow, const int iCol) const
+{
+	bool arrOpen[8];
+	unsigned int arrLabels[8];
+	for (unsigned int i = 0; i < 8; i++)
+	{
+		arrOpen[i] = IsOpen(arrTiles, iRow + RING_OFFSETS[i][1], iCol + RING_OFFSETS[i][0]);
+		arrLabels[i] = i;
+	}
+
+	// Join the open tiles of the ring which are next to each other. In 8 directions, the
+	// orthogonal tiles two steps apart around the ring are diagonal to each other as well
+	const unsigned int uiNumSteps = (uiNumDirections == 8) ? 2 : 1;
+	bool bChanged = true;
+	while (bChanged)
+	{
+		bChanged = false;
+		for (unsigned int i = 0; i < 8; i++)
+		{
+			for (unsigned int uiStep = 1; uiStep <= uiNumSteps; uiStep++)
+			{
+				const unsigned int j = (i + uiStep) % 8;
+				if ((uiStep == 2) && (i % 2 == 1))
+					continue;
+				if (!arrOpen[i] || !arrOpen[j] || (arrLabels[i] == arrLabels[j]))
+					continue;
+
+				const unsigned int uiLabel = (arrLabels[i] < arrLabels[j]) ? arrLabels[i] : arrLabels[j];
+				arrLabels[i] = arrLabels[j] = uiLabel;
+				bChanged = true;
+			}
+		}
+	}
+
+	// Count the groups which hold a neighbour of the tile
+	unsigned int uiFirstLabel = NO_NODE;
+	for (unsigned int i = 0; i < 8; i++)
+	{
+		if (!arrOpen[i] || ((uiNumDirections == 4) && (i % 2 == 1)))
+			continue;
+		if (uiFirstLabel == NO_NODE)
+			uiFirstLabel = arrLabels[i];
+		else if (arrLabels[i] != uiFirstLabel)
+			return true;
+	}
+	return false;
+}
@@ -0,0 +1,81 @@
+/**
+ CConnectivityRegions
+ @brief A class which labels the connected regions of open tiles in a level with union-find,
+		so that a path search between two tiles in different regions can be turned down
+		without flooding the start's region. Tiles are solid when TileProperties::IsSolid()
+		says so, the same as CGridSearch, and the regions join tiles in 4 or 8 directions.
+
+		The regions are updated tile by tile as the level changes. A tile which opens is
+		joined to the regions around it. A tile which becomes solid can only split its region
+		if its open neighbours are not joined to each other around it, and only then are the
+		regions built again. Positions are the row and column in the level's row-major tile
+		array, where row 0 is the bottom row.
+ */
+#pragma once
+
+#include <vector>
+
+class CConnectivityRegions
+{
+public:
+	// Constructor
+	CConnectivityRegions(void);
+
+	// Destructor
+	virtual ~CConnectivityRegions(void);
+
+	// Build the regions from the tiles of a level
+	void Build(	const unsigned short* arrTiles,
+				const unsigned int uiNumRows,
+				const unsigned int uiNumCols,
+				const unsigned int uiNumDirections);
+
+	// Update the regions after the value of a tile has changed
+	void Update(const unsigned short* arrTiles, const unsigned int uiRow, const unsigned int uiCol);
+
+	// Check if there is a path of open tiles between two tiles
+	bool IsConnected(	const unsigned int uiRowA, const unsigned int uiColA,
+						const unsigned int uiRowB, const unsigned int uiColB) const;
+
+	// Get the number of times the regions were built, including the rebuilds after a split
+	unsigned int GetNumBuilds(void) const;
+
+	// Swap the contents with other regions
+	void Swap(CConnectivityRegions& cOther);
+
+protected:
+	// The node of a tile which is solid
+	static const unsigned int NO_NODE = 0xFFFFFFFF;
+
+	// The size of the level, and the directions which the regions join tiles in
+	unsigned int uiNumRows;
+	unsigned int uiNumCols;
+	unsigned int uiNumDirections;
+
+	// The union-find node of each tile, or NO_NODE if it is solid. A tile which opens again
+	// gets a new node, since its old node may still hold a region which it is no longer in
+	std::vector<unsigned int> vTileNodes;
+	// The parent and the size of each node, where a root is its own parent
+	std::vector<unsigned int> vParents;
+	std::vector<unsigned int> vSizes;
+
+	// The number of times the regions were built
+	unsigned int uiNumBuilds;
+
+	// Check if a tile value does not block
+	static bool IsOpenValue(const unsigned short usValue);
+	// Check if a tile is inside the level and open
+	bool IsOpen(const unsigned short* arrTiles, const int iRow, const int iCol) const;
+
+	// Get the root of a node, halving the path to it on the way
+	unsigned int Find(unsigned int uiNode);
+	// Get the root of a node without changing the nodes
+	unsigned int FindRoot(unsigned int uiNode) const;
+	// Join the regions of two nodes
+	void Union(const unsigned int uiNodeA, const unsigned int uiNodeB);
+	// Join a tile to the regions of its open neighbours
+	void JoinNeighbours(const unsigned short* arrTiles, const int iRow, const int iCol);
+
+	// Check if making a tile solid could split its region
+	bool MaySplit(const unsigned short* arrTiles, const int iRow, const int iCol) const;
+};
@@ -14,8 +14,8 @@
 #include <includes/gtc/matrix_transform.hpp>
 #include <includes/gtc/type_ptr.hpp>
 
-// Include CEntity2D
-#include "Primitives/Entity2D.h"
+// Include CEnemyBody2D
+#include "EnemyBody2D.h"
 
 // Include the Map2D as we will use it to check the player's movements and actions
 class CMap2D;
@@ -29,7 +29,7 @@ class CMap2D;
 // Include Player2D
 #include "Player2D.h"
 
-class CEnemy2D : public CEntity2D
+class CEnemy2D : public CEnemyBody2D
 {
 public:
 	// Constructor
@@ -78,15 +78,6 @@ public:
 	bool bIsActive;
 
 protected:
-	enum DIRECTION
-	{
-		LEFT = 0,
-		RIGHT = 1,
-		UP = 2,
-		DOWN = 3,
-		NUM_DIRECTIONS
-	};
-
 	enum FSM
 	{
 		IDLE = 0,
@@ -103,19 +94,15 @@ protected:
 	// Handler to the CMap2D instance
 	CMap2D* cMap2D;
 
+	// The path buffer, which is reused for every path
+	std::vector<glm::vec2> vPath;
+
 	// A transformation matrix for controlling where to render the entities
 	glm::mat4 transform;
 
 	// The vec2 which stores the indices of the enemy2D in the Map2D
 	glm::vec2 i32vec2Index;
 
-	// The vec2 variable which stores The number of microsteps from the tile indices for the enemy2D. 
-	// A tile's width or height is in multiples of these microsteps
-	glm::vec2 i32vec2NumMicroSteps;
-
-	// The vec2 variable which stores the UV coordinates to render the enemy2D
-	glm::vec2 vec2UVCoordinate;
-
 	// The vec2 which stores the indices of the destination for enemy2D in the Map2D
 	glm::vec2 i32vec2Destination;
 	// The vec2 which stores the direction for enemy2D movement in the Map2D
@@ -124,36 +111,15 @@ protected:
 	// Settings
 	CSettings* cSettings;
 
-	// Physics
-	CPhysics2D cPhysics2D;
-
 	// Current color
 	glm::vec4 runtimeColour;
 
 	// Handle to the CPlayer2D
 	CPlayer2D* cPlayer2D;
 
-	// Current FSM
-	FSM sCurrentFSM;
-
-	// FSM counter - count how many frames it has been in this FSM
-	int iFSMCounter;
-
 	// Max count in a state
 	const int iMaxFSMCounter = 60;
 
-	// Constraint the enemy2D's position within a boundary
-	void Constraint(DIRECTION eDirection = LEFT);
-
-	// Check if a position is possible to move into
-	bool CheckPosition(DIRECTION eDirection);
-
-	// Check if the enemy2D is in mid-air
-	bool IsMidAir(void);
-
-	// Update Jump or Fall
-	void UpdateJumpFall(const double dElapsedTime = 0.0166666666666667);
-
 	// Let enemy2D interact with the player
 	bool InteractWithPlayer(void);
 
@@ -0,0 +1,77 @@
+/**
+ CEnemyBody2D
+ @brief A class which every enemy derives from. It holds a body in the CEnemySimulation.
+ */
+#include "EnemyBody2D.h"
+
+/**
+ @brief Constructor
+ */
+CEnemyBody2D::CEnemyBody2D(void)
+	: cSimulation(NULL)
+	, uiBody(0)
+{
+	// Get the handler to the CEnemySimulation instance, and a body in it
+	cSimulation = CEnemySimulation::GetInstance();
+	uiBody = cSimulation->AddBody(this);
+}
+
+/**
+ @brief Destructor
+ */
+CEnemyBody2D::~CEnemyBody2D(void)
+{
+	// Give the body back to the simulation
+	if (cSimulation)
+	{
+		cSimulation->RemoveBody(uiBody);
+		cSimulation = NULL;
+	}
+}
+
+/**
+ @brief Move the enemy to a position, outside of the updates of the simulation
+ @param vec2NewIndex A const glm::vec2& variable containing the indices of the position
+ */
+void CEnemyBody2D::SetIndex(const glm::vec2& vec2NewIndex)
+{
+	Index() = vec2NewIndex;
+	// Copy it now, since the enemy may be found by its position before the next update
+	vec2Index = vec2NewIndex;
+}
+
+/**
+ @brief Constraint the enemy's position within a boundary
+ @param eDirection A DIRECTION enumerated data type which indicates the direction to check
+ */
+void CEnemyBody2D::Constraint(DIRECTION eDirection)
+{
+	cSimulation->Constraint(uiBody, (CEnemySimulation::DIRECTION)eDirection);
+}
+
+/**
+ @brief Check if a position is possible to move into
+ @param eDirection A DIRECTION enumerated data type which indicates the direction to check
+ */
+bool CEnemyBody2D::CheckPosition(DIRECTION eDirection)
+{
+	return cSimulation->CheckPosition(uiBody, (CEnemySimulation::DIRECTION)eDirection);
+}
+
+/**
+ @brief Check if the enemy is in mid-air
+ */
+bool CEnemyBody2D::IsMidAir(void)
+{
+	return cSimulation->IsMidAir(uiBody);
+}
+
+/**
+ @brief Calculate the distance between two positions
+ @param source A const glm::vec2& variable containing the first position
+ @param destination A const glm::vec2& variable containing the second position
+ */
+float CEnemyBody2D::CalculateDistance(const glm::vec2& source, const glm::vec2& destination)
+{
+	return glm::length(destination - source);
+}
@@ -0,0 +1,92 @@
+/**
+ CEnemyBody2D
+ @brief A class which every enemy derives from. It holds a body in the CEnemySimulation,
+		and gives the enemy's own code access to the state which the simulation keeps,
+		such as its position, microsteps, jump or fall and FSM. The enemy's position is
+		kept in the simulation, and copied into vec2Index after every update of it, so
+		the enemy's own code uses Index() and everything else reads vec2Index.
+ */
+#pragma once
+
+// Include CEntity2D
+#include "Primitives/Entity2D.h"
+
+// Include CEnemySimulation
+#include "EnemySimulation.h"
+
+class CEnemyBody2D : public CEntity2D
+{
+public:
+	// Constructor
+	CEnemyBody2D(void);
+
+	// Destructor
+	virtual ~CEnemyBody2D(void);
+
+protected:
+	enum DIRECTION
+	{
+		LEFT = CEnemySimulation::LEFT,
+		RIGHT = CEnemySimulation::RIGHT,
+		UP = CEnemySimulation::UP,
+		DOWN = CEnemySimulation::DOWN,
+		NUM_DIRECTIONS
+	};
+
+	// Handler to the CEnemySimulation instance
+	CEnemySimulation* cSimulation;
+
+	// The body of this enemy in the simulation
+	unsigned int uiBody;
+
+	// The indices of the enemy in the Map2D
+	glm::vec2& Index(void)
+	{
+		return cSimulation->Index(uiBody);
+	}
+
+	// The number of microsteps from the tile indices of the enemy
+	glm::vec2& MicroSteps(void)
+	{
+		return cSimulation->MicroSteps(uiBody);
+	}
+
+	// The UV coordinates to render the enemy
+	glm::vec2& UVCoordinate(void)
+	{
+		return cSimulation->UVCoordinate(uiBody);
+	}
+
+	// The current FSM
+	int& CurrentFSM(void)
+	{
+		return cSimulation->FSM(uiBody);
+	}
+
+	// The number of frames it has been in the current FSM
+	int& FSMCounter(void)
+	{
+		return cSimulation->FSMCounter(uiBody);
+	}
+
+	// The time until the enemy can attack again
+	float& AttackTimer(void)
+	{
+		return cSimulation->Timer(uiBody);
+	}
+
+	// Move the enemy to a position, outside of the updates of the simulation
+	void SetIndex(const glm::vec2& vec2NewIndex);
+
+	// Constraint the enemy's position within a boundary
+	void Constraint(DIRECTION eDirection = LEFT);
+
+	// Check if a position is possible to move into
+	bool CheckPosition(DIRECTION eDirection);
+
+	// Check if the enemy is in mid-air
+	bool IsMidAir(void);
+
+	// Calculate the distance between two positions
+	static float CalculateDistance(const glm::vec2& source, const glm::vec2& destination);
+};
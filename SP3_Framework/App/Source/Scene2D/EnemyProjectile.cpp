@@ -22,6 +22,8 @@ using namespace std;
 
 // Include the Map2D as we will use it to check the player's movements and actions
 #include "Map2D.h"
+// Include TileProperties
+#include "TileProperties.h"
 // Include math.h
 #include <math.h>
 
@@ -35,6 +37,10 @@ CEnemyProjectile::CEnemyProjectile(void)
 	, cPlayer2D(NULL)
 	, quadMesh(NULL)
 	, bulletAnimation(NULL)
+	, iWallCol(0)
+	, uiWallVersion(0)
+	, iWallRow(-1)
+	, iWallDirection(0)
 {
 	transform = glm::mat4(1.0f);	// make sure to initialize matrix to identity matrix first
 
@@ -63,6 +69,13 @@ CEnemyProjectile::~CEnemyProjectile(void)
 		quadMesh = NULL;
 	}
 
+	// Delete the bulletAnimation
+	if (bulletAnimation)
+	{
+		delete bulletAnimation;
+		bulletAnimation = NULL;
+	}
+
 	cPlayer2D = NULL;
 
 	// We won't delete this since it was created elsewhere
@@ -75,7 +88,8 @@ CEnemyProjectile::~CEnemyProjectile(void)
 }
 
 /**
-  @brief Initialise this instance without reading from the map (won't be necessary)
+  @brief Initialise the things which do not change between shots, such as the meshes and the
+		texture. This is done once, when the projectile pool is created, and Fire() starts each shot
   */
 bool CEnemyProjectile::Init(void)
 {
@@ -85,13 +99,6 @@ bool CEnemyProjectile::Init(void)
 	// Get the handler to the CMap2D instance
 	cMap2D = CMap2D::GetInstance();
 
-	// By default, microsteps should be zero
-	i32vec2NumMicroSteps = glm::i32vec2(0, 0);
-	// By default, microsteps should be zero
-	i32vec2NumMicroSteps = glm::i32vec2(0, 0);
-
-	//i32vec2Direction = glm::i32vec2(0, 0);
-
 	glGenVertexArrays(1, &VAO);
 	glBindVertexArray(VAO);
 
@@ -110,6 +117,21 @@ bool CEnemyProjectile::Init(void)
 	bulletAnimation->AddAnimation("Left", 0, 2);
 	bulletAnimation->AddAnimation("Right", 3, 5);
 
+	bulletDamage = 10;
+
+	// The bullet is not active until it is fired
+	bIsActive = false;
+
+	return true;
+}
+
+/**
+ @brief Start a shot from the indices and direction which have been set
+ */
+void CEnemyProjectile::Fire(void)
+{
+	// By default, microsteps should be zero
+	i32vec2NumMicroSteps = glm::i32vec2(0, 0);
 
 	//CS: Init the color to white
 	runtimeColour = glm::vec4(1.0, 1.0, 1.0, 1.0);
@@ -118,15 +140,12 @@ bool CEnemyProjectile::Init(void)
 	cPhysics2D.Init();
 	cPhysics2D.SetStatus(CPhysics2D::STATUS::FALL);
 
-	bulletStorage = CScene2D::GetInstance()->getLiveBulletVector();
 	hitPlayer = false;
 
-	bulletDamage = 10;
+	// Find the first wall in the bullet's path again
+	iWallRow = -1;
 
-	// If this class is initialised properly, then set the bIsActive to true
 	bIsActive = true;
-
-	return true;
 }
 
 /**
@@ -139,10 +158,9 @@ void CEnemyProjectile::Update(const double dElapsedTime)
 
 	
 	UpdatePosition();
-	if (bulletStorage.size() != 0)
-	{
-		CheckForInteraction();
-	}
+	CheckForInteraction();
+	if (!bIsActive)
+		return;
 	bulletAnimation->Update(dElapsedTime);
 	
 
@@ -159,17 +177,6 @@ void CEnemyProjectile::SetPlayer2D(CPlayer2D* cPlayer2D)
 	//UpdateDirection();
 }
 
-void CEnemyProjectile::setBulletVector(vector<CEntity2D*>& newBulletVector)
-{
-	bulletStorage = newBulletVector;
-}
-
-vector<CEntity2D*>& CEnemyProjectile::getBulletVector(void)
-{
-	// TODO: insert return statement here
-	return bulletStorage;
-}
-
 /**
  @brief Set up the OpenGL display environment before rendering
  */
@@ -322,7 +329,7 @@ bool CEnemyProjectile::CheckPosition(DIRECTION eDirection)
 		if (i32vec2NumMicroSteps.y == 0)
 		{
 			// If the grid is not accessible, then return false
-			if (cMap2D->GetMapInfo(vec2Index.y, vec2Index.x) >= 100)
+			if (cMap2D->IsSolid(vec2Index.y, vec2Index.x))
 			{
 				return false;
 			}
@@ -331,8 +338,8 @@ bool CEnemyProjectile::CheckPosition(DIRECTION eDirection)
 		else if (i32vec2NumMicroSteps.y != 0)
 		{
 			// If the 2 grids are not accessible, then return false
-			if ((cMap2D->GetMapInfo(vec2Index.y, vec2Index.x) >= 100) ||
-				(cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x) >= 100))
+			if (cMap2D->IsSolid(vec2Index.y, vec2Index.x) ||
+				cMap2D->IsSolid(vec2Index.y + 1, vec2Index.x))
 			{
 				return false;
 			}
@@ -351,7 +358,7 @@ bool CEnemyProjectile::CheckPosition(DIRECTION eDirection)
 		if (i32vec2NumMicroSteps.y == 0)
 		{
 			// If the grid is not accessible, then return false
-			if (cMap2D->GetMapInfo(vec2Index.y, vec2Index.x + 1) >= 100)
+			if (cMap2D->IsSolid(vec2Index.y, vec2Index.x + 1))
 			{
 				return false;
 			}
@@ -360,8 +367,8 @@ bool CEnemyProjectile::CheckPosition(DIRECTION eDirection)
 		else if (i32vec2NumMicroSteps.y != 0)
 		{
 			// If the 2 grids are not accessible, then return false
-			if ((cMap2D->GetMapInfo(vec2Index.y, vec2Index.x + 1) >= 100) ||
-				(cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x + 1) >= 100))
+			if (cMap2D->IsSolid(vec2Index.y, vec2Index.x + 1) ||
+				cMap2D->IsSolid(vec2Index.y + 1, vec2Index.x + 1))
 			{
 				return false;
 			}
@@ -381,7 +388,7 @@ bool CEnemyProjectile::CheckPosition(DIRECTION eDirection)
 		if (i32vec2NumMicroSteps.x == 0)
 		{
 			// If the grid is not accessible, then return false
-			if (cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x) >= 100)
+			if (cMap2D->IsSolid(vec2Index.y + 1, vec2Index.x))
 			{
 				return false;
 			}
@@ -390,8 +397,7 @@ bool CEnemyProjectile::CheckPosition(DIRECTION eDirection)
 		else if (i32vec2NumMicroSteps.x != 0)
 		{
 			// If the 2 grids are not accessible, then return false
-			if ((cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x) >= 100) ||
-				(cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x + 1) >= 100))
+			if (cMap2D->AnySolid(vec2Index.y + 1, vec2Index.x, vec2Index.x + 1))
 			{
 				return false;
 			}
@@ -403,7 +409,7 @@ bool CEnemyProjectile::CheckPosition(DIRECTION eDirection)
 		if (i32vec2NumMicroSteps.x == 0)
 		{
 			// If the grid is not accessible, then return false
-			if (cMap2D->GetMapInfo(vec2Index.y, vec2Index.x) >= 100)
+			if (cMap2D->IsSolid(vec2Index.y, vec2Index.x))
 			{
 				return false;
 			}
@@ -412,8 +418,7 @@ bool CEnemyProjectile::CheckPosition(DIRECTION eDirection)
 		else if (i32vec2NumMicroSteps.x != 0)
 		{
 			// If the 2 grids are not accessible, then return false
-			if ((cMap2D->GetMapInfo(vec2Index.y, vec2Index.x) >= 100) ||
-				(cMap2D->GetMapInfo(vec2Index.y, vec2Index.x + 1) >= 100))
+			if (cMap2D->AnySolid(vec2Index.y, vec2Index.x, vec2Index.x + 1))
 			{
 				return false;
 			}
@@ -427,41 +432,51 @@ bool CEnemyProjectile::CheckPosition(DIRECTION eDirection)
 	return true;
 }
 
+/**
+ @brief Check if the bullet has reached the wall in its path, or the edge of the level
+ @param eDirection A DIRECTION enumerated data type which indicates the direction of the bullet
+ */
 bool CEnemyProjectile::CheckPos(DIRECTION eDirection)
 {
+	if (i32vec2NumMicroSteps.x != 0)
+		return false;
+
+	UpdateWall();
 	if (eDirection == LEFT)
-	{
-		if ((cMap2D->GetMapInfo(vec2Index.y, vec2Index.x) >= 100) ||
-			(cMap2D->GetMapInfo(vec2Index.y, vec2Index.x - 1) >= 100) ||
-			vec2Index.x < 0)
-		{
-			if (i32vec2NumMicroSteps.x == 0)
-				return true;
-		}
-		else
-		{
-			return false;
-		}
-	}
+		return iWallCol >= (int)vec2Index.x - 1;
 	else if (eDirection == RIGHT)
-	{
-		if ((cMap2D->GetMapInfo(vec2Index.y, vec2Index.x) >= 100) ||
-			(cMap2D->GetMapInfo(vec2Index.y, vec2Index.x + 1) >= 100) ||
-			vec2Index.x >= (int)cSettings->NUM_TILES_XAXIS - 1)
-		{
-			if (i32vec2NumMicroSteps.x == 0)
-				return true;
-		}
-		else
-		{
-			return false;
-		}
-	}
-	
-	
+		return iWallCol <= (int)vec2Index.x + 1;
+
 	return false;
 }
 
+/**
+ @brief Find the first wall in the bullet's path with one raycast along its row. This is only
+		done again when a tile of the level changes, or the bullet changes row or direction.
+		If there is no wall, the column past the edge of the level is used
+ */
+void CEnemyProjectile::UpdateWall(void)
+{
+	const int iDirection = (i32vec2Direction.x < 0) ? -1 : 1;
+	if ((uiWallVersion == cMap2D->GetMapVersion()) &&
+		(iWallRow == (int)vec2Index.y) &&
+		(iWallDirection == iDirection))
+		return;
+
+	uiWallVersion = cMap2D->GetMapVersion();
+	iWallRow = (int)vec2Index.y;
+	iWallDirection = iDirection;
+
+	const int iEdgeCol = (iDirection < 0) ? 0 : (int)cSettings->NUM_TILES_XAXIS - 1;
+	CTileRaycaster::RaycastHit sHit;
+	if (cMap2D->Raycast(glm::vec2((int)vec2Index.x + 0.5f, iWallRow + 0.5f),
+						glm::vec2(iEdgeCol + 0.5f, iWallRow + 0.5f),
+						sHit))
+		iWallCol = sHit.i32vec2Tile.x;
+	else
+		iWallCol = iEdgeCol + iDirection;
+}
+
 // Check if the enemy2D is in mid-air
 bool CEnemyProjectile::IsMidAir(void)
 {
@@ -471,7 +486,7 @@ bool CEnemyProjectile::IsMidAir(void)
 
 	// Check if the tile below the player's current position is empty
 	if ((i32vec2NumMicroSteps.x == 0) &&
-		(cMap2D->GetMapInfo(vec2Index.y - 1, vec2Index.x) == 0))
+		TileProperties::IsEmpty(cMap2D->GetMapInfo(vec2Index.y - 1, vec2Index.x)))
 	{
 		return true;
 	}
@@ -605,58 +620,18 @@ void CEnemyProjectile::UpdatePosition(void)
 	}
 }
 
+/**
+ @brief Stop the bullet when it reaches a wall or hits the player. The bullet is then inactive,
+		and the projectile pool puts it back on the free list
+ */
 void CEnemyProjectile::CheckForInteraction(void)
 {
-	for (int i = 0; i < bulletStorage.size(); i++)
+	if (((i32vec2Direction.x > 0) && CheckPos(RIGHT)) ||
+		((i32vec2Direction.x < 0) && CheckPos(LEFT)) ||
+		(i32vec2Direction.x == 0) ||
+		hitPlayer)
 	{
-		if (i32vec2Direction.x > 0)
-		{
-			if (CheckPos(RIGHT))
-			{
-				bulletStorage[i]->~CEntity2D();
-				vector <CEntity2D*> temp = CScene2D::GetInstance()->getLiveBulletVector();
-				temp.erase(temp.begin() + i);
-				CScene2D::GetInstance()->setLiveBulletVector(temp);
-				bulletStorage = temp;
-				//cout << bulletStorage.size() << endl;
-				break;
-			}
-				    
-		}
-		else if (i32vec2Direction.x < 0)
-		{
-			if (CheckPos(LEFT))
-			{			
-				bulletStorage[i]->~CEntity2D();
-				vector <CEntity2D*> temp = CScene2D::GetInstance()->getLiveBulletVector();
-				temp.erase(temp.begin() + i);
-				CScene2D::GetInstance()->setLiveBulletVector(temp);
-				bulletStorage = temp;
-				//cout << bulletStorage.size() << endl;
-				break;	
-			}
-			
-		}
-		else if (i32vec2Direction.x == 0)
-		{
-			bulletStorage[i]->~CEntity2D();
-			vector <CEntity2D*> temp = CScene2D::GetInstance()->getLiveBulletVector();
-			temp.erase(temp.begin() + i);
-			CScene2D::GetInstance()->setLiveBulletVector(temp);
-			bulletStorage = temp;
-			//cout << bulletStorage.size() << endl;
-			break;
-		}
-		if (hitPlayer)
-		{
-			bulletStorage[i]->~CEntity2D();
-			vector <CEntity2D*> temp = CScene2D::GetInstance()->getLiveBulletVector();
-			temp.erase(temp.begin() + i);
-			CScene2D::GetInstance()->setLiveBulletVector(temp);
-			bulletStorage = temp;
-			//cout << bulletStorage.size() << endl;
-			hitPlayer = false;
-			break;
-		}
+		hitPlayer = false;
+		bIsActive = false;
 	}
 }
@@ -46,9 +46,12 @@ public:
 	// Destructor
 	virtual ~CEnemyProjectile(void);
 
-	// Init
+	// Init the things which do not change between shots
 	bool Init(void);
 
+	// Start a shot from the indices and direction which have been set
+	void Fire(void);
+
 	// Update
 	void Update(const double dElapsedTime);
 
@@ -85,12 +88,6 @@ public:
 	// Set the handle to cPlayer to this class instance
 	void SetPlayer2D(CPlayer2D* cPlayer2D);
 
-	// Set the size of the current bullet vector
-	void setBulletVector(vector<CEntity2D*>&newBulletVector);
-
-
-	vector<CEntity2D*>& getBulletVector(void);
-
 	
 	// boolean flag to indicate if this enemy is active
 	bool bIsActive;
@@ -105,8 +102,6 @@ protected:
 		NUM_DIRECTIONS
 	};
 
-	vector <CEntity2D*> bulletStorage;
-
 	glm::vec2 i32vec2OldIndex;
 
 	//CS: The quadMesh for drawing the tiles
@@ -158,6 +153,13 @@ protected:
 
 	CSpriteAnimation* bulletAnimation;
 
+	// The column of the first wall in the bullet's path, found with one raycast, and the
+	// version of the level, row and direction which it was found for
+	int iWallCol;
+	unsigned int uiWallVersion;
+	int iWallRow;
+	int iWallDirection;
+
 
 
 	// Constraint the enemy2D's position within a boundary
@@ -168,6 +170,8 @@ protected:
 
 	// Check if position is alr at wall
 	bool CheckPos(DIRECTION eDirection);
+	// Find the first wall in the bullet's path again if the level or the path has changed
+	void UpdateWall(void);
 
 	// Check if the enemy2D is in mid-air
 	bool IsMidAir(void);
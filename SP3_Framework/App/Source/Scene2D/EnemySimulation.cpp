@@ -0,0 +1,521 @@
+/**
+ CEnemySimulation
+ @brief A class which keeps the state that every enemy has in common, in one array per
+		field, and moves the enemies in batched passes over those arrays.
+ */
+#include "EnemySimulation.h"
+
+// Include CMap2D
+#include "Map2D.h"
+// Include TileProperties
+#include "TileProperties.h"
+
+// Include Settings
+#include "GameControl\Settings.h"
+
+#include <cmath>
+#include <iostream>
+using namespace std;
+
+const unsigned char CEnemySimulation::BODY_FREE;
+const unsigned char CEnemySimulation::BODY_IN_USE;
+
+/**
+ @brief Constructor This constructor has protected access modifier as this class will be a Singleton
+ */
+CEnemySimulation::CEnemySimulation(void)
+	: cMap2D(NULL)
+	, cSettings(NULL)
+{
+	// Get the handler to the CMap2D instance
+	cMap2D = CMap2D::GetInstance();
+
+	// Get the handler to the CSettings instance
+	cSettings = CSettings::GetInstance();
+}
+
+/**
+ @brief Destructor This destructor has protected access modifier as this class will be a Singleton
+ */
+CEnemySimulation::~CEnemySimulation(void)
+{
+	// We won't delete these since they were created elsewhere
+	cMap2D = NULL;
+	cSettings = NULL;
+}
+
+/**
+ @brief Add a body for an enemy, whose position is copied into the enemy after every update
+ @param pOwner A CEntity2D* variable containing the enemy
+ @return The body of the enemy
+ */
+unsigned int CEnemySimulation::AddBody(CEntity2D* pOwner)
+{
+	unsigned int uiBody;
+	if (vFreeBodies.empty() == false)
+	{
+		uiBody = vFreeBodies.back();
+		vFreeBodies.pop_back();
+	}
+	else
+	{
+		uiBody = (unsigned int)vUsage.size();
+		vUsage.push_back(BODY_FREE);
+		vpOwners.push_back(NULL);
+		vIndex.push_back(glm::vec2(0.0f));
+		vMicroSteps.push_back(glm::vec2(0.0f));
+		vStatus.push_back(CPhysics2D::STATUS::IDLE);
+		vVelocity.push_back(glm::vec2(0.0f));
+		vfTime.push_back(0.0f);
+		vUVCoordinate.push_back(glm::vec2(0.0f));
+		viFSM.push_back(0);
+		viFSMCounter.push_back(0);
+		vfTimer.push_back(0.0f);
+	}
+
+	vUsage[uiBody] = BODY_IN_USE;
+	vpOwners[uiBody] = pOwner;
+	vIndex[uiBody] = glm::vec2(0.0f);
+	vMicroSteps[uiBody] = glm::vec2(0.0f);
+	vStatus[uiBody] = CPhysics2D::STATUS::IDLE;
+	vVelocity[uiBody] = glm::vec2(0.0f);
+	vfTime[uiBody] = 0.0f;
+	vUVCoordinate[uiBody] = glm::vec2(0.0f);
+	viFSM[uiBody] = 0;
+	viFSMCounter[uiBody] = 0;
+	vfTimer[uiBody] = 0.0f;
+	return uiBody;
+}
+
+/**
+ @brief Remove the body of an enemy
+ @param uiBody A const unsigned int variable containing the body
+ */
+void CEnemySimulation::RemoveBody(const unsigned int uiBody)
+{
+	if ((uiBody >= vUsage.size()) || (vUsage[uiBody] == BODY_FREE))
+		return;
+
+	vUsage[uiBody] = BODY_FREE;
+	vpOwners[uiBody] = NULL;
+	vFreeBodies.push_back(uiBody);
+}
+
+/**
+ @brief Get the number of bodies in the simulation
+ */
+unsigned int CEnemySimulation::GetNumBodies(void) const
+{
+	return (unsigned int)(vUsage.size() - vFreeBodies.size());
+}
+
+/**
+ @brief Move the bodies which are jumping or falling, and copy the positions into the enemies
+ @param dElapsedTime A const double variable containing the elapsed time since the last frame
+ */
+void CEnemySimulation::Update(const double dElapsedTime)
+{
+	UpdateJumpFall((float)dElapsedTime);
+	UpdateUVCoordinates();
+	WriteBack();
+}
+
+/**
+ @brief Reset the velocity and time of the jump or fall of a body
+ @param uiBody A const unsigned int variable containing the body
+ */
+void CEnemySimulation::ResetPhysics(const unsigned int uiBody)
+{
+	vVelocity[uiBody] = glm::vec2(0.0f);
+	vfTime[uiBody] = 0.0f;
+}
+
+/**
+ @brief Set the physics status of a body, which resets its velocity and time if it changes
+ @param uiBody A const unsigned int variable containing the body
+ @param sStatus A const CPhysics2D::STATUS variable containing the new status
+ */
+void CEnemySimulation::SetStatus(const unsigned int uiBody, const CPhysics2D::STATUS sStatus)
+{
+	if (vStatus[uiBody] != sStatus)
+	{
+		ResetPhysics(uiBody);
+		vStatus[uiBody] = (unsigned char)sStatus;
+	}
+}
+
+/**
+ @brief Get the physics status of a body
+ @param uiBody A const unsigned int variable containing the body
+ */
+CPhysics2D::STATUS CEnemySimulation::GetStatus(const unsigned int uiBody) const
+{
+	return (CPhysics2D::STATUS)vStatus[uiBody];
+}
+
+/**
+ @brief Set the velocity of a body, such as at the start of a jump
+ @param uiBody A const unsigned int variable containing the body
+ @param v2Velocity A const glm::vec2& variable containing the velocity
+ */
+void CEnemySimulation::SetVelocity(const unsigned int uiBody, const glm::vec2& v2Velocity)
+{
+	vVelocity[uiBody] = v2Velocity;
+}
+
+/**
+ @brief Get the velocity of a body
+ @param uiBody A const unsigned int variable containing the body
+ */
+glm::vec2 CEnemySimulation::GetVelocity(const unsigned int uiBody) const
+{
+	return vVelocity[uiBody];
+}
+
+/**
+ @brief Constraint a body's position within the level
+ @param uiBody A const unsigned int variable containing the body
+ @param eDirection A const DIRECTION variable which indicates the direction to check
+ */
+void CEnemySimulation::Constraint(const unsigned int uiBody, const DIRECTION eDirection)
+{
+	glm::vec2& vec2Index = vIndex[uiBody];
+	glm::vec2& vec2NumMicroSteps = vMicroSteps[uiBody];
+	if (eDirection == LEFT)
+	{
+		if (vec2Index.x < 0)
+		{
+			vec2Index.x = 0;
+			vec2NumMicroSteps.x = 0;
+		}
+	}
+	else if (eDirection == RIGHT)
+	{
+		if (vec2Index.x >= (int)cSettings->NUM_TILES_XAXIS - 1)
+		{
+			vec2Index.x = ((int)cSettings->NUM_TILES_XAXIS) - 1;
+			vec2NumMicroSteps.x = 0;
+		}
+	}
+	else if (eDirection == UP)
+	{
+		if (vec2Index.y >= (int)cSettings->NUM_TILES_YAXIS - 1)
+		{
+			vec2Index.y = ((int)cSettings->NUM_TILES_YAXIS) - 1;
+			vec2NumMicroSteps.y = 0;
+		}
+	}
+	else if (eDirection == DOWN)
+	{
+		if (vec2Index.y < 0)
+		{
+			vec2Index.y = 0;
+			vec2NumMicroSteps.y = 0;
+		}
+	}
+	else
+	{
+		cout << "CEnemySimulation::Constraint: Unknown direction." << endl;
+	}
+}
+
+/**
+ @brief Check if a body's position is possible to move into
+ @param uiBody A const unsigned int variable containing the body
+ @param eDirection A const DIRECTION variable which indicates the direction to check
+ */
+bool CEnemySimulation::CheckPosition(const unsigned int uiBody, const DIRECTION eDirection)
+{
+	const glm::vec2& vec2Index = vIndex[uiBody];
+	glm::vec2& vec2NumMicroSteps = vMicroSteps[uiBody];
+	if (eDirection == LEFT)
+	{
+		// If the new position is fully within a row, then check this row only
+		if (vec2NumMicroSteps.y == 0)
+		{
+			// If the grid is not accessible, then return false
+			if (cMap2D->IsSolid(vec2Index.y, vec2Index.x))
+			{
+				return false;
+			}
+		}
+		// If the new position is between 2 rows, then check both rows as well
+		else if (vec2NumMicroSteps.y != 0)
+		{
+			// If the 2 grids are not accessible, then return false
+			if (cMap2D->IsSolid(vec2Index.y, vec2Index.x) ||
+				cMap2D->IsSolid(vec2Index.y + 1, vec2Index.x))
+			{
+				return false;
+			}
+		}
+	}
+	else if (eDirection == RIGHT)
+	{
+		// If the new position is at the top row, then return true
+		if (vec2Index.x >= cSettings->NUM_TILES_XAXIS - 1)
+		{
+			vec2NumMicroSteps.x = 0;
+			return true;
+		}
+
+		// If the new position is fully within a row, then check this row only
+		if (vec2NumMicroSteps.y == 0)
+		{
+			// If the grid is not accessible, then return false
+			if (cMap2D->IsSolid(vec2Index.y, vec2Index.x + 1))
+			{
+				return false;
+			}
+		}
+		// If the new position is between 2 rows, then check both rows as well
+		else if (vec2NumMicroSteps.y != 0)
+		{
+			// If the 2 grids are not accessible, then return false
+			if (cMap2D->IsSolid(vec2Index.y, vec2Index.x + 1) ||
+				cMap2D->IsSolid(vec2Index.y + 1, vec2Index.x + 1))
+			{
+				return false;
+			}
+		}
+	}
+	else if (eDirection == UP)
+	{
+		// If the new position is at the top row, then return true
+		if (vec2Index.y >= cSettings->NUM_TILES_YAXIS - 1)
+		{
+			vec2NumMicroSteps.y = 0;
+			return true;
+		}
+
+		// If the new position is fully within a column, then check this column only
+		if (vec2NumMicroSteps.x == 0)
+		{
+			// If the grid is not accessible, then return false
+			if (cMap2D->IsSolid(vec2Index.y + 1, vec2Index.x))
+			{
+				return false;
+			}
+		}
+		// If the new position is between 2 columns, then check both columns as well
+		else if (vec2NumMicroSteps.x != 0)
+		{
+			// If the 2 grids are not accessible, then return false
+			if (cMap2D->AnySolid(vec2Index.y + 1, vec2Index.x, vec2Index.x + 1))
+			{
+				return false;
+			}
+		}
+	}
+	else if (eDirection == DOWN)
+	{
+		// If the new position is fully within a column, then check this column only
+		if (vec2NumMicroSteps.x == 0)
+		{
+			// If the grid is not accessible, then return false
+			if (cMap2D->IsSolid(vec2Index.y, vec2Index.x))
+			{
+				return false;
+			}
+		}
+		// If the new position is between 2 columns, then check both columns as well
+		else if (vec2NumMicroSteps.x != 0)
+		{
+			// If the 2 grids are not accessible, then return false
+			if (cMap2D->AnySolid(vec2Index.y, vec2Index.x, vec2Index.x + 1))
+			{
+				return false;
+			}
+		}
+	}
+	else
+	{
+		cout << "CEnemySimulation::CheckPosition: Unknown direction." << endl;
+	}
+
+	return true;
+}
+
+/**
+ @brief Check if a body is in mid-air
+ @param uiBody A const unsigned int variable containing the body
+ */
+bool CEnemySimulation::IsMidAir(const unsigned int uiBody) const
+{
+	const glm::vec2& vec2Index = vIndex[uiBody];
+
+	// if the enemy is at the bottom row, then he is not in mid-air for sure
+	if (vec2Index.y == 0)
+		return false;
+
+	// Check if the tile below the enemy's current position is empty
+	if ((vMicroSteps[uiBody].x == 0) &&
+		TileProperties::IsEmpty(cMap2D->GetMapInfo(vec2Index.y - 1, vec2Index.x)))
+	{
+		return true;
+	}
+
+	return false;
+}
+
+/**
+ @brief Move the bodies which are jumping or falling
+ @param fElapsedTime A const float variable containing the elapsed time since the last frame
+ */
+void CEnemySimulation::UpdateJumpFall(const float fElapsedTime)
+{
+	// Most enemies are walking, so this is mostly a sweep over the status array
+	const unsigned int uiNumBodies = (unsigned int)vStatus.size();
+	for (unsigned int uiBody = 0; uiBody < uiNumBodies; uiBody++)
+	{
+		if ((vStatus[uiBody] == CPhysics2D::STATUS::IDLE) || (vUsage[uiBody] == BODY_FREE))
+			continue;
+
+		if (vStatus[uiBody] == CPhysics2D::STATUS::JUMP)
+			UpdateJump(uiBody, fElapsedTime);
+		else if (vStatus[uiBody] == CPhysics2D::STATUS::FALL)
+			UpdateFall(uiBody, fElapsedTime);
+	}
+}
+
+/**
+ @brief Move a body which is jumping, until it hits a tile above or reaches the top of its jump
+ @param uiBody A const unsigned int variable containing the body
+ @param fElapsedTime A const float variable containing the elapsed time since the last frame
+ */
+void CEnemySimulation::UpdateJump(const unsigned int uiBody, const float fElapsedTime)
+{
+	glm::vec2& vec2Index = vIndex[uiBody];
+	glm::vec2& vec2NumMicroSteps = vMicroSteps[uiBody];
+
+	// Add the elapsed time, and find the displacement and the velocity after it, as CPhysics2D does
+	vfTime[uiBody] += fElapsedTime;
+	const glm::vec2 v2Displacement = vVelocity[uiBody] * vfTime[uiBody];
+	vVelocity[uiBody] = vVelocity[uiBody] + v2Gravity * vfTime[uiBody];
+
+	// Store the current vec2Index.y
+	int iIndex_YAxis_OLD = vec2Index.y;
+
+	int iDisplacement_MicroSteps = (int)(v2Displacement.y / cSettings->MICRO_STEP_YAXIS); //DIsplacement divide by distance for 1 microstep
+	if (vec2Index.y < (int)cSettings->NUM_TILES_YAXIS)
+	{
+		vec2NumMicroSteps.y += iDisplacement_MicroSteps;
+		if (vec2NumMicroSteps.y > cSettings->NUM_STEPS_PER_TILE_YAXIS)
+		{
+			vec2NumMicroSteps.y -= cSettings->NUM_STEPS_PER_TILE_YAXIS;
+			if (vec2NumMicroSteps.y < 0)
+				vec2NumMicroSteps.y = 0;
+			vec2Index.y++;
+		}
+	}
+
+	// Constraint the enemy's position within the screen boundary
+	Constraint(uiBody, UP);
+
+	// Iterate through all rows until the proposed row
+	// Check if the enemy will hit a tile; stop jump if so.
+	int iIndex_YAxis_Proposed = vec2Index.y;
+	for (int i = iIndex_YAxis_OLD; i <= iIndex_YAxis_Proposed; i++)
+	{
+		// Change the enemy's index to the current i value
+		vec2Index.y = i;
+		// If the new position is not feasible, then revert to old position
+		if (CheckPosition(uiBody, UP) == false)
+		{
+			// Align with the row
+			vec2NumMicroSteps.y = 0;
+			// Set the Physics to fall status
+			SetStatus(uiBody, CPhysics2D::STATUS::FALL);
+			break;
+		}
+	}
+
+	// If the enemy is still jumping and the velocity has reached zero or below zero,
+	// then it has reach the peak of its jump
+	if ((vStatus[uiBody] == CPhysics2D::STATUS::JUMP) && (vVelocity[uiBody].y <= 0.0f))
+	{
+		// Set status to fall
+		SetStatus(uiBody, CPhysics2D::STATUS::FALL);
+	}
+}
+
+/**
+ @brief Move a body which is falling, until it lands
+ @param uiBody A const unsigned int variable containing the body
+ @param fElapsedTime A const float variable containing the elapsed time since the last frame
+ */
+void CEnemySimulation::UpdateFall(const unsigned int uiBody, const float fElapsedTime)
+{
+	glm::vec2& vec2Index = vIndex[uiBody];
+	glm::vec2& vec2NumMicroSteps = vMicroSteps[uiBody];
+
+	// Add the elapsed time, and find the displacement and the velocity after it, as CPhysics2D does
+	vfTime[uiBody] += fElapsedTime;
+	const glm::vec2 v2Displacement = vVelocity[uiBody] * vfTime[uiBody];
+	vVelocity[uiBody] = vVelocity[uiBody] + v2Gravity * vfTime[uiBody];
+
+	// Store the current vec2Index.y
+	int iIndex_YAxis_OLD = vec2Index.y;
+
+	// Translate the displacement from pixels to indices
+	int iDisplacement_MicroSteps = (int)(v2Displacement.y / cSettings->MICRO_STEP_YAXIS);
+
+	if (vec2Index.y >= 0)
+	{
+		vec2NumMicroSteps.y -= fabs(iDisplacement_MicroSteps);
+		if (vec2NumMicroSteps.y < 0)
+		{
+			vec2NumMicroSteps.y = ((int)cSettings->NUM_STEPS_PER_TILE_YAXIS) - 1;
+			vec2Index.y--;
+		}
+	}
+
+	// Constraint the enemy's position within the screen boundary
+	Constraint(uiBody, DOWN);
+
+	// Iterate through all rows until the proposed row
+	// Check if the enemy will hit a tile; stop fall if so.
+	int iIndex_YAxis_Proposed = vec2Index.y;
+	for (int i = iIndex_YAxis_OLD; i >= iIndex_YAxis_Proposed; i--)
+	{
+		// Change the enemy's index to the current i value
+		vec2Index.y = i;
+		// If the new position is not feasible, then revert to old position
+		if (CheckPosition(uiBody, DOWN) == false)
+		{
+			// Revert to the previous position
+			if (i != iIndex_YAxis_OLD)
+				vec2Index.y = i + 1;
+			// Set the Physics to idle status
+			SetStatus(uiBody, CPhysics2D::STATUS::IDLE);
+			vec2NumMicroSteps.y = 0;
+			break;
+		}
+	}
+}
+
+/**
+ @brief Work out where the bodies are drawn
+ */
+void CEnemySimulation::UpdateUVCoordinates(void)
+{
+	const unsigned int uiNumBodies = (unsigned int)vIndex.size();
+	for (unsigned int uiBody = 0; uiBody < uiNumBodies; uiBody++)
+	{
+		vUVCoordinate[uiBody].x = cSettings->ConvertIndexToUVSpace(cSettings->x, vIndex[uiBody].x, false, vMicroSteps[uiBody].x * cSettings->MICRO_STEP_XAXIS);
+		vUVCoordinate[uiBody].y = cSettings->ConvertIndexToUVSpace(cSettings->y, vIndex[uiBody].y, false, vMicroSteps[uiBody].y * cSettings->MICRO_STEP_YAXIS);
+	}
+}
+
+/**
+ @brief Copy the positions of the bodies into their enemies
+ */
+void CEnemySimulation::WriteBack(void)
+{
+	const unsigned int uiNumBodies = (unsigned int)vIndex.size();
+	for (unsigned int uiBody = 0; uiBody < uiNumBodies; uiBody++)
+	{
+		if (vUsage[uiBody] == BODY_IN_USE)
+			vpOwners[uiBody]->vec2Index = vIndex[uiBody];
+	}
+}
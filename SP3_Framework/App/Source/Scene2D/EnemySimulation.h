@@ -0,0 +1,165 @@
+/**
+ CEnemySimulation
+ @brief A class which keeps the state that every enemy has in common, in one array per
+		field, and moves the enemies in batched passes over those arrays instead of one
+		enemy at a time. An enemy is a body in the simulation, which is a slot in every
+		array. The enemy classes read and write their body's slots, and only their own
+		behaviour runs per enemy.
+
+		Each frame, after the enemies have run their behaviour, Update() makes the enemies
+		which are jumping or falling move under gravity and land on solid tiles, works out
+		where they are drawn, and then copies their positions into their CEntity2Ds, which
+		the rest of the scene reads.
+ */
+#pragma once
+
+// Include SingletonTemplate
+#include "DesignPatterns\SingletonTemplate.h"
+
+// Include GLM
+#include <includes/glm.hpp>
+
+// Include CEntity2D
+#include "Primitives/Entity2D.h"
+
+// Include Physics2D
+#include "Physics2D.h"
+
+#include <vector>
+
+class CMap2D;
+class CSettings;
+
+class CEnemySimulation : public CSingletonTemplate<CEnemySimulation>
+{
+	friend CSingletonTemplate<CEnemySimulation>;
+public:
+	enum DIRECTION
+	{
+		LEFT = 0,
+		RIGHT = 1,
+		UP = 2,
+		DOWN = 3,
+		NUM_DIRECTIONS
+	};
+
+	// Add a body for an enemy, whose position is copied into the enemy after every update
+	unsigned int AddBody(CEntity2D* pOwner);
+
+	// Remove the body of an enemy
+	void RemoveBody(const unsigned int uiBody);
+
+	// Get the number of bodies in the simulation
+	unsigned int GetNumBodies(void) const;
+
+	// Move the bodies which are jumping or falling, and copy the positions into the enemies
+	void Update(const double dElapsedTime);
+
+	// The state of a body
+	glm::vec2& Index(const unsigned int uiBody)
+	{
+		return vIndex[uiBody];
+	}
+	glm::vec2& MicroSteps(const unsigned int uiBody)
+	{
+		return vMicroSteps[uiBody];
+	}
+	glm::vec2& UVCoordinate(const unsigned int uiBody)
+	{
+		return vUVCoordinate[uiBody];
+	}
+	int& FSM(const unsigned int uiBody)
+	{
+		return viFSM[uiBody];
+	}
+	int& FSMCounter(const unsigned int uiBody)
+	{
+		return viFSMCounter[uiBody];
+	}
+	float& Timer(const unsigned int uiBody)
+	{
+		return vfTimer[uiBody];
+	}
+
+	// Reset the velocity and time of the jump or fall of a body
+	void ResetPhysics(const unsigned int uiBody);
+
+	// Set the physics status of a body, which resets its velocity and time if it changes
+	void SetStatus(const unsigned int uiBody, const CPhysics2D::STATUS sStatus);
+	// Get the physics status of a body
+	CPhysics2D::STATUS GetStatus(const unsigned int uiBody) const;
+
+	// Set the velocity of a body, such as at the start of a jump
+	void SetVelocity(const unsigned int uiBody, const glm::vec2& v2Velocity);
+	// Get the velocity of a body
+	glm::vec2 GetVelocity(const unsigned int uiBody) const;
+
+	// Constraint a body's position within the level
+	void Constraint(const unsigned int uiBody, const DIRECTION eDirection);
+
+	// Check if a body's position is possible to move into
+	bool CheckPosition(const unsigned int uiBody, const DIRECTION eDirection);
+
+	// Check if a body is in mid-air
+	bool IsMidAir(const unsigned int uiBody) const;
+
+protected:
+	// The body of an enemy which has been removed, which can be reused
+	static const unsigned char BODY_FREE = 0;
+	static const unsigned char BODY_IN_USE = 1;
+
+	// Whether each slot holds a body, and the enemy of each body
+	std::vector<unsigned char> vUsage;
+	std::vector<CEntity2D*> vpOwners;
+
+	// The position, in tiles and in microsteps from the tile
+	std::vector<glm::vec2> vIndex;
+	std::vector<glm::vec2> vMicroSteps;
+
+	// The jump or fall of each body
+	std::vector<unsigned char> vStatus;
+	std::vector<glm::vec2> vVelocity;
+	std::vector<float> vfTime;
+
+	// Where each body is drawn
+	std::vector<glm::vec2> vUVCoordinate;
+
+	// The state of each enemy's FSM, the number of frames it has been in it, and a timer
+	// which the enemy counts down between attacks
+	std::vector<int> viFSM;
+	std::vector<int> viFSMCounter;
+	std::vector<float> vfTimer;
+
+	// The slots of the bodies which have been removed
+	std::vector<unsigned int> vFreeBodies;
+
+	// Handler to the CMap2D instance
+	CMap2D* cMap2D;
+
+	// Handler to the CSettings instance
+	CSettings* cSettings;
+
+	// The acceleration of the bodies which are jumping or falling
+	const glm::vec2 v2Gravity = glm::vec2(0.0f, -10.0f);
+
+	// Constructor
+	CEnemySimulation(void);
+
+	// Destructor
+	virtual ~CEnemySimulation(void);
+
+	// Move the bodies which are jumping or falling
+	void UpdateJumpFall(const float fElapsedTime);
+
+	// Move a body which is jumping, until it hits a tile above or reaches the top of its jump
+	void UpdateJump(const unsigned int uiBody, const float fElapsedTime);
+
+	// Move a body which is falling, until it lands
+	void UpdateFall(const unsigned int uiBody, const float fElapsedTime);
+
+	// Work out where the bodies are drawn
+	void UpdateUVCoordinates(void);
+
+	// Copy the positions of the bodies into their enemies
+	void WriteBack(void);
+};
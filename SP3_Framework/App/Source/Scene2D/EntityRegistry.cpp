@@ -0,0 +1,223 @@
+/**
+ CEntityRegistry
+ @brief A class which owns the entities of a scene and hands out handles to them, with
+		adding and removing deferred until the end of the frame.
+ */
+#include "EntityRegistry.h"
+
+// Include CEntitySpatialHash
+#include "EntitySpatialHash.h"
+
+const unsigned int CEntityRegistry::NOT_LISTED;
+
+/**
+ @brief Constructor
+ */
+CEntityRegistry::CEntityRegistry(void)
+	: pSpatialHash(NULL)
+{
+}
+
+/**
+ @brief Destructor
+ */
+CEntityRegistry::~CEntityRegistry(void)
+{
+	Clear();
+}
+
+/**
+ @brief Attach a spatial hash, which entities are put into when listed and taken out of when removed
+ @param pSpatialHash A CEntitySpatialHash* variable containing the spatial hash, or NULL for none
+ */
+void CEntityRegistry::SetSpatialHash(CEntitySpatialHash* pSpatialHash)
+{
+	this->pSpatialHash = pSpatialHash;
+	if (pSpatialHash == NULL)
+		return;
+
+	// Put the entities which are already listed into it
+	pSpatialHash->Clear();
+	for (unsigned int i = 0; i < vEntities.size(); i++)
+	{
+		if (IsRemoving(i) == false)
+			pSpatialHash->Insert(GetHandle(i), vEntities[i]);
+	}
+}
+
+/**
+ @brief Add an entity, which the registry then owns. It is in the list after the next Flush()
+ @param pEntity A CEntity2D* variable containing the entity
+ @return The handle of the entity
+ */
+CEntityRegistry::Handle CEntityRegistry::Add(CEntity2D* pEntity)
+{
+	unsigned int uiSlot;
+	if (vFreeSlots.empty() == false)
+	{
+		uiSlot = vFreeSlots.back();
+		vFreeSlots.pop_back();
+	}
+	else
+	{
+		uiSlot = (unsigned int)vSlots.size();
+		Slot slot;
+		slot.uiGeneration = 1;
+		vSlots.push_back(slot);
+	}
+
+	Slot& slot = vSlots[uiSlot];
+	slot.pEntity = pEntity;
+	slot.uiListIndex = NOT_LISTED;
+	slot.bRemoving = false;
+	vPendingAdds.push_back(uiSlot);
+
+	Handle handle;
+	handle.uiSlot = uiSlot;
+	handle.uiGeneration = slot.uiGeneration;
+	return handle;
+}
+
+/**
+ @brief Remove an entity. It is deleted at the next Flush()
+ @param handle A const Handle& variable containing the handle of the entity
+ @return false if the entity was already removed, so that a kill is only counted once
+ */
+bool CEntityRegistry::Remove(const Handle& handle)
+{
+	if (IsValid(handle) == false)
+		return false;
+
+	vSlots[handle.uiSlot].bRemoving = true;
+	vPendingRemoves.push_back(handle.uiSlot);
+	// Take it out of the spatial hash now, so that it is not found again in this frame
+	if (pSpatialHash)
+		pSpatialHash->Remove(handle);
+	return true;
+}
+
+/**
+ @brief Add the entities which were added, and delete the entities which were removed
+ */
+void CEntityRegistry::Flush(void)
+{
+	// Add first, so that an entity which was added and removed in the same frame is deleted
+	for (unsigned int i = 0; i < vPendingAdds.size(); i++)
+	{
+		Slot& slot = vSlots[vPendingAdds[i]];
+		slot.uiListIndex = (unsigned int)vEntities.size();
+		vEntities.push_back(slot.pEntity);
+		vEntitySlots.push_back(vPendingAdds[i]);
+		if ((pSpatialHash) && (slot.bRemoving == false))
+			pSpatialHash->Insert(GetHandle(slot.uiListIndex), slot.pEntity);
+	}
+	vPendingAdds.clear();
+
+	for (unsigned int i = 0; i < vPendingRemoves.size(); i++)
+	{
+		const unsigned int uiSlot = vPendingRemoves[i];
+		const unsigned int uiListIndex = vSlots[uiSlot].uiListIndex;
+
+		// Fill the gap with the last entity in the list, since the order does not matter
+		const unsigned int uiLastIndex = (unsigned int)vEntities.size() - 1;
+		if (uiListIndex != uiLastIndex)
+		{
+			vEntities[uiListIndex] = vEntities[uiLastIndex];
+			vEntitySlots[uiListIndex] = vEntitySlots[uiLastIndex];
+			vSlots[vEntitySlots[uiListIndex]].uiListIndex = uiListIndex;
+		}
+		vEntities.pop_back();
+		vEntitySlots.pop_back();
+
+		FreeSlot(uiSlot);
+	}
+	vPendingRemoves.clear();
+}
+
+/**
+ @brief Delete all the entities at once
+ */
+void CEntityRegistry::Clear(void)
+{
+	for (unsigned int i = 0; i < vEntitySlots.size(); i++)
+		FreeSlot(vEntitySlots[i]);
+	for (unsigned int i = 0; i < vPendingAdds.size(); i++)
+		FreeSlot(vPendingAdds[i]);
+
+	vEntities.clear();
+	vEntitySlots.clear();
+	vPendingAdds.clear();
+	vPendingRemoves.clear();
+
+	if (pSpatialHash)
+		pSpatialHash->Clear();
+}
+
+/**
+ @brief Get the entity of a handle, or NULL if it has been removed
+ @param handle A const Handle& variable containing the handle of the entity
+ */
+CEntity2D* CEntityRegistry::Get(const Handle& handle) const
+{
+	if (IsValid(handle) == false)
+		return NULL;
+	return vSlots[handle.uiSlot].pEntity;
+}
+
+/**
+ @brief Check if a handle still refers to an entity which has not been removed
+ @param handle A const Handle& variable containing the handle of the entity
+ */
+bool CEntityRegistry::IsValid(const Handle& handle) const
+{
+	if (handle.uiSlot >= vSlots.size())
+		return false;
+
+	const Slot& slot = vSlots[handle.uiSlot];
+	return (slot.uiGeneration == handle.uiGeneration) && (slot.pEntity != NULL) && (slot.bRemoving == false);
+}
+
+/**
+ @brief Get the handle of an entity in the list
+ @param uiIndex A const unsigned int variable containing the index of the entity in the list
+ */
+CEntityRegistry::Handle CEntityRegistry::GetHandle(const unsigned int uiIndex) const
+{
+	Handle handle;
+	if (uiIndex >= vEntitySlots.size())
+		return handle;
+
+	handle.uiSlot = vEntitySlots[uiIndex];
+	handle.uiGeneration = vSlots[handle.uiSlot].uiGeneration;
+	return handle;
+}
+
+/**
+ @brief Check if an entity in the list has been removed and is waiting to be deleted
+ @param uiIndex A const unsigned int variable containing the index of the entity in the list
+ */
+bool CEntityRegistry::IsRemoving(const unsigned int uiIndex) const
+{
+	if (uiIndex >= vEntitySlots.size())
+		return true;
+	return vSlots[vEntitySlots[uiIndex]].bRemoving;
+}
+
+/**
+ @brief Delete the entity of a slot and put the slot on the free list
+ @param uiSlot A const unsigned int variable containing the slot
+ */
+void CEntityRegistry::FreeSlot(const unsigned int uiSlot)
+{
+	Slot& slot = vSlots[uiSlot];
+	delete slot.pEntity;
+	slot.pEntity = NULL;
+	slot.uiListIndex = NOT_LISTED;
+	slot.bRemoving = false;
+
+	// Move to the next generation, skipping 0 when it wraps around
+	slot.uiGeneration++;
+	if (slot.uiGeneration == 0)
+		slot.uiGeneration = 1;
+	vFreeSlots.push_back(uiSlot);
+}
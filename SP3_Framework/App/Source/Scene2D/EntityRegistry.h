@@ -0,0 +1,123 @@
+/**
+ CEntityRegistry
+ @brief A class which owns the entities of a scene and hands out handles to them. A handle
+		is a slot and the generation of that slot, and the generation goes up whenever the
+		slot's entity is deleted, so a handle to an entity which is gone no longer finds
+		anything, even after the slot has been reused.
+
+		Adding and removing are deferred until Flush(), which the scene calls at the end of
+		a frame. Until then, the list of entities does not change, so it can be iterated by
+		const reference while entities are being hit, killed or spawned. A removed entity
+		stays in the list until Flush(), but IsRemoving() is true for it, and Flush()
+		deletes it.
+
+		A CEntitySpatialHash can be attached, which the registry then keeps up to date with
+		the entities which are listed and not removed. It must outlive the registry.
+ */
+#pragma once
+
+// Include CEntity2D
+#include "Primitives/Entity2D.h"
+
+#include <vector>
+
+class CEntitySpatialHash;
+
+class CEntityRegistry
+{
+public:
+	// A handle to an entity. A generation of 0 is never used, so a default handle finds nothing
+	struct Handle
+	{
+		unsigned int uiSlot;
+		unsigned int uiGeneration;
+
+		Handle(void)
+			: uiSlot(0)
+			, uiGeneration(0)
+		{
+		}
+	};
+
+	// Constructor
+	CEntityRegistry(void);
+
+	// Destructor
+	virtual ~CEntityRegistry(void);
+
+	// Attach a spatial hash, which entities are put into when listed and taken out of when removed
+	void SetSpatialHash(CEntitySpatialHash* pSpatialHash);
+
+	// Add an entity, which the registry then owns. It is in the list after the next Flush()
+	Handle Add(CEntity2D* pEntity);
+
+	// Remove an entity. It is deleted at the next Flush()
+	bool Remove(const Handle& handle);
+
+	// Add the entities which were added, and delete the entities which were removed
+	void Flush(void);
+
+	// Delete all the entities at once
+	void Clear(void);
+
+	// Get the entity of a handle, or NULL if it has been removed
+	CEntity2D* Get(const Handle& handle) const;
+
+	// Check if a handle still refers to an entity which has not been removed
+	bool IsValid(const Handle& handle) const;
+
+	// Get the entities in the list
+	const std::vector<CEntity2D*>& GetEntities(void) const
+	{
+		return vEntities;
+	}
+
+	// Get the handle of an entity in the list
+	Handle GetHandle(const unsigned int uiIndex) const;
+
+	// Check if an entity in the list has been removed and is waiting to be deleted
+	bool IsRemoving(const unsigned int uiIndex) const;
+
+	// Get the number of entities in the list
+	unsigned int GetNumEntities(void) const
+	{
+		return (unsigned int)vEntities.size();
+	}
+
+protected:
+	// The index in the list of a slot whose entity is not in the list
+	static const unsigned int NOT_LISTED = 0xFFFFFFFF;
+
+	// A slot which can hold an entity
+	struct Slot
+	{
+		CEntity2D* pEntity;
+		unsigned int uiGeneration;
+		// The index of the entity in the list, or NOT_LISTED
+		unsigned int uiListIndex;
+		bool bRemoving;
+	};
+
+	// The slots, which are reused through a free list
+	std::vector<Slot> vSlots;
+	std::vector<unsigned int> vFreeSlots;
+
+	// The entities in the list, and the slot of each of them
+	std::vector<CEntity2D*> vEntities;
+	std::vector<unsigned int> vEntitySlots;
+
+	// The spatial hash which is kept up to date, or NULL
+	CEntitySpatialHash* pSpatialHash;
+
+	// The slots which were added or removed since the last Flush()
+	std::vector<unsigned int> vPendingAdds;
+	std::vector<unsigned int> vPendingRemoves;
+
+	// Delete the entity of a slot and put the slot on the free list
+	void FreeSlot(const unsigned int uiSlot);
+
+private:
+	// The entities are owned by one registry, so it cannot be copied
+	CEntityRegistry(const CEntityRegistry&);
+	CEntityRegistry& operator=(const CEntityRegistry&);
+};
@@ -0,0 +1,339 @@
+/**
+ CEntitySpatialHash
+ @brief A class which sorts the entities of a CEntityRegistry into square cells of tiles,
+		so that finding the entities near a position only looks at the cells around it.
+ */
+#include "EntitySpatialHash.h"
+
+#include <algorithm>
+#include <utility>
+
+using namespace std;
+
+const unsigned int CEntitySpatialHash::NO_CELL;
+
+/**
+ @brief Constructor
+ */
+CEntitySpatialHash::CEntitySpatialHash(void)
+	: uiNumRows(0)
+	, uiNumCols(0)
+	, uiCellSize(1)
+	, uiNumCellRows(0)
+	, uiNumCellCols(0)
+{
+}
+
+/**
+ @brief Destructor
+ */
+CEntitySpatialHash::~CEntitySpatialHash(void)
+{
+}
+
+/**
+ @brief Set up the cells for a level
+ @param uiNumRows A const unsigned int variable containing the number of rows of tiles
+ @param uiNumCols A const unsigned int variable containing the number of columns of tiles
+ @param uiCellSize A const unsigned int variable containing the width and height of a cell in tiles
+ */
+void CEntitySpatialHash::Init(const unsigned int uiNumRows, const unsigned int uiNumCols, const unsigned int uiCellSize)
+{
+	this->uiNumRows = uiNumRows;
+	this->uiNumCols = uiNumCols;
+	this->uiCellSize = (uiCellSize > 0) ? uiCellSize : 1;
+	uiNumCellRows = (uiNumRows + this->uiCellSize - 1) / this->uiCellSize;
+	uiNumCellCols = (uiNumCols + this->uiCellSize - 1) / this->uiCellSize;
+	if (uiNumCellRows == 0)
+		uiNumCellRows = 1;
+	if (uiNumCellCols == 0)
+		uiNumCellCols = 1;
+
+	vCells.assign(uiNumCellRows * uiNumCellCols, vector<Entry>());
+	vSlotCells.clear();
+}
+
+/**
+ @brief Take every entity out of the cells
+ */
+void CEntitySpatialHash::Clear(void)
+{
+	for (unsigned int i = 0; i < vCells.size(); i++)
+		vCells[i].clear();
+	vSlotCells.clear();
+}
+
+/**
+ @brief Put an entity into the cell of its position
+ @param handle A const CEntityRegistry::Handle& variable containing the handle of the entity
+ @param pEntity A CEntity2D* variable containing the entity
+ */
+void CEntitySpatialHash::Insert(const CEntityRegistry::Handle& handle, CEntity2D* pEntity)
+{
+	if (vCells.empty())
+		return;
+
+	// An entity which is already in a cell is moved instead
+	Remove(handle);
+
+	if (handle.uiSlot >= vSlotCells.size())
+		vSlotCells.resize(handle.uiSlot + 1, NO_CELL);
+
+	const unsigned int uiCell = GetCell(pEntity->vec2Index);
+	Entry entry;
+	entry.handle = handle;
+	entry.pEntity = pEntity;
+	vCells[uiCell].push_back(entry);
+	vSlotCells[handle.uiSlot] = uiCell;
+}
+
+/**
+ @brief Take an entity out of its cell
+ @param handle A const CEntityRegistry::Handle& variable containing the handle of the entity
+ */
+void CEntitySpatialHash::Remove(const CEntityRegistry::Handle& handle)
+{
+	if ((handle.uiSlot >= vSlotCells.size()) || (vSlotCells[handle.uiSlot] == NO_CELL))
+		return;
+
+	vector<Entry>& vCell = vCells[vSlotCells[handle.uiSlot]];
+	for (unsigned int i = 0; i < vCell.size(); i++)
+	{
+		if (vCell[i].handle.uiSlot == handle.uiSlot)
+		{
+			// Fill the gap with the last entry, since the order does not matter
+			vCell[i] = vCell.back();
+			vCell.pop_back();
+			break;
+		}
+	}
+	vSlotCells[handle.uiSlot] = NO_CELL;
+}
+
+/**
+ @brief Move the entities of a registry which have changed cells since the last update
+ @param cRegistry A const CEntityRegistry& variable containing the entities
+ */
+void CEntitySpatialHash::Update(const CEntityRegistry& cRegistry)
+{
+	const vector<CEntity2D*>& vEntities = cRegistry.GetEntities();
+	for (unsigned int i = 0; i < vEntities.size(); i++)
+	{
+		// The entities which have been removed are no longer in the cells
+		if (cRegistry.IsRemoving(i))
+			continue;
+
+		const CEntityRegistry::Handle handle = cRegistry.GetHandle(i);
+		if ((handle.uiSlot < vSlotCells.size()) &&
+			(vSlotCells[handle.uiSlot] == GetCell(vEntities[i]->vec2Index)))
+			continue;
+
+		Insert(handle, vEntities[i]);
+	}
+}
+
+/**
+ @brief Find the entities within a distance of a position
+ @param vec2Pos A const glm::vec2& variable containing the position
+ @param fRadius A const float variable containing the distance, in tiles
+ @param vResults A std::vector<CEntityRegistry::Handle>& variable which the handles are put into
+ */
+void CEntitySpatialHash::QueryRadius(const glm::vec2& vec2Pos, const float fRadius, vector<CEntityRegistry::Handle>& vResults) const
+{
+	vResults.clear();
+	if (vCells.empty())
+		return;
+
+	const float fRadiusSquared = fRadius * fRadius;
+	const unsigned int uiMinCellRow = GetCellRow(vec2Pos.y - fRadius);
+	const unsigned int uiMaxCellRow = GetCellRow(vec2Pos.y + fRadius);
+	const unsigned int uiMinCellCol = GetCellCol(vec2Pos.x - fRadius);
+	const unsigned int uiMaxCellCol = GetCellCol(vec2Pos.x + fRadius);
+	for (unsigned int uiCellRow = uiMinCellRow; uiCellRow <= uiMaxCellRow; uiCellRow++)
+	{
+		for (unsigned int uiCellCol = uiMinCellCol; uiCellCol <= uiMaxCellCol; uiCellCol++)
+		{
+			const vector<Entry>& vCell = vCells[uiCellRow * uiNumCellCols + uiCellCol];
+			for (unsigned int i = 0; i < vCell.size(); i++)
+			{
+				const glm::vec2 vec2Offset = vCell[i].pEntity->vec2Index - vec2Pos;
+				if (glm::dot(vec2Offset, vec2Offset) <= fRadiusSquared)
+					vResults.push_back(vCell[i].handle);
+			}
+		}
+	}
+}
+
+/**
+ @brief Find the entities inside a box of tiles, including its edges
+ @param vec2Min A const glm::vec2& variable containing the lowest column and row of the box
+ @param vec2Max A const glm::vec2& variable containing the highest column and row of the box
+ @param vResults A std::vector<CEntityRegistry::Handle>& variable which the handles are put into
+ */
+void CEntitySpatialHash::QueryAABB(const glm::vec2& vec2Min, const glm::vec2& vec2Max, vector<CEntityRegistry::Handle>& vResults) const
+{
+	vResults.clear();
+	if ((vCells.empty()) || (vec2Min.x > vec2Max.x) || (vec2Min.y > vec2Max.y))
+		return;
+
+	const unsigned int uiMinCellRow = GetCellRow(vec2Min.y);
+	const unsigned int uiMaxCellRow = GetCellRow(vec2Max.y);
+	const unsigned int uiMinCellCol = GetCellCol(vec2Min.x);
+	const unsigned int uiMaxCellCol = GetCellCol(vec2Max.x);
+	for (unsigned int uiCellRow = uiMinCellRow; uiCellRow <= uiMaxCellRow; uiCellRow++)
+	{
+		for (unsigned int uiCellCol = uiMinCellCol; uiCellCol <= uiMaxCellCol; uiCellCol++)
+		{
+			const vector<Entry>& vCell = vCells[uiCellRow * uiNumCellCols + uiCellCol];
+			for (unsigned int i = 0; i < vCell.size(); i++)
+			{
+				const glm::vec2& vec2Index = vCell[i].pEntity->vec2Index;
+				if ((vec2Index.x >= vec2Min.x) && (vec2Index.x <= vec2Max.x) &&
+					(vec2Index.y >= vec2Min.y) && (vec2Index.y <= vec2Max.y))
+					vResults.push_back(vCell[i].handle);
+			}
+		}
+	}
+}
+
+/**
+ @brief Find the entities in a row, between two columns
+ @param fRow A const float variable containing the row
+ @param fMinCol A const float variable containing the lowest column
+ @param fMaxCol A const float variable containing the highest column
+ @param vResults A std::vector<CEntityRegistry::Handle>& variable which the handles are put into
+ */
+void CEntitySpatialHash::QueryRow(const float fRow, const float fMinCol, const float fMaxCol, vector<CEntityRegistry::Handle>& vResults) const
+{
+	vResults.clear();
+	if ((vCells.empty()) || (fMinCol > fMaxCol))
+		return;
+
+	const unsigned int uiCellRow = GetCellRow(fRow);
+	const unsigned int uiMinCellCol = GetCellCol(fMinCol);
+	const unsigned int uiMaxCellCol = GetCellCol(fMaxCol);
+	for (unsigned int uiCellCol = uiMinCellCol; uiCellCol <= uiMaxCellCol; uiCellCol++)
+	{
+		const vector<Entry>& vCell = vCells[uiCellRow * uiNumCellCols + uiCellCol];
+		for (unsigned int i = 0; i < vCell.size(); i++)
+		{
+			const glm::vec2& vec2Index = vCell[i].pEntity->vec2Index;
+			if ((vec2Index.y == fRow) && (vec2Index.x >= fMinCol) && (vec2Index.x <= fMaxCol))
+				vResults.push_back(vCell[i].handle);
+		}
+	}
+}
+
+/**
+ @brief Find up to uiCount entities nearest to a position, nearest first
+ @param vec2Pos A const glm::vec2& variable containing the position
+ @param uiCount A const unsigned int variable containing the most entities to find
+ @param vResults A std::vector<CEntityRegistry::Handle>& variable which the handles are put into
+ */
+void CEntitySpatialHash::QueryNearest(const glm::vec2& vec2Pos, const unsigned int uiCount, vector<CEntityRegistry::Handle>& vResults) const
+{
+	vResults.clear();
+	if ((vCells.empty()) || (uiCount == 0))
+		return;
+
+	// The entities found so far, with the square of their distance
+	vector<pair<float, CEntityRegistry::Handle>> vFound;
+
+	// Search rings of cells around the cell of the position, one ring further out each time
+	const int iCentreRow = (int)GetCellRow(vec2Pos.y);
+	const int iCentreCol = (int)GetCellCol(vec2Pos.x);
+	const int iMaxRing = max(max(iCentreRow, (int)uiNumCellRows - 1 - iCentreRow),
+							 max(iCentreCol, (int)uiNumCellCols - 1 - iCentreCol));
+	for (int iRing = 0; iRing <= iMaxRing; iRing++)
+	{
+		for (int iCellRow = iCentreRow - iRing; iCellRow <= iCentreRow + iRing; iCellRow++)
+		{
+			if ((iCellRow < 0) || (iCellRow >= (int)uiNumCellRows))
+				continue;
+
+			// Only the first and last rows of a ring are whole, the rest are just their ends
+			const bool bWholeRow = (iCellRow == iCentreRow - iRing) || (iCellRow == iCentreRow + iRing);
+			const int iStep = (bWholeRow || (iRing == 0)) ? 1 : 2 * iRing;
+			for (int iCellCol = iCentreCol - iRing; iCellCol <= iCentreCol + iRing; iCellCol += iStep)
+			{
+				if ((iCellCol < 0) || (iCellCol >= (int)uiNumCellCols))
+					continue;
+
+				const vector<Entry>& vCell = vCells[iCellRow * uiNumCellCols + iCellCol];
+				for (unsigned int i = 0; i < vCell.size(); i++)
+				{
+					const glm::vec2 vec2Offset = vCell[i].pEntity->vec2Index - vec2Pos;
+					vFound.push_back(make_pair(glm::dot(vec2Offset, vec2Offset), vCell[i].handle));
+				}
+			}
+		}
+
+		// Any entity in the next ring is more than iRing cells away, so stop once enough
+		// entities have been found which are nearer than that
+		if (vFound.size() >= uiCount)
+		{
+			const float fRingDistance = (float)(iRing * uiCellSize);
+			unsigned int uiNearer = 0;
+			for (unsigned int i = 0; i < vFound.size(); i++)
+			{
+				if (vFound[i].first <= fRingDistance * fRingDistance)
+					uiNearer++;
+			}
+			if (uiNearer >= uiCount)
+				break;
+		}
+	}
+
+	const unsigned int uiNumResults = min(uiCount, (unsigned int)vFound.size());
+	partial_sort(vFound.begin(), vFound.begin() + uiNumResults, vFound.end(),
+		[](const pair<float, CEntityRegistry::Handle>& a, const pair<float, CEntityRegistry::Handle>& b)
+		{
+			return a.first < b.first;
+		});
+	for (unsigned int i = 0; i < uiNumResults; i++)
+		vResults.push_back(vFound[i].second);
+}
+
+/**
+ @brief Get the number of entities in the cells
+ */
+unsigned int CEntitySpatialHash::GetNumEntities(void) const
+{
+	unsigned int uiNumEntities = 0;
+	for (unsigned int i = 0; i < vCells.size(); i++)
+		uiNumEntities += (unsigned int)vCells[i].size();
+	return uiNumEntities;
+}
+
+/**
+ @brief Get the row of the cell which holds a row of tiles, clamped to the level
+ @param fRow A const float variable containing the row of tiles
+ */
+unsigned int CEntitySpatialHash::GetCellRow(const float fRow) const
+{
+	if (fRow <= 0.0f)
+		return 0;
+	const unsigned int uiCellRow = (unsigned int)fRow / uiCellSize;
+	return (uiCellRow < uiNumCellRows) ? uiCellRow : uiNumCellRows - 1;
+}
+
+/**
+ @brief Get the column of the cell which holds a column of tiles, clamped to the level
+ @param fCol A const float variable containing the column of tiles
+ */
+unsigned int CEntitySpatialHash::GetCellCol(const float fCol) const
+{
+	if (fCol <= 0.0f)
+		return 0;
+	const unsigned int uiCellCol = (unsigned int)fCol / uiCellSize;
+	return (uiCellCol < uiNumCellCols) ? uiCellCol : uiNumCellCols - 1;
+}
+
+/**
+ @brief Get the cell which holds a position
+ @param vec2Pos A const glm::vec2& variable containing the column and row of the position
+ */
+unsigned int CEntitySpatialHash::GetCell(const glm::vec2& vec2Pos) const
+{
+	return GetCellRow(vec2Pos.y) * uiNumCellCols + GetCellCol(vec2Pos.x);
+}
@@ -0,0 +1,94 @@
+/**
+ CEntitySpatialHash
+ @brief A class which sorts the entities of a CEntityRegistry into square cells of tiles,
+		so that finding the entities near a position only looks at the cells around it
+		instead of at every entity. The cells cover the level, so the hash of a cell is
+		simply its row and column, and positions outside the level fall into the cells at
+		its edge.
+
+		The registry inserts an entity when it is listed, and takes it out as soon as it is
+		removed, so a query never finds an entity which has been killed. Entities which move
+		are moved to their new cell by Update(), which only touches the entities which have
+		changed cells. Queries return handles, which are looked up in the registry.
+ */
+#pragma once
+
+// Include CEntityRegistry
+#include "EntityRegistry.h"
+
+// Include GLM
+#include <includes/glm.hpp>
+
+#include <vector>
+
+class CEntitySpatialHash
+{
+public:
+	// Constructor
+	CEntitySpatialHash(void);
+
+	// Destructor
+	virtual ~CEntitySpatialHash(void);
+
+	// Set up the cells for a level
+	void Init(const unsigned int uiNumRows, const unsigned int uiNumCols, const unsigned int uiCellSize);
+
+	// Take every entity out of the cells
+	void Clear(void);
+
+	// Put an entity into the cell of its position
+	void Insert(const CEntityRegistry::Handle& handle, CEntity2D* pEntity);
+
+	// Take an entity out of its cell
+	void Remove(const CEntityRegistry::Handle& handle);
+
+	// Move the entities of a registry which have changed cells since the last update
+	void Update(const CEntityRegistry& cRegistry);
+
+	// Find the entities within a distance of a position
+	void QueryRadius(const glm::vec2& vec2Pos, const float fRadius, std::vector<CEntityRegistry::Handle>& vResults) const;
+
+	// Find the entities inside a box of tiles, including its edges
+	void QueryAABB(const glm::vec2& vec2Min, const glm::vec2& vec2Max, std::vector<CEntityRegistry::Handle>& vResults) const;
+
+	// Find the entities in a row, between two columns
+	void QueryRow(const float fRow, const float fMinCol, const float fMaxCol, std::vector<CEntityRegistry::Handle>& vResults) const;
+
+	// Find up to uiCount entities nearest to a position, nearest first
+	void QueryNearest(const glm::vec2& vec2Pos, const unsigned int uiCount, std::vector<CEntityRegistry::Handle>& vResults) const;
+
+	// Get the number of entities in the cells
+	unsigned int GetNumEntities(void) const;
+
+protected:
+	// The cell of an entity which is not in any cell
+	static const unsigned int NO_CELL = 0xFFFFFFFF;
+
+	// An entity in a cell
+	struct Entry
+	{
+		CEntityRegistry::Handle handle;
+		CEntity2D* pEntity;
+	};
+
+	// The size of the level, in tiles
+	unsigned int uiNumRows;
+	unsigned int uiNumCols;
+	// The size of a cell, in tiles
+	unsigned int uiCellSize;
+	// The number of cells along each side of the level
+	unsigned int uiNumCellRows;
+	unsigned int uiNumCellCols;
+
+	// The entities in each cell, row by row
+	std::vector<std::vector<Entry>> vCells;
+	// The cell of each slot of the registry, or NO_CELL
+	std::vector<unsigned int> vSlotCells;
+
+	// Get the row or column of the cell which holds a row or column of tiles
+	unsigned int GetCellRow(const float fRow) const;
+	unsigned int GetCellCol(const float fCol) const;
+
+	// Get the cell which holds a position
+	unsigned int GetCell(const glm::vec2& vec2Pos) const;
+};
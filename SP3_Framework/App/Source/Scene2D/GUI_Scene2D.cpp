@@ -19,6 +19,7 @@ CGUI_Scene2D::CGUI_Scene2D(void)
 	, m_fProgressBar(0.0f)
 	, cInventoryManager(NULL)
 	, cInventoryItem(NULL)
+	, emptyInventoryTextureID(0)
 {
 }
 
@@ -33,6 +34,9 @@ CGUI_Scene2D::~CGUI_Scene2D(void)
 		cInventoryManager = NULL;
 	}
 
+	// Release the image for the empty inventory slots
+	CImageLoader::GetInstance()->ReleaseTexture(emptyInventoryTextureID);
+
 	// Cleanup
 	ImGui_ImplOpenGL3_Shutdown();
 	ImGui_ImplGlfw_Shutdown();
@@ -85,10 +89,6 @@ bool CGUI_Scene2D::Init(void)
 	// Initialise the vector
 	storePlayerItem.clear();
 
-	// Initialise the enemyHealth vector
-	enemyHealth.clear();
-
-
 	CImageLoader* il = CImageLoader::GetInstance();
 	emptyInventoryTextureID = il->LoadTextureGetID("Image\\GUI\\itemhotbar.png", false);
 
@@ -97,9 +97,10 @@ bool CGUI_Scene2D::Init(void)
 	emptyInventorySlot.active = false;
 	emptyInventorySlot.noOfItems = 0;
 
+	// The empty slots share the image loaded above, so only one reference to it is released
+	emptyInventorySlot.textureID = emptyInventoryTextureID;
 	for (int i = 0; i < inventoryHotbar; ++i)
 	{
-		emptyInventorySlot.textureID = il->LoadTextureGetID("Image\\GUI\\itemhotbar.png", false);
 		emptyInventorySlot.slotID = i;
 		playerInventory.push_back(emptyInventorySlot);
 	}
@@ -174,24 +175,23 @@ void CGUI_Scene2D::Update(const double dElapsedTime)
 	ImGui::End();
 
 	// Render the Enemy Health	
-	enemyHealth = CScene2D::GetInstance()->returnEnemyVector();
-	enemyHealth = CPlayer2D::GetInstance()->returnNearestEnemy(enemyHealth);
+	CEntity2D* nearestEnemy = CPlayer2D::GetInstance()->returnNearestEnemy();
 
-	if (enemyHealth.size() > 0)
+	if (nearestEnemy != NULL)
 	{
 		ImGui::Begin("Enemy_Health", NULL, healthWindowFlags);
 
 
-		ImGui::SetWindowPos(ImVec2(enemyHealth.front()->vec2Index.x * 25 * relativeScale_x - 10.f, cSettings->iWindowHeight - 50.0f - (enemyHealth.front()->vec2Index.y * 25 * relativeScale_y)));
-		//cout << enemyHealth[i]->vec2Index.x * 25 * relativeScale_x << ", " << cSettings->iWindowHeight - (enemyHealth[i]->vec2Index.y * 25 * relativeScale_y)  << endl;
+		ImGui::SetWindowPos(ImVec2(nearestEnemy->vec2Index.x * 25 * relativeScale_x - 10.f, cSettings->iWindowHeight - 50.0f - (nearestEnemy->vec2Index.y * 25 * relativeScale_y)));
+		//cout << nearestEnemy->vec2Index.x * 25 * relativeScale_x << ", " << cSettings->iWindowHeight - (nearestEnemy->vec2Index.y * 25 * relativeScale_y)  << endl;
 
 		ImGui::SetWindowSize(ImVec2(10.0f * relativeScale_x, 2.0f * relativeScale_y));
 		ImGui::SetWindowFontScale(1.0f * relativeScale_y);
 
 		ImGui::PushStyleColor(ImGuiCol_PlotHistogram, ImVec4(1.0f, 0.0f, 0.0f, 1.0f));
 		ImGui::PushStyleColor(ImGuiCol_FrameBg, ImVec4(0.0f, 0.0f, 1.0f, 1.0f));
-		ImGui::ProgressBar(enemyHealth.front()->health /
-			enemyHealth.front()->maxHealth, ImVec2(50.0f * relativeScale_x, 13.0f * relativeScale_y));
+		ImGui::ProgressBar(nearestEnemy->health /
+			nearestEnemy->maxHealth, ImVec2(50.0f * relativeScale_x, 13.0f * relativeScale_y));
 		ImGui::PopStyleColor();
 		ImGui::PopStyleColor();
 
@@ -131,8 +131,6 @@ protected:
 
 	int inventorySize; // Size of overall Inventory
 
-	vector <CEntity2D*> enemyHealth; // Stores the enemy health
-
 	int emptyInventoryTextureID;
 
 
@@ -33,21 +33,11 @@ CGlutton::CGlutton(void)
 	, cMap2D(NULL)
 	, cSettings(NULL)
 	, cPlayer2D(NULL)
-	, sCurrentFSM(FSM::IDLE)
-	, iFSMCounter(0)
 	, quadMesh(NULL)
+	, uiPathRequest(CPathRequestQueue::NO_REQUEST)
 {
 	transform = glm::mat4(1.0f);	// make sure to initialize matrix to identity matrix first
 
-	// Initialise vecIndex
-	vec2Index = glm::i32vec2(0);
-
-	// Initialise vecNumMicroSteps
-	i32vec2NumMicroSteps = glm::i32vec2(0);
-
-	// Initialise vec2UVCoordinate
-	vec2UVCoordinate = glm::vec2(0.0f);
-
 	i32vec2Destination = glm::i32vec2(0, 0);	// Initialise the iDestination
 	i32vec2Direction = glm::i32vec2(0, 0);		// Initialise the iDirection
 }
@@ -67,6 +57,10 @@ CGlutton::~CGlutton(void)
 	// We won't delete this since it was created elsewhere
 	cPlayer2D = NULL;
 
+	// Give the path request back to the queue
+	if (cMap2D)
+		cMap2D->ReleasePathRequest(uiPathRequest);
+
 	// We won't delete this since it was created elsewhere
 	cMap2D = NULL;
 
@@ -96,11 +90,11 @@ bool CGlutton::Init(void)
 	cMap2D->SetMapInfo(uiRow, uiCol, 0);
 
 	// Set the start position of the Player to iRow and iCol
-	vec2Index = glm::i32vec2(uiCol, uiRow);
+	SetIndex(glm::vec2(uiCol, uiRow));
 
 	reachedOtherside = false;
 	// By default, microsteps should be zero
-	i32vec2NumMicroSteps = glm::i32vec2(0, 0);
+	MicroSteps() = glm::i32vec2(0, 0);
 
 	glGenVertexArrays(1, &VAO);
 	glBindVertexArray(VAO);
@@ -131,10 +125,10 @@ bool CGlutton::Init(void)
 	runtimeColour = glm::vec4(1.0, 1.0, 1.0, 1.0);
 
 	// Set the Physics to fall status by default
-	cPhysics2D.Init();
-	cPhysics2D.SetStatus(CPhysics2D::STATUS::FALL);
+	cSimulation->ResetPhysics(uiBody);
+	cSimulation->SetStatus(uiBody, CPhysics2D::STATUS::FALL);
 
-	shotInterval = 1.5f;
+	AttackTimer() = 1.5f;
 
 	// If this class is initialised properly, then set the bIsActive to true
 	bIsActive = true;
@@ -181,10 +175,10 @@ bool CGlutton::Init2(void)
 	runtimeColour = glm::vec4(1.0, 1.0, 1.0, 1.0);
 
 	// Set the Physics to fall status by default
-	cPhysics2D.Init();
-	cPhysics2D.SetStatus(CPhysics2D::STATUS::FALL);
+	cSimulation->ResetPhysics(uiBody);
+	cSimulation->SetStatus(uiBody, CPhysics2D::STATUS::FALL);
 
-	shotInterval = 1.0f;
+	AttackTimer() = 1.0f;
 
 	wallDist = 0.0f;
 
@@ -202,35 +196,37 @@ void CGlutton::Update(const double dElapsedTime)
 	if (!bIsActive)
 		return;
 
-	switch (sCurrentFSM)
+	switch (CurrentFSM())
 	{
 	case IDLE:
 		gluttonAnimatedSprites->AddAnimation("Idle", -1, 5);
-		if (iFSMCounter > iMaxFSMCounter)
+		if (FSMCounter() > iMaxFSMCounter)
 		{
-			sCurrentFSM = PATROL;
-			iFSMCounter = 0;
+			CurrentFSM() = PATROL;
+			FSMCounter() = 0;
 			//cout << "Switching to Patrol State" << endl;
 		}
-		iFSMCounter++;
+		FSMCounter()++;
 		break;
 	case PATROL:
-		if (iFSMCounter > iMaxFSMCounter)
+		if (FSMCounter() > iMaxFSMCounter)
 		{
-			sCurrentFSM = IDLE;
-			iFSMCounter = 0;
+			CurrentFSM() = IDLE;
+			FSMCounter() = 0;
 			//cout << "Switching to Idle State" << endl;
 		}
-		else if (cPhysics2D.CalculateDistance(vec2Index, cPlayer2D->vec2Index) < 25.0f)
+		// Keep patrolling if the player is walled off, since there is no path to trace
+		else if ((CalculateDistance(Index(), cPlayer2D->vec2Index) < 25.0f) &&
+				cMap2D->IsReachable(Index(), cPlayer2D->vec2Index))
 		{
-			sCurrentFSM = TRACE;
-			iFSMCounter = 0;
+			CurrentFSM() = TRACE;
+			FSMCounter() = 0;
 			//cout << "Switching to TRACE State" << endl;
 		}
 		else if (checkForWall())
 		{
-			sCurrentFSM = JUMP_OVER_WALL;
-			iFSMCounter = 0;
+			CurrentFSM() = JUMP_OVER_WALL;
+			FSMCounter() = 0;
 			//cout << "Switching to JUMP_OVER_WALL State" << endl;
 
 		}
@@ -241,25 +237,22 @@ void CGlutton::Update(const double dElapsedTime)
 			// Update the Enemy2D's position for patrol
 			UpdatePosition();
 		}
-		iFSMCounter++;
+		FSMCounter()++;
 		break;
 	case TRACE:
-		if (cPhysics2D.CalculateDistance(vec2Index, cPlayer2D->vec2Index) >= 10.0f || vec2Index.y != cPlayer2D->vec2Index.y)
+		if (CalculateDistance(Index(), cPlayer2D->vec2Index) >= 10.0f || Index().y != cPlayer2D->vec2Index.y)
 		{
 			// Calculate a path to the player
 			//cMap2D->PrintSelf();
 			//cout << "StartPos: " << vec2Index.x << ", " << vec2Index.y << endl;
 			//cout << "TargetPos: " << cPlayer2D->vec2Index.x << ", " 
 			//		<< cPlayer2D->vec2Index.y << endl;
-			auto path = cMap2D->PathFind(	vec2Index, 
-											cPlayer2D->vec2Index, 
-											heuristic::euclidean, 
-											10);
+			cMap2D->GetPlatformPath(Index(), cSimulation->GetStatus(uiBody) != CPhysics2D::STATUS::IDLE, vPath);
 			//cout << "=== Printing out the path ===" << endl;
 
 			// Calculate new destination
 			bool bFirstPosition = true;
-			for (const auto& coord : path)
+			for (const auto& coord : vPath)
 			{
 				//std::cout << coord.x << "," << coord.y << "\n";
 				if (bFirstPosition == true)
@@ -267,7 +260,7 @@ void CGlutton::Update(const double dElapsedTime)
 					// Set a destination
 					i32vec2Destination = coord;
 					// Calculate the direction between enemy2D and this destination
-					i32vec2Direction = i32vec2Destination - vec2Index;
+					i32vec2Direction = i32vec2Destination - Index();
 					bFirstPosition = false;
 				}
 				else
@@ -300,32 +293,34 @@ void CGlutton::Update(const double dElapsedTime)
 			
 			if (checkForWall())
 			{
-				sCurrentFSM = JUMP_OVER_WALL;
-				iFSMCounter = 0;
+				CurrentFSM() = JUMP_OVER_WALL;
+				FSMCounter() = 0;
 				//cout << "TRACE TO JUMP_OVER_WALL\n";
 
 			}
 			else
 			{
-				sCurrentFSM = SHOOT;
-				iFSMCounter = 0;
+				CurrentFSM() = SHOOT;
+				FSMCounter() = 0;
 				//cout << "TRACE to SHOOT\n";
 			}
 						
 			
 			
-			iFSMCounter++;
+			FSMCounter()++;
 		}
 		break;
 	case SHOOT:
 	{
-		if (vec2Index.y == cPlayer2D->vec2Index.y)
+		// Only shoot along the row while no wall is in the way
+		if ((Index().y == cPlayer2D->vec2Index.y) &&
+			cMap2D->HasLineOfSight(Index(), cPlayer2D->vec2Index))
 		{
-			shotInterval -= dElapsedTime;
-			if (shotInterval <= 0)
+			AttackTimer() -= dElapsedTime;
+			if (AttackTimer() <= 0)
 			{
 				// Checks whether enemy is facing left or right
-				if (vec2Index.x - cPlayer2D->vec2Index.x > 0)  
+				if (Index().x - cPlayer2D->vec2Index.x > 0)  
 				{
 					gluttonAnimatedSprites->PlayAnimation("shootLeft", -1, 1);
 				}
@@ -335,28 +330,25 @@ void CGlutton::Update(const double dElapsedTime)
 
 				}
 				//cout << "Shot Bullet\n";
-				CEnemyProjectile* cEnemyProjectile = new CEnemyProjectile(); // Create new Projectile
-				cEnemyProjectile->SetShader("Shader2D_Colour");
-				cEnemyProjectile->Seti32vec2Index(vec2Index.x, vec2Index.y);
-				cEnemyProjectile->seti32vec2Direction(cPlayer2D->vec2Index.x, vec2Index.x);
-				cEnemyProjectile->SetPlayer2D(cPlayer2D);
-				CScene2D::GetInstance()->pushBullet(cEnemyProjectile);
-
-				if (cEnemyProjectile->Init() == true)   // Initialise the Projectile
+				// Take a Projectile from the pool, unless every one is already in flight
+				CEnemyProjectile* cEnemyProjectile = CScene2D::GetInstance()->AcquireBullet();
+				if (cEnemyProjectile)
 				{
-					//cout << "SPAWNED\n";
-
+					cEnemyProjectile->Seti32vec2Index(Index().x, Index().y);
+					cEnemyProjectile->seti32vec2Direction(cPlayer2D->vec2Index.x, Index().x);
+					cEnemyProjectile->SetPlayer2D(cPlayer2D);
+					cEnemyProjectile->Fire();
 				}
 
-				shotInterval = 1.5f;
+				AttackTimer() = 1.5f;
 				
 			}
 			
 		}
 		else
 		{		
-			sCurrentFSM = IDLE;
-			iFSMCounter = 0;
+			CurrentFSM() = IDLE;
+			FSMCounter() = 0;
 			//cout << "SHOOT TO IDLE\n";
 			
 		}
@@ -367,18 +359,25 @@ void CGlutton::Update(const double dElapsedTime)
 	break;
 	case JUMP_OVER_WALL:
 	{
-		if (vec2Index.y == cPlayer2D->vec2Index.y)
+		if (!cMap2D->IsReachable(Index(), destination))
+		{
+			// Go back to patrolling if the destination is walled off
+			CurrentFSM() = PATROL;
+			FSMCounter() = 0;
+		}
+		else if (Index().y == cPlayer2D->vec2Index.y)
 		{
 			// Calculate a path to the player
-			auto path = cMap2D->PathFind(vec2Index,
-				destination,
-				heuristic::euclidean,
-				3);
+			cMap2D->RequestPlatformPath(	uiPathRequest,
+											Index(), 
+											destination, 
+											cSimulation->GetStatus(uiBody) != CPhysics2D::STATUS::IDLE,
+											vPath);
 			//cout << "=== Printing out the path ===" << endl;
 
 			// Calculate new destination
 			bool bFirstPosition = true;
-			for (const auto& coord : path)
+			for (const auto& coord : vPath)
 			{
 				//std::cout << coord.x << "," << coord.y << "\n";
 				if (bFirstPosition == true)
@@ -386,7 +385,7 @@ void CGlutton::Update(const double dElapsedTime)
 					// Set a destination
 					i32vec2Destination = coord;
 					// Calculate the direction between enemy2D and this destination
-					i32vec2Direction = i32vec2Destination - vec2Index;
+					i32vec2Direction = i32vec2Destination - Index();
 					bFirstPosition = false;
 				}
 				else
@@ -404,26 +403,26 @@ void CGlutton::Update(const double dElapsedTime)
 
 			/*	if (!checkForWall())
 				{
-					sCurrentFSM = SHOOT;
-					iFSMCounter = 0;
+					CurrentFSM() = SHOOT;
+					FSMCounter() = 0;
 				}
-				else if (iFSMCounter > iMaxFSMCounter)
+				else if (FSMCounter() > iMaxFSMCounter)
 				{
-					sCurrentFSM = PATROL;
-					iFSMCounter = 0;
+					CurrentFSM() = PATROL;
+					FSMCounter() = 0;
 				}
-				iFSMCounter++;*/
+				FSMCounter()++;*/
 		}
-		else if (vec2Index == destination)
+		else if (Index() == destination)
 		{
-			sCurrentFSM = SHOOT;
-			iFSMCounter = 0;
+			CurrentFSM() = SHOOT;
+			FSMCounter() = 0;
 			destination = glm::vec2(0, 0);
 		}
 		else
 		{
-			sCurrentFSM = PATROL;
-			iFSMCounter = 0;
+			CurrentFSM() = PATROL;
+			FSMCounter() = 0;
 		}
 		
 		
@@ -436,13 +435,9 @@ void CGlutton::Update(const double dElapsedTime)
 		break;
 	}
 
-	// Update Jump or Fall
-	UpdateJumpFall(dElapsedTime);
 	gluttonAnimatedSprites->Update(dElapsedTime);
 
-	// Update the UV Coordinates
-	vec2UVCoordinate.x = cSettings->ConvertIndexToUVSpace(cSettings->x, vec2Index.x, false, i32vec2NumMicroSteps.x*cSettings->MICRO_STEP_XAXIS);
-	vec2UVCoordinate.y = cSettings->ConvertIndexToUVSpace(cSettings->y, vec2Index.y, false, i32vec2NumMicroSteps.y*cSettings->MICRO_STEP_YAXIS);
+	// The jump or fall, and the UV Coordinates, are updated by CEnemySimulation for all enemies at once
 }
 
 /**
@@ -479,8 +474,8 @@ void CGlutton::Render(void)
 	glUniformMatrix4fv(transformLoc, 1, GL_FALSE, glm::value_ptr(transform));
 
 	transform = glm::mat4(1.0f); // make sure to initialize matrix to identity matrix first
-	transform = glm::translate(transform, glm::vec3(vec2UVCoordinate.x,
-		vec2UVCoordinate.y,
+	transform = glm::translate(transform, glm::vec3(UVCoordinate().x,
+		UVCoordinate().y,
 		0.0f));
 	// Update the shaders with the latest transform
 	glUniformMatrix4fv(transformLoc, 1, GL_FALSE, glm::value_ptr(transform));
@@ -518,8 +513,7 @@ void CGlutton::PostRender(void)
 */
 void CGlutton::Seti32vec2Index(const int iIndex_XAxis, const int iIndex_YAxis)
 {
-	this->vec2Index.x = iIndex_XAxis;
-	this->vec2Index.y = iIndex_YAxis;
+	SetIndex(glm::vec2(iIndex_XAxis, iIndex_YAxis));
 }
 
 /**
@@ -529,8 +523,7 @@ void CGlutton::Seti32vec2Index(const int iIndex_XAxis, const int iIndex_YAxis)
 */
 void CGlutton::Seti32vec2NumMicroSteps(const int iNumMicroSteps_XAxis, const int iNumMicroSteps_YAxis)
 {
-	this->i32vec2NumMicroSteps.x = iNumMicroSteps_XAxis;
-	this->i32vec2NumMicroSteps.y = iNumMicroSteps_YAxis;
+	MicroSteps() = glm::vec2(iNumMicroSteps_XAxis, iNumMicroSteps_YAxis);
 }
 
 /**
@@ -545,48 +538,32 @@ void CGlutton::SetPlayer2D(CPlayer2D* cPlayer2D)
 	UpdateDirection();
 }
 
+/**
+ @brief Check for a wall up to 10 tiles ahead in the row of the glutton, with one raycast.
+		If a wall is found before the player, the destination is set to the tile past it
+ @return true if there is a wall to jump over, otherwise false
+ */
 bool CGlutton::checkForWall(void)
 {
-	for (float i = 0; i <= 10.f; ++i)
-	{
-		if (i32vec2Direction.x < 0)
-		{
-			
-			if (vec2Index.x - i == cPlayer2D->vec2Index.x)
-			{
-				return false;
-			}
-			else if (cMap2D->GetMapInfo(vec2Index.y, vec2Index.x - i) >= 100)
-			{
-				wallDist = -(i + 2);
-				destination = glm::vec2(vec2Index.x + wallDist, vec2Index.y);
-				return true;
-			}
-			else
-			{
-				continue;
-			}
-		}
-		else if (i32vec2Direction.x > 0)
-		{
-			if (vec2Index.x + i == cPlayer2D->vec2Index.x)
-			{
-				return false;
-			}
-			else if (cMap2D->GetMapInfo(vec2Index.y, vec2Index.x + i) >= 100)
-			{
-				wallDist = i + 2;
-				destination = glm::vec2(vec2Index.x + wallDist, vec2Index.y);
-				return true;
-			}
-			else
-			{
-				continue;
-			}
-		}
-		
-	}
-	return false;
+	if (i32vec2Direction.x == 0)
+		return false;
+
+	const int iStep = (i32vec2Direction.x < 0) ? -1 : 1;
+	CTileRaycaster::RaycastHit sHit;
+	if (cMap2D->Raycast(glm::vec2(Index().x + 0.5f, Index().y + 0.5f),
+						glm::vec2(Index().x + iStep * 10 + 0.5f, Index().y + 0.5f),
+						sHit) == false)
+		return false;
+
+	// There is no wall in the way if the player is reached first
+	const int iWallDistance = (sHit.i32vec2Tile.x - Index().x) * iStep;
+	const int iPlayerDistance = (cPlayer2D->vec2Index.x - Index().x) * iStep;
+	if ((iPlayerDistance >= 0) && (iPlayerDistance <= iWallDistance))
+		return false;
+
+	wallDist = (float)(iStep * (iWallDistance + 2));
+	destination = glm::vec2(Index().x + wallDist, Index().y);
+	return true;
 }
 
 float CGlutton::getHP(void)
@@ -610,291 +587,6 @@ void CGlutton::setMaxHP(float maxHealth)
 }
 
 
-/**
- @brief Constraint the enemy2D's position within a boundary
- @param eDirection A DIRECTION enumerated data type which indicates the direction to check
- */
-void CGlutton::Constraint(DIRECTION eDirection)
-{
-	if (eDirection == LEFT)
-	{
-		if (vec2Index.x < 0)
-		{
-			vec2Index.x = 0;
-			i32vec2NumMicroSteps.x = 0;
-		}
-	}
-	else if (eDirection == RIGHT)
-	{
-		if (vec2Index.x >= (int)cSettings->NUM_TILES_XAXIS - 1)
-		{
-			vec2Index.x = ((int)cSettings->NUM_TILES_XAXIS) - 1;
-			i32vec2NumMicroSteps.x = 0;
-		}
-	}
-	else if (eDirection == UP)
-	{
-		if (vec2Index.y >= (int)cSettings->NUM_TILES_YAXIS - 1)
-		{
-			vec2Index.y = ((int)cSettings->NUM_TILES_YAXIS) - 1;
-			i32vec2NumMicroSteps.y = 0;
-		}
-	}
-	else if (eDirection == DOWN)
-	{
-		if (vec2Index.y < 0)
-		{
-			vec2Index.y = 0;
-			i32vec2NumMicroSteps.y = 0;
-		}
-	}
-	else
-	{
-		cout << "CGlutton::Constraint: Unknown direction." << endl;
-	}
-}
-
-/**
- @brief Check if a position is possible to move into
- @param eDirection A DIRECTION enumerated data type which indicates the direction to check
- */
-bool CGlutton::CheckPosition(DIRECTION eDirection)
-{
-	if (eDirection == LEFT)
-	{
-		// If the new position is fully within a row, then check this row only
-		if (i32vec2NumMicroSteps.y == 0)
-		{
-			// If the grid is not accessible, then return false
-			if (cMap2D->GetMapInfo(vec2Index.y, vec2Index.x) >= 100)
-			{
-				return false;
-			}
-		}
-		// If the new position is between 2 rows, then check both rows as well
-		else if (i32vec2NumMicroSteps.y != 0)
-		{
-			// If the 2 grids are not accessible, then return false
-			if ((cMap2D->GetMapInfo(vec2Index.y, vec2Index.x) >= 100) ||
-				(cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x) >= 100))
-			{
-				return false;
-			}
-		}
-	}
-	else if (eDirection == RIGHT)
-	{
-		// If the new position is at the top row, then return true
-		if (vec2Index.x >= cSettings->NUM_TILES_XAXIS - 1)
-		{
-			i32vec2NumMicroSteps.x = 0;
-			return true;
-		}
-
-		// If the new position is fully within a row, then check this row only
-		if (i32vec2NumMicroSteps.y == 0)
-		{
-			// If the grid is not accessible, then return false
-			if (cMap2D->GetMapInfo(vec2Index.y, vec2Index.x + 1) >= 100)
-			{
-				return false;
-			}
-		}
-		// If the new position is between 2 rows, then check both rows as well
-		else if (i32vec2NumMicroSteps.y != 0)
-		{
-			// If the 2 grids are not accessible, then return false
-			if ((cMap2D->GetMapInfo(vec2Index.y, vec2Index.x + 1) >= 100) ||
-				(cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x + 1) >= 100))
-			{
-				return false;
-			}
-		}
-
-	}
-	else if (eDirection == UP)
-	{
-		// If the new position is at the top row, then return true
-		if (vec2Index.y >= cSettings->NUM_TILES_YAXIS - 1)
-		{
-			i32vec2NumMicroSteps.y = 0;
-			return true;
-		}
-
-		// If the new position is fully within a column, then check this column only
-		if (i32vec2NumMicroSteps.x == 0)
-		{
-			// If the grid is not accessible, then return false
-			if (cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x) >= 100)
-			{
-				return false;
-			}
-		}
-		// If the new position is between 2 columns, then check both columns as well
-		else if (i32vec2NumMicroSteps.x != 0)
-		{
-			// If the 2 grids are not accessible, then return false
-			if ((cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x) >= 100) ||
-				(cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x + 1) >= 100))
-			{
-				return false;
-			}
-		}
-	}
-	else if (eDirection == DOWN)
-	{
-		// If the new position is fully within a column, then check this column only
-		if (i32vec2NumMicroSteps.x == 0)
-		{
-			// If the grid is not accessible, then return false
-			if (cMap2D->GetMapInfo(vec2Index.y, vec2Index.x) >= 100)
-			{
-				return false;
-			}
-		}
-		// If the new position is between 2 columns, then check both columns as well
-		else if (i32vec2NumMicroSteps.x != 0)
-		{
-			// If the 2 grids are not accessible, then return false
-			if ((cMap2D->GetMapInfo(vec2Index.y, vec2Index.x) >= 100) ||
-				(cMap2D->GetMapInfo(vec2Index.y, vec2Index.x + 1) >= 100))
-			{
-				return false;
-			}
-		}
-	}
-	else
-	{
-		cout << "CGlutton::CheckPosition: Unknown direction." << endl;
-	}
-
-	return true;
-}
-
-// Check if the enemy2D is in mid-air
-bool CGlutton::IsMidAir(void)
-{
-	// if the player is at the bottom row, then he is not in mid-air for sure
-	if (vec2Index.y == 0)
-		return false;
-
-	// Check if the tile below the player's current position is empty
-	if ((i32vec2NumMicroSteps.x == 0) &&
-		(cMap2D->GetMapInfo(vec2Index.y - 1, vec2Index.x) == 0))
-	{
-		return true;
-	}
-
-	return false;
-}
-
-// Update Jump or Fall
-void CGlutton::UpdateJumpFall(const double dElapsedTime)
-{
-	if (cPhysics2D.GetStatus() == CPhysics2D::STATUS::JUMP)
-	{
-		// Update the elapsed time to the physics engine
-		cPhysics2D.AddElapsedTime((float)dElapsedTime);
-		// Call the physics engine update method to calculate the final velocity and displacement
-		cPhysics2D.Update();
-		// Get the displacement from the physics engine
-		glm::vec2 v2Displacement = cPhysics2D.GetDisplacement();
-
-		// Store the current vec2Index.y
-		int iIndex_YAxis_OLD = vec2Index.y;
-
-		int iDisplacement_MicroSteps = (int)(v2Displacement.y / cSettings->MICRO_STEP_YAXIS); //DIsplacement divide by distance for 1 microstep
-		if (vec2Index.y < (int)cSettings->NUM_TILES_YAXIS)
-		{
-			i32vec2NumMicroSteps.y += iDisplacement_MicroSteps;
-			if (i32vec2NumMicroSteps.y > cSettings->NUM_STEPS_PER_TILE_YAXIS)
-			{
-				i32vec2NumMicroSteps.y -= cSettings->NUM_STEPS_PER_TILE_YAXIS;
-				if (i32vec2NumMicroSteps.y < 0)
-					i32vec2NumMicroSteps.y = 0;
-				vec2Index.y++;
-			}
-		}
-
-		// Constraint the player's position within the screen boundary
-		Constraint(UP);
-
-		// Iterate through all rows until the proposed row
-		// Check if the player will hit a tile; stop jump if so.
-		int iIndex_YAxis_Proposed = vec2Index.y;
-		for (int i = iIndex_YAxis_OLD; i <= iIndex_YAxis_Proposed; i++)
-		{
-			// Change the player's index to the current i value
-			vec2Index.y = i;
-			// If the new position is not feasible, then revert to old position
-			if (CheckPosition(UP) == false)
-			{
-				// Align with the row
-				i32vec2NumMicroSteps.y = 0;
-				// Set the Physics to fall status
-				cPhysics2D.SetStatus(CPhysics2D::STATUS::FALL);
-				break;
-			}
-		}
-
-		// If the player is still jumping and the initial velocity has reached zero or below zero, 
-		// then it has reach the peak of its jump
-		if ((cPhysics2D.GetStatus() == CPhysics2D::STATUS::JUMP) && (cPhysics2D.GetInitialVelocity().y <= 0.0f))
-		{
-			// Set status to fall
-			cPhysics2D.SetStatus(CPhysics2D::STATUS::FALL);
-		}
-	}
-	else if (cPhysics2D.GetStatus() == CPhysics2D::STATUS::FALL)
-	{
-		// Update the elapsed time to the physics engine
-		cPhysics2D.AddElapsedTime((float)dElapsedTime);
-		// Call the physics engine update method to calculate the final velocity and displacement
-		cPhysics2D.Update();
-		// Get the displacement from the physics engine
-		glm::vec2 v2Displacement = cPhysics2D.GetDisplacement();
-
-		// Store the current vec2Index.y
-		int iIndex_YAxis_OLD = vec2Index.y;
-
-		// Translate the displacement from pixels to indices
-		int iDisplacement_MicroSteps = (int)(v2Displacement.y / cSettings->MICRO_STEP_YAXIS);
-
-		if (vec2Index.y >= 0)
-		{
-			i32vec2NumMicroSteps.y -= fabs(iDisplacement_MicroSteps);
-			if (i32vec2NumMicroSteps.y < 0)
-			{
-				i32vec2NumMicroSteps.y = ((int)cSettings->NUM_STEPS_PER_TILE_YAXIS) - 1;
-				vec2Index.y--;
-			}
-		}
-
-		// Constraint the player's position within the screen boundary
-		Constraint(DOWN);
-
-		// Iterate through all rows until the proposed row
-		// Check if the player will hit a tile; stop fall if so.
-		int iIndex_YAxis_Proposed = vec2Index.y;
-		for (int i = iIndex_YAxis_OLD; i >= iIndex_YAxis_Proposed; i--)
-		{
-			// Change the player's index to the current i value
-			vec2Index.y = i;
-			// If the new position is not feasible, then revert to old position
-			if (CheckPosition(DOWN) == false)
-			{
-				// Revert to the previous position
-				if (i != iIndex_YAxis_OLD)
-					vec2Index.y = i + 1;
-				// Set the Physics to idle status
-				cPhysics2D.SetStatus(CPhysics2D::STATUS::IDLE);
-				i32vec2NumMicroSteps.y = 0;
-				break;
-			}
-		}
-	}
-}
-
 /**
  @brief Let enemy2D interact with the player.
  */
@@ -903,15 +595,15 @@ bool CGlutton::InteractWithPlayer(void)
 	glm::i32vec2 i32vec2PlayerPos = cPlayer2D->vec2Index;
 	
 	// Check if the enemy2D is within 1.5 indices of the player2D
-	if (((vec2Index.x >= i32vec2PlayerPos.x - 0.5) && 
-		(vec2Index.x <= i32vec2PlayerPos.x + 0.5))
+	if (((Index().x >= i32vec2PlayerPos.x - 0.5) && 
+		(Index().x <= i32vec2PlayerPos.x + 0.5))
 		&& 
-		((vec2Index.y >= i32vec2PlayerPos.y - 0.5) &&
-		(vec2Index.y <= i32vec2PlayerPos.y + 0.5)))
+		((Index().y >= i32vec2PlayerPos.y - 0.5) &&
+		(Index().y <= i32vec2PlayerPos.y + 0.5)))
 	{
 		// Since the player has been caught, then reset the FSM
 	
-		iFSMCounter = 0;
+		FSMCounter() = 0;
 		return true;
 	}
 	return false;
@@ -926,10 +618,10 @@ void CGlutton::UpdateDirection(void)
 	i32vec2Destination = cPlayer2D->vec2Index;
 
 	// Calculate the direction between enemy2D and player2D
-	i32vec2Direction = i32vec2Destination - vec2Index;
+	i32vec2Direction = i32vec2Destination - Index();
 
 	// Calculate the distance between enemy2D and player2D
-	float fDistance = cPhysics2D.CalculateDistance(vec2Index, i32vec2Destination);
+	float fDistance = CalculateDistance(Index(), i32vec2Destination);
 	if (fDistance >= 0.01f)
 	{
 		// Calculate direction vector.
@@ -958,20 +650,20 @@ void CGlutton::FlipHorizontalDirection(void)
 void CGlutton::UpdatePosition(void)
 {
 	// Store the old position
-	i32vec2OldIndex = vec2Index;
+	i32vec2OldIndex = Index();
 
 	// if the player is to the left or right of the enemy2D, then jump to attack
 	if (i32vec2Direction.x < 0)
 	{
 		// Move left
-		const int iOldIndex = vec2Index.x;
-		if (vec2Index.x >= 0)
+		const int iOldIndex = Index().x;
+		if (Index().x >= 0)
 		{
-			i32vec2NumMicroSteps.x--;
-			if (i32vec2NumMicroSteps.x < 0)
+			MicroSteps().x--;
+			if (MicroSteps().x < 0)
 			{
-				i32vec2NumMicroSteps.x = ((int)cSettings->NUM_STEPS_PER_TILE_XAXIS) - 1;
-				vec2Index.x--;
+				MicroSteps().x = ((int)cSettings->NUM_STEPS_PER_TILE_XAXIS) - 1;
+				Index().x--;
 			}
 		}
 
@@ -982,14 +674,14 @@ void CGlutton::UpdatePosition(void)
 		if (CheckPosition(LEFT) == false)
 		{
 			FlipHorizontalDirection();
-			vec2Index = i32vec2OldIndex;
-			i32vec2NumMicroSteps.x = 0;
+			Index() = i32vec2OldIndex;
+			MicroSteps().x = 0;
 		}
 
 		// Check if enemy2D is in mid-air, such as walking off a platform
 		if (IsMidAir() == true)
 		{
-			cPhysics2D.SetStatus(CPhysics2D::STATUS::FALL);
+			cSimulation->SetStatus(uiBody, CPhysics2D::STATUS::FALL);
 		}
 		gluttonAnimatedSprites->PlayAnimation("Left", -1, 5);
 
@@ -999,15 +691,15 @@ void CGlutton::UpdatePosition(void)
 	else if (i32vec2Direction.x > 0)
 	{
 		// Move right
-		const int iOldIndex = vec2Index.x;
-		if (vec2Index.x < (int)cSettings->NUM_TILES_XAXIS)
+		const int iOldIndex = Index().x;
+		if (Index().x < (int)cSettings->NUM_TILES_XAXIS)
 		{
-			i32vec2NumMicroSteps.x++;
+			MicroSteps().x++;
 
-			if (i32vec2NumMicroSteps.x >= cSettings->NUM_STEPS_PER_TILE_XAXIS)
+			if (MicroSteps().x >= cSettings->NUM_STEPS_PER_TILE_XAXIS)
 			{
-				i32vec2NumMicroSteps.x = 0;
-				vec2Index.x++;
+				MicroSteps().x = 0;
+				Index().x++;
 			}
 		}
 
@@ -1019,13 +711,13 @@ void CGlutton::UpdatePosition(void)
 		{
 			FlipHorizontalDirection();
 			//vec2Index = i32vec2OldIndex;
-			i32vec2NumMicroSteps.x = 0;
+			MicroSteps().x = 0;
 		}
 
 		// Check if enemy2D is in mid-air, such as walking off a platform
 		if (IsMidAir() == true)
 		{
-			cPhysics2D.SetStatus(CPhysics2D::STATUS::FALL);
+			cSimulation->SetStatus(uiBody, CPhysics2D::STATUS::FALL);
 		}
 
 		// Interact with the Player
@@ -1035,12 +727,12 @@ void CGlutton::UpdatePosition(void)
 	}
 
 	// if the player is above the enemy2D, then jump to attack
-	if (i32vec2Direction.y > 0 && cPlayer2D->vec2Index.y - vec2Index.y < 5.f)
+	if (i32vec2Direction.y > 0 && cPlayer2D->vec2Index.y - Index().y < 5.f)
 	{
-		if (cPhysics2D.GetStatus() == CPhysics2D::STATUS::IDLE)
+		if (cSimulation->GetStatus(uiBody) == CPhysics2D::STATUS::IDLE)
 		{
-			cPhysics2D.SetStatus(CPhysics2D::STATUS::JUMP);
-			cPhysics2D.SetInitialVelocity(glm::vec2(0.0f, 2.5f));
+			cSimulation->SetStatus(uiBody, CPhysics2D::STATUS::JUMP);
+			cSimulation->SetVelocity(uiBody, glm::vec2(0.0f, 2.5f));
 		}
 	}
 }
@@ -0,0 +1,278 @@
+/**
+ CGridSearch
+ @brief A class which finds paths on the tiles of a level, with either A* Path Finding or
+		Jump Point Search. It only reads the tiles and the caller's search context, so
+		searches with different contexts can run at the same time.
+		Positions are (column, row), where row 0 is the bottom row. Tiles are solid when
+		TileProperties::IsSolid() says so.
+ */
+#include "GridSearch.h"
+
+// Include TileProperties
+#include "TileProperties.h"
+
+// The steps which can be taken, with the 4 orthogonal steps first
+const int CGridSearch::DIRECTIONS[8][2] = {
+	{ -1, 0 }, { 1, 0 }, { 0, 1 }, { 0, -1 },
+	{ -1, -1 }, { 1, 1 }, { -1, 1 }, { 1, -1 } };
+
+/**
+ @brief Constructor
+ @param arrTiles A const unsigned short* variable containing the tiles of the level
+ @param uiNumRows A const unsigned int variable containing the number of rows
+ @param uiNumCols A const unsigned int variable containing the number of columns
+ @param uiNumDirections A const unsigned int variable containing 4 for orthogonal movements only,
+			or 8 to include diagonal movements
+ */
+CGridSearch::CGridSearch(	const unsigned short* arrTiles,
+							const unsigned int uiNumRows,
+							const unsigned int uiNumCols,
+							const unsigned int uiNumDirections)
+	: arrTiles(arrTiles)
+	, iNumRows((int)uiNumRows)
+	, iNumCols((int)uiNumCols)
+	, uiNumDirections((uiNumDirections == 8) ? 8 : 4)
+{
+}
+
+/**
+ @brief Destructor
+ */
+CGridSearch::~CGridSearch(void)
+{
+}
+
+/**
+ @brief Check if a tile is inside the level and not solid
+ */
+bool CGridSearch::IsWalkable(const int iCol, const int iRow) const
+{
+	if ((iCol < 0) || (iCol >= iNumCols) || (iRow < 0) || (iRow >= iNumRows))
+		return false;
+
+	return !TileProperties::IsSolid(arrTiles[iRow * iNumCols + iCol]);
+}
+
+/**
+ @brief Check if both positions are walkable, and start a new search
+ */
+bool CGridSearch::Begin(AStarContext& context, const glm::vec2& startPos, const glm::vec2& targetPos) const
+{
+	if (!IsWalkable((int)startPos.x, (int)startPos.y) ||
+		!IsWalkable((int)targetPos.x, (int)targetPos.y))
+		return false;
+
+	// Start a new search, which invalidates the records of the previous one
+	context.Begin(iNumRows * iNumCols);
+	return true;
+}
+
+/**
+ @brief Move from a tile in a direction until a jump point is found. A jump point is the
+		target, or a tile next to which a path may need to turn
+ @param iCol An int variable containing the column of the tile to move from
+ @param iRow An int variable containing the row of the tile to move from
+ @param iDirX A const int variable containing the column step
+ @param iDirY A const int variable containing the row step
+ @param iTargetIndex A const int variable containing the 1D position of the target
+ @return The 1D position of the jump point, or -1 if a solid tile or the edge was reached first
+ */
+int CGridSearch::Jump(int iCol, int iRow, const int iDirX, const int iDirY, const int iTargetIndex) const
+{
+	while (true)
+	{
+		iCol += iDirX;
+		iRow += iDirY;
+		if (!IsWalkable(iCol, iRow))
+			return -1;
+
+		const int iIndex = iRow * iNumCols + iCol;
+		if (iIndex == iTargetIndex)
+			return iIndex;
+
+		if (uiNumDirections == 8)
+		{
+			if ((iDirX != 0) && (iDirY != 0))
+			{
+				// A tile next to a solid tile behind the move can only be reached well from here
+				if ((!IsWalkable(iCol - iDirX, iRow) && IsWalkable(iCol - iDirX, iRow + iDirY)) ||
+					(!IsWalkable(iCol, iRow - iDirY) && IsWalkable(iCol + iDirX, iRow - iDirY)))
+					return iIndex;
+
+				// Stop if a straight move from here leads to a jump point
+				if ((Jump(iCol, iRow, iDirX, 0, iTargetIndex) >= 0) ||
+					(Jump(iCol, iRow, 0, iDirY, iTargetIndex) >= 0))
+					return iIndex;
+			}
+			else if (iDirX != 0)
+			{
+				if ((!IsWalkable(iCol, iRow + 1) && IsWalkable(iCol + iDirX, iRow + 1)) ||
+					(!IsWalkable(iCol, iRow - 1) && IsWalkable(iCol + iDirX, iRow - 1)))
+					return iIndex;
+			}
+			else
+			{
+				if ((!IsWalkable(iCol + 1, iRow) && IsWalkable(iCol + 1, iRow + iDirY)) ||
+					(!IsWalkable(iCol - 1, iRow) && IsWalkable(iCol - 1, iRow + iDirY)))
+					return iIndex;
+			}
+		}
+		else
+		{
+			if (iDirX != 0)
+			{
+				// A tile above or below which could not be reached from the previous column
+				if ((IsWalkable(iCol, iRow + 1) && !IsWalkable(iCol - iDirX, iRow + 1)) ||
+					(IsWalkable(iCol, iRow - 1) && !IsWalkable(iCol - iDirX, iRow - 1)))
+					return iIndex;
+			}
+			else
+			{
+				// Vertical moves turn into horizontal ones, so stop if either side leads to a jump point
+				if ((Jump(iCol, iRow, 1, 0, iTargetIndex) >= 0) ||
+					(Jump(iCol, iRow, -1, 0, iTargetIndex) >= 0))
+					return iIndex;
+			}
+		}
+	}
+}
+
+/**
+ @brief Get the directions to search from a jump point, given the tile it was reached from.
+		Directions which are reached as well or better through the parent are skipped
+ @param iCol A const int variable containing the column of the jump point
+ @param iRow A const int variable containing the row of the jump point
+ @param iParentCol A const int variable containing the column of the parent jump point
+ @param iParentRow A const int variable containing the row of the parent jump point
+ @param arrDirections An int[8][2] variable which will store the directions
+ @return The number of directions
+ */
+unsigned int CGridSearch::GetJumpDirections(const int iCol, const int iRow,
+											const int iParentCol, const int iParentRow,
+											int arrDirections[8][2]) const
+{
+	unsigned int uiCount = 0;
+
+	// The start position has no parent, so every direction is searched
+	if ((iCol == iParentCol) && (iRow == iParentRow))
+	{
+		for (unsigned int i = 0; i < uiNumDirections; i++)
+		{
+			arrDirections[uiCount][0] = DIRECTIONS[i][0];
+			arrDirections[uiCount][1] = DIRECTIONS[i][1];
+			uiCount++;
+		}
+		return uiCount;
+	}
+
+	const int iDirX = (iCol > iParentCol) ? 1 : ((iCol < iParentCol) ? -1 : 0);
+	const int iDirY = (iRow > iParentRow) ? 1 : ((iRow < iParentRow) ? -1 : 0);
+
+	if (uiNumDirections == 8)
+	{
+		if ((iDirX != 0) && (iDirY != 0))
+		{
+			arrDirections[uiCount][0] = iDirX;	arrDirections[uiCount++][1] = 0;
+			arrDirections[uiCount][0] = 0;		arrDirections[uiCount++][1] = iDirY;
+			arrDirections[uiCount][0] = iDirX;	arrDirections[uiCount++][1] = iDirY;
+			if (!IsWalkable(iCol - iDirX, iRow))
+			{
+				arrDirections[uiCount][0] = -iDirX;	arrDirections[uiCount++][1] = iDirY;
+			}
+			if (!IsWalkable(iCol, iRow - iDirY))
+			{
+				arrDirections[uiCount][0] = iDirX;	arrDirections[uiCount++][1] = -iDirY;
+			}
+		}
+		else if (iDirX != 0)
+		{
+			arrDirections[uiCount][0] = iDirX;	arrDirections[uiCount++][1] = 0;
+			if (!IsWalkable(iCol, iRow + 1))
+			{
+				arrDirections[uiCount][0] = iDirX;	arrDirections[uiCount++][1] = 1;
+			}
+			if (!IsWalkable(iCol, iRow - 1))
+			{
+				arrDirections[uiCount][0] = iDirX;	arrDirections[uiCount++][1] = -1;
+			}
+		}
+		else
+		{
+			arrDirections[uiCount][0] = 0;	arrDirections[uiCount++][1] = iDirY;
+			if (!IsWalkable(iCol + 1, iRow))
+			{
+				arrDirections[uiCount][0] = 1;	arrDirections[uiCount++][1] = iDirY;
+			}
+			if (!IsWalkable(iCol - 1, iRow))
+			{
+				arrDirections[uiCount][0] = -1;	arrDirections[uiCount++][1] = iDirY;
+			}
+		}
+	}
+	else
+	{
+		if (iDirX != 0)
+		{
+			arrDirections[uiCount][0] = iDirX;	arrDirections[uiCount++][1] = 0;
+			if (!IsWalkable(iCol - iDirX, iRow + 1))
+			{
+				arrDirections[uiCount][0] = 0;	arrDirections[uiCount++][1] = 1;
+			}
+			if (!IsWalkable(iCol - iDirX, iRow - 1))
+			{
+				arrDirections[uiCount][0] = 0;	arrDirections[uiCount++][1] = -1;
+			}
+		}
+		else
+		{
+			arrDirections[uiCount][0] = 0;	arrDirections[uiCount++][1] = iDirY;
+			arrDirections[uiCount][0] = 1;	arrDirections[uiCount++][1] = 0;
+			arrDirections[uiCount][0] = -1;	arrDirections[uiCount++][1] = 0;
+		}
+	}
+	return uiCount;
+}
+
+/**
+ @brief Build a path by following the parents of the node records back from the target.
+		Jump points can be several tiles apart, so the tiles between them are filled in.
+		The path is written from the grid after the start position to the target position
+ @param context A const AStarContext& variable containing the scratch data of a finished search
+ @param uiTargetIndex A const unsigned int variable containing the 1D position of the target
+ @param vPath A std::vector<glm::vec2>& variable which will store the path
+ */
+void CGridSearch::BuildPath(const AStarContext& context,
+							const unsigned int uiTargetIndex,
+							std::vector<glm::vec2>& vPath) const
+{
+	// Count the tiles first, so the path can be written in order without reversing it
+	unsigned int uiLength = 0;
+	for (unsigned int uiIndex = uiTargetIndex; context.m_nodes[uiIndex].uiParent != uiIndex; uiIndex = context.m_nodes[uiIndex].uiParent)
+	{
+		const unsigned int uiParent = context.m_nodes[uiIndex].uiParent;
+		const int iDistX = abs((int)(uiIndex % iNumCols) - (int)(uiParent % iNumCols));
+		const int iDistY = abs((int)(uiIndex / iNumCols) - (int)(uiParent / iNumCols));
+		uiLength += (iDistX > iDistY) ? iDistX : iDistY;
+	}
+
+	vPath.resize(uiLength);
+	unsigned int i = uiLength;
+	for (unsigned int uiIndex = uiTargetIndex; context.m_nodes[uiIndex].uiParent != uiIndex; uiIndex = context.m_nodes[uiIndex].uiParent)
+	{
+		const unsigned int uiParent = context.m_nodes[uiIndex].uiParent;
+		int iCol = (int)(uiIndex % iNumCols);
+		int iRow = (int)(uiIndex / iNumCols);
+		const int iParentCol = (int)(uiParent % iNumCols);
+		const int iParentRow = (int)(uiParent / iNumCols);
+		const int iDirX = (iParentCol > iCol) ? 1 : ((iParentCol < iCol) ? -1 : 0);
+		const int iDirY = (iParentRow > iRow) ? 1 : ((iParentRow < iRow) ? -1 : 0);
+
+		// Walk back towards the parent, which is in a straight or diagonal line
+		while ((iCol != iParentCol) || (iRow != iParentRow))
+		{
+			vPath[--i] = glm::vec2(iCol, iRow);
+			iCol += iDirX;
+			iRow += iDirY;
+		}
+	}
+}
@@ -0,0 +1,255 @@
+/**
+ CGridSearch
+ @brief A class which finds paths on the tiles of a level, with either A* Path Finding or
+		Jump Point Search. It only reads the tiles and the caller's search context, so
+		searches with different contexts can run at the same time.
+		Positions are (column, row), where row 0 is the bottom row. Tiles are solid when
+		TileProperties::IsSolid() says so.
+
+		Jump Point Search skips over the open areas of a level by only adding the tiles
+		where a path may need to turn to the open list. It finds paths of the same length
+		as A*, but expands far fewer nodes. Both are only optimal with a heuristic which never
+		overestimates: heuristic::Manhattan for 4 directions and heuristic::Chebyshev for 8,
+		since a diagonal step costs the same as a straight one. The path is filled in between the jump points,
+		so both searches output one entry per tile.
+ */
+#pragma once
+
+// Include AStarContext
+#include "AStarContext.h"
+
+#include <cstdlib>
+
+class CGridSearch
+{
+public:
+	// Constructor
+	CGridSearch(const unsigned short* arrTiles,
+				const unsigned int uiNumRows,
+				const unsigned int uiNumCols,
+				const unsigned int uiNumDirections);
+
+	// Destructor
+	virtual ~CGridSearch(void);
+
+	// Find a path with A* Path Finding
+	template <typename Heuristic>
+	bool AStar(	AStarContext& context,
+				const glm::vec2& startPos,
+				const glm::vec2& targetPos,
+				std::vector<glm::vec2>& vPath,
+				const int weight = 1) const;
+
+	// Find a path with Jump Point Search
+	template <typename Heuristic>
+	bool JumpPoint(	AStarContext& context,
+					const glm::vec2& startPos,
+					const glm::vec2& targetPos,
+					std::vector<glm::vec2>& vPath,
+					const int weight = 1) const;
+
+	// Check if a tile is inside the level and not solid
+	bool IsWalkable(const int iCol, const int iRow) const;
+
+protected:
+	// The tiles which are searched
+	const unsigned short* arrTiles;
+	int iNumRows;
+	int iNumCols;
+	// 4 for orthogonal movements only, or 8 to include diagonal movements
+	unsigned int uiNumDirections;
+
+	// The steps which can be taken, with the 4 orthogonal steps first
+	static const int DIRECTIONS[8][2];
+
+	// Check if both positions are walkable, and start a new search
+	bool Begin(AStarContext& context, const glm::vec2& startPos, const glm::vec2& targetPos) const;
+
+	// Move from a tile in a direction until a jump point is found
+	int Jump(int iCol, int iRow, const int iDirX, const int iDirY, const int iTargetIndex) const;
+	// Get the directions to search from a jump point, given the tile it was reached from
+	unsigned int GetJumpDirections(	const int iCol, const int iRow,
+									const int iParentCol, const int iParentRow,
+									int arrDirections[8][2]) const;
+
+	// Build a path from the node records, filling in the tiles between them
+	void BuildPath(	const AStarContext& context,
+					const unsigned int uiTargetIndex,
+					std::vector<glm::vec2>& vPath) const;
+};
+
+/**
+ @brief Find a path with A* Path Finding. Once the context and the path buffer have grown to
+		the size of the level, a search does not allocate memory
+ @param context An AStarContext& variable containing the scratch data of the search
+ @param startPos A const glm::vec2& variable containing the start position
+ @param targetPos A const glm::vec2& variable containing the target position
+ @param vPath A std::vector<glm::vec2>& variable which will store the path, from the grid
+			after startPos to targetPos
+ @param weight A const int variable containing the weight of the heuristic
+ @return true if a path was found, otherwise false
+ */
+template <typename Heuristic>
+bool CGridSearch::AStar(AStarContext& context,
+						const glm::vec2& startPos,
+						const glm::vec2& targetPos,
+						std::vector<glm::vec2>& vPath,
+						const int weight) const
+{
+	vPath.clear();
+	if (!Begin(context, startPos, targetPos))
+		return false;
+
+	const Heuristic cHeuristic;
+	const unsigned int uiStartIndex = (int)startPos.y * iNumCols + (int)startPos.x;
+	const unsigned int uiTargetIndex = (int)targetPos.y * iNumCols + (int)targetPos.x;
+
+	// Add the start pos to the open list
+	context.GetNode(uiStartIndex);
+	context.PushOpen(0, uiStartIndex);
+
+	// Start the path finding...
+	bool bFound = false;
+	while (!context.m_openList.empty())
+	{
+		// Get the node with the least f value
+		const unsigned int uiCurrentIndex = context.PopOpen();
+		AStarNode& sCurrent = context.GetNode(uiCurrentIndex);
+
+		// If the targetPos was reached, then quit this loop
+		if (uiCurrentIndex == uiTargetIndex)
+		{
+			bFound = true;
+			break;
+		}
+
+		// A node can be in the open list more than once, so skip the copies after the first
+		if (sCurrent.bClosed)
+			continue;
+		sCurrent.bClosed = true;
+		context.uiNumExpanded++;
+
+		const int iCurrentCol = (int)(uiCurrentIndex % iNumCols);
+		const int iCurrentRow = (int)(uiCurrentIndex / iNumCols);
+		const unsigned int gNew = sCurrent.g + 1;
+
+		// Check the neighbors of the current node
+		for (unsigned int i = 0; i < uiNumDirections; ++i)
+		{
+			const int iCol = iCurrentCol + DIRECTIONS[i][0];
+			const int iRow = iCurrentRow + DIRECTIONS[i][1];
+			if (!IsWalkable(iCol, iRow))
+				continue;
+
+			const unsigned int uiNeighborIndex = iRow * iNumCols + iCol;
+			AStarNode& sNeighbor = context.GetNode(uiNeighborIndex);
+			if (sNeighbor.bClosed)
+				continue;
+
+			const unsigned int hNew = cHeuristic(glm::vec2(iCol, iRow), targetPos, weight);
+			const unsigned int fNew = gNew + hNew;
+			if ((sNeighbor.f == 0) || (fNew < sNeighbor.f))
+			{
+				sNeighbor.uiParent = uiCurrentIndex;
+				sNeighbor.g = gNew;
+				sNeighbor.f = fNew;
+				context.PushOpen(fNew, uiNeighborIndex);
+			}
+		}
+	}
+
+	if (bFound)
+		BuildPath(context, uiTargetIndex, vPath);
+	return bFound;
+}
+
+/**
+ @brief Find a path with Jump Point Search. The output is the same as AStar()
+ @param context An AStarContext& variable containing the scratch data of the search
+ @param startPos A const glm::vec2& variable containing the start position
+ @param targetPos A const glm::vec2& variable containing the target position
+ @param vPath A std::vector<glm::vec2>& variable which will store the path, from the grid
+			after startPos to targetPos
+ @param weight A const int variable containing the weight of the heuristic
+ @return true if a path was found, otherwise false
+ */
+template <typename Heuristic>
+bool CGridSearch::JumpPoint(AStarContext& context,
+							const glm::vec2& startPos,
+							const glm::vec2& targetPos,
+							std::vector<glm::vec2>& vPath,
+							const int weight) const
+{
+	vPath.clear();
+	if (!Begin(context, startPos, targetPos))
+		return false;
+
+	const Heuristic cHeuristic;
+	const unsigned int uiStartIndex = (int)startPos.y * iNumCols + (int)startPos.x;
+	const unsigned int uiTargetIndex = (int)targetPos.y * iNumCols + (int)targetPos.x;
+
+	// Add the start pos to the open list
+	context.GetNode(uiStartIndex);
+	context.PushOpen(0, uiStartIndex);
+
+	int arrDirections[8][2];
+	bool bFound = false;
+	while (!context.m_openList.empty())
+	{
+		// Get the jump point with the least f value
+		const unsigned int uiCurrentIndex = context.PopOpen();
+		AStarNode& sCurrent = context.GetNode(uiCurrentIndex);
+
+		if (uiCurrentIndex == uiTargetIndex)
+		{
+			bFound = true;
+			break;
+		}
+
+		if (sCurrent.bClosed)
+			continue;
+		sCurrent.bClosed = true;
+		context.uiNumExpanded++;
+
+		const int iCurrentCol = (int)(uiCurrentIndex % iNumCols);
+		const int iCurrentRow = (int)(uiCurrentIndex / iNumCols);
+		const unsigned int uiNumJumpDirections = GetJumpDirections(
+			iCurrentCol, iCurrentRow,
+			(int)(sCurrent.uiParent % iNumCols), (int)(sCurrent.uiParent / iNumCols),
+			arrDirections);
+
+		// Jump in each direction which may lead somewhere new
+		for (unsigned int i = 0; i < uiNumJumpDirections; ++i)
+		{
+			const int iJumpIndex = Jump(iCurrentCol, iCurrentRow,
+										arrDirections[i][0], arrDirections[i][1],
+										(int)uiTargetIndex);
+			if (iJumpIndex < 0)
+				continue;
+
+			AStarNode& sNeighbor = context.GetNode(iJumpIndex);
+			if (sNeighbor.bClosed)
+				continue;
+
+			// Every step costs 1, including diagonal ones, the same as AStar()
+			const int iCol = iJumpIndex % iNumCols;
+			const int iRow = iJumpIndex / iNumCols;
+			const int iDistX = abs(iCol - iCurrentCol);
+			const int iDistY = abs(iRow - iCurrentRow);
+			const unsigned int gNew = sCurrent.g + ((iDistX > iDistY) ? iDistX : iDistY);
+			const unsigned int hNew = cHeuristic(glm::vec2(iCol, iRow), targetPos, weight);
+			const unsigned int fNew = gNew + hNew;
+			if ((sNeighbor.f == 0) || (fNew < sNeighbor.f))
+			{
+				sNeighbor.uiParent = uiCurrentIndex;
+				sNeighbor.g = gNew;
+				sNeighbor.f = fNew;
+				context.PushOpen(fNew, iJumpIndex);
+			}
+		}
+	}
+
+	if (bFound)
+		BuildPath(context, uiTargetIndex, vPath);
+	return bFound;
+}
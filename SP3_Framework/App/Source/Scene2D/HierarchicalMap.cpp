@@ -0,0 +1,613 @@
+/**
+ CHierarchicalMap
+ @brief A class which finds long paths on the tiles of a level with Hierarchical Path Finding
+		(HPA*). The level is split into square clusters. The tiles where a path can cross
+		from one cluster into the next are the entrances. The shortest paths between the
+		entrances of each cluster are found in advance, which forms a small abstract graph.
+		A path is planned over the abstract graph first, and then filled in one cluster at a
+		time, so the cost of a query grows with the number of clusters crossed rather than
+		the number of tiles in the level.
+ */
+#include "HierarchicalMap.h"
+
+// Include TileProperties
+#include "TileProperties.h"
+
+#include <cstdlib>
+using namespace std;
+
+const unsigned int CHierarchicalMap::NO_EDGE;
+
+// The flags in vRebuildFlags
+static const unsigned char REBUILD_ENTRANCES = 1;
+static const unsigned char REBUILD_CLUSTER = 2;
+
+// A run of entrance tiles at least this long gets an entrance at each end instead of one in the middle
+static const int MIN_DOUBLE_ENTRANCE_LENGTH = 6;
+
+/**
+ @brief Constructor
+ */
+CHierarchicalMap::CHierarchicalMap(void)
+	: arrTiles(NULL)
+	, iNumRows(0)
+	, iNumCols(0)
+	, iClusterSize(0)
+	, iNumClusterRows(0)
+	, iNumClusterCols(0)
+	, uiNumDirections(4)
+	, bBuilt(false)
+	, uiLevel(0)
+	, uiNumRebuilt(0)
+	, uiLocalGeneration(0)
+{
+}
+
+/**
+ @brief Destructor
+ */
+CHierarchicalMap::~CHierarchicalMap(void)
+{
+}
+
+/**
+ @brief Bring the abstract graph up to date with the tiles of a level. Only the clusters whose
+		version has changed since they were built, and their neighbours, are built again.
+		Everything is built again if the level, its size or the movement directions change
+ @param arrTiles A const unsigned short* variable containing the tiles of the level
+ @param uiNumRows A const unsigned int variable containing the number of rows
+ @param uiNumCols A const unsigned int variable containing the number of columns
+ @param uiClusterSize A const unsigned int variable containing the number of tiles along each side of a cluster
+ @param uiNumDirections A const unsigned int variable containing 4 for orthogonal movements only,
+			or 8 to include diagonal movements
+ @param uiLevel A const unsigned int variable containing the level
+ @param arrClusterVersions A const unsigned int* variable containing the version of each cluster,
+			in row-major order, which changes whenever a tile in the cluster changes
+ */
+void CHierarchicalMap::Update(	const unsigned short* arrTiles,
+								const unsigned int uiNumRows,
+								const unsigned int uiNumCols,
+								const unsigned int uiClusterSize,
+								const unsigned int uiNumDirections,
+								const unsigned int uiLevel,
+								const unsigned int* arrClusterVersions)
+{
+	this->arrTiles = arrTiles;
+	uiNumRebuilt = 0;
+
+	const unsigned int uiDirections = (uiNumDirections == 8) ? 8 : 4;
+	const bool bFullRebuild = !bBuilt ||
+		(this->uiLevel != uiLevel) ||
+		(iNumRows != (int)uiNumRows) ||
+		(iNumCols != (int)uiNumCols) ||
+		(iClusterSize != (int)uiClusterSize) ||
+		(this->uiNumDirections != uiDirections);
+
+	if (bFullRebuild)
+	{
+		this->uiLevel = uiLevel;
+		this->uiNumDirections = uiDirections;
+		iNumRows = (int)uiNumRows;
+		iNumCols = (int)uiNumCols;
+		iClusterSize = (int)uiClusterSize;
+		iNumClusterRows = (iNumRows + iClusterSize - 1) / iClusterSize;
+		iNumClusterCols = (iNumCols + iClusterSize - 1) / iClusterSize;
+
+		const unsigned int uiNumClusters = iNumClusterRows * iNumClusterCols;
+		const unsigned int uiNumTiles = uiNumRows * uiNumCols;
+		vEntrances.assign(uiNumClusters, vector<pair<unsigned int, unsigned int> >());
+		vClusters.assign(uiNumClusters, Cluster());
+		vClusterVersions.assign(uiNumClusters, 0);
+		vRebuildFlags.assign(uiNumClusters, 0);
+		vNodeSlots.assign(uiNumTiles, -1);
+		vLocalGenerations.assign(uiNumTiles, 0);
+		vLocalDistances.resize(uiNumTiles);
+		vLocalParents.resize(uiNumTiles);
+		vLocalQueue.resize(uiNumTiles);
+		uiLocalGeneration = 0;
+		bBuilt = true;
+	}
+
+	// A changed cluster changes the entrances on all its borders, which changes the costs of its neighbours too
+	bool bChanged = false;
+	for (int iClusterRow = 0; iClusterRow < iNumClusterRows; iClusterRow++)
+	{
+		for (int iClusterCol = 0; iClusterCol < iNumClusterCols; iClusterCol++)
+		{
+			const int iCluster = iClusterRow * iNumClusterCols + iClusterCol;
+			if (!bFullRebuild && (vClusterVersions[iCluster] == arrClusterVersions[iCluster]))
+				continue;
+			vClusterVersions[iCluster] = arrClusterVersions[iCluster];
+			bChanged = true;
+
+			for (int iOffsetRow = -1; iOffsetRow <= 1; iOffsetRow++)
+			{
+				for (int iOffsetCol = -1; iOffsetCol <= 1; iOffsetCol++)
+				{
+					const int iCol = iClusterCol + iOffsetCol;
+					const int iRow = iClusterRow + iOffsetRow;
+					if ((iCol < 0) || (iCol >= iNumClusterCols) || (iRow < 0) || (iRow >= iNumClusterRows))
+						continue;
+
+					// The clusters on the left and below own the borders shared with this cluster
+					vRebuildFlags[iRow * iNumClusterCols + iCol] |= REBUILD_CLUSTER;
+					if ((iOffsetCol < 0) || ((iOffsetCol == 0) && (iOffsetRow <= 0)))
+						vRebuildFlags[iRow * iNumClusterCols + iCol] |= REBUILD_ENTRANCES;
+				}
+			}
+		}
+	}
+	if (!bChanged)
+		return;
+
+	for (unsigned int i = 0; i < vRebuildFlags.size(); i++)
+	{
+		if (vRebuildFlags[i] & REBUILD_ENTRANCES)
+			BuildEntrances(i);
+	}
+	for (unsigned int i = 0; i < vRebuildFlags.size(); i++)
+	{
+		if (vRebuildFlags[i] & REBUILD_CLUSTER)
+		{
+			BuildCluster(i);
+			uiNumRebuilt++;
+		}
+		vRebuildFlags[i] = 0;
+	}
+}
+
+/**
+ @brief Find a path. The path is planned over the abstract graph, and then filled in
+		inside each cluster, so it may be a little longer than the shortest path
+ @param startPos A const glm::vec2& variable containing the start position
+ @param targetPos A const glm::vec2& variable containing the target position
+ @param vPath A std::vector<glm::vec2>& variable which will store the path, from the grid
+			after startPos to targetPos
+ @return true if a path was found, otherwise false
+ */
+bool CHierarchicalMap::FindPath(const glm::vec2& startPos,
+								const glm::vec2& targetPos,
+								std::vector<glm::vec2>& vPath)
+{
+	vPath.clear();
+	if (!bBuilt ||
+		!IsWalkable((int)startPos.x, (int)startPos.y) ||
+		!IsWalkable((int)targetPos.x, (int)targetPos.y))
+		return false;
+
+	const unsigned int uiStartIndex = (int)startPos.y * iNumCols + (int)startPos.x;
+	const unsigned int uiTargetIndex = (int)targetPos.y * iNumCols + (int)targetPos.x;
+	if (uiStartIndex == uiTargetIndex)
+		return true;
+
+	const int iStartCluster = GetCluster(uiStartIndex);
+	const int iTargetCluster = GetCluster(uiTargetIndex);
+
+	// Searches inside one cluster do not need the abstract graph
+	if (iStartCluster == iTargetCluster)
+	{
+		SearchCluster(uiTargetIndex, iTargetCluster);
+		if (GetLocalDistance(uiStartIndex) != NO_EDGE)
+		{
+			for (unsigned int uiIndex = uiStartIndex; uiIndex != uiTargetIndex; )
+			{
+				uiIndex = vLocalParents[uiIndex];
+				vPath.push_back(glm::vec2(uiIndex % iNumCols, uiIndex / iNumCols));
+			}
+			return true;
+		}
+	}
+
+	// Connect the start and the target to the entrances of their clusters
+	const Cluster& sStartCluster = vClusters[iStartCluster];
+	SearchCluster(uiStartIndex, iStartCluster);
+	vStartEdges.clear();
+	for (unsigned int i = 0; i < sStartCluster.vNodes.size(); i++)
+	{
+		const unsigned int uiDistance = GetLocalDistance(sStartCluster.vNodes[i]);
+		if (uiDistance != NO_EDGE)
+			vStartEdges.push_back(make_pair(sStartCluster.vNodes[i], uiDistance));
+	}
+
+	const Cluster& sTargetCluster = vClusters[iTargetCluster];
+	SearchCluster(uiTargetIndex, iTargetCluster);
+	vGoalCosts.resize(sTargetCluster.vNodes.size());
+	for (unsigned int i = 0; i < sTargetCluster.vNodes.size(); i++)
+	{
+		vGoalCosts[i] = GetLocalDistance(sTargetCluster.vNodes[i]);
+	}
+
+	// Search the abstract graph
+	cSearchContext.Begin(iNumRows * iNumCols);
+	cSearchContext.GetNode(uiStartIndex);
+	cSearchContext.PushOpen(0, uiStartIndex);
+
+	bool bFound = false;
+	while (!cSearchContext.m_openList.empty())
+	{
+		const unsigned int uiCurrentIndex = cSearchContext.PopOpen();
+		AStarNode& sCurrent = cSearchContext.GetNode(uiCurrentIndex);
+		if (uiCurrentIndex == uiTargetIndex)
+		{
+			bFound = true;
+			break;
+		}
+
+		if (sCurrent.bClosed)
+			continue;
+		sCurrent.bClosed = true;
+		cSearchContext.uiNumExpanded++;
+
+		if (uiCurrentIndex == uiStartIndex)
+		{
+			for (unsigned int i = 0; i < vStartEdges.size(); i++)
+				Relax(uiCurrentIndex, vStartEdges[i].first, vStartEdges[i].second, uiTargetIndex);
+		}
+
+		const int iSlot = vNodeSlots[uiCurrentIndex];
+		if (iSlot < 0)
+			continue;
+
+		// Move to the other entrances of this cluster, or across to the next cluster
+		const int iCluster = GetCluster(uiCurrentIndex);
+		const Cluster& sCluster = vClusters[iCluster];
+		const unsigned int uiNumNodes = (unsigned int)sCluster.vNodes.size();
+		for (unsigned int i = 0; i < uiNumNodes; i++)
+		{
+			const unsigned int uiCost = sCluster.vCosts[iSlot * uiNumNodes + i];
+			if (((int)i != iSlot) && (uiCost != NO_EDGE))
+				Relax(uiCurrentIndex, sCluster.vNodes[i], uiCost, uiTargetIndex);
+		}
+		for (unsigned int i = 0; i < sCluster.vLinks[iSlot].size(); i++)
+		{
+			Relax(uiCurrentIndex, sCluster.vLinks[iSlot][i], 1, uiTargetIndex);
+		}
+		if ((iCluster == iTargetCluster) && (vGoalCosts[iSlot] != NO_EDGE))
+			Relax(uiCurrentIndex, uiTargetIndex, vGoalCosts[iSlot], uiTargetIndex);
+	}
+	if (!bFound)
+		return false;
+
+	// Collect the abstract path from the start to the target
+	vAbstractPath.clear();
+	for (unsigned int uiIndex = uiTargetIndex; uiIndex != uiStartIndex; uiIndex = cSearchContext.m_nodes[uiIndex].uiParent)
+		vAbstractPath.push_back(uiIndex);
+	vAbstractPath.push_back(uiStartIndex);
+
+	// Fill in the tiles between each pair of abstract nodes
+	for (unsigned int i = (unsigned int)vAbstractPath.size() - 1; i > 0; i--)
+	{
+		const unsigned int uiFromIndex = vAbstractPath[i];
+		const unsigned int uiToIndex = vAbstractPath[i - 1];
+		const int iCluster = GetCluster(uiFromIndex);
+		if (iCluster != GetCluster(uiToIndex))
+		{
+			vPath.push_back(glm::vec2(uiToIndex % iNumCols, uiToIndex / iNumCols));
+			continue;
+		}
+
+		SearchCluster(uiToIndex, iCluster);
+		for (unsigned int uiIndex = uiFromIndex; uiIndex != uiToIndex; )
+		{
+			uiIndex = vLocalParents[uiIndex];
+			vPath.push_back(glm::vec2(uiIndex % iNumCols, uiIndex / iNumCols));
+		}
+	}
+	return true;
+}
+
+/**
+ @brief Get the number of abstract nodes which the last search expanded
+ */
+unsigned int CHierarchicalMap::GetNumExpanded(void) const
+{
+	return cSearchContext.uiNumExpanded;
+}
+
+/**
+ @brief Get the number of clusters which the last update built
+ */
+unsigned int CHierarchicalMap::GetNumRebuilt(void) const
+{
+	return uiNumRebuilt;
+}
+
+/**
+ @brief Check if a tile is inside the level and not solid
+ */
+bool CHierarchicalMap::IsWalkable(const int iCol, const int iRow) const
+{
+	if ((iCol < 0) || (iCol >= iNumCols) || (iRow < 0) || (iRow >= iNumRows))
+		return false;
+
+	return !TileProperties::IsSolid(arrTiles[iRow * iNumCols + iCol]);
+}
+
+/**
+ @brief Get the cluster which a tile is in
+ */
+int CHierarchicalMap::GetCluster(const unsigned int uiIndex) const
+{
+	const int iCol = (int)(uiIndex % iNumCols);
+	const int iRow = (int)(uiIndex / iNumCols);
+	return (iRow / iClusterSize) * iNumClusterCols + (iCol / iClusterSize);
+}
+
+/**
+ @brief Find the entrances on one border of a cluster. Each run of tiles which can be crossed
+		gets one entrance in its middle, or one at each end if it is long
+ @param vBorderEntrances A vector& variable which the entrances are added to
+ @param iFromCol A const int variable containing the column of the first tile of the border, inside the cluster
+ @param iFromRow A const int variable containing the row of the first tile of the border, inside the cluster
+ @param iStepCol A const int variable containing the column step along the border
+ @param iStepRow A const int variable containing the row step along the border
+ @param iCrossCol A const int variable containing the column step across the border
+ @param iCrossRow A const int variable containing the row step across the border
+ @param iLength A const int variable containing the number of tiles along the border
+ */
+void CHierarchicalMap::AddBorderEntrances(	std::vector<std::pair<unsigned int, unsigned int> >& vBorderEntrances,
+											const int iFromCol, const int iFromRow,
+											const int iStepCol, const int iStepRow,
+											const int iCrossCol, const int iCrossRow,
+											const int iLength)
+{
+	int iRunStart = -1;
+	for (int i = 0; i <= iLength; i++)
+	{
+		const int iCol = iFromCol + iStepCol * i;
+		const int iRow = iFromRow + iStepRow * i;
+		const bool bOpen = (i < iLength) &&
+			IsWalkable(iCol, iRow) && IsWalkable(iCol + iCrossCol, iRow + iCrossRow);
+
+		if (bOpen && (iRunStart < 0))
+		{
+			iRunStart = i;
+		}
+		else if (!bOpen && (iRunStart >= 0))
+		{
+			const int iRunEnd = i - 1;
+			if (iRunEnd - iRunStart + 1 >= MIN_DOUBLE_ENTRANCE_LENGTH)
+			{
+				const int arrEnds[2] = { iRunStart, iRunEnd };
+				for (int j = 0; j < 2; j++)
+				{
+					const int iEndCol = iFromCol + iStepCol * arrEnds[j];
+					const int iEndRow = iFromRow + iStepRow * arrEnds[j];
+					vBorderEntrances.push_back(make_pair(	iEndRow * iNumCols + iEndCol,
+															(iEndRow + iCrossRow) * iNumCols + iEndCol + iCrossCol));
+				}
+			}
+			else
+			{
+				const int iMiddle = (iRunStart + iRunEnd) / 2;
+				const int iMiddleCol = iFromCol + iStepCol * iMiddle;
+				const int iMiddleRow = iFromRow + iStepRow * iMiddle;
+				vBorderEntrances.push_back(make_pair(	iMiddleRow * iNumCols + iMiddleCol,
+														(iMiddleRow + iCrossRow) * iNumCols + iMiddleCol + iCrossCol));
+			}
+			iRunStart = -1;
+		}
+	}
+
+	if (uiNumDirections != 8)
+		return;
+
+	// Diagonal moves can cross the border where no straight move can
+	for (int i = 0; i + 1 < iLength; i++)
+	{
+		const int iCol = iFromCol + iStepCol * i;
+		const int iRow = iFromRow + iStepRow * i;
+		const int iNextCol = iCol + iStepCol;
+		const int iNextRow = iRow + iStepRow;
+		if ((IsWalkable(iCol, iRow) && IsWalkable(iCol + iCrossCol, iRow + iCrossRow)) ||
+			(IsWalkable(iNextCol, iNextRow) && IsWalkable(iNextCol + iCrossCol, iNextRow + iCrossRow)))
+			continue;
+
+		if (IsWalkable(iCol, iRow) && IsWalkable(iNextCol + iCrossCol, iNextRow + iCrossRow))
+			vBorderEntrances.push_back(make_pair(	iRow * iNumCols + iCol,
+													(iNextRow + iCrossRow) * iNumCols + iNextCol + iCrossCol));
+		if (IsWalkable(iNextCol, iNextRow) && IsWalkable(iCol + iCrossCol, iRow + iCrossRow))
+			vBorderEntrances.push_back(make_pair(	iNextRow * iNumCols + iNextCol,
+													(iRow + iCrossRow) * iNumCols + iCol + iCrossCol));
+	}
+}
+
+/**
+ @brief Find the entrances on the borders which a cluster owns, which are the borders to its
+		right and above it, and with diagonal movements, its top right and bottom right corners
+ @param iCluster A const int variable containing the cluster
+ */
+void CHierarchicalMap::BuildEntrances(const int iCluster)
+{
+	vector<pair<unsigned int, unsigned int> >& vClusterEntrances = vEntrances[iCluster];
+	vClusterEntrances.clear();
+
+	const int iClusterCol = iCluster % iNumClusterCols;
+	const int iClusterRow = iCluster / iNumClusterCols;
+	const int iMinCol = iClusterCol * iClusterSize;
+	const int iMinRow = iClusterRow * iClusterSize;
+	const int iMaxCol = ((iMinCol + iClusterSize < iNumCols) ? iMinCol + iClusterSize : iNumCols) - 1;
+	const int iMaxRow = ((iMinRow + iClusterSize < iNumRows) ? iMinRow + iClusterSize : iNumRows) - 1;
+
+	if (iClusterCol + 1 < iNumClusterCols)
+		AddBorderEntrances(vClusterEntrances, iMaxCol, iMinRow, 0, 1, 1, 0, iMaxRow - iMinRow + 1);
+	if (iClusterRow + 1 < iNumClusterRows)
+		AddBorderEntrances(vClusterEntrances, iMinCol, iMaxRow, 1, 0, 0, 1, iMaxCol - iMinCol + 1);
+
+	if (uiNumDirections != 8)
+		return;
+
+	// The corners, where a diagonal move is the only way into the cluster across it
+	if (IsWalkable(iMaxCol, iMaxRow) && IsWalkable(iMaxCol + 1, iMaxRow + 1))
+		vClusterEntrances.push_back(make_pair(iMaxRow * iNumCols + iMaxCol, (iMaxRow + 1) * iNumCols + iMaxCol + 1));
+	if (IsWalkable(iMaxCol, iMinRow) && IsWalkable(iMaxCol + 1, iMinRow - 1))
+		vClusterEntrances.push_back(make_pair(iMinRow * iNumCols + iMaxCol, (iMinRow - 1) * iNumCols + iMaxCol + 1));
+}
+
+/**
+ @brief Collect the entrances of a cluster from the borders around it, and find the costs of
+		the shortest paths between them inside the cluster
+ @param iCluster A const int variable containing the cluster
+ */
+void CHierarchicalMap::BuildCluster(const int iCluster)
+{
+	Cluster& sCluster = vClusters[iCluster];
+	for (unsigned int i = 0; i < sCluster.vNodes.size(); i++)
+		vNodeSlots[sCluster.vNodes[i]] = -1;
+	sCluster.vNodes.clear();
+	sCluster.vLinks.clear();
+
+	// The borders of this cluster are owned by itself and the clusters to its left and below
+	const int iClusterCol = iCluster % iNumClusterCols;
+	const int iClusterRow = iCluster / iNumClusterCols;
+	for (int iOffsetRow = -1; iOffsetRow <= 1; iOffsetRow++)
+	{
+		for (int iOffsetCol = -1; iOffsetCol <= 0; iOffsetCol++)
+		{
+			if ((iOffsetCol == 0) && (iOffsetRow > 0))
+				continue;
+			const int iCol = iClusterCol + iOffsetCol;
+			const int iRow = iClusterRow + iOffsetRow;
+			if ((iCol < 0) || (iRow < 0) || (iRow >= iNumClusterRows))
+				continue;
+
+			const vector<pair<unsigned int, unsigned int> >& vOwnerEntrances = vEntrances[iRow * iNumClusterCols + iCol];
+			for (unsigned int i = 0; i < vOwnerEntrances.size(); i++)
+			{
+				// Take the end of each entrance which is inside this cluster
+				unsigned int uiNode, uiLink;
+				if (GetCluster(vOwnerEntrances[i].first) == iCluster)
+				{
+					uiNode = vOwnerEntrances[i].first;
+					uiLink = vOwnerEntrances[i].second;
+				}
+				else if (GetCluster(vOwnerEntrances[i].second) == iCluster)
+				{
+					uiNode = vOwnerEntrances[i].second;
+					uiLink = vOwnerEntrances[i].first;
+				}
+				else
+					continue;
+
+				if (vNodeSlots[uiNode] < 0)
+				{
+					vNodeSlots[uiNode] = (int)sCluster.vNodes.size();
+					sCluster.vNodes.push_back(uiNode);
+					sCluster.vLinks.push_back(vector<unsigned int>());
+				}
+				sCluster.vLinks[vNodeSlots[uiNode]].push_back(uiLink);
+			}
+		}
+	}
+
+	// Find the costs between every pair of entrances
+	const unsigned int uiNumNodes = (unsigned int)sCluster.vNodes.size();
+	sCluster.vCosts.assign(uiNumNodes * uiNumNodes, NO_EDGE);
+	for (unsigned int i = 0; i < uiNumNodes; i++)
+	{
+		SearchCluster(sCluster.vNodes[i], iCluster);
+		for (unsigned int j = 0; j < uiNumNodes; j++)
+		{
+			sCluster.vCosts[i * uiNumNodes + j] = GetLocalDistance(sCluster.vNodes[j]);
+		}
+	}
+}
+
+/**
+ @brief Search a cluster outwards from a tile with a breadth-first search, without leaving the
+		cluster. Afterwards, each reached tile's parent is the next tile towards uiFromIndex
+ @param uiFromIndex A const unsigned int variable containing the 1D position of the tile
+ @param iCluster A const int variable containing the cluster
+ */
+void CHierarchicalMap::SearchCluster(const unsigned int uiFromIndex, const int iCluster)
+{
+	// Starting a new search invalidates the distances of the previous one
+	if (++uiLocalGeneration == 0)
+	{
+		vLocalGenerations.assign(vLocalGenerations.size(), 0);
+		uiLocalGeneration = 1;
+	}
+
+	const int iMinCol = (iCluster % iNumClusterCols) * iClusterSize;
+	const int iMinRow = (iCluster / iNumClusterCols) * iClusterSize;
+	const int iMaxCol = (iMinCol + iClusterSize < iNumCols) ? iMinCol + iClusterSize : iNumCols;
+	const int iMaxRow = (iMinRow + iClusterSize < iNumRows) ? iMinRow + iClusterSize : iNumRows;
+
+	static const int DIRECTIONS[8][2] = {
+		{ -1, 0 }, { 1, 0 }, { 0, 1 }, { 0, -1 },
+		{ -1, -1 }, { 1, 1 }, { -1, 1 }, { 1, -1 } };
+
+	unsigned int uiHead = 0, uiTail = 0;
+	vLocalGenerations[uiFromIndex] = uiLocalGeneration;
+	vLocalDistances[uiFromIndex] = 0;
+	vLocalParents[uiFromIndex] = uiFromIndex;
+	vLocalQueue[uiTail++] = uiFromIndex;
+	while (uiHead < uiTail)
+	{
+		const unsigned int uiCurrentIndex = vLocalQueue[uiHead++];
+		const int iCurrentCol = (int)(uiCurrentIndex % iNumCols);
+		const int iCurrentRow = (int)(uiCurrentIndex / iNumCols);
+
+		for (unsigned int i = 0; i < uiNumDirections; i++)
+		{
+			const int iCol = iCurrentCol + DIRECTIONS[i][0];
+			const int iRow = iCurrentRow + DIRECTIONS[i][1];
+			if ((iCol < iMinCol) || (iCol >= iMaxCol) || (iRow < iMinRow) || (iRow >= iMaxRow) ||
+				!IsWalkable(iCol, iRow))
+				continue;
+
+			const unsigned int uiNeighborIndex = iRow * iNumCols + iCol;
+			if (vLocalGenerations[uiNeighborIndex] == uiLocalGeneration)
+				continue;
+
+			vLocalGenerations[uiNeighborIndex] = uiLocalGeneration;
+			vLocalDistances[uiNeighborIndex] = vLocalDistances[uiCurrentIndex] + 1;
+			vLocalParents[uiNeighborIndex] = uiCurrentIndex;
+			vLocalQueue[uiTail++] = uiNeighborIndex;
+		}
+	}
+}
+
+/**
+ @brief Get the distance to a tile from the last SearchCluster(), or NO_EDGE if it was not reached
+ */
+unsigned int CHierarchicalMap::GetLocalDistance(const unsigned int uiIndex) const
+{
+	if (vLocalGenerations[uiIndex] != uiLocalGeneration)
+		return NO_EDGE;
+	return vLocalDistances[uiIndex];
+}
+
+/**
+ @brief Estimate the cost between two tiles. Every step costs 1, including diagonal ones,
+		so the estimate never exceeds the real cost
+ */
+unsigned int CHierarchicalMap::GetHeuristic(const unsigned int uiFromIndex, const unsigned int uiToIndex) const
+{
+	const int iDistX = abs((int)(uiFromIndex % iNumCols) - (int)(uiToIndex % iNumCols));
+	const int iDistY = abs((int)(uiFromIndex / iNumCols) - (int)(uiToIndex / iNumCols));
+	if (uiNumDirections == 8)
+		return (iDistX > iDistY) ? iDistX : iDistY;
+	return iDistX + iDistY;
+}
+
+/**
+ @brief Add an edge to the open list of the abstract search, if it improves the cost of its end
+ */
+void CHierarchicalMap::Relax(	const unsigned int uiFromIndex, const unsigned int uiToIndex,
+								const unsigned int uiCost, const unsigned int uiTargetIndex)
+{
+	const unsigned int gNew = cSearchContext.m_nodes[uiFromIndex].g + uiCost;
+	AStarNode& sNode = cSearchContext.GetNode(uiToIndex);
+	if (sNode.bClosed)
+		return;
+
+	const unsigned int fNew = gNew + GetHeuristic(uiToIndex, uiTargetIndex);
+	if ((sNode.f == 0) || (fNew < sNode.f))
+	{
+		sNode.uiParent = uiFromIndex;
+		sNode.g = gNew;
+		sNode.f = fNew;
+		cSearchContext.PushOpen(fNew, uiToIndex);
+	}
+}
@@ -0,0 +1,132 @@
+/**
+ CHierarchicalMap
+ @brief A class which finds long paths on the tiles of a level with Hierarchical Path Finding
+		(HPA*). The level is split into square clusters. The tiles where a path can cross
+		from one cluster into the next are the entrances. The shortest paths between the
+		entrances of each cluster are found in advance, which forms a small abstract graph.
+		A path is planned over the abstract graph first, and then filled in one cluster at a
+		time, so the cost of a query grows with the number of clusters crossed rather than
+		the number of tiles in the level.
+
+		Each cluster remembers the version at which it was built, so when tiles change, only
+		the clusters which changed and their neighbours are built again.
+		Positions are (column, row), where row 0 is the bottom row. Tiles are solid when
+		TileProperties::IsSolid() says so. The searches use scratch data stored in this class, so only
+		one thread can use an instance at a time.
+ */
+#pragma once
+
+// Include AStarContext
+#include "AStarContext.h"
+
+#include <vector>
+#include <utility>
+
+class CHierarchicalMap
+{
+public:
+	// The cost of a pair of entrances which cannot reach each other
+	static const unsigned int NO_EDGE = 0xFFFFFFFF;
+
+	// Constructor
+	CHierarchicalMap(void);
+
+	// Destructor
+	virtual ~CHierarchicalMap(void);
+
+	// Bring the abstract graph up to date with the tiles of a level
+	void Update(const unsigned short* arrTiles,
+				const unsigned int uiNumRows,
+				const unsigned int uiNumCols,
+				const unsigned int uiClusterSize,
+				const unsigned int uiNumDirections,
+				const unsigned int uiLevel,
+				const unsigned int* arrClusterVersions);
+
+	// Find a path
+	bool FindPath(	const glm::vec2& startPos,
+					const glm::vec2& targetPos,
+					std::vector<glm::vec2>& vPath);
+
+	// Get the number of abstract nodes which the last search expanded
+	unsigned int GetNumExpanded(void) const;
+	// Get the number of clusters which the last update built
+	unsigned int GetNumRebuilt(void) const;
+
+protected:
+	// The entrances of a cluster, and the costs of the shortest paths between them
+	struct Cluster
+	{
+		// The 1D positions of the entrance tiles
+		std::vector<unsigned int> vNodes;
+		// The cost between each pair of entrances, indexed by [from * vNodes.size() + to]
+		std::vector<unsigned int> vCosts;
+		// The tiles in the neighbouring clusters which each entrance leads to
+		std::vector<std::vector<unsigned int> > vLinks;
+	};
+
+	// The tiles of the level
+	const unsigned short* arrTiles;
+	int iNumRows;
+	int iNumCols;
+	int iClusterSize;
+	int iNumClusterRows;
+	int iNumClusterCols;
+	unsigned int uiNumDirections;
+
+	// What the abstract graph was built for
+	bool bBuilt;
+	unsigned int uiLevel;
+	std::vector<unsigned int> vClusterVersions;
+	unsigned int uiNumRebuilt;
+
+	// The entrances on the borders to the right of and above each cluster, and on its two right
+	// corners, as pairs of a tile in the cluster and the tile in the other cluster it leads to
+	std::vector<std::vector<std::pair<unsigned int, unsigned int> > > vEntrances;
+	// Flags for the clusters whose entrances or costs need to be built again
+	std::vector<unsigned char> vRebuildFlags;
+	// The entrances and costs of each cluster
+	std::vector<Cluster> vClusters;
+	// The slot of each tile in its cluster's entrance list, or -1 if it is not an entrance
+	std::vector<int> vNodeSlots;
+
+	// Scratch data for the breadth-first searches inside a cluster
+	unsigned int uiLocalGeneration;
+	std::vector<unsigned int> vLocalGenerations;
+	std::vector<unsigned int> vLocalDistances;
+	std::vector<unsigned int> vLocalParents;
+	std::vector<unsigned int> vLocalQueue;
+
+	// Scratch data for the search over the abstract graph
+	AStarContext cSearchContext;
+	std::vector<std::pair<unsigned int, unsigned int> > vStartEdges;
+	std::vector<unsigned int> vGoalCosts;
+	std::vector<unsigned int> vAbstractPath;
+
+	// Check if a tile is inside the level and not solid
+	bool IsWalkable(const int iCol, const int iRow) const;
+	// Get the cluster which a tile is in
+	int GetCluster(const unsigned int uiIndex) const;
+
+	// Find the entrances on one border of a cluster
+	void AddBorderEntrances(std::vector<std::pair<unsigned int, unsigned int> >& vBorderEntrances,
+							const int iFromCol, const int iFromRow,
+							const int iStepCol, const int iStepRow,
+							const int iCrossCol, const int iCrossRow,
+							const int iLength);
+	// Find the entrances on the borders which a cluster owns
+	void BuildEntrances(const int iCluster);
+	// Collect the entrances of a cluster and find the costs between them
+	void BuildCluster(const int iCluster);
+
+	// Search a cluster outwards from a tile, without leaving the cluster
+	void SearchCluster(const unsigned int uiFromIndex, const int iCluster);
+	// Get the distance to a tile from the last SearchCluster(), or NO_EDGE if it was not reached
+	unsigned int GetLocalDistance(const unsigned int uiIndex) const;
+
+	// Estimate the cost between two tiles
+	unsigned int GetHeuristic(const unsigned int uiFromIndex, const unsigned int uiToIndex) const;
+	// Add an edge to the open list of the abstract search
+	void Relax(const unsigned int uiFromIndex, const unsigned int uiToIndex,
+			   const unsigned int uiCost, const unsigned int uiTargetIndex);
+};
@@ -0,0 +1,139 @@
+/**
+ CLockFreeQueue
+ @brief A bounded queue which many threads can push to and pop from without a lock.
+		Each cell of the ring has a sequence number, which tells a thread whether the cell
+		is free to be written or holds an item to be read, so a thread only has to claim a
+		position with one compare-and-swap. Items are swapped in and out of the cells, so
+		the memory held by an item, like the buffer of a vector, is reused by later items.
+		The capacity is rounded up to a power of 2.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+template <typename T>
+class CLockFreeQueue
+{
+public:
+	// Constructor
+	explicit CLockFreeQueue(const unsigned int uiMinCapacity)
+		: arrCells(NULL)
+		, uiMask(0)
+		, uiEnqueuePos(0)
+		, uiDequeuePos(0)
+	{
+		size_t uiCapacity = 2;
+		while (uiCapacity < uiMinCapacity)
+			uiCapacity *= 2;
+
+		arrCells = new Cell[uiCapacity];
+		for (size_t i = 0; i < uiCapacity; i++)
+			arrCells[i].uiSequence.store(i, std::memory_order_relaxed);
+		uiMask = uiCapacity - 1;
+	}
+
+	// Destructor
+	virtual ~CLockFreeQueue(void)
+	{
+		delete[] arrCells;
+	}
+
+	/**
+	 @brief Push an item to the back of the queue. The item is swapped into the queue, so
+			it is left holding an older item from the same cell
+	 @param item A T& variable containing the item to push
+	 @return false if the queue is full, and the item is not changed
+	 */
+	bool Push(T& item)
+	{
+		Cell* pCell = NULL;
+		size_t uiPos = uiEnqueuePos.load(std::memory_order_relaxed);
+		while (true)
+		{
+			pCell = &arrCells[uiPos & uiMask];
+			const size_t uiSequence = pCell->uiSequence.load(std::memory_order_acquire);
+			const ptrdiff_t iDiff = (ptrdiff_t)uiSequence - (ptrdiff_t)uiPos;
+			if (iDiff == 0)
+			{
+				// The cell is free, so try to claim its position
+				if (uiEnqueuePos.compare_exchange_weak(uiPos, uiPos + 1, std::memory_order_relaxed))
+					break;
+			}
+			else if (iDiff < 0)
+			{
+				// The cell still holds an item from one lap ago
+				return false;
+			}
+			else
+			{
+				// Another thread has claimed this position
+				uiPos = uiEnqueuePos.load(std::memory_order_relaxed);
+			}
+		}
+
+		std::swap(pCell->item, item);
+		pCell->uiSequence.store(uiPos + 1, std::memory_order_release);
+		return true;
+	}
+
+	/**
+	 @brief Pop an item from the front of the queue
+	 @param item A T& variable which will store the item
+	 @return false if the queue is empty, and the item is not changed
+	 */
+	bool Pop(T& item)
+	{
+		Cell* pCell = NULL;
+		size_t uiPos = uiDequeuePos.load(std::memory_order_relaxed);
+		while (true)
+		{
+			pCell = &arrCells[uiPos & uiMask];
+			const size_t uiSequence = pCell->uiSequence.load(std::memory_order_acquire);
+			const ptrdiff_t iDiff = (ptrdiff_t)uiSequence - (ptrdiff_t)(uiPos + 1);
+			if (iDiff == 0)
+			{
+				// The cell holds an item, so try to claim its position
+				if (uiDequeuePos.compare_exchange_weak(uiPos, uiPos + 1, std::memory_order_relaxed))
+					break;
+			}
+			else if (iDiff < 0)
+			{
+				// The cell has not been written yet
+				return false;
+			}
+			else
+			{
+				// Another thread has claimed this position
+				uiPos = uiDequeuePos.load(std::memory_order_relaxed);
+			}
+		}
+
+		std::swap(pCell->item, item);
+		// Free the cell for the push one lap later
+		pCell->uiSequence.store(uiPos + uiMask + 1, std::memory_order_release);
+		return true;
+	}
+
+protected:
+	// A cell of the ring
+	struct Cell
+	{
+		std::atomic<size_t> uiSequence;
+		T item;
+	};
+
+	// The ring of cells
+	Cell* arrCells;
+	size_t uiMask;
+
+	// The positions of the next push and the next pop
+	std::atomic<size_t> uiEnqueuePos;
+	std::atomic<size_t> uiDequeuePos;
+
+private:
+	// The queue cannot be copied
+	CLockFreeQueue(const CLockFreeQueue&);
+	CLockFreeQueue& operator=(const CLockFreeQueue&);
+};
@@ -13,22 +13,41 @@
 #include "System\filesystem.h"
 // Include ImageLoader
 #include "System\ImageLoader.h"
+// Include MappedFile and the binary level format
+#include "System\MappedFile.h"
+#include "System\LevelFormat.h"
 #include "Primitives/MeshBuilder.h"
 
 #include <iostream>
 #include <vector>
+#include <cstring>
+#include <ctime>
 using namespace std;
 
-// For AStar PathFinding
-using namespace std::placeholders;
-
 /**
  @brief Constructor This constructor has protected access modifier as this class will be a Singleton
  */
 CMap2D::CMap2D(void)
 	: uiCurLevel(0)
-	, quadMesh(NULL)
+	, arrValueIndices(NULL)
+	, arrSpawnIndices(NULL)
+	, arrRegions(NULL)
+	, arrSolidBoards(NULL)
+	, uiTileTextureArrayID(0)
+	, uiNumChunkRows(0)
+	, uiNumChunkCols(0)
+	, arrMapVersions(NULL)
+	, arrChunkVersions(NULL)
+	, uiLineOfSightFrame(1)
+	, arrTileMapRenderers(NULL)
+	, arrTileMapVersions(NULL)
+	, uiPreparedLevel(0)
+	, arrPreparedTiles(NULL)
+	, uiPreparedNumDirections(4)
+	, bLevelPrepared(false)
 {
+	// Frame 0 is never current, so every entry starts empty
+	memset(arrLineOfSightCache, 0, sizeof(arrLineOfSightCache));
 }
 
 /**
@@ -36,25 +55,38 @@ CMap2D::CMap2D(void)
  */
 CMap2D::~CMap2D(void)
 {
-	// Delete AStar lists
-	DeleteAStarLists();
+	// Stop preparing a level, since it will never be used
+	CancelPreparedLevel();
 
-	// Dynamically deallocate the 3D array used to store the map information
+	// Dynamically deallocate the arrays used to store the map information
 	for (unsigned int uiLevel = 0; uiLevel < uiNumLevels; uiLevel++)
 	{
-		for (unsigned int iRow = 0; iRow < cSettings->NUM_TILES_YAXIS; iRow++)
-		{
-			delete[] arrMapInfo[uiLevel][iRow];
-		}
-		delete [] arrMapInfo[uiLevel];
+		delete[] arrMapInfo[uiLevel];
 	}
 	delete[] arrMapInfo;
+	delete[] arrValueIndices;
+	delete[] arrSpawnIndices;
+	delete[] arrRegions;
+	delete[] arrSolidBoards;
+
+	// Delete the batched tile renderers
+	for (unsigned int uiLevel = 0; uiLevel < uiNumLevels; uiLevel++)
+	{
+		delete arrTileMapRenderers[uiLevel];
+	}
+	delete[] arrTileMapRenderers;
+	delete[] arrTileMapVersions;
 
-	if (quadMesh)
+	// Delete the change tracking arrays
+	for (unsigned int uiLevel = 0; uiLevel < uiNumLevels; uiLevel++)
 	{
-		delete quadMesh;
-		quadMesh = NULL;
+		delete[] arrChunkVersions[uiLevel];
 	}
+	delete[] arrChunkVersions;
+	delete[] arrMapVersions;
+
+	// Delete the tile texture array
+	glDeleteTextures(1, &uiTileTextureArrayID);
 
 	// optional: de-allocate all resources once they've outlived their purpose:
 	glDeleteVertexArrays(1, &VAO);
@@ -76,393 +108,129 @@ bool CMap2D::Init(	const unsigned int uiNumLevels,
 	cSettings = CSettings::GetInstance();
 
 	// Create the arrMapInfo and initialise to 0
-	// Start by initialising the number of levels
-	arrMapInfo = new Grid** [uiNumLevels];
+	// Each level is a single contiguous array of tile values
+	arrMapInfo = new unsigned short* [uiNumLevels];
 	for (unsigned uiLevel = 0; uiLevel < uiNumLevels; uiLevel++)
 	{
-		arrMapInfo[uiLevel] = new Grid* [uiNumRows];
-		for (unsigned uiRow = 0; uiRow < uiNumRows; uiRow++)
-		{
-			arrMapInfo[uiLevel][uiRow] = new Grid[uiNumCols];
-			for (unsigned uiCol = 0; uiCol < uiNumCols; uiCol++)
-			{
-				arrMapInfo[uiLevel][uiRow][uiCol].value = 0;
-			}
-		}
-	}
-
-	// Store the map sizes in cSettings
-	uiCurLevel = 0;
-	this->uiNumLevels = uiNumLevels;
-	cSettings->NUM_TILES_XAXIS = uiNumCols;
-	cSettings->NUM_TILES_YAXIS = uiNumRows;
-	cSettings->UpdateSpecifications();
-
-	glGenVertexArrays(1, &VAO);
-	glBindVertexArray(VAO);
-
-	//CS: Create the Quad Mesh using the mesh builder
-	quadMesh = CMeshBuilder::GenerateQuad(glm::vec4(1, 1, 1, 1), cSettings->TILE_WIDTH, cSettings->TILE_HEIGHT);
-
-	// Load and create textures
-	// Load the ground texture
-	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/dirtblock.png", true);
-	if (iTextureID == 0)
-	{
-		cout << "Unable to load Image/Scene2D_GroundTile.tga" << endl;
-		return false;
-	}
-	else
-	{
-		// Store the texture ID into MapOfTextureIDs
-		MapOfTextureIDs.insert(pair<int, int>(100, iTextureID));
-	}
-	// Load the health potion texture
-	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Big_red.tga", true);
-	if (iTextureID == 0)
-	{
-		cout << "Unable to load Image/Big_red.tga" << endl;
-		return false;
-	}
-	else
-	{
-		// Store the texture ID into MapOfTextureIDs
-		MapOfTextureIDs.insert(pair<int, int>(2, iTextureID));
-	}
-	// Load the speed potion texture
-	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Big_yellow.tga", true);
-	if (iTextureID == 0)
-	{
-		cout << "Unable to load Image/Big_yellow.tga" << endl;
-		return false;
-	}
-	else
-	{
-		// Store the texture ID into MapOfTextureIDs
-		MapOfTextureIDs.insert(pair<int, int>(3, iTextureID));
-	}
-	// Load the strength potion texture
-	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Big_green.tga", true);
-	if (iTextureID == 0)
-	{
-		cout << "Unable to load Image/Big_green.tga" << endl;
-		return false;
-	}
-	else
-	{
-		// Store the texture ID into MapOfTextureIDs
-		MapOfTextureIDs.insert(pair<int, int>(4, iTextureID));
-	}
-	// Load the jump potion texture
-	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Big_blue.tga", true);
-	if (iTextureID == 0)
-	{
-		cout << "Unable to load Image/Big_blue.tga" << endl;
-		return false;
-	}
-	else
-	{
-		// Store the texture ID into MapOfTextureIDs
-		MapOfTextureIDs.insert(pair<int, int>(5, iTextureID));
-	}
-	// Load the Life texture
-	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Scene2D_Lives.tga", true);
-	if (iTextureID == 0)
-	{
-		cout << "Unable to load Image/Scene2D_Lives.tga" << endl;
-		return false;
-	}
-	else
-	{
-		// Store the texture ID into MapOfTextureIDs
-		MapOfTextureIDs.insert(pair<int, int>(10, iTextureID));
-	}
-	// Load the spike texture
-	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Scene2D_Spikes.tga", true);
-	if (iTextureID == 0)
-	{
-		cout << "Unable to load Image/Scene2D_Spikes.tga" << endl;
-		return false;
-	}
-	else
-	{
-		// Store the texture ID into MapOfTextureIDs
-		MapOfTextureIDs.insert(pair<int, int>(20, iTextureID));
-	}
-	// Load the Spa texture
-	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Scene2D_Spa.tga", true);
-	if (iTextureID == 0)
-	{
-		cout << "Unable to load Image/Scene2D_Spa.tga" << endl;
-		return false;
-	}
-	else
-	{
-		// Store the texture ID into MapOfTextureIDs
-		MapOfTextureIDs.insert(pair<int, int>(21, iTextureID));
-	}
-	// Load the sword texture
-	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/sword.tga", true);
-	if (iTextureID == 0)
-	{
-		cout << "Unable to load Image/sword.tga" << endl;
-		return false;
-	}
-	else
-	{
-		// Store the texture ID into MapOfTextureIDs
-		MapOfTextureIDs.insert(pair<int, int>(30, iTextureID));
-	}
-	// Load the spear texture
-	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/spear.tga", true);
-	if (iTextureID == 0)
-	{
-		cout << "Unable to load Image/spear.tga" << endl;
-		return false;
-	}
-	else
-	{
-		// Store the texture ID into MapOfTextureIDs
-		MapOfTextureIDs.insert(pair<int, int>(31, iTextureID));
-	}
-	// Load the bow texture
-	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/bow.tga", true);
-	if (iTextureID == 0)
-	{
-		cout << "Unable to load Image/bow.tga" << endl;
-		return false;
-	}
-	else
-	{
-		// Store the texture ID into MapOfTextureIDs
-		MapOfTextureIDs.insert(pair<int, int>(32, iTextureID));
-	}
-	// Load the axe texture
-	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/axe.tga", true);
-	if (iTextureID == 0)
-	{
-		cout << "Unable to load Image/axe.tga" << endl;
-		return false;
-	}
-	else
-	{
-		// Store the texture ID into MapOfTextureIDs
-		MapOfTextureIDs.insert(pair<int, int>(33, iTextureID));
-	}
-	// Load the shovel texture
-	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/shovel.tga", true);
-	if (iTextureID == 0)
-	{
-		cout << "Unable to load Image/shovel.tga" << endl;
-		return false;
-	}
-	else
-	{
-		// Store the texture ID into MapOfTextureIDs
-		MapOfTextureIDs.insert(pair<int, int>(40, iTextureID));
-	}
-	// Load the helmet texture
-	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/helmet.tga", true);
-	if (iTextureID == 0)
-	{
-		cout << "Unable to load Image/helmet.tga" << endl;
-		return false;
-	}
-	else
-	{
-		// Store the texture ID into MapOfTextureIDs
-		MapOfTextureIDs.insert(pair<int, int>(41, iTextureID));
-	}
-	// Load the chestplate texture
-	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/chestplate.tga", true);
-	if (iTextureID == 0)
-	{
-		cout << "Unable to load Image/chestplate.tga" << endl;
-		return false;
-	}
-	else
-	{
-		// Store the texture ID into MapOfTextureIDs
-		MapOfTextureIDs.insert(pair<int, int>(42, iTextureID));
-	}
-	// Load the leggings texture
-	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/leggings.tga", true);
-	if (iTextureID == 0)
-	{
-		cout << "Unable to load Image/leggings.tga" << endl;
-		return false;
-	}
-	else
-	{
-		// Store the texture ID into MapOfTextureIDs
-		MapOfTextureIDs.insert(pair<int, int>(43, iTextureID));
-	}
-	// Load the boots texture
-	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/boots.tga", true);
-	if (iTextureID == 0)
-	{
-		cout << "Unable to load Image/boots.tga" << endl;
-		return false;
-	}
-	else
-	{
-		// Store the texture ID into MapOfTextureIDs
-		MapOfTextureIDs.insert(pair<int, int>(44, iTextureID));
-	}
-	// Load the Exit texture
-	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Scene2D_Exit.tga", true);
-	if (iTextureID == 0)
-	{
-		cout << "Unable to load Image/Scene2D_Exit.tga" << endl;
-		return false;
-	}
-	else
-	{
-		// Store the texture ID into MapOfTextureIDs
-		MapOfTextureIDs.insert(pair<int, int>(99, iTextureID));
-	}
-	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/bedrock.png", true);
-	if (iTextureID == 0)
-	{
-		cout << "Unable to load Image/bedrock.png" << endl;
-		return false;
-	}
-	else
-	{
-		// Store the texture ID into MapOfTextureIDs
-		MapOfTextureIDs.insert(pair<int, int>(101, iTextureID));
-	}
-	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/dirtbroken1.png", true);
-	if (iTextureID == 0)
-	{
-		cout << "Unable to load Image/dirtbroken1.png" << endl;
-		return false;
-	}
-	else
-	{
-		// Store the texture ID into MapOfTextureIDs
-		MapOfTextureIDs.insert(pair<int, int>(102, iTextureID));
-	}
-	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/dirtbroken2.png", true);
-	if (iTextureID == 0)
-	{
-		cout << "Unable to load Image/dirtbroken2.png" << endl;
-		return false;
-	}
-	else
-	{
-		// Store the texture ID into MapOfTextureIDs
-		MapOfTextureIDs.insert(pair<int, int>(103, iTextureID));
-
-	}
-	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/tree.png", true);
-	if (iTextureID == 0)
-	{
-		cout << "Unable to load Image/tree.png" << endl;
-		return false;
-	}
-	else
-	{
-		// Store the texture ID into MapOfTextureIDs
-		MapOfTextureIDs.insert(pair<int, int>(106, iTextureID));
-
-	}
-	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/tree1.png", true);
-	if (iTextureID == 0)
-	{
-		cout << "Unable to load Image/tree1.png" << endl;
-		return false;
-	}
-	else
-	{
-		// Store the texture ID into MapOfTextureIDs
-		MapOfTextureIDs.insert(pair<int, int>(107, iTextureID));
-
+		arrMapInfo[uiLevel] = new unsigned short[uiNumRows * uiNumCols]();
 	}
-	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/tree2.png", true);
-	if (iTextureID == 0)
+	arrValueIndices = new CTileValueIndex[uiNumLevels];
+	for (unsigned uiLevel = 0; uiLevel < uiNumLevels; uiLevel++)
 	{
-		cout << "Unable to load Image/tree2.png" << endl;
-		return false;
+		arrValueIndices[uiLevel].Build(arrMapInfo[uiLevel], uiNumRows * uiNumCols);
 	}
-	else
+	arrSpawnIndices = new CSpawnCellIndex[uiNumLevels];
+	for (unsigned uiLevel = 0; uiLevel < uiNumLevels; uiLevel++)
 	{
-		// Store the texture ID into MapOfTextureIDs
-		MapOfTextureIDs.insert(pair<int, int>(108, iTextureID));
-
+		arrSpawnIndices[uiLevel].Build(arrMapInfo[uiLevel], uiNumRows, uiNumCols);
 	}
-	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/logs.png", true);
-	if (iTextureID == 0)
+	// The regions are built once the number of directions for AStar is set, below
+	arrRegions = new CConnectivityRegions[uiNumLevels];
+	arrSolidBoards = new CSolidBitboard[uiNumLevels];
+	for (unsigned uiLevel = 0; uiLevel < uiNumLevels; uiLevel++)
 	{
-		cout << "Unable to load Image/logs.png" << endl;
-		return false;
+		arrSolidBoards[uiLevel].Build(arrMapInfo[uiLevel], uiNumRows, uiNumCols);
 	}
-	else
-	{
-		// Store the texture ID into MapOfTextureIDs
-		MapOfTextureIDs.insert(pair<int, int>(75, iTextureID));
 
-	}
-	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/dirtpile.png", true);
-	if (iTextureID == 0)
-	{
-		cout << "Unable to load Image/dirtpile.png" << endl;
-		return false;
-	}
-	else
-	{
-		// Store the texture ID into MapOfTextureIDs
-		MapOfTextureIDs.insert(pair<int, int>(76, iTextureID));
+	// Store the map sizes in cSettings
+	uiCurLevel = 0;
+	this->uiNumLevels = uiNumLevels;
+	cSettings->NUM_TILES_XAXIS = uiNumCols;
+	cSettings->NUM_TILES_YAXIS = uiNumRows;
+	cSettings->UpdateSpecifications();
 
-	}
-	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/wood.png", true);
-	if (iTextureID == 0)
+	// Create the change tracking arrays. Every level and chunk starts at version 1,
+	// so that anything built from version 0 sees the whole level as changed
+	uiNumChunkRows = (uiNumRows + CHUNK_SIZE - 1) / CHUNK_SIZE;
+	uiNumChunkCols = (uiNumCols + CHUNK_SIZE - 1) / CHUNK_SIZE;
+	arrMapVersions = new unsigned int[uiNumLevels];
+	arrChunkVersions = new unsigned int* [uiNumLevels];
+	for (unsigned uiLevel = 0; uiLevel < uiNumLevels; uiLevel++)
 	{
-		cout << "Unable to load Image/wood.png" << endl;
-		return false;
+		arrMapVersions[uiLevel] = 1;
+		arrChunkVersions[uiLevel] = new unsigned int[uiNumChunkRows * uiNumChunkCols];
+		for (unsigned int i = 0; i < uiNumChunkRows * uiNumChunkCols; i++)
+		{
+			arrChunkVersions[uiLevel][i] = 1;
+		}
 	}
-	else
-	{
-		// Store the texture ID into MapOfTextureIDs
-		MapOfTextureIDs.insert(pair<int, int>(104, iTextureID));
 
-	}
-	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/chest.png", true);
-	if (iTextureID == 0)
+	// Create a batched tile renderer for each level
+	arrTileMapRenderers = new CTileMapRenderer* [uiNumLevels];
+	arrTileMapVersions = new unsigned int[uiNumLevels];
+	for (unsigned uiLevel = 0; uiLevel < uiNumLevels; uiLevel++)
 	{
-		cout << "Unable to load Image/chest.png" << endl;
+		arrTileMapRenderers[uiLevel] = new CTileMapRenderer();
+		arrTileMapRenderers[uiLevel]->Init(uiNumRows, uiNumCols);
+		arrTileMapVersions[uiLevel] = 0;
+	}
+
+	// Load the tile textures into the layers of one texture array
+	// Each tile value with an image is given a compact layer index
+	const struct {
+		int iValue;
+		const char* cFilename;
+	} arrTileTextures[] = {
+		{ 100, "Image/dirtblock.png" },	// Ground
+		{ 2, "Image/Big_red.tga" },	// Health potion
+		{ 3, "Image/Big_yellow.tga" },	// Speed potion
+		{ 4, "Image/Big_green.tga" },	// Strength potion
+		{ 5, "Image/Big_blue.tga" },	// Jump potion
+		{ 10, "Image/Scene2D_Lives.tga" },	// Life
+		{ 20, "Image/Scene2D_Spikes.tga" },	// Spikes
+		{ 21, "Image/Scene2D_Spa.tga" },	// Spa
+		{ 30, "Image/sword.tga" },	// Sword
+		{ 31, "Image/spear.tga" },	// Spear
+		{ 32, "Image/bow.tga" },	// Bow
+		{ 33, "Image/axe.tga" },	// Axe
+		{ 40, "Image/shovel.tga" },	// Shovel
+		{ 41, "Image/helmet.tga" },	// Helmet
+		{ 42, "Image/chestplate.tga" },	// Chestplate
+		{ 43, "Image/leggings.tga" },	// Leggings
+		{ 44, "Image/boots.tga" },	// Boots
+		{ 99, "Image/Scene2D_Exit.tga" },	// Exit
+		{ 101, "Image/bedrock.png" },	// Bedrock
+		{ 102, "Image/dirtbroken1.png" },	// Broken dirt
+		{ 103, "Image/dirtbroken2.png" },	// Broken dirt
+		{ 106, "Image/tree.png" },	// Tree
+		{ 107, "Image/tree1.png" },	// Damaged tree
+		{ 108, "Image/tree2.png" },	// Damaged tree
+		{ 75, "Image/logs.png" },	// Logs
+		{ 76, "Image/dirtpile.png" },	// Dirt pile
+		{ 104, "Image/wood.png" },	// Wood
+		{ 105, "Image/chest.png" },	// Chest
+	};
+	const unsigned int uiNumTileTextures = sizeof(arrTileTextures) / sizeof(arrTileTextures[0]);
+
+	std::vector<std::string> vTileFilenames;
+	for (unsigned int i = 0; i < uiNumTileTextures; i++)
+	{
+		vTileFilenames.push_back(arrTileTextures[i].cFilename);
+		// Store the layer index into vTileLayers, which is indexed by the tile value
+		if (arrTileTextures[i].iValue >= (int)vTileLayers.size())
+			vTileLayers.resize(arrTileTextures[i].iValue + 1, -1);
+		vTileLayers[arrTileTextures[i].iValue] = i;
+	}
+	uiTileTextureArrayID = CImageLoader::GetInstance()->LoadTextureArrayGetID(vTileFilenames, true);
+	if (uiTileTextureArrayID == 0)
+	{
+		cout << "Unable to load the tile textures" << endl;
 		return false;
 	}
-	else
-	{
-		// Store the texture ID into MapOfTextureIDs
-		MapOfTextureIDs.insert(pair<int, int>(105, iTextureID));
-
-	}
 
 	// Initialise the variables for AStar
-	m_weight = 1;
-	m_startPos = glm::vec2(0, 0);
-	m_targetPos = glm::vec2(0, 0);
-	//m_size = cSettings->NUM_TILES_YAXIS* cSettings->NUM_TILES_XAXIS;
-
 	m_nrOfDirections = 4;
-	m_directions = { { -1, 0 }, { 1, 0 }, { 0, 1 }, { 0, -1 },
-						{ -1, -1 }, { 1, 1 }, { -1, 1 }, { 1, -1 } };
-
-	// Resize these 2 lists
-	m_cameFromList.resize(cSettings->NUM_TILES_YAXIS * cSettings->NUM_TILES_XAXIS);
-	m_closedList.resize(cSettings->NUM_TILES_YAXIS * cSettings->NUM_TILES_XAXIS, false);
+	m_searchMode = SEARCH_ASTAR;
+	for (unsigned uiLevel = 0; uiLevel < uiNumLevels; uiLevel++)
+	{
+		arrRegions[uiLevel].Build(arrMapInfo[uiLevel], uiNumRows, uiNumCols, m_nrOfDirections);
+	}
 
 	//// Clear AStar memory
 	//ClearAStar();
 
-	validposition = false;
-	validposition1 = false;
-	xChest = 32;
-	yChest = 24;
-	xTree = 32;
-	yTree = 24;
+	// Seed the random number generator for spawning items
+	cRandom.seed((unsigned)time(NULL));
 
 	return true;
 }
@@ -473,6 +241,9 @@ bool CMap2D::Init(	const unsigned int uiNumLevels,
 void CMap2D::Update(const double dElapsedTime)
 {
 	//spawnchest();
+
+	// Forget the line of sight checks of this frame, since the entities will have moved
+	uiLineOfSightFrame++;
 }
 
 /**
@@ -496,28 +267,24 @@ void CMap2D::PreRender(void)
  */
 void CMap2D::Render(void)
 {
-	// get matrix's uniform location and set matrix
+	// Rebuild the batched tiles if the level has been modified since the last frame
+	if (arrTileMapVersions[uiCurLevel] != arrMapVersions[uiCurLevel])
+	{
+		RebuildTileMap(uiCurLevel);
+	}
+
+	// The tile positions are already baked into the batch, so use an identity transform
+	transform = glm::mat4(1.0f);
 	unsigned int transformLoc = glGetUniformLocation(CShaderManager::GetInstance()->activeShader->ID, "transform");
 	glUniformMatrix4fv(transformLoc, 1, GL_FALSE, glm::value_ptr(transform));
 
-	// Render
-	for (unsigned int uiRow = 0; uiRow < cSettings->NUM_TILES_YAXIS; uiRow++)
-	{
-		for (unsigned int uiCol = 0; uiCol < cSettings->NUM_TILES_XAXIS; uiCol++)
-		{
-			transform = glm::mat4(1.0f); // make sure to initialize matrix to identity matrix first
-			transform = glm::translate(transform, glm::vec3(cSettings->ConvertIndexToUVSpace(cSettings->x, uiCol, false, 0),
-															cSettings->ConvertIndexToUVSpace(cSettings->y, uiRow, true, 0),
-															0.0f));
-			//transform = glm::rotate(transform, (float)glfwGetTime(), glm::vec3(0.0f, 0.0f, 1.0f));
+	// Bind all the tile textures at once
+	glBindTexture(GL_TEXTURE_2D_ARRAY, uiTileTextureArrayID);
 
-			// Update the shaders with the latest transform
-			glUniformMatrix4fv(transformLoc, 1, GL_FALSE, glm::value_ptr(transform));
+	// Render the whole level
+	arrTileMapRenderers[uiCurLevel]->Render();
 
-			// Render a tile
-			RenderTile(uiRow, uiCol);
-		}
-	}
+	glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
 }
 
 /**
@@ -597,10 +364,25 @@ void CMap2D::SetNumSteps(const CSettings::AXIS sAxis, const unsigned int uiValue
  */
 void CMap2D::SetMapInfo(const unsigned int uiRow, const unsigned int uiCol, const int iValue, const bool bInvert)
 {
-	if (bInvert)
-		arrMapInfo[uiCurLevel][cSettings->NUM_TILES_YAXIS - uiRow - 1][uiCol].value = iValue;
-	else
-		arrMapInfo[uiCurLevel][uiRow][uiCol].value = iValue;
+	// arrMapInfo is stored with row 0 at the bottom, so only the top-down rows need converting
+	const unsigned int uiStorageRow = bInvert ? uiRow : cSettings->NUM_TILES_YAXIS - uiRow - 1;
+	unsigned short& usTile = arrMapInfo[uiCurLevel][uiStorageRow * cSettings->NUM_TILES_XAXIS + uiCol];
+
+	// Only record a change if the value is different, so that the cached data stays valid
+	if (usTile == (unsigned short)iValue)
+		return;
+
+	const bool bWasSolid = arrSolidBoards[uiCurLevel].IsSolid(uiStorageRow, uiCol);
+	arrValueIndices[uiCurLevel].Set(uiStorageRow * cSettings->NUM_TILES_XAXIS + uiCol, usTile, (unsigned short)iValue);
+	usTile = (unsigned short)iValue;
+	arrSpawnIndices[uiCurLevel].Update(arrMapInfo[uiCurLevel], uiStorageRow, uiCol);
+	arrRegions[uiCurLevel].Update(arrMapInfo[uiCurLevel], uiStorageRow, uiCol);
+	arrSolidBoards[uiCurLevel].Update(arrMapInfo[uiCurLevel], uiStorageRow, uiCol);
+	MarkChanged(uiCurLevel, uiStorageRow, uiCol);
+
+	// Only a block being built or broken changes the clusters, so picking up items does not rebuild them
+	if (bWasSolid != arrSolidBoards[uiCurLevel].IsSolid(uiStorageRow, uiCol))
+		UpdateHierarchicalMap();
 }
 
 /**
@@ -612,16 +394,57 @@ void CMap2D::SetMapInfo(const unsigned int uiRow, const unsigned int uiCol, cons
 int CMap2D::GetMapInfo(const unsigned int uiRow, const int unsigned uiCol, const bool bInvert) const
 {
 	if (bInvert)
-		return arrMapInfo[uiCurLevel][cSettings->NUM_TILES_YAXIS - uiRow - 1][uiCol].value;
+		return arrMapInfo[uiCurLevel][uiRow * cSettings->NUM_TILES_XAXIS + uiCol];
+	else
+		return arrMapInfo[uiCurLevel][(cSettings->NUM_TILES_YAXIS - uiRow - 1) * cSettings->NUM_TILES_XAXIS + uiCol];
+}
+
+/**
+ @brief Check if a tile of the current level is solid, with a bit test instead of loading its value.
+		Tiles outside the level are not solid
+ @param uiRow A const unsigned int variable containing the row index of the tile
+ @param uiCol A const unsigned int variable containing the column index of the tile
+ @param bInvert A const bool variable which indicates if the row information is inverted
+ */
+bool CMap2D::IsSolid(const unsigned int uiRow, const unsigned int uiCol, const bool bInvert) const
+{
+	if (bInvert)
+		return arrSolidBoards[uiCurLevel].IsSolid(uiRow, uiCol);
+	else
+		return arrSolidBoards[uiCurLevel].IsSolid(cSettings->NUM_TILES_YAXIS - uiRow - 1, uiCol);
+}
+
+/**
+ @brief Check if any tile in a span of columns of a row of the current level is solid, a word at a time
+ @param uiRow A const unsigned int variable containing the row index
+ @param uiFirstCol A const unsigned int variable containing the first column of the span
+ @param uiLastCol A const unsigned int variable containing the last column of the span
+ @param bInvert A const bool variable which indicates if the row information is inverted
+ */
+bool CMap2D::AnySolid(	const unsigned int uiRow,
+						const unsigned int uiFirstCol,
+						const unsigned int uiLastCol,
+						const bool bInvert) const
+{
+	if (bInvert)
+		return arrSolidBoards[uiCurLevel].AnySolid(uiRow, uiFirstCol, uiLastCol);
 	else
-		return arrMapInfo[uiCurLevel][uiRow][uiCol].value;
+		return arrSolidBoards[uiCurLevel].AnySolid(cSettings->NUM_TILES_YAXIS - uiRow - 1, uiFirstCol, uiLastCol);
 }
 
 /**
- @brief Load a map
+ @brief Load a map. Files ending in .map are loaded as cooked binary maps,
+		and all other files are loaded as CSV maps
  */ 
 bool CMap2D::LoadMap(string filename, const unsigned int uiCurLevel)
 {
+	// A level being prepared from the old tiles would overwrite the new ones
+	if (cPrepareThread.joinable() && (uiPreparedLevel == uiCurLevel))
+		CancelPreparedLevel();
+
+	if ((filename.size() >= 4) && (filename.compare(filename.size() - 4, 4, ".map") == 0))
+		return LoadBinaryMap(filename, uiCurLevel);
+
 	doc = rapidcsv::Document(FileSystem::getPath(filename).c_str());
 
 	// Check if the sizes of CSV data matches the declared arrMapInfo sizes
@@ -639,66 +462,207 @@ bool CMap2D::LoadMap(string filename, const unsigned int uiCurLevel)
 		std::vector<std::string> row = doc.GetRow<std::string>(uiRow);
 		
 		// Load a particular CSV value into the arrMapInfo
+		// The CSV file lists the top row first, while arrMapInfo starts from the bottom row
+		unsigned short* arrRow = &arrMapInfo[uiCurLevel][(cSettings->NUM_TILES_YAXIS - uiRow - 1) * cSettings->NUM_TILES_XAXIS];
 		for (unsigned int uiCol = 0; uiCol < cSettings->NUM_TILES_XAXIS; ++uiCol)
 		{
-			arrMapInfo[uiCurLevel][uiRow][uiCol].value = (int)stoi(row[uiCol]);
+			arrRow[uiCol] = (unsigned short)stoi(row[uiCol]);
 		}
 	}
 
+	// Everything built from this level is now out of date
+	arrValueIndices[uiCurLevel].Build(arrMapInfo[uiCurLevel], cSettings->NUM_TILES_YAXIS * cSettings->NUM_TILES_XAXIS);
+	arrSpawnIndices[uiCurLevel].Build(arrMapInfo[uiCurLevel], cSettings->NUM_TILES_YAXIS, cSettings->NUM_TILES_XAXIS);
+	arrRegions[uiCurLevel].Build(arrMapInfo[uiCurLevel], cSettings->NUM_TILES_YAXIS, cSettings->NUM_TILES_XAXIS, m_nrOfDirections);
+	arrSolidBoards[uiCurLevel].Build(arrMapInfo[uiCurLevel], cSettings->NUM_TILES_YAXIS, cSettings->NUM_TILES_XAXIS);
+	MarkLevelChanged(uiCurLevel);
+
 	return true;
 }
 
 /**
- @brief Save the tilemap to a text file
- @param filename A string variable containing the name of the text file to save the map to
+ @brief Load a cooked binary map, which is created from a CSV map by the MapCooker tool.
+		The file is mapped into memory and its tiles are copied into arrMapInfo as one block
+ @param filename A const string& variable containing the path of the .map file
+ @param uiLevel A const unsigned int variable containing the level to load into
  */
-bool CMap2D::SaveMap(string filename, const unsigned int uiCurLevel)
+bool CMap2D::LoadBinaryMap(const string& filename, const unsigned int uiLevel)
 {
-	// Update the rapidcsv::Document from arrMapInfo
-	for (unsigned int uiRow = 0; uiRow < cSettings->NUM_TILES_YAXIS; uiRow++)
+	using namespace LevelFormat;
+
+	CMappedFile cFile;
+	if (cFile.Open(FileSystem::getPath(filename)) == false)
 	{
-		for (unsigned int uiCol = 0; uiCol < cSettings->NUM_TILES_XAXIS; uiCol++)
-		{
-			doc.SetCell(uiCol, uiRow, arrMapInfo[uiCurLevel][uiRow][uiCol].value);
-		}
-		cout << endl;
+		cout << "Unable to open the map " << filename << endl;
+		return false;
 	}
 
-	// Save the rapidcsv::Document to a file
-	doc.Save(FileSystem::getPath(filename).c_str());
-
-	return true;
-}
+	const unsigned char* pData = cFile.GetData();
+	const size_t uiSize = cFile.GetSize();
 
-/**
-@brief Find the indices of a certain value in arrMapInfo
-@param iValue A const int variable containing the row index of the found element
-@param iRow A const int variable containing the row index of the found element
-@param iCol A const int variable containing the column index of the found element
-@param bInvert A const bool variable which indicates if the row information is inverted
-*/
-bool CMap2D::FindValue(const int iValue, unsigned int& uirRow, unsigned int& uirCol, const bool bInvert)
-{
-	for (unsigned int uiRow = 0; uiRow < cSettings->NUM_TILES_YAXIS; uiRow++)
+	// Check the header
+	if (uiSize < sizeof(LevelFileHeader))
 	{
-		for (unsigned int uiCol = 0; uiCol < cSettings->NUM_TILES_XAXIS; uiCol++)
-		{
-			if (arrMapInfo[uiCurLevel][uiRow][uiCol].value == iValue)
+		cout << "The map " << filename << " is too small." << endl;
+		return false;
+	}
+	const LevelFileHeader* sHeader = (const LevelFileHeader*)pData;
+	if ((memcmp(sHeader->cMagic, MAGIC, sizeof(MAGIC)) != 0) || (sHeader->uiVersion != VERSION))
+	{
+		cout << "The map " << filename << " is not a supported binary map." << endl;
+		return false;
+	}
+	if ((cSettings->NUM_TILES_XAXIS != sHeader->uiNumCols) ||
+		(cSettings->NUM_TILES_YAXIS != sHeader->uiNumRows))
+	{
+		cout << "Sizes of binary map does not match declared arrMapInfo sizes." << endl;
+		return false;
+	}
+
+	// Find the tiles section, skipping the others
+	const size_t uiTilesSize = sHeader->uiNumRows * sHeader->uiNumCols * sizeof(unsigned short);
+	size_t uiOffset = sizeof(LevelFileHeader);
+	for (unsigned int i = 0; i < sHeader->uiNumSections; i++)
+	{
+		if (uiOffset + sizeof(LevelSectionHeader) > uiSize)
+			break;
+		const LevelSectionHeader* sSection = (const LevelSectionHeader*)(pData + uiOffset);
+		uiOffset += sizeof(LevelSectionHeader);
+		if (uiOffset + sSection->uiSize > uiSize)
+			break;
+
+		if ((sSection->uiType == SECTION_TILES) && (sSection->uiSize == uiTilesSize))
+		{
+			memcpy(arrMapInfo[uiLevel], pData + uiOffset, uiTilesSize);
+
+			// Everything built from this level is now out of date
+			arrValueIndices[uiLevel].Build(arrMapInfo[uiLevel], sHeader->uiNumRows * sHeader->uiNumCols);
+			arrSpawnIndices[uiLevel].Build(arrMapInfo[uiLevel], sHeader->uiNumRows, sHeader->uiNumCols);
+			arrRegions[uiLevel].Build(arrMapInfo[uiLevel], sHeader->uiNumRows, sHeader->uiNumCols, m_nrOfDirections);
+			arrSolidBoards[uiLevel].Build(arrMapInfo[uiLevel], sHeader->uiNumRows, sHeader->uiNumCols);
+			MarkLevelChanged(uiLevel);
+			return true;
+		}
+		uiOffset += AlignSize(sSection->uiSize);
+	}
+
+	cout << "The map " << filename << " has no valid tiles section." << endl;
+	return false;
+}
+
+/**
+ @brief Save the tilemap to a text file. The level is copied and written by a background
+		thread, so this returns straight away. Saving the same file again before it has been
+		written only writes the latest copy
+ @param filename A string variable containing the name of the text file to save the map to
+ */
+bool CMap2D::SaveMap(string filename, const unsigned int uiCurLevel)
+{
+	if (uiCurLevel >= uiNumLevels)
+		return false;
+
+	// Hand a snapshot of the level to the background writer, so the game does not wait for the file
+	cMapWriter.Save(FileSystem::getPath(filename),
+					arrMapInfo[uiCurLevel],
+					cSettings->NUM_TILES_YAXIS,
+					cSettings->NUM_TILES_XAXIS);
+
+	return true;
+}
+
+/**
+ @brief Check if any map is still being saved
+ */
+bool CMap2D::IsSaving(void)
+{
+	return cMapWriter.IsBusy();
+}
+
+/**
+@brief Find the indices of a certain value in arrMapInfo. The index of tile values is used,
+	   so only the tiles holding the value are checked. If several tiles hold the value,
+	   the one nearest the top left is returned
+@param iValue A const int variable containing the row index of the found element
+@param iRow A const int variable containing the row index of the found element
+@param iCol A const int variable containing the column index of the found element
+@param bInvert A const bool variable which indicates if the row information is inverted
+*/
+bool CMap2D::FindValue(const int iValue, unsigned int& uirRow, unsigned int& uirCol, const bool bInvert)
+{
+	const unsigned int uiNumCols = cSettings->NUM_TILES_XAXIS;
+	unsigned int uiPosition = 0;
+	bool bFound = false;
+
+	if (iValue == 0)
+	{
+		// Empty tiles are not indexed, so search from the top row down
+		for (unsigned int uiRow = cSettings->NUM_TILES_YAXIS; (uiRow-- > 0) && !bFound; )
+		{
+			for (unsigned int uiCol = 0; uiCol < uiNumCols; uiCol++)
 			{
-				if (bInvert)
-					uirRow = cSettings->NUM_TILES_YAXIS - uiRow - 1;
-				else
+				if (arrMapInfo[uiCurLevel][uiRow * uiNumCols + uiCol] == 0)
 				{
-					uirRow = uiRow;
-			
+					uiPosition = uiRow * uiNumCols + uiCol;
+					bFound = true;
+					break;
 				}
-				// Return true immediately if the value has been found
-				uirCol = uiCol;
-				return true;
 			}
 		}
 	}
-	return false;
+	else if ((iValue > 0) && (iValue <= 0xFFFF))
+	{
+		// Pick the tile which a search from the top row down would find first
+		const vector<unsigned int>& vPositions = arrValueIndices[uiCurLevel].Get((unsigned short)iValue);
+		for (unsigned int i = 0; i < vPositions.size(); i++)
+		{
+			const unsigned int uiRow = vPositions[i] / uiNumCols;
+			const unsigned int uiCol = vPositions[i] % uiNumCols;
+			if (!bFound ||
+				(uiRow > uiPosition / uiNumCols) ||
+				((uiRow == uiPosition / uiNumCols) && (uiCol < uiPosition % uiNumCols)))
+			{
+				uiPosition = vPositions[i];
+				bFound = true;
+			}
+		}
+	}
+
+	if (!bFound)
+		return false;
+
+	if (bInvert)
+		uirRow = uiPosition / uiNumCols;
+	else
+		uirRow = cSettings->NUM_TILES_YAXIS - uiPosition / uiNumCols - 1;
+	uirCol = uiPosition % uiNumCols;
+	return true;
+}
+
+/**
+@brief Find the indices of all the tiles with a certain value in arrMapInfo.
+	   Empty tiles (value 0) are not indexed, so they cannot be searched for
+@param iValue A const int variable containing the value to search for
+@param vPositions A std::vector<glm::i32vec2>& variable which will store the column (x) and row (y) of each tile found
+@param bInvert A const bool variable which indicates if the row information is inverted
+@return true if any tile has been found, otherwise false
+*/
+bool CMap2D::FindAllValues(const int iValue, std::vector<glm::i32vec2>& vPositions, const bool bInvert) const
+{
+	vPositions.clear();
+	if ((iValue <= 0) || (iValue > 0xFFFF))
+		return false;
+
+	const unsigned int uiNumCols = cSettings->NUM_TILES_XAXIS;
+	const vector<unsigned int>& vIndexed = arrValueIndices[uiCurLevel].Get((unsigned short)iValue);
+	vPositions.reserve(vIndexed.size());
+	for (unsigned int i = 0; i < vIndexed.size(); i++)
+	{
+		int iRow = vIndexed[i] / uiNumCols;
+		if (!bInvert)
+			iRow = cSettings->NUM_TILES_YAXIS - iRow - 1;
+		vPositions.push_back(glm::i32vec2(vIndexed[i] % uiNumCols, iRow));
+	}
+	return !vPositions.empty();
 }
 
 /**
@@ -708,6 +672,10 @@ void CMap2D::SetCurrentLevel(unsigned int uiCurLevel)
 {
 	if (uiCurLevel < uiNumLevels)
 	{
+		// The level will be changed by the main thread from now on, so it cannot be prepared in the background
+		if (cPrepareThread.joinable() && (uiPreparedLevel == uiCurLevel))
+			CancelPreparedLevel();
+
 		this->uiCurLevel = uiCurLevel;
 	}
 }
@@ -720,161 +688,289 @@ unsigned int CMap2D::GetCurrentLevel(void) const
 }
 
 /**
- @brief Render a tile at a position based on its tile index
- @param iRow A const int variable containing the row index of the tile
- @param iCol A const int variable containing the column index of the tile
+ @brief Get the version of the current level. The version changes whenever a tile
+		in the level changes, so it can be compared to a stored version to check
+		if the map is unchanged since then
  */
-void CMap2D::RenderTile(const unsigned int uiRow, const unsigned int uiCol)
+unsigned int CMap2D::GetMapVersion(void) const
 {
-	if (arrMapInfo[uiCurLevel][uiRow][uiCol].value != 0)
+	return arrMapVersions[uiCurLevel];
+}
+
+/**
+ @brief Get the version of a level
+ @param uiLevel A const unsigned int variable containing the level
+ */
+unsigned int CMap2D::GetMapVersion(const unsigned int uiLevel) const
+{
+	if (uiLevel >= uiNumLevels)
+		return 0;
+	return arrMapVersions[uiLevel];
+}
+
+/**
+ @brief Get the region of a level which has changed since a version.
+		The region is rounded up to whole chunks, so it may include unchanged tiles
+ @param uiLevel A const unsigned int variable containing the level
+ @param uiSinceVersion A const unsigned int variable containing the version to compare against
+ @param uirMinRow An unsigned int variable which will store the lowest changed row
+ @param uirMinCol An unsigned int variable which will store the lowest changed column
+ @param uirMaxRow An unsigned int variable which will store the highest changed row
+ @param uirMaxCol An unsigned int variable which will store the highest changed column
+ @param bInvert A const bool variable which indicates if the row information is inverted
+ @return true if any tile has changed, otherwise false
+ */
+bool CMap2D::GetChangedRegion(	const unsigned int uiLevel,
+								const unsigned int uiSinceVersion,
+								unsigned int& uirMinRow, unsigned int& uirMinCol,
+								unsigned int& uirMaxRow, unsigned int& uirMaxCol,
+								const bool bInvert) const
+{
+	if ((uiLevel >= uiNumLevels) || (arrMapVersions[uiLevel] == uiSinceVersion))
+		return false;
+
+	// Find the bounding box of the chunks which have changed
+	unsigned int uiMinChunkRow = uiNumChunkRows, uiMinChunkCol = uiNumChunkCols;
+	unsigned int uiMaxChunkRow = 0, uiMaxChunkCol = 0;
+	bool bChanged = false;
+	for (unsigned int uiChunkRow = 0; uiChunkRow < uiNumChunkRows; uiChunkRow++)
 	{
-		//if (arrMapInfo[uiCurLevel][uiRow][uiCol].value < 3)
-		glBindTexture(GL_TEXTURE_2D, MapOfTextureIDs.at(arrMapInfo[uiCurLevel][uiRow][uiCol].value));
+		for (unsigned int uiChunkCol = 0; uiChunkCol < uiNumChunkCols; uiChunkCol++)
+		{
+			if (arrChunkVersions[uiLevel][uiChunkRow * uiNumChunkCols + uiChunkCol] <= uiSinceVersion)
+				continue;
+
+			uiMinChunkRow = min(uiMinChunkRow, uiChunkRow);
+			uiMinChunkCol = min(uiMinChunkCol, uiChunkCol);
+			uiMaxChunkRow = max(uiMaxChunkRow, uiChunkRow);
+			uiMaxChunkCol = max(uiMaxChunkCol, uiChunkCol);
+			bChanged = true;
+		}
+	}
+	if (!bChanged)
+		return false;
 
-		glBindVertexArray(VAO);
-		//CS: Render the tile
-		quadMesh->Render();
-		glBindVertexArray(0);
+	// Convert the chunks into tiles
+	uirMinRow = uiMinChunkRow * CHUNK_SIZE;
+	uirMinCol = uiMinChunkCol * CHUNK_SIZE;
+	uirMaxRow = min((uiMaxChunkRow + 1) * CHUNK_SIZE, cSettings->NUM_TILES_YAXIS) - 1;
+	uirMaxCol = min((uiMaxChunkCol + 1) * CHUNK_SIZE, cSettings->NUM_TILES_XAXIS) - 1;
+
+	if (!bInvert)
+	{
+		const unsigned int uiMinRow = uirMinRow;
+		uirMinRow = cSettings->NUM_TILES_YAXIS - uirMaxRow - 1;
+		uirMaxRow = cSettings->NUM_TILES_YAXIS - uiMinRow - 1;
 	}
+	return true;
 }
 
+/**
+ @brief Record a change to a tile of a level
+ @param uiLevel A const unsigned int variable containing the level
+ @param uiRow A const unsigned int variable containing the row index in arrMapInfo, where row 0 is the bottom row
+ @param uiCol A const unsigned int variable containing the column index
+ */
+void CMap2D::MarkChanged(const unsigned int uiLevel, const unsigned int uiRow, const unsigned int uiCol)
+{
+	arrMapVersions[uiLevel]++;
+	arrChunkVersions[uiLevel][(uiRow / CHUNK_SIZE) * uiNumChunkCols + (uiCol / CHUNK_SIZE)] = arrMapVersions[uiLevel];
+}
 
 /**
- @brief Find a path
+ @brief Record a change to every tile of a level
+ @param uiLevel A const unsigned int variable containing the level
  */
-std::vector<glm::vec2> CMap2D::PathFind(	const glm::vec2& startPos, 
-											const glm::vec2& targetPos, 
-											HeuristicFunction heuristicFunc, 
-											const int weight)
+void CMap2D::MarkLevelChanged(const unsigned int uiLevel)
 {
-	// Check if the startPos and targetPost are blocked
-	if (isBlocked(startPos.y, startPos.x) ||
-		(isBlocked(targetPos.y, targetPos.x)))
+	arrMapVersions[uiLevel]++;
+	for (unsigned int i = 0; i < uiNumChunkRows * uiNumChunkCols; i++)
 	{
-		cout << "Invalid start or target position." << endl;
-		// Return an empty path
-		std::vector<glm::vec2> path;
-		return path;
+		arrChunkVersions[uiLevel][i] = arrMapVersions[uiLevel];
 	}
+}
 
-	// Set up the variables and lists
-	m_startPos = startPos;
-	m_targetPos = targetPos;
-	m_weight = weight;
-	m_heuristic = std::bind(heuristicFunc, _1, _2, _3);
-
-	// Reset AStar lists
-	ResetAStarLists();
+/**
+ @brief Rebuild the batched tiles of a level from arrMapInfo.
+		Only the tiles which have changed since the last rebuild are updated
+ @param uiLevel A const unsigned int variable containing the level to rebuild
+ */
+void CMap2D::RebuildTileMap(const unsigned int uiLevel)
+{
+	unsigned int uiMinRow, uiMinCol, uiMaxRow, uiMaxCol;
+	if (GetChangedRegion(uiLevel, arrTileMapVersions[uiLevel], uiMinRow, uiMinCol, uiMaxRow, uiMaxCol))
+	{
+		for (unsigned int uiRow = uiMinRow; uiRow <= uiMaxRow; uiRow++)
+		{
+			for (unsigned int uiCol = uiMinCol; uiCol <= uiMaxCol; uiCol++)
+			{
+				// Empty tiles and values which have no texture, such as spawn markers, are not drawn
+				const unsigned int uiValue = arrMapInfo[uiLevel][uiRow * cSettings->NUM_TILES_XAXIS + uiCol];
+				if ((uiValue >= vTileLayers.size()) || (vTileLayers[uiValue] < 0))
+					arrTileMapRenderers[uiLevel]->ClearTile(uiRow, uiCol);
+				else
+					arrTileMapRenderers[uiLevel]->SetTile(uiRow, uiCol, vTileLayers[uiValue]);
+			}
+		}
+		arrTileMapRenderers[uiLevel]->Upload(uiMinRow, uiMaxRow);
+	}
 
-	// Add the start pos to 2 lists
-	m_cameFromList[ConvertTo1D(m_startPos)].parent = m_startPos;
-	m_openList.push(Grid(m_startPos, 0));
+	arrTileMapVersions[uiLevel] = arrMapVersions[uiLevel];
+}
 
-	unsigned int fNew, gNew, hNew;
-	glm::vec2 currentPos;
 
-	// Start the path finding...
-	while (!m_openList.empty())
+/**
+ @brief Find a long path over the clusters of the current level with Hierarchical Path Finding.
+		Use it for long-range queries, where PathFind() would search most of the level. The
+		clusters are rebuilt by SetMapInfo() when a block is built or broken, and only the
+		first change or query on a level builds all of them. The path may be a few tiles
+		longer than the one from PathFind(), but far fewer nodes are searched
+ @param startPos A const glm::vec2& variable containing the start position
+ @param targetPos A const glm::vec2& variable containing the target position
+ @param vPath A std::vector<glm::vec2>& variable which will store the path, from the grid
+			after startPos to targetPos
+ @return true if a path was found, otherwise false
+ */
+bool CMap2D::FindHierarchicalPath(const glm::vec2& startPos, const glm::vec2& targetPos, std::vector<glm::vec2>& vPath)
+{
+	if (!isValid(startPos) || !isValid(targetPos))
 	{
-		// Get the node with the least f value
-		currentPos = m_openList.top().pos;
-		//cout << endl << "*** New position to check: " << currentPos.x << ", " << currentPos.y << endl;
-		//cout << "*** targetPos: " << m_targetPos.x << ", " << m_targetPos.y << endl;
+		vPath.clear();
+		return false;
+	}
 
-		// If the targetPos was reached, then quit this loop
-		if (currentPos == m_targetPos)
-		{
-			//cout << "=== Found the targetPos: " << m_targetPos.x << ", " << m_targetPos.y << endl;
-			while (m_openList.size() != 0)
-				m_openList.pop();
-			break;
-		}
+	UpdateHierarchicalMap();
+	return cHierarchicalMap.FindPath(startPos, targetPos, vPath);
+}
 
-		m_openList.pop();
-		m_closedList[ConvertTo1D(currentPos)] = true;
+/**
+ @brief Set the jump of the ground enemies. Its arc decides how high and how far the jump
+		links of the platform navigation graph reach, so the graph is built again
+ @param v2JumpVelocity A const glm::vec2& variable containing the initial velocity of the jump
+ */
+void CMap2D::SetJumpArc(const glm::vec2& v2JumpVelocity)
+{
+	cPlatformNavGraph.SetJumpArc(	v2JumpVelocity,
+									cSettings->frameTime / 1000.0f,
+									cSettings->MICRO_STEP_YAXIS,
+									(int)cSettings->NUM_STEPS_PER_TILE_XAXIS,
+									(int)cSettings->NUM_STEPS_PER_TILE_YAXIS);
+}
 
-		// Check the neighbors of the current node
-		for (unsigned int i = 0; i < m_nrOfDirections; ++i)
-		{
-			const auto neighborPos = currentPos + m_directions[i];
-			const auto neighborIndex = ConvertTo1D(neighborPos);
+/**
+ @brief Point the ground enemies' shared platform field at a target. The field is only built
+		again when the target moves to another tile, or the tiles of the current level change
+ @param targetPos A const glm::vec2& variable containing the target position
+ */
+void CMap2D::UpdatePlatformField(const glm::vec2& targetPos)
+{
+	if (!isValid(targetPos))
+		return;
 
-			//cout << "\t#" << i << ": Check this: " << neighborPos.x << ", " << neighborPos.y << ":\t";
-			if (!isValid(neighborPos) || 
-				isBlocked(neighborPos.y, neighborPos.x) || 
-				m_closedList[neighborIndex] == true)
-			{
-				//cout << "This position is not valid. Going to next neighbour." << endl;
-				continue;
-			}
+	UpdatePlatformNavGraph();
+	if (!cPlatformNavGraph.IsFieldBuiltFor(targetPos))
+		cPlatformNavGraph.BuildField(targetPos);
+}
 
-			gNew = m_cameFromList[ConvertTo1D(currentPos)].g + 1;
-			hNew = m_heuristic(neighborPos, m_targetPos, m_weight);
-			fNew = gNew + hNew;
+/**
+ @brief Get the path which a ground enemy can follow under gravity to the target of the
+		platform field. While the enemy is in the air, it keeps following the path it had,
+		since a jump or a fall cannot be changed once it has started
+ @param startPos A const glm::vec2& variable containing the start position
+ @param bAirborne A const bool variable which is true if the enemy is jumping or falling
+ @param vPath A std::vector<glm::vec2>& variable containing the enemy's path, which will
+			store the path from the grid after startPos to the target
+ @return true if a path was found, otherwise false
+ */
+bool CMap2D::GetPlatformPath(const glm::vec2& startPos, const bool bAirborne, std::vector<glm::vec2>& vPath)
+{
+	if (bAirborne && ContinuePath(startPos, vPath))
+		return true;
 
-			if (m_cameFromList[neighborIndex].f == 0 || fNew < m_cameFromList[neighborIndex].f)
-			{
-				//cout << "Adding to Open List: " << neighborPos.x << ", " << neighborPos.y;
-				//cout << ". [ f : " << fNew << ", g : " << gNew << ", h : " << hNew << "]" << endl;
-				m_openList.push(Grid(neighborPos, fNew));
-				m_cameFromList[neighborIndex] = { neighborPos, currentPos, fNew, gNew, hNew };
-			}
-			else
-			{
-				//cout << "Not adding this" << endl;
-			}
-		}
-		//system("pause");
+	if (!isValid(startPos))
+	{
+		vPath.clear();
+		return false;
 	}
-
-	return BuildPath();
+	return cPlatformNavGraph.GetFieldPath(startPos, vPath);
 }
 
 /**
- @brief Build a path
+ @brief Find a path which a ground enemy can follow under gravity, with A* Path Finding over
+		the walk, jump and fall links of the current level. While the enemy is in the air, it
+		keeps following the path it had
+ @param context An AStarContext& variable containing the scratch data of the search
+ @param startPos A const glm::vec2& variable containing the start position
+ @param targetPos A const glm::vec2& variable containing the target position
+ @param bAirborne A const bool variable which is true if the enemy is jumping or falling
+ @param vPath A std::vector<glm::vec2>& variable containing the enemy's path, which will
+			store the path from the grid after startPos to targetPos
+ @return true if a path was found, otherwise false
  */
-std::vector<glm::vec2> CMap2D::BuildPath() const
+bool CMap2D::PlatformPathFind(	AStarContext& context,
+								const glm::vec2& startPos,
+								const glm::vec2& targetPos,
+								const bool bAirborne,
+								std::vector<glm::vec2>& vPath)
 {
-	std::vector<glm::vec2> path;
-	auto currentPos = m_targetPos;
-	auto currentIndex = ConvertTo1D(currentPos);
+	if (bAirborne && ContinuePath(startPos, vPath))
+		return true;
 
-	while (!(m_cameFromList[currentIndex].parent == currentPos))
+	if (!isValid(startPos) || !isValid(targetPos))
 	{
-		path.push_back(currentPos);
-		currentPos = m_cameFromList[currentIndex].parent;
-		currentIndex = ConvertTo1D(currentPos);
+		vPath.clear();
+		return false;
 	}
 
-	// If the path has only 1 entry, then it is the the target position
-	if (path.size() == 1)
+	// Every move of the graph is through open tiles, so it cannot leave the start's region
+	if (!IsReachable(startPos, targetPos))
 	{
-		// if m_startPos is next to m_targetPos, then having 1 path point is OK
-		if (m_nrOfDirections == 4)
-		{
-			if (abs(m_targetPos.y - m_startPos.y) + abs(m_targetPos.x - m_startPos.x) > 1)
-				path.clear();
-		}
-		else
-		{
-			if (abs(m_targetPos.y - m_startPos.y) + abs(m_targetPos.x - m_startPos.x) > 2)
-				path.clear();
-			else if (abs(m_targetPos.y - m_startPos.y) + abs(m_targetPos.x - m_startPos.x) > 1)
-				path.clear();
-		}
+		vPath.clear();
+		return false;
 	}
-	else
-		std::reverse(path.begin(), path.end());
 
-	return path;
+	UpdatePlatformNavGraph();
+	return cPlatformNavGraph.FindPath(context, startPos, targetPos, vPath);
 }
 
 /**
- @brief Toggle the checks for diagonal movements
+ @brief Toggle the checks for diagonal movements. The regions of every level are built again
+		if the number of directions changes, since diagonal moves can join more tiles.
+		PathFind() is also switched to the faster search for the number of directions:
+		Jump Point Search for 8 directions, where PathBenchmark finds it faster than A* on
+		every shipped level, and A* for 4 directions, where it is slower on the forest, hills
+		and plains levels. Call SetSearchMode() afterwards to choose another search
+ @param bEnable A const bool variable which is true to allow diagonal movements
  */
 void CMap2D::SetDiagonalMovement(const bool bEnable)
 {
-	m_nrOfDirections = (bEnable) ? 8 : 4;
+	m_searchMode = (bEnable) ? SEARCH_JUMP_POINT : SEARCH_ASTAR;
+
+	const unsigned int uiNumDirections = (bEnable) ? 8 : 4;
+	if (uiNumDirections == m_nrOfDirections)
+		return;
+
+	m_nrOfDirections = uiNumDirections;
+	for (unsigned int uiLevel = 0; uiLevel < uiNumLevels; uiLevel++)
+	{
+		arrRegions[uiLevel].Build(	arrMapInfo[uiLevel],
+									cSettings->NUM_TILES_YAXIS,
+									cSettings->NUM_TILES_XAXIS,
+									m_nrOfDirections);
+	}
+}
+
+/**
+ @brief Set the search which PathFind() uses, instead of the one which SetDiagonalMovement()
+		picked. Jump Point Search expands far fewer nodes
+		on levels with large open areas, but is not always faster. Both find paths of the same
+		length, as long as the heuristic does not overestimate, such as heuristic::Manhattan
+		for 4 directions and heuristic::Chebyshev for 8 directions
+ @param eSearchMode A const SEARCH_MODE variable containing the search to use
+ */
+void CMap2D::SetSearchMode(const SEARCH_MODE eSearchMode)
+{
+	m_searchMode = eSearchMode;
 }
 
 /**
@@ -887,13 +983,14 @@ void CMap2D::PrintSelf(void) const
 	for (unsigned uiLevel = 0; uiLevel < uiNumLevels; uiLevel++)
 	{
 		cout << "Level: " << uiLevel << endl;
-		for (unsigned uiRow = 0; uiRow < cSettings->NUM_TILES_YAXIS; uiRow++)
+		// Print from the top row down, in the same layout as the CSV file
+		for (unsigned uiRow = cSettings->NUM_TILES_YAXIS; uiRow-- > 0; )
 		{
 			for (unsigned uiCol = 0; uiCol < cSettings->NUM_TILES_XAXIS; uiCol++)
 			{
 				cout.fill('0');
 				cout.width(3);
-				cout << arrMapInfo[uiLevel][uiRow][uiCol].value;
+				cout << arrMapInfo[uiLevel][uiRow * cSettings->NUM_TILES_XAXIS + uiCol];
 				if (uiCol != cSettings->NUM_TILES_XAXIS - 1)
 					cout << ", ";
 				else
@@ -902,10 +999,6 @@ void CMap2D::PrintSelf(void) const
 		}
 	}
 
-	cout << "m_openList: " << m_openList.size() << endl;
-	cout << "m_cameFromList: " << m_cameFromList.size() << endl;
-	cout << "m_closedList: " << m_closedList.size() << endl;
-
 	cout << "===== AStar::PrintSelf() =====" << endl;
 }
 
@@ -925,22 +1018,84 @@ bool CMap2D::isValid(const glm::vec2& pos) const
  */
 bool CMap2D::isBlocked(const unsigned int uiRow, const unsigned int uiCol, const bool bInvert) const
 {
-	if (bInvert == true)
-	{
-		if ((arrMapInfo[uiCurLevel][cSettings->NUM_TILES_YAXIS - uiRow - 1][uiCol].value >= 100) &&
-			(arrMapInfo[uiCurLevel][cSettings->NUM_TILES_YAXIS - uiRow - 1][uiCol].value < 200))
-			return true;
-		else
-			return false;
-	}
-	else
-	{
-		if ((arrMapInfo[uiCurLevel][uiRow][uiCol].value >= 100) &&
-			(arrMapInfo[uiCurLevel][uiRow][uiCol].value < 200))
-			return true;
-		else
-			return false;
-	}
+	return IsSolid(uiRow, uiCol, bInvert);
+}
+
+/**
+ @brief Check if two positions are in the same region of open tiles of the current level.
+		If they are not, no path can join them, which is known without searching
+ @param startPos A const glm::vec2& variable containing the start position
+ @param targetPos A const glm::vec2& variable containing the target position
+ @return true if both positions are open and connected, otherwise false
+ */
+bool CMap2D::IsReachable(const glm::vec2& startPos, const glm::vec2& targetPos) const
+{
+	if (!isValid(startPos) || !isValid(targetPos))
+		return false;
+
+	return arrRegions[uiCurLevel].IsConnected(	(unsigned int)startPos.y, (unsigned int)startPos.x,
+												(unsigned int)targetPos.y, (unsigned int)targetPos.x);
+}
+
+/**
+ @brief Cast a ray through the tiles of the current level, stopping at the first solid tile
+ @param startPos A const glm::vec2& variable containing the start position, in tiles
+ @param targetPos A const glm::vec2& variable containing the target position, in tiles
+ @param sHit A CTileRaycaster::RaycastHit& variable which will store what the ray hit
+ @return true if the ray hit a solid tile before reaching the tile of its target
+ */
+bool CMap2D::Raycast(const glm::vec2& startPos, const glm::vec2& targetPos, CTileRaycaster::RaycastHit& sHit) const
+{
+	const CTileRaycaster cRaycaster(arrMapInfo[uiCurLevel], cSettings->NUM_TILES_YAXIS, cSettings->NUM_TILES_XAXIS);
+	return cRaycaster.Cast(startPos, targetPos, sHit);
+}
+
+/**
+ @brief Cast many rays through the tiles of the current level
+ @param vRays A const std::vector<CTileRaycaster::Ray>& variable containing the rays
+ @param vHits A std::vector<CTileRaycaster::RaycastHit>& variable which will store what each ray hit
+ @return The number of rays which hit a solid tile
+ */
+unsigned int CMap2D::Raycast(	const std::vector<CTileRaycaster::Ray>& vRays,
+								std::vector<CTileRaycaster::RaycastHit>& vHits) const
+{
+	const CTileRaycaster cRaycaster(arrMapInfo[uiCurLevel], cSettings->NUM_TILES_YAXIS, cSettings->NUM_TILES_XAXIS);
+	return cRaycaster.Cast(vRays, vHits);
+}
+
+/**
+ @brief Check if no solid tile is between the centres of two tiles. The answer is remembered
+		until the end of the frame or until a tile changes, so many enemies asking the same
+		question only cast one ray
+ @param startIndex A const glm::vec2& variable containing the start tile
+ @param targetIndex A const glm::vec2& variable containing the target tile
+ @return true if the target can be seen from the start
+ */
+bool CMap2D::HasLineOfSight(const glm::vec2& startIndex, const glm::vec2& targetIndex)
+{
+	if (!isValid(startIndex) || !isValid(targetIndex))
+		return false;
+
+	// Each coordinate gets 16 bits of the key, so maps up to 65536 tiles wide and high
+	// never give two checks the same key
+	const unsigned long long ullKey =	((unsigned long long)startIndex.x << 48) |
+										((unsigned long long)startIndex.y << 32) |
+										((unsigned long long)targetIndex.x << 16) |
+										(unsigned long long)targetIndex.y;
+	LineOfSightEntry& sEntry = arrLineOfSightCache[((ullKey * 11400714819323198485ull) >> 32) % LINE_OF_SIGHT_CACHE_SIZE];
+	if ((sEntry.uiFrame == uiLineOfSightFrame) &&
+		(sEntry.ullKey == ullKey) &&
+		(sEntry.uiLevel == uiCurLevel) &&
+		(sEntry.uiVersion == arrMapVersions[uiCurLevel]))
+		return sEntry.bVisible;
+
+	CTileRaycaster::RaycastHit sHit;
+	sEntry.ullKey = ullKey;
+	sEntry.uiFrame = uiLineOfSightFrame;
+	sEntry.uiLevel = uiCurLevel;
+	sEntry.uiVersion = arrMapVersions[uiCurLevel];
+	sEntry.bVisible = !Raycast(startIndex + glm::vec2(0.5f), targetIndex + glm::vec2(0.5f), sHit);
+	return sEntry.bVisible;
 }
 
 /**
@@ -953,131 +1108,376 @@ int CMap2D::ConvertTo1D(const glm::vec2& pos) const
 }
 
 /**
- @brief Delete AStar lists
+ @brief Spawn 3 to 7 chests in the current level, on empty tiles directly above the ground
  */
-bool CMap2D::DeleteAStarLists(void)
+void CMap2D::spawnchest(void)
 {
-	// Delete m_openList
-	while (m_openList.size() != 0)
-		m_openList.pop();
-	// Delete m_cameFromList
-	m_cameFromList.clear();
-	// Delete m_closedList
-	m_closedList.clear();
-
-	return true;
+	const unsigned int uiNumOfChest = cRandom() % 5 + 3;
+	unsigned int uiRow, uiCol;
+	for (unsigned int i = 0; i < uiNumOfChest; i++)
+	{
+		if (arrSpawnIndices[uiCurLevel].Sample(CSpawnCellIndex::SPAWN_ON_GROUND, cRandom, uiRow, uiCol) == false)
+			break;
+		SetMapInfo(uiRow, uiCol, 105);
+	}
 }
 
+/**
+ @brief Spawn a tree in the current level, on an empty tile directly above the ground
+ */
+void CMap2D::spawntree(void)
+{
+	unsigned int uiRow, uiCol;
+	if (arrSpawnIndices[uiCurLevel].Sample(CSpawnCellIndex::SPAWN_ON_GROUND, cRandom, uiRow, uiCol))
+		SetMapInfo(uiRow, uiCol, 106);
+}
 
 /**
- @brief Reset AStar lists
+ @brief Place the chests and trees for a new level into its tiles.
+		This is the same as calling spawnchest() once and spawntree() 13 times
+ @param arrTiles An unsigned short* variable containing the tiles of a level
+ @param cSpawnIndex A CSpawnCellIndex& variable containing the spawn index built from arrTiles, which is kept up to date
+ @param cGenerator A std::mt19937& variable containing the random number generator to use
  */
-bool CMap2D::ResetAStarLists(void)
+void CMap2D::PopulateLevel(unsigned short* arrTiles, CSpawnCellIndex& cSpawnIndex, std::mt19937& cGenerator) const
 {
-	// Delete m_openList
-	while (m_openList.size() != 0)
-		m_openList.pop();
-	// Reset m_cameFromList
-	for (int i = 0; i < m_cameFromList.size(); i++)
+	const unsigned int uiNumCols = cSettings->NUM_TILES_XAXIS;
+	unsigned int uiRow, uiCol;
+
+	const unsigned int uiNumOfChest = cGenerator() % 5 + 3;
+	for (unsigned int i = 0; i < uiNumOfChest; i++)
 	{
-		m_cameFromList[i].pos = glm::vec2(0,0);
-		m_cameFromList[i].parent = glm::vec2(0, 0);
-		m_cameFromList[i].f = 0;
-		m_cameFromList[i].g = 0;
-		m_cameFromList[i].h = 0;
+		if (cSpawnIndex.Sample(CSpawnCellIndex::SPAWN_ON_GROUND, cGenerator, uiRow, uiCol))
+		{
+			arrTiles[uiRow * uiNumCols + uiCol] = 105;
+			cSpawnIndex.Update(arrTiles, uiRow, uiCol);
+		}
 	}
-	// Reset m_closedList
-	for (int i = 0; i < m_closedList.size(); i++)
+
+	for (unsigned int i = 0; i < 13; i++)
 	{
-		m_closedList[i] = false;
+		if (cSpawnIndex.Sample(CSpawnCellIndex::SPAWN_ON_GROUND, cGenerator, uiRow, uiCol))
+		{
+			arrTiles[uiRow * uiNumCols + uiCol] = 106;
+			cSpawnIndex.Update(arrTiles, uiRow, uiCol);
+		}
 	}
+}
 
+/**
+ @brief Start preparing a level on a worker thread. The worker copies the level's tiles and
+		places its chests and trees, and builds its indices, regions and solid bitboard, so that
+		SwitchToPreparedLevel() only needs to swap pointers.
+		Any level which was being prepared before is discarded
+ @param uiLevel A const unsigned int variable containing the level to prepare
+ @return true if the preparation has started, otherwise false
+ */
+bool CMap2D::PrepareLevel(const unsigned int uiLevel)
+{
+	CancelPreparedLevel();
+
+	if ((uiLevel >= uiNumLevels) || (uiLevel == uiCurLevel))
+		return false;
+
+	// Only the current level is changed by the main thread, so the worker can read this level safely
+	uiPreparedLevel = uiLevel;
+	const unsigned int uiNumTiles = cSettings->NUM_TILES_YAXIS * cSettings->NUM_TILES_XAXIS;
+	const unsigned short* arrSourceTiles = arrMapInfo[uiLevel];
+	const unsigned int uiSeed = cRandom();
+	uiPreparedNumDirections = m_nrOfDirections;
+	cPrepareThread = std::thread([this, arrSourceTiles, uiNumTiles, uiSeed]()
+	{
+		unsigned short* arrTiles = new unsigned short[uiNumTiles];
+		memcpy(arrTiles, arrSourceTiles, uiNumTiles * sizeof(unsigned short));
+
+		std::mt19937 cGenerator(uiSeed);
+		cPreparedSpawnIndex.Build(arrTiles, cSettings->NUM_TILES_YAXIS, cSettings->NUM_TILES_XAXIS);
+		PopulateLevel(arrTiles, cPreparedSpawnIndex, cGenerator);
+		cPreparedValueIndex.Build(arrTiles, uiNumTiles);
+		cPreparedRegions.Build(arrTiles, cSettings->NUM_TILES_YAXIS, cSettings->NUM_TILES_XAXIS, uiPreparedNumDirections);
+		cPreparedSolidBoard.Build(arrTiles, cSettings->NUM_TILES_YAXIS, cSettings->NUM_TILES_XAXIS);
+
+		arrPreparedTiles = arrTiles;
+		bLevelPrepared = true;
+	});
 	return true;
 }
 
+/**
+ @brief Check if the level being prepared is ready to be switched to
+ */
+bool CMap2D::IsLevelPrepared(void) const
+{
+	return bLevelPrepared;
+}
+
+/**
+ @brief Get the level which is being prepared
+ */
+unsigned int CMap2D::GetPreparedLevel(void) const
+{
+	return uiPreparedLevel;
+}
+
+/**
+ @brief Switch to the prepared level. If the worker thread has not finished yet, this waits for it
+ @return true if the level was switched, otherwise false if no level was being prepared
+ */
+bool CMap2D::SwitchToPreparedLevel(void)
+{
+	if (!cPrepareThread.joinable())
+		return false;
+	cPrepareThread.join();
+
+	// Swap in the prepared tiles
+	delete[] arrMapInfo[uiPreparedLevel];
+	arrMapInfo[uiPreparedLevel] = arrPreparedTiles;
+	arrPreparedTiles = NULL;
+	bLevelPrepared = false;
+
+	arrValueIndices[uiPreparedLevel].Swap(cPreparedValueIndex);
+	arrSpawnIndices[uiPreparedLevel].Swap(cPreparedSpawnIndex);
+	arrRegions[uiPreparedLevel].Swap(cPreparedRegions);
+	// SetDiagonalMovement() may have been called while the level was being prepared
+	if (uiPreparedNumDirections != m_nrOfDirections)
+	{
+		arrRegions[uiPreparedLevel].Build(	arrMapInfo[uiPreparedLevel],
+											cSettings->NUM_TILES_YAXIS,
+											cSettings->NUM_TILES_XAXIS,
+											m_nrOfDirections);
+	}
+	arrSolidBoards[uiPreparedLevel].Swap(cPreparedSolidBoard);
+
+	// Everything built from this level is now out of date
+	MarkLevelChanged(uiPreparedLevel);
+	SetCurrentLevel(uiPreparedLevel);
+	return true;
+}
+
+/**
+ @brief Get a random tile of a spawn category in the current level. Every tile of the
+		category is equally likely, and no tiles are tried and rejected
+ @param eCategory A const CSpawnCellIndex::SPAWN_CATEGORY variable containing the category
+ @param uirRow An unsigned int variable which will store the row of the tile, where row 0 is the bottom row
+ @param uirCol An unsigned int variable which will store the column of the tile
+ @return true if a tile was found, otherwise false if the level has no tiles of the category
+ */
+bool CMap2D::GetRandomSpawnCell(const CSpawnCellIndex::SPAWN_CATEGORY eCategory,
+								unsigned int& uirRow,
+								unsigned int& uirCol)
+{
+	return arrSpawnIndices[uiCurLevel].Sample(eCategory, cRandom, uirRow, uirCol);
+}
 
 /**
- @brief manhattan calculation method for calculation of h
+ @brief Get a random tile of a spawn category in the current level, within a range of columns
+ @param eCategory A const CSpawnCellIndex::SPAWN_CATEGORY variable containing the category
+ @param uiMinCol A const unsigned int variable containing the first column of the range
+ @param uiMaxCol A const unsigned int variable containing the last column of the range, inclusive
+ @param uirRow An unsigned int variable which will store the row of the tile, where row 0 is the bottom row
+ @param uirCol An unsigned int variable which will store the column of the tile
+ @return true if a tile was found, otherwise false if the range has no tiles of the category
  */
-unsigned int heuristic::manhattan(const glm::vec2& v1, const glm::vec2& v2, int weight)
+bool CMap2D::GetRandomSpawnCell(const CSpawnCellIndex::SPAWN_CATEGORY eCategory,
+								const unsigned int uiMinCol,
+								const unsigned int uiMaxCol,
+								unsigned int& uirRow,
+								unsigned int& uirCol)
 {
-	glm::vec2 delta = v2 - v1;
-	return static_cast<unsigned int>(weight * (delta.x + delta.y));
+	return arrSpawnIndices[uiCurLevel].Sample(eCategory, uiMinCol, uiMaxCol, cRandom, uirRow, uirCol);
 }
 
 /**
- @brief euclidean calculation method for calculation of h
+ @brief Get a random number from a range, from the same generator as the spawn tiles, which is
+		seeded once in Init()
+ @param uiMin A const unsigned int variable containing the smallest number
+ @param uiMax A const unsigned int variable containing the largest number
+ @return A number from uiMin to uiMax, inclusive
  */
-unsigned int heuristic::euclidean(const glm::vec2& v1, const glm::vec2& v2, int weight)
+unsigned int CMap2D::GetRandom(const unsigned int uiMin, const unsigned int uiMax)
 {
-	glm::vec2 delta = v2 - v1;
-	return static_cast<unsigned int>(weight * sqrt((delta.x * delta.x) + (delta.y * delta.y)));
+	std::uniform_int_distribution<unsigned int> cDistribution(uiMin, uiMax);
+	return cDistribution(cRandom);
 }
 
-void CMap2D::spawnchest() {
-	srand((unsigned)time(NULL));
+/**
+ @brief Ask the path request queue for a path which a ground enemy can follow under gravity.
+		The search runs in UpdatePathRequests() over the next frames, and the enemy keeps
+		following the path it had until the new one is ready. A request whose start, target
+		and level have not changed keeps its result, so it can be made every frame
+ @param uirRequest An unsigned int& variable containing the handle of the enemy's request,
+			or CPathRequestQueue::NO_REQUEST to make a new one, which will store the handle
+ @param startPos A const glm::vec2& variable containing the start position
+ @param targetPos A const glm::vec2& variable containing the target position
+ @param bAirborne A const bool variable which is true if the enemy is jumping or falling
+ @param vPath A std::vector<glm::vec2>& variable containing the enemy's path, which will
+			store the newest path from the grid after startPos
+ @return true if there is a path to follow, otherwise false
+ */
+bool CMap2D::RequestPlatformPath(	unsigned int& uirRequest,
+									const glm::vec2& startPos,
+									const glm::vec2& targetPos,
+									const bool bAirborne,
+									std::vector<glm::vec2>& vPath)
+{
+	if (bAirborne && ContinuePath(startPos, vPath))
+		return true;
 
-	float randNumOfChest = rand() % 5 + 3;
-	float numOfChest = 0;
-	while (validposition == false) {
+	if (!isValid(startPos) || !isValid(targetPos))
+	{
+		vPath.clear();
+		return false;
+	}
 
-		yChest = rand() % 31 + 1;
-		xChest = rand() % 23 + 1;
+	// A target which is walled off is turned down without queueing a search
+	if (!IsReachable(startPos, targetPos))
+	{
+		vPath.clear();
+		return false;
+	}
 
-		switch (GetMapInfo(xChest, yChest))
-		{
-		case 0:
+	cPathRequests.Submit(uirRequest, startPos, targetPos, arrMapVersions[uiCurLevel]);
+	if (cPathRequests.GetPath(uirRequest, vPath))
+		return true;
 
-			if (GetMapInfo(xChest - 1, yChest) == 100)
-			{
-				SetMapInfo(xChest, yChest, 105);
-				numOfChest++;
-				if (numOfChest == randNumOfChest)
-					validposition = true;			
-			}
-			else
-				continue;
+	if (cPathRequests.GetStatus(uirRequest) == CPathRequestQueue::REQUEST_FAILED)
+	{
+		vPath.clear();
+		return false;
+	}
+	return ContinuePath(startPos, vPath);
+}
 
-			break;
-		/*
-		case 100:
-			SetMapInfo(xChest, yChest, 105);
-			validposition = true;
-			break;*/
-		default:
-			break;
-		}
+/**
+ @brief Release a request made with RequestPlatformPath()
+ @param uirRequest An unsigned int& variable containing the handle, which will be set to
+			CPathRequestQueue::NO_REQUEST
+ */
+void CMap2D::ReleasePathRequest(unsigned int& uirRequest)
+{
+	cPathRequests.Release(uirRequest);
+}
 
+/**
+ @brief Set the most nodes which the queued path searches can expand in one frame
+ @param uiMaxExpandedPerFrame A const unsigned int variable containing the budget
+ */
+void CMap2D::SetPathBudget(const unsigned int uiMaxExpandedPerFrame)
+{
+	cPathRequests.SetBudget(uiMaxExpandedPerFrame);
+}
+
+/**
+ @brief Run the queued path searches within this frame's budget, with the requests which
+		start closest to the player first. If the path workers are running, the searches are
+		handed to them instead, along with a copy of the graph which is only made again
+		when the level has changed
+ @param playerPos A const glm::vec2& variable containing the position of the player
+ */
+void CMap2D::UpdatePathRequests(const glm::vec2& playerPos)
+{
+	UpdatePlatformNavGraph();
+	if (cPathWorkers.GetNumWorkers() == 0)
+	{
+		cPathRequests.Update(cPlatformNavGraph, arrMapVersions[uiCurLevel], playerPos);
+		return;
 	}
-	validposition = false;
+
+	if (!pPlatformNavSnapshot || !pPlatformNavSnapshot->IsBuiltFor(uiCurLevel, arrMapVersions[uiCurLevel]))
+		pPlatformNavSnapshot = make_shared<const CPlatformNavGraph>(cPlatformNavGraph);
+	cPathRequests.Dispatch(cPathWorkers, pPlatformNavSnapshot, playerPos);
 }
-void CMap2D::spawntree() {
-	srand(time(NULL));
 
-	while (validposition1 == false) {
+/**
+ @brief Start worker threads for the queued path searches. With no workers, the searches are
+		run on the main thread within the budget set by SetPathBudget()
+ @param uiNumWorkers A const unsigned int variable containing the number of workers
+ */
+void CMap2D::StartPathWorkers(const unsigned int uiNumWorkers)
+{
+	cPathWorkers.Start(uiNumWorkers);
+	if (uiNumWorkers == 0)
+		pPlatformNavSnapshot.reset();
+}
 
-		yTree = rand() % 31 + 1;
-		xTree = rand() % 23 + 1;
+/**
+ @brief Store the paths which the path workers have finished, so the enemies can pick them up
+		with RequestPlatformPath(). This is called at the start of a frame
+ */
+void CMap2D::CollectPathResults(void)
+{
+	cPathRequests.Collect(cPathWorkers);
+}
 
-		switch (GetMapInfo(xTree, yTree))
-		{
-		case 0:
+/**
+ @brief Bring the platform navigation graph up to date with the current level. Only the links
+		around the chunks which have changed since the graph was built are built again
+ */
+void CMap2D::UpdatePlatformNavGraph(void)
+{
+	const unsigned int uiVersion = arrMapVersions[uiCurLevel];
+	if (cPlatformNavGraph.IsBuiltFor(uiCurLevel, uiVersion))
+		return;
 
-			if (GetMapInfo(xTree - 1, yTree) == 100)
-			{
-				SetMapInfo(xTree, yTree, 106);
+	unsigned int uiMinRow, uiMinCol, uiMaxRow, uiMaxCol;
+	if (cPlatformNavGraph.IsBuiltFor(uiCurLevel) &&
+		GetChangedRegion(uiCurLevel, cPlatformNavGraph.GetVersion(), uiMinRow, uiMinCol, uiMaxRow, uiMaxCol))
+	{
+		cPlatformNavGraph.Update(arrMapInfo[uiCurLevel], uiMinRow, uiMinCol, uiMaxCol, uiVersion);
+	}
+	else
+	{
+		cPlatformNavGraph.Build(arrMapInfo[uiCurLevel],
+								cSettings->NUM_TILES_YAXIS,
+								cSettings->NUM_TILES_XAXIS,
+								uiCurLevel,
+								uiVersion);
+	}
+}
 
-				validposition1 = true;
-			}
-			else
-				continue;
+/**
+ @brief Bring the clusters for Hierarchical Path Finding up to date with the current level.
+		The clusters are the same as the chunks whose versions SetMapInfo() bumps, so only the
+		clusters which a change touched, and their neighbours, are built again
+ */
+void CMap2D::UpdateHierarchicalMap(void)
+{
+	cHierarchicalMap.Update(arrMapInfo[uiCurLevel],
+							cSettings->NUM_TILES_YAXIS,
+							cSettings->NUM_TILES_XAXIS,
+							CHUNK_SIZE,
+							m_nrOfDirections,
+							uiCurLevel,
+							arrChunkVersions[uiCurLevel]);
+}
 
-			break;
-			
-		default:
+/**
+ @brief Drop the tiles of a path up to a position, so an enemy in the air finishes the move it
+		started. The path is left as it is if the position is not on it yet
+ @return true if there is still some path to follow, otherwise false
+ */
+bool CMap2D::ContinuePath(const glm::vec2& pos, std::vector<glm::vec2>& vPath)
+{
+	for (unsigned int i = 0; i < vPath.size(); i++)
+	{
+		if (vPath[i] == pos)
+		{
+			vPath.erase(vPath.begin(), vPath.begin() + i + 1);
 			break;
 		}
-
 	}
-	validposition1 = false;
-}
\ No newline at end of file
+	return !vPath.empty();
+}
+
+/**
+ @brief Wait for the worker thread and discard the prepared level
+ */
+void CMap2D::CancelPreparedLevel(void)
+{
+	if (cPrepareThread.joinable())
+		cPrepareThread.join();
+
+	delete[] arrPreparedTiles;
+	arrPreparedTiles = NULL;
+	bLevelPrepared = false;
+}
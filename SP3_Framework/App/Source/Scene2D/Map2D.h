@@ -31,9 +31,36 @@
 // Include Entity2D
 #include "Primitives/Entity2D.h"
 
-// Include files for AStar
-#include <queue>
-#include <functional>
+// Include CTileMapRenderer
+#include "TileMapRenderer.h"
+// Include CMapWriter
+#include "MapWriter.h"
+// Include CTileValueIndex
+#include "TileValueIndex.h"
+// Include CSpawnCellIndex
+#include "SpawnCellIndex.h"
+// Include CConnectivityRegions
+#include "ConnectivityRegions.h"
+// Include CTileRaycaster
+#include "TileRaycaster.h"
+// Include CSolidBitboard
+#include "SolidBitboard.h"
+
+// Include CGridSearch
+#include "GridSearch.h"
+// Include CHierarchicalMap
+#include "HierarchicalMap.h"
+// Include CPlatformNavGraph
+#include "PlatformNavGraph.h"
+// Include CPathRequestQueue
+#include "PathRequestQueue.h"
+// Include CPathWorkerPool
+#include "PathWorkerPool.h"
+
+// Include files for preparing levels in the background
+#include <thread>
+#include <atomic>
+#include <random>
 
 // A structure storing information about Map Sizes
 struct MapSize {
@@ -41,41 +68,18 @@ struct MapSize {
 	unsigned int uiColSize;
 };
 
-// A structure storing information about a map grid
-// It includes data to be used for A* Path Finding
-struct Grid {
-	unsigned int value;
-
-	Grid() 
-		: value(0), pos(0, 0), parent(-1, -1), f(0), g(0), h(0) {}
-	Grid(	const glm::vec2& pos, unsigned int f) 
-		: value(0), pos(pos), parent(-1, 1), f(f), g(0), h(0) {}
-	Grid(	const glm::vec2& pos, const glm::vec2& parent, 
-			unsigned int f, unsigned int g, unsigned int h) 
-		: value(0), pos(pos), parent(parent), f(f), g(g), h(h) {}
-
-	glm::vec2 pos;
-	glm::vec2 parent;
-	unsigned int f;
-	unsigned int g;
-	unsigned int h;
-};
-
-using HeuristicFunction = 
-	std::function<unsigned int(const glm::vec2&, const glm::vec2&, int)>;
-// Reverse std::priority_queue to get the largest f value on top
-inline bool operator< (const Grid& a, const Grid& b) { return b.f < a.f; }
-
-namespace heuristic
-{
-	unsigned int manhattan(const glm::vec2& v1, const glm::vec2& v2, int weight);
-	unsigned int euclidean(const glm::vec2& v1, const glm::vec2& v2, int weight);
-}
-
 class CMap2D : public CSingletonTemplate<CMap2D>, public CEntity2D
 {
 	friend CSingletonTemplate<CMap2D>;
 public:
+	// The searches which PathFind() can use
+	enum SEARCH_MODE
+	{
+		SEARCH_ASTAR = 0,
+		SEARCH_JUMP_POINT,
+		NUM_SEARCH_MODES
+	};
+
 	// Init
 	bool Init(	const unsigned int uiNumLevels = 1,
 				const unsigned int uiNumRows = 24,
@@ -103,27 +107,96 @@ public:
 	// Get the value at certain indices in the arrMapInfo
 	int GetMapInfo(const unsigned int uiRow, const unsigned int uiCol, const bool bInvert = true) const;
 
+	// Check if a tile of the current level is solid
+	bool IsSolid(const unsigned int uiRow, const unsigned int uiCol, const bool bInvert = true) const;
+	// Check if any tile in a span of columns of a row of the current level is solid
+	bool AnySolid(	const unsigned int uiRow,
+					const unsigned int uiFirstCol,
+					const unsigned int uiLastCol,
+					const bool bInvert = true) const;
+
 	// Load a map
 	bool LoadMap(string filename, const unsigned int uiLevel = 0);
 
-	// Save a tilemap
+	// Save a tilemap in the background
 	bool SaveMap(string filename, const unsigned int uiLevel = 0);
+	// Check if any map is still being saved
+	bool IsSaving(void);
 
 	// Find the indices of a certain value in arrMapInfo
 	bool FindValue(const int iValue, unsigned int& uirRow, unsigned int& uirCol, const bool bInvert = true);
+	// Find the indices of all the tiles with a certain value in arrMapInfo
+	bool FindAllValues(const int iValue, std::vector<glm::i32vec2>& vPositions, const bool bInvert = true) const;
 
 	// Set current level
 	void SetCurrentLevel(unsigned int uiCurLevel);
 	// Get current level
 	unsigned int GetCurrentLevel(void) const;
 
-	// For AStar PathFinding
-	std::vector<glm::vec2> PathFind(	const glm::vec2& startPos, 
-										const glm::vec2& targetPos, 
-										HeuristicFunction heuristicFunc, 
-										const int weight = 1);
-	// Set if AStar PathFinding will consider diagonal movements
+	// Get the version of the current level, which changes whenever a tile in it changes
+	unsigned int GetMapVersion(void) const;
+	// Get the version of a level, which changes whenever a tile in it changes
+	unsigned int GetMapVersion(const unsigned int uiLevel) const;
+	// Get the region of a level which has changed since a version
+	bool GetChangedRegion(	const unsigned int uiLevel,
+							const unsigned int uiSinceVersion,
+							unsigned int& uirMinRow, unsigned int& uirMinCol,
+							unsigned int& uirMaxRow, unsigned int& uirMaxCol,
+							const bool bInvert = true) const;
+
+	// Check if two positions are in the same region of open tiles, so a path could join them
+	bool IsReachable(const glm::vec2& startPos, const glm::vec2& targetPos) const;
+
+	// Cast a ray through the tiles of the current level, stopping at the first solid tile
+	bool Raycast(const glm::vec2& startPos, const glm::vec2& targetPos, CTileRaycaster::RaycastHit& sHit) const;
+	// Cast many rays through the tiles of the current level
+	unsigned int Raycast(	const std::vector<CTileRaycaster::Ray>& vRays,
+							std::vector<CTileRaycaster::RaycastHit>& vHits) const;
+	// Check if no solid tile is between the centres of two tiles, remembering the answer for this frame
+	bool HasLineOfSight(const glm::vec2& startIndex, const glm::vec2& targetIndex);
+
+	// For AStar PathFinding, using the caller's search context and path buffer
+	template <typename Heuristic>
+	bool PathFind(	AStarContext& context,
+					const glm::vec2& startPos, 
+					const glm::vec2& targetPos, 
+					std::vector<glm::vec2>& vPath,
+					const int weight = 1) const;
+	// Find a long path over the clusters of the current level with Hierarchical Path Finding,
+	// which costs far less than PathFind() for long-range queries
+	bool FindHierarchicalPath(const glm::vec2& startPos, const glm::vec2& targetPos, std::vector<glm::vec2>& vPath);
+	// Set the jump of the ground enemies, which decides the jump links of the platform navigation graph
+	void SetJumpArc(const glm::vec2& v2JumpVelocity);
+	// Point the ground enemies' shared platform field at a target
+	void UpdatePlatformField(const glm::vec2& targetPos);
+	// Get the path which a ground enemy can follow under gravity to the target of the platform field
+	bool GetPlatformPath(const glm::vec2& startPos, const bool bAirborne, std::vector<glm::vec2>& vPath);
+	// Find a path which a ground enemy can follow under gravity, with A* over the platform navigation graph
+	bool PlatformPathFind(	AStarContext& context,
+							const glm::vec2& startPos,
+							const glm::vec2& targetPos,
+							const bool bAirborne,
+							std::vector<glm::vec2>& vPath);
+	// Ask the path request queue for a path which a ground enemy can follow under gravity
+	bool RequestPlatformPath(	unsigned int& uirRequest,
+								const glm::vec2& startPos,
+								const glm::vec2& targetPos,
+								const bool bAirborne,
+								std::vector<glm::vec2>& vPath);
+	// Release a request made with RequestPlatformPath()
+	void ReleasePathRequest(unsigned int& uirRequest);
+	// Set the most nodes which the queued path searches can expand in one frame
+	void SetPathBudget(const unsigned int uiMaxExpandedPerFrame);
+	// Run the queued path searches within this frame's budget, or hand them to the path workers
+	void UpdatePathRequests(const glm::vec2& playerPos);
+	// Start worker threads for the queued path searches, or none to run them on the main thread
+	void StartPathWorkers(const unsigned int uiNumWorkers);
+	// Store the paths which the path workers have finished
+	void CollectPathResults(void);
+	// Set if PathFinding will consider diagonal movements, and pick the faster search for it
 	void SetDiagonalMovement(const bool bEnable);
+	// Set the search which PathFind() uses
+	void SetSearchMode(const SEARCH_MODE eSearchMode);
 	// Print out details about this class instance in the console window
 	void PrintSelf(void) const;
 
@@ -131,27 +204,89 @@ public:
 	void spawnchest(void);
 	void spawntree(void);
 
+	// Start preparing a level on a worker thread, so that it can be switched to without a pause
+	bool PrepareLevel(const unsigned int uiLevel);
+	// Check if the level being prepared is ready to be switched to
+	bool IsLevelPrepared(void) const;
+	// Get the level which is being prepared
+	unsigned int GetPreparedLevel(void) const;
+	// Switch to the prepared level
+	bool SwitchToPreparedLevel(void);
+
+	// Get a random tile of a spawn category in the current level
+	bool GetRandomSpawnCell(const CSpawnCellIndex::SPAWN_CATEGORY eCategory,
+							unsigned int& uirRow,
+							unsigned int& uirCol);
+	// Get a random tile of a spawn category in the current level, within a range of columns
+	bool GetRandomSpawnCell(const CSpawnCellIndex::SPAWN_CATEGORY eCategory,
+							const unsigned int uiMinCol,
+							const unsigned int uiMaxCol,
+							unsigned int& uirRow,
+							unsigned int& uirCol);
+	// Get a random number from a range, from the same generator as the spawn tiles
+	unsigned int GetRandom(const unsigned int uiMin, const unsigned int uiMax);
+
 protected:
 	// The variable containing the rapidcsv::Document
 	// We will load the CSV file's content into this Document
 	rapidcsv::Document doc;
 
-	// A 3-D array which stores the values of the tile map
-	Grid*** arrMapInfo;
+	// A 1-D array of levels, where each level stores its tile values in one
+	// contiguous row-major array. Row 0 is the bottom row of the screen
+	unsigned short** arrMapInfo;
 
 	// The current level
 	unsigned int uiCurLevel;
 	// The number of levels
 	unsigned int uiNumLevels;
 
+	// A 1-D array which stores the index from tile values to positions for each level
+	CTileValueIndex* arrValueIndices;
+	// A 1-D array which stores the index of the tiles where things can be spawned for each level
+	CSpawnCellIndex* arrSpawnIndices;
+	// A 1-D array which stores the connected regions of open tiles for each level
+	CConnectivityRegions* arrRegions;
+	// A 1-D array which stores the solid tiles as packed bits for each level
+	CSolidBitboard* arrSolidBoards;
+
 	// A 1-D array which stores the map sizes for each level
 	MapSize* arrMapSizes;
 
-	// Map containing texture IDs
-	map<int, int> MapOfTextureIDs;
-
-	//CS: The quadMesh for drawing the tiles
-	CMesh* quadMesh;
+	// The texture array containing the images of all the tile types
+	unsigned int uiTileTextureArrayID;
+	// A lookup table from a tile value to its layer in the texture array, or -1 if it has no image
+	vector<int> vTileLayers;
+
+	// The number of tiles along each side of a change tracking chunk
+	static const unsigned int CHUNK_SIZE = 8;
+	// The number of chunks along each axis
+	unsigned int uiNumChunkRows;
+	unsigned int uiNumChunkCols;
+	// A 1-D array which stores the version of each level
+	unsigned int* arrMapVersions;
+	// A 2-D array which stores the version at which each chunk of each level last changed
+	unsigned int** arrChunkVersions;
+
+	// A line of sight check which was made this frame
+	struct LineOfSightEntry
+	{
+		unsigned long long ullKey;
+		unsigned int uiFrame;
+		unsigned int uiLevel;
+		unsigned int uiVersion;
+		bool bVisible;
+	};
+	// The number of line of sight checks which are remembered in a frame
+	static const unsigned int LINE_OF_SIGHT_CACHE_SIZE = 256;
+	// The line of sight checks of this frame, indexed by a hash of their tiles
+	LineOfSightEntry arrLineOfSightCache[LINE_OF_SIGHT_CACHE_SIZE];
+	// The frame which the line of sight checks are remembered for
+	unsigned int uiLineOfSightFrame;
+
+	// A 1-D array which stores the batched tile renderer for each level
+	CTileMapRenderer** arrTileMapRenderers;
+	// A 1-D array which stores the level version which each batched tile renderer was built from
+	unsigned int* arrTileMapVersions;
 
 	// Constructor
 	CMap2D(void);
@@ -159,12 +294,18 @@ protected:
 	// Destructor
 	virtual ~CMap2D(void);
 
-	// Render a tile
-	void RenderTile(const unsigned int uiRow, const unsigned int uiCol);
+	// Record a change to a tile of a level
+	void MarkChanged(const unsigned int uiLevel, const unsigned int uiRow, const unsigned int uiCol);
+	// Record a change to every tile of a level
+	void MarkLevelChanged(const unsigned int uiLevel);
+
+	// Load a cooked binary map
+	bool LoadBinaryMap(const string& filename, const unsigned int uiLevel);
+
+	// Rebuild the changed part of the batched tiles of a level
+	void RebuildTileMap(const unsigned int uiLevel);
 
 	// For A-Star PathFinding
-	// Build a path from m_cameFromList after calling PathFind()
-	std::vector<glm::vec2> BuildPath() const;
 	// Check if a grid is valid
 	bool isValid(const glm::vec2& pos) const;
 	// Check if a grid is blocked
@@ -174,33 +315,98 @@ protected:
 	// Convert a position to a 1D position in the array
 	int ConvertTo1D(const glm::vec2& pos) const;
 
-	// Delete AStar lists
-	bool DeleteAStarLists(void);
-	// Reset AStar lists
-	bool ResetAStarLists(void);
-
 	// Variables for A-Star PathFinding
-	int m_weight;
 	unsigned int m_nrOfDirections;
-	glm::vec2 m_startPos;
-	glm::vec2 m_targetPos;
-
-	// The handle for heuristic functions
-	HeuristicFunction m_heuristic;
-
-	// Lists for A-Star PathFinding
-	std::priority_queue<Grid> m_openList;
-	std::vector<bool> m_closedList;
-	std::vector<Grid> m_cameFromList;
-	std::vector<glm::vec2> m_directions;
+	SEARCH_MODE m_searchMode;
+
+	// The clusters of the current level for Hierarchical Path Finding, kept up to date by SetMapInfo()
+	CHierarchicalMap cHierarchicalMap;
+
+	// The walk, jump and fall links of the current level for the ground enemies, built as they are needed
+	CPlatformNavGraph cPlatformNavGraph;
+	// The path searches of the enemies, which are run a little every frame
+	CPathRequestQueue cPathRequests;
+	// The threads which run the path searches when there are cores to spare
+	CPathWorkerPool cPathWorkers;
+	// The copy of the platform navigation graph which the path workers search
+	std::shared_ptr<const CPlatformNavGraph> pPlatformNavSnapshot;
+
+	// Bring the platform navigation graph up to date with the current level
+	void UpdatePlatformNavGraph(void);
+	// Bring the clusters for Hierarchical Path Finding up to date with the current level
+	void UpdateHierarchicalMap(void);
+	// Drop the tiles of a path up to a position, so an enemy in the air finishes the move it started
+	static bool ContinuePath(const glm::vec2& pos, std::vector<glm::vec2>& vPath);
 
 	
-	bool validposition;
-	bool validposition1;
-	int xTree;
-	int yTree;
-	int xChest;
-	int yChest;
-	
+	// The random number generator for spawning items on the main thread
+	std::mt19937 cRandom;
+
+	// Place the chests and trees for a new level into its tiles
+	void PopulateLevel(unsigned short* arrTiles, CSpawnCellIndex& cSpawnIndex, std::mt19937& cGenerator) const;
+
+	// Variables for preparing a level in the background
+	std::thread cPrepareThread;
+	// The level being prepared, and its tiles once the worker thread has finished
+	unsigned int uiPreparedLevel;
+	unsigned short* arrPreparedTiles;
+	CTileValueIndex cPreparedValueIndex;
+	CSpawnCellIndex cPreparedSpawnIndex;
+	CConnectivityRegions cPreparedRegions;
+	CSolidBitboard cPreparedSolidBoard;
+	// The number of directions which the prepared regions join tiles in
+	unsigned int uiPreparedNumDirections;
+	std::atomic<bool> bLevelPrepared;
+
+	// Wait for the worker thread and discard the prepared level
+	void CancelPreparedLevel(void);
+
+	// The background writer for SaveMap()
+	CMapWriter cMapWriter;
 };
 
+/**
+ @brief Find a path, with the search selected by SetSearchMode(). The search only reads the
+		tiles and its own context, so searches with different contexts can run at the same
+		time, as long as the map is not being changed. Once the context and the path buffer
+		have grown to the size of the map, a search does not allocate memory
+ @param context An AStarContext& variable containing the scratch data of the search
+ @param startPos A const glm::vec2& variable containing the start position
+ @param targetPos A const glm::vec2& variable containing the target position
+ @param vPath A std::vector<glm::vec2>& variable which will store the path, from the grid
+			after startPos to targetPos
+ @param weight A const int variable containing the weight of the heuristic
+ @return true if a path was found, otherwise false
+ */
+template <typename Heuristic>
+bool CMap2D::PathFind(	AStarContext& context,
+						const glm::vec2& startPos,
+						const glm::vec2& targetPos,
+						std::vector<glm::vec2>& vPath,
+						const int weight) const
+{
+	// Check if the startPos and targetPost are blocked. Nothing is printed, since other
+	// threads may be searching at the same time
+	if (!isValid(startPos) || !isValid(targetPos) ||
+		isBlocked(startPos.y, startPos.x) ||
+		isBlocked(targetPos.y, targetPos.x))
+	{
+		vPath.clear();
+		return false;
+	}
+
+	// There is nothing to search if the target is walled off from the start
+	if (!IsReachable(startPos, targetPos))
+	{
+		vPath.clear();
+		return false;
+	}
+
+	const CGridSearch cGridSearch(	arrMapInfo[uiCurLevel],
+									cSettings->NUM_TILES_YAXIS,
+									cSettings->NUM_TILES_XAXIS,
+									m_nrOfDirections);
+	if (m_searchMode == SEARCH_JUMP_POINT)
+		return cGridSearch.JumpPoint<Heuristic>(context, startPos, targetPos, vPath, weight);
+	return cGridSearch.AStar<Heuristic>(context, startPos, targetPos, vPath, weight);
+}
@@ -0,0 +1,163 @@
+/**
+ CMapWriter
+ @brief A class which writes snapshots of tile maps to CSV files on a background thread.
+		Each file is written to a temporary file first and then renamed over the old one,
+		so a save which is interrupted never leaves a half-written map behind.
+		If a file is saved again before its previous snapshot was written, only the
+		latest snapshot is written.
+ */
+#include "MapWriter.h"
+
+#ifdef _WIN32
+	#include <windows.h>
+#endif
+
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+using namespace std;
+
+/**
+ @brief Constructor
+ */
+CMapWriter::CMapWriter(void)
+	: uiNumWriting(0)
+	, bStopWriting(false)
+{
+	cWriterThread = thread(&CMapWriter::WriterThread, this);
+}
+
+/**
+ @brief Destructor. The queued snapshots are written before the writer thread stops
+ */
+CMapWriter::~CMapWriter(void)
+{
+	{
+		lock_guard<mutex> lock(cWriterMutex);
+		bStopWriting = true;
+	}
+	cWriterCondition.notify_one();
+	if (cWriterThread.joinable())
+		cWriterThread.join();
+}
+
+/**
+ @brief Queue a snapshot of a tile map to be written to a file. The tiles are copied,
+		so the caller can keep changing them straight away
+ @param filename A const std::string& variable containing the full path of the file
+ @param arrTiles A const unsigned short* variable containing the tiles, where row 0 is the bottom row
+ @param uiNumRows A const unsigned int variable containing the number of rows
+ @param uiNumCols A const unsigned int variable containing the number of columns
+ */
+void CMapWriter::Save(	const std::string& filename,
+						const unsigned short* arrTiles,
+						const unsigned int uiNumRows,
+						const unsigned int uiNumCols)
+{
+	// Copy the tiles outside the lock, so the writer thread is never held up by it
+	shared_ptr<MapSnapshot> sSnapshot = make_shared<MapSnapshot>();
+	sSnapshot->vTiles.assign(arrTiles, arrTiles + uiNumRows * uiNumCols);
+	sSnapshot->uiNumRows = uiNumRows;
+	sSnapshot->uiNumCols = uiNumCols;
+
+	{
+		lock_guard<mutex> lock(cWriterMutex);
+		// Replace any older snapshot of the same file which has not been written yet
+		MapOfPendingSaves[filename] = sSnapshot;
+	}
+	cWriterCondition.notify_one();
+}
+
+/**
+ @brief Check if any snapshot is queued or being written
+ */
+bool CMapWriter::IsBusy(void)
+{
+	lock_guard<mutex> lock(cWriterMutex);
+	return !MapOfPendingSaves.empty() || (uiNumWriting > 0);
+}
+
+/**
+ @brief Wait until all the queued snapshots have been written
+ */
+void CMapWriter::Flush(void)
+{
+	unique_lock<mutex> lock(cWriterMutex);
+	cIdleCondition.wait(lock, [this] { return MapOfPendingSaves.empty() && (uiNumWriting == 0); });
+}
+
+/**
+ @brief The loop of the writer thread
+ */
+void CMapWriter::WriterThread(void)
+{
+	unique_lock<mutex> lock(cWriterMutex);
+	while (true)
+	{
+		cWriterCondition.wait(lock, [this] { return bStopWriting || !MapOfPendingSaves.empty(); });
+
+		// Stop once everything queued has been written
+		if (MapOfPendingSaves.empty())
+			return;
+
+		// Take the next snapshot and write it without holding the lock
+		string filename = MapOfPendingSaves.begin()->first;
+		shared_ptr<const MapSnapshot> sSnapshot = MapOfPendingSaves.begin()->second;
+		MapOfPendingSaves.erase(MapOfPendingSaves.begin());
+		uiNumWriting++;
+
+		lock.unlock();
+		if (WriteSnapshot(filename, *sSnapshot) == false)
+			cout << "CMapWriter : Unable to save the map to " << filename << endl;
+		lock.lock();
+
+		uiNumWriting--;
+		if (MapOfPendingSaves.empty())
+			cIdleCondition.notify_all();
+	}
+}
+
+/**
+ @brief Write a snapshot to a temporary file, in the same CSV layout as the level maps,
+		and then replace the file with it
+ @param filename A const std::string& variable containing the full path of the file
+ @param sSnapshot A const MapSnapshot& variable containing the snapshot to write
+ */
+bool CMapWriter::WriteSnapshot(const std::string& filename, const MapSnapshot& sSnapshot) const
+{
+	const string strTempFilename = filename + ".tmp";
+	{
+		ofstream file(strTempFilename.c_str());
+		if (!file.is_open())
+			return false;
+
+		// Write the header row
+		file << "//";
+		for (unsigned int uiCol = 0; uiCol < sSnapshot.uiNumCols; uiCol++)
+		{
+			file << (uiCol + 1) << ((uiCol != sSnapshot.uiNumCols - 1) ? "," : "\n");
+		}
+
+		// Write the rows from the top down
+		for (unsigned int uiRow = sSnapshot.uiNumRows; uiRow-- > 0; )
+		{
+			const unsigned short* arrRow = &sSnapshot.vTiles[uiRow * sSnapshot.uiNumCols];
+			for (unsigned int uiCol = 0; uiCol < sSnapshot.uiNumCols; uiCol++)
+			{
+				file << arrRow[uiCol] << ((uiCol != sSnapshot.uiNumCols - 1) ? "," : "\n");
+			}
+		}
+
+		file.flush();
+		if (!file.good())
+			return false;
+	}
+
+	// Replace the old file in one step
+#ifdef _WIN32
+	return MoveFileExA(strTempFilename.c_str(), filename.c_str(),
+						MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != FALSE;
+#else
+	return rename(strTempFilename.c_str(), filename.c_str()) == 0;
+#endif
+}
@@ -0,0 +1,65 @@
+/**
+ CMapWriter
+ @brief A class which writes snapshots of tile maps to CSV files on a background thread.
+		Each file is written to a temporary file first and then renamed over the old one,
+		so a save which is interrupted never leaves a half-written map behind.
+		If a file is saved again before its previous snapshot was written, only the
+		latest snapshot is written.
+ */
+#pragma once
+
+#include <string>
+#include <map>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <memory>
+
+class CMapWriter
+{
+public:
+	// Constructor
+	CMapWriter(void);
+
+	// Destructor
+	virtual ~CMapWriter(void);
+
+	// Queue a snapshot of a tile map to be written to a file
+	void Save(	const std::string& filename,
+				const unsigned short* arrTiles,
+				const unsigned int uiNumRows,
+				const unsigned int uiNumCols);
+
+	// Check if any snapshot is queued or being written
+	bool IsBusy(void);
+
+	// Wait until all the queued snapshots have been written
+	void Flush(void);
+
+protected:
+	// A structure storing a snapshot of a tile map. Row 0 is the bottom row
+	struct MapSnapshot {
+		std::vector<unsigned short> vTiles;
+		unsigned int uiNumRows;
+		unsigned int uiNumCols;
+	};
+
+	// The snapshots waiting to be written, keyed by the full path of their file
+	std::map<std::string, std::shared_ptr<const MapSnapshot> > MapOfPendingSaves;
+	// The number of snapshots being written right now
+	unsigned int uiNumWriting;
+
+	// The writer thread and the variables shared with it
+	std::thread cWriterThread;
+	std::mutex cWriterMutex;
+	std::condition_variable cWriterCondition;
+	std::condition_variable cIdleCondition;
+	bool bStopWriting;
+
+	// The loop of the writer thread
+	void WriterThread(void);
+
+	// Write a snapshot to a file
+	bool WriteSnapshot(const std::string& filename, const MapSnapshot& sSnapshot) const;
+};
@@ -0,0 +1,313 @@
+/**
+ CPathRequestQueue
+ @brief A class which runs the path searches of the enemies a little at a time, within a
+		budget of expanded nodes per frame, with the requests closest to the player first.
+ */
+#include "PathRequestQueue.h"
+
+#include <algorithm>
+using namespace std;
+
+const unsigned int CPathRequestQueue::NO_REQUEST;
+
+/**
+ @brief Constructor
+ */
+CPathRequestQueue::CPathRequestQueue(void)
+	: uiBudget(256)
+	, uiNumExpanded(0)
+	, uiLastTicket(0)
+{
+}
+
+/**
+ @brief Destructor
+ */
+CPathRequestQueue::~CPathRequestQueue(void)
+{
+}
+
+/**
+ @brief Set the most nodes which the searches can expand in one frame. At least one node is
+		expanded every frame, so the requests are always answered in the end
+ @param uiMaxExpandedPerFrame A const unsigned int variable containing the budget
+ */
+void CPathRequestQueue::SetBudget(const unsigned int uiMaxExpandedPerFrame)
+{
+	uiBudget = (uiMaxExpandedPerFrame > 0) ? uiMaxExpandedPerFrame : 1;
+}
+
+/**
+ @brief Get the most nodes which the searches can expand in one frame
+ */
+unsigned int CPathRequestQueue::GetBudget(void) const
+{
+	return uiBudget;
+}
+
+/**
+ @brief Submit a request for a path. If the request was already made with the same start,
+		target and version of the level, its result or its running search is kept
+ @param uirRequest An unsigned int& variable containing the handle of the caller's request,
+			or NO_REQUEST to make a new one, which will store the handle
+ @param startPos A const glm::vec2& variable containing the start position
+ @param targetPos A const glm::vec2& variable containing the target position
+ @param uiVersion A const unsigned int variable containing the version of the level
+ */
+void CPathRequestQueue::Submit(	unsigned int& uirRequest,
+								const glm::vec2& startPos,
+								const glm::vec2& targetPos,
+								const unsigned int uiVersion)
+{
+	Request* pRequest = GetRequest(uirRequest);
+	if (pRequest == NULL)
+	{
+		// Reuse the slot of a released request if there is one
+		if (!vFreeSlots.empty())
+		{
+			uirRequest = vFreeSlots.back() + 1;
+			vFreeSlots.pop_back();
+		}
+		else
+		{
+			vRequests.push_back(Request());
+			uirRequest = (unsigned int)vRequests.size();
+		}
+		pRequest = &vRequests[uirRequest - 1];
+		pRequest->bUsed = true;
+	}
+	else if ((pRequest->eStatus != REQUEST_NONE) &&
+			(pRequest->startPos == startPos) &&
+			(pRequest->targetPos == targetPos) &&
+			(pRequest->uiVersion == uiVersion))
+	{
+		return;
+	}
+
+	pRequest->eStatus = REQUEST_PENDING;
+	pRequest->startPos = startPos;
+	pRequest->targetPos = targetPos;
+	pRequest->uiVersion = uiVersion;
+	pRequest->bStarted = false;
+	pRequest->bDispatched = false;
+}
+
+/**
+ @brief Get the state of a request
+ */
+CPathRequestQueue::REQUEST_STATUS CPathRequestQueue::GetStatus(const unsigned int uiRequest) const
+{
+	const Request* pRequest = GetRequest(uiRequest);
+	return (pRequest != NULL) ? pRequest->eStatus : REQUEST_NONE;
+}
+
+/**
+ @brief Get the path of a request which is ready
+ @param uiRequest A const unsigned int variable containing the handle of the request
+ @param vPath A std::vector<glm::vec2>& variable which will store the path, from the grid
+			after the start position of the request to its target
+ @return true if the request is ready, otherwise false and vPath is not changed
+ */
+bool CPathRequestQueue::GetPath(const unsigned int uiRequest, std::vector<glm::vec2>& vPath) const
+{
+	const Request* pRequest = GetRequest(uiRequest);
+	if ((pRequest == NULL) || (pRequest->eStatus != REQUEST_READY))
+		return false;
+
+	vPath = pRequest->vPath;
+	return true;
+}
+
+/**
+ @brief Release a request, so that its slot can be reused. The memory of its search is kept
+		for the next request in the slot
+ @param uirRequest An unsigned int& variable containing the handle, which will be set to NO_REQUEST
+ */
+void CPathRequestQueue::Release(unsigned int& uirRequest)
+{
+	Request* pRequest = GetRequest(uirRequest);
+	if (pRequest != NULL)
+	{
+		pRequest->bUsed = false;
+		pRequest->eStatus = REQUEST_NONE;
+		pRequest->bDispatched = false;
+		pRequest->vPath.clear();
+		vFreeSlots.push_back(uirRequest - 1);
+	}
+	uirRequest = NO_REQUEST;
+}
+
+/**
+ @brief Run the pending searches, with the requests whose start is closest to the player
+		first, until the budget of this frame is used up. A search which was started for an
+		older version of the level is started again, since the graph has changed under it
+ @param cPlatformNavGraph A const CPlatformNavGraph& variable containing the graph to search,
+			which must be up to date with uiVersion
+ @param uiVersion A const unsigned int variable containing the version of the level
+ @param playerPos A const glm::vec2& variable containing the position of the player
+ */
+void CPathRequestQueue::Update(	const CPlatformNavGraph& cPlatformNavGraph,
+								const unsigned int uiVersion,
+								const glm::vec2& playerPos)
+{
+	uiNumExpanded = 0;
+
+	SortPending(playerPos);
+	for (unsigned int i = 0; (i < vOrder.size()) && (uiNumExpanded < uiBudget); i++)
+	{
+		Request& sRequest = vRequests[vOrder[i].second];
+		if (!sRequest.bStarted || (sRequest.uiVersion != uiVersion))
+		{
+			sRequest.uiVersion = uiVersion;
+			sRequest.bStarted = cPlatformNavGraph.BeginSearch(	sRequest.context,
+																sRequest.startPos,
+																sRequest.targetPos,
+																sRequest.uiStartIndex,
+																sRequest.uiTargetIndex);
+			if (!sRequest.bStarted)
+			{
+				sRequest.eStatus = REQUEST_FAILED;
+				sRequest.vPath.clear();
+				continue;
+			}
+		}
+
+		const unsigned int uiExpandedBefore = sRequest.context.uiNumExpanded;
+		const CPlatformNavGraph::SEARCH_STATUS eStatus = cPlatformNavGraph.ContinueSearch(
+			sRequest.context, sRequest.uiTargetIndex, uiBudget - uiNumExpanded);
+		uiNumExpanded += sRequest.context.uiNumExpanded - uiExpandedBefore;
+
+		if (eStatus == CPlatformNavGraph::SEARCH_FOUND)
+		{
+			cPlatformNavGraph.GetSearchPath(sRequest.context,
+											sRequest.startPos,
+											sRequest.uiStartIndex,
+											sRequest.uiTargetIndex,
+											sRequest.vPath);
+			sRequest.eStatus = REQUEST_READY;
+		}
+		else if (eStatus == CPlatformNavGraph::SEARCH_FAILED)
+		{
+			sRequest.vPath.clear();
+			sRequest.eStatus = REQUEST_FAILED;
+		}
+	}
+}
+
+/**
+ @brief Hand the pending requests to worker threads, with the requests whose start is closest
+		to the player first. A request is dispatched once, unless the graph has changed
+		since, and then it is dispatched again with a new ticket so its older result is dropped
+ @param cWorkers A CPathWorkerPool& variable containing the workers
+ @param pNavGraph A const std::shared_ptr<const CPlatformNavGraph>& variable containing a copy
+			of the graph, which must not be changed while the workers hold it
+ @param playerPos A const glm::vec2& variable containing the position of the player
+ */
+void CPathRequestQueue::Dispatch(	CPathWorkerPool& cWorkers,
+									const std::shared_ptr<const CPlatformNavGraph>& pNavGraph,
+									const glm::vec2& playerPos)
+{
+	uiNumExpanded = 0;
+
+	SortPending(playerPos);
+	for (unsigned int i = 0; i < vOrder.size(); i++)
+	{
+		Request& sRequest = vRequests[vOrder[i].second];
+		if (sRequest.bDispatched && (sRequest.uiVersion == pNavGraph->GetVersion()))
+			continue;
+
+		sRequest.uiVersion = pNavGraph->GetVersion();
+		sRequest.bDispatched = true;
+		sRequest.uiTicket = ++uiLastTicket;
+
+		CPathWorkerPool::PathJob sJob;
+		sJob.uiRequest = vOrder[i].second + 1;
+		sJob.uiTicket = sRequest.uiTicket;
+		sJob.pNavGraph = pNavGraph;
+		sJob.startPos = sRequest.startPos;
+		sJob.targetPos = sRequest.targetPos;
+		cWorkers.Submit(sJob);
+	}
+}
+
+/**
+ @brief Store the results which the worker threads have finished. A result whose ticket is
+		not the one of its request's last dispatch is dropped
+ @param cWorkers A CPathWorkerPool& variable containing the workers
+ */
+void CPathRequestQueue::Collect(CPathWorkerPool& cWorkers)
+{
+	while (cWorkers.PopResult(sResult))
+	{
+		Request* pRequest = GetRequest(sResult.uiRequest);
+		if ((pRequest == NULL) ||
+			(pRequest->eStatus != REQUEST_PENDING) ||
+			!pRequest->bDispatched ||
+			(pRequest->uiTicket != sResult.uiTicket))
+			continue;
+
+		pRequest->vPath.swap(sResult.vPath);
+		pRequest->eStatus = sResult.bFound ? REQUEST_READY : REQUEST_FAILED;
+		pRequest->bDispatched = false;
+	}
+}
+
+/**
+ @brief Get the number of nodes which were expanded in the last update
+ */
+unsigned int CPathRequestQueue::GetNumExpanded(void) const
+{
+	return uiNumExpanded;
+}
+
+/**
+ @brief Get the number of requests which are waiting to be searched
+ */
+unsigned int CPathRequestQueue::GetNumPending(void) const
+{
+	unsigned int uiNumPending = 0;
+	for (unsigned int i = 0; i < vRequests.size(); i++)
+	{
+		if (vRequests[i].eStatus == REQUEST_PENDING)
+			uiNumPending++;
+	}
+	return uiNumPending;
+}
+
+/**
+ @brief Sort the pending requests by the squared distance from their start to the player,
+		into vOrder
+ */
+void CPathRequestQueue::SortPending(const glm::vec2& playerPos)
+{
+	vOrder.clear();
+	for (unsigned int i = 0; i < vRequests.size(); i++)
+	{
+		if (vRequests[i].eStatus != REQUEST_PENDING)
+			continue;
+
+		const glm::vec2 v2Offset = vRequests[i].startPos - playerPos;
+		vOrder.push_back(make_pair(glm::dot(v2Offset, v2Offset), i));
+	}
+	sort(vOrder.begin(), vOrder.end());
+}
+
+/**
+ @brief Get a request from its handle, or NULL if the handle is not valid
+ */
+CPathRequestQueue::Request* CPathRequestQueue::GetRequest(const unsigned int uiRequest)
+{
+	if ((uiRequest == NO_REQUEST) || (uiRequest > vRequests.size()) || !vRequests[uiRequest - 1].bUsed)
+		return NULL;
+	return &vRequests[uiRequest - 1];
+}
+
+/**
+ @brief Get a request from its handle, or NULL if the handle is not valid
+ */
+const CPathRequestQueue::Request* CPathRequestQueue::GetRequest(const unsigned int uiRequest) const
+{
+	if ((uiRequest == NO_REQUEST) || (uiRequest > vRequests.size()) || !vRequests[uiRequest - 1].bUsed)
+		return NULL;
+	return &vRequests[uiRequest - 1];
+}
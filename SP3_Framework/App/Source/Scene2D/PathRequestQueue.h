@@ -0,0 +1,138 @@
+/**
+ CPathRequestQueue
+ @brief A class which runs the path searches of the enemies a little at a time, so that many
+		enemies asking for a path on the same frame do not make that frame slow. An enemy
+		submits a request and then polls it on the following frames. Each frame, the pending
+		requests are searched in order of how close their start is to the player, until a
+		budget of expanded nodes is used up. A search which is not finished carries on from
+		where it stopped on the next frame.
+
+		A request keeps its result until its start, its target or the version of the level
+		changes, so an enemy which submits the same request every frame only has it searched
+		once. Requests are identified by a handle, where NO_REQUEST means none.
+
+		On machines with cores to spare, the pending requests are dispatched to a
+		CPathWorkerPool instead, and their results are collected at the start of a frame.
+		Each dispatch carries a ticket, so a result for a request which has since been
+		submitted again or released is dropped.
+ */
+#pragma once
+
+// Include CPlatformNavGraph
+#include "PlatformNavGraph.h"
+// Include CPathWorkerPool
+#include "PathWorkerPool.h"
+
+#include <vector>
+#include <utility>
+#include <memory>
+
+class CPathRequestQueue
+{
+public:
+	// The states of a request
+	enum REQUEST_STATUS
+	{
+		REQUEST_NONE = 0,
+		REQUEST_PENDING,
+		REQUEST_READY,
+		REQUEST_FAILED,
+		NUM_REQUEST_STATUS
+	};
+
+	// The handle of no request
+	static const unsigned int NO_REQUEST = 0;
+
+	// Constructor
+	CPathRequestQueue(void);
+
+	// Destructor
+	virtual ~CPathRequestQueue(void);
+
+	// Set the most nodes which the searches can expand in one frame
+	void SetBudget(const unsigned int uiMaxExpandedPerFrame);
+	// Get the most nodes which the searches can expand in one frame
+	unsigned int GetBudget(void) const;
+
+	// Submit a request for a path, or keep the result of the last one if nothing has changed
+	void Submit(unsigned int& uirRequest,
+				const glm::vec2& startPos,
+				const glm::vec2& targetPos,
+				const unsigned int uiVersion);
+	// Get the state of a request
+	REQUEST_STATUS GetStatus(const unsigned int uiRequest) const;
+	// Get the path of a request which is ready
+	bool GetPath(const unsigned int uiRequest, std::vector<glm::vec2>& vPath) const;
+	// Release a request, so that its slot can be reused
+	void Release(unsigned int& uirRequest);
+
+	// Run the pending searches until the budget of this frame is used up
+	void Update(const CPlatformNavGraph& cPlatformNavGraph,
+				const unsigned int uiVersion,
+				const glm::vec2& playerPos);
+
+	// Hand the pending requests to worker threads, instead of running them in Update()
+	void Dispatch(	CPathWorkerPool& cWorkers,
+					const std::shared_ptr<const CPlatformNavGraph>& pNavGraph,
+					const glm::vec2& playerPos);
+	// Store the results which the worker threads have finished
+	void Collect(CPathWorkerPool& cWorkers);
+
+	// Get the number of nodes which were expanded in the last update
+	unsigned int GetNumExpanded(void) const;
+	// Get the number of requests which are waiting to be searched
+	unsigned int GetNumPending(void) const;
+
+protected:
+	// A request and the search which answers it
+	struct Request
+	{
+		Request()
+			: bUsed(false), eStatus(REQUEST_NONE), startPos(0.0f), targetPos(0.0f), uiVersion(0)
+			, bStarted(false), uiStartIndex(0), uiTargetIndex(0)
+			, bDispatched(false), uiTicket(0) {}
+
+		bool bUsed;
+		REQUEST_STATUS eStatus;
+		glm::vec2 startPos;
+		glm::vec2 targetPos;
+		// The version of the level which the result or the running search is for
+		unsigned int uiVersion;
+
+		// The search, which may run over several frames
+		bool bStarted;
+		unsigned int uiStartIndex;
+		unsigned int uiTargetIndex;
+		AStarContext context;
+
+		// The search on a worker thread, and the ticket which its result must carry
+		bool bDispatched;
+		unsigned int uiTicket;
+
+		// The result
+		std::vector<glm::vec2> vPath;
+	};
+
+	// The most nodes which the searches can expand in one frame
+	unsigned int uiBudget;
+	// The number of nodes which were expanded in the last update
+	unsigned int uiNumExpanded;
+
+	// The requests, indexed by their handle - 1
+	std::vector<Request> vRequests;
+	// The slots of the released requests
+	std::vector<unsigned int> vFreeSlots;
+	// The pending requests, in the order they are searched, kept to reuse its memory
+	std::vector<std::pair<float, unsigned int> > vOrder;
+	// The ticket of the last dispatch
+	unsigned int uiLastTicket;
+	// A result from the worker threads, kept to reuse its memory
+	CPathWorkerPool::PathResult sResult;
+
+	// Sort the pending requests by how close their start is to the player, into vOrder
+	void SortPending(const glm::vec2& playerPos);
+
+	// Get a request from its handle, or NULL if the handle is not valid
+	Request* GetRequest(const unsigned int uiRequest);
+	const Request* GetRequest(const unsigned int uiRequest) const;
+};
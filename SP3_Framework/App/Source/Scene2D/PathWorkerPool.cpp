@@ -0,0 +1,134 @@
+/**
+ CPathWorkerPool
+ @brief A class which runs the path searches of the enemies on background threads, on shared
+		copies of the platform navigation graph, and sends the paths back through a lock-free queue.
+ */
+#include "PathWorkerPool.h"
+
+using namespace std;
+
+/**
+ @brief Constructor
+ */
+CPathWorkerPool::CPathWorkerPool(void)
+	: bStopWorkers(false)
+	, cResults(256)
+{
+}
+
+/**
+ @brief Destructor
+ */
+CPathWorkerPool::~CPathWorkerPool(void)
+{
+	Stop();
+}
+
+/**
+ @brief Start a number of worker threads. Any workers which are running are stopped first
+ @param uiNumWorkers A const unsigned int variable containing the number of workers
+ */
+void CPathWorkerPool::Start(const unsigned int uiNumWorkers)
+{
+	Stop();
+
+	bStopWorkers = false;
+	for (unsigned int i = 0; i < uiNumWorkers; i++)
+	{
+		vWorkers.push_back(thread(&CPathWorkerPool::WorkerThread, this));
+	}
+}
+
+/**
+ @brief Stop the worker threads. The jobs which have not been started are dropped, and the
+		results which have not been collected are kept for PopResult()
+ */
+void CPathWorkerPool::Stop(void)
+{
+	{
+		lock_guard<mutex> lock(cJobMutex);
+		bStopWorkers = true;
+		dJobs.clear();
+	}
+	cJobCondition.notify_all();
+
+	for (unsigned int i = 0; i < vWorkers.size(); i++)
+	{
+		if (vWorkers[i].joinable())
+			vWorkers[i].join();
+	}
+	vWorkers.clear();
+}
+
+/**
+ @brief Get the number of worker threads
+ */
+unsigned int CPathWorkerPool::GetNumWorkers(void) const
+{
+	return (unsigned int)vWorkers.size();
+}
+
+/**
+ @brief Submit a job to the workers. Jobs are started in the order they are submitted
+ @param sJob A const PathJob& variable containing the job
+ */
+void CPathWorkerPool::Submit(const PathJob& sJob)
+{
+	{
+		lock_guard<mutex> lock(cJobMutex);
+		dJobs.push_back(sJob);
+	}
+	cJobCondition.notify_one();
+}
+
+/**
+ @brief Get a finished result. This does not lock, so it can be called every frame
+ @param sResult A PathResult& variable which will store the result
+ @return false if there are no finished results
+ */
+bool CPathWorkerPool::PopResult(PathResult& sResult)
+{
+	return cResults.Pop(sResult);
+}
+
+/**
+ @brief The loop of a worker thread. The search context and the result are kept between
+		jobs, so that their memory is reused
+ */
+void CPathWorkerPool::WorkerThread(void)
+{
+	AStarContext context;
+	PathResult sResult;
+	PathJob sJob;
+
+	while (true)
+	{
+		{
+			unique_lock<mutex> lock(cJobMutex);
+			cJobCondition.wait(lock, [this] { return bStopWorkers || !dJobs.empty(); });
+			if (bStopWorkers)
+				return;
+
+			sJob = dJobs.front();
+			dJobs.pop_front();
+		}
+
+		sResult.uiRequest = sJob.uiRequest;
+		sResult.uiTicket = sJob.uiTicket;
+		sResult.bFound = sJob.pNavGraph->FindPath(context, sJob.startPos, sJob.targetPos, sResult.vPath);
+
+		// Let go of the graph, so that an old version is freed as soon as possible
+		sJob.pNavGraph.reset();
+
+		// Wait for the main thread to collect some results if the queue is full
+		while (!cResults.Push(sResult))
+		{
+			{
+				lock_guard<mutex> lock(cJobMutex);
+				if (bStopWorkers)
+					return;
+			}
+			this_thread::yield();
+		}
+	}
+}
@@ -0,0 +1,87 @@
+/**
+ CPathWorkerPool
+ @brief A class which runs the path searches of the enemies on background threads. The main
+		thread submits jobs, each of which holds a shared copy of the platform navigation graph
+		for the version of the level it was made for, so the workers never read the tiles
+		which the main thread is changing. Each worker keeps its own search context.
+		Jobs are handed to the workers under a lock, while the finished paths are sent back
+		through a lock-free queue, so the main thread never waits on a worker to collect them.
+ */
+#pragma once
+
+// Include CPlatformNavGraph
+#include "PlatformNavGraph.h"
+// Include CLockFreeQueue
+#include "LockFreeQueue.h"
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <memory>
+
+class CPathWorkerPool
+{
+public:
+	// A search for a worker to run
+	struct PathJob
+	{
+		PathJob()
+			: uiRequest(0), uiTicket(0), startPos(0.0f), targetPos(0.0f) {}
+
+		// The request which the result is for, and the ticket which tells if it is still wanted
+		unsigned int uiRequest;
+		unsigned int uiTicket;
+		// The graph to search, which is not changed while the job holds it
+		std::shared_ptr<const CPlatformNavGraph> pNavGraph;
+		glm::vec2 startPos;
+		glm::vec2 targetPos;
+	};
+
+	// The result of a job
+	struct PathResult
+	{
+		PathResult()
+			: uiRequest(0), uiTicket(0), bFound(false) {}
+
+		unsigned int uiRequest;
+		unsigned int uiTicket;
+		bool bFound;
+		std::vector<glm::vec2> vPath;
+	};
+
+	// Constructor
+	CPathWorkerPool(void);
+
+	// Destructor
+	virtual ~CPathWorkerPool(void);
+
+	// Start a number of worker threads
+	void Start(const unsigned int uiNumWorkers);
+	// Stop the worker threads, dropping the jobs which have not been started
+	void Stop(void);
+	// Get the number of worker threads
+	unsigned int GetNumWorkers(void) const;
+
+	// Submit a job to the workers
+	void Submit(const PathJob& sJob);
+	// Get a finished result, on the main thread
+	bool PopResult(PathResult& sResult);
+
+protected:
+	// The worker threads
+	std::vector<std::thread> vWorkers;
+
+	// The jobs waiting for a worker, and the variables shared with the workers
+	std::deque<PathJob> dJobs;
+	std::mutex cJobMutex;
+	std::condition_variable cJobCondition;
+	bool bStopWorkers;
+
+	// The finished results, waiting for the main thread
+	CLockFreeQueue<PathResult> cResults;
+
+	// The loop of a worker thread
+	void WorkerThread(void);
+};
@@ -0,0 +1,771 @@
+/**
+ CPlatformNavGraph
+ @brief A class which stores the places where a ground enemy can stand in a level, and the
+		moves between them which it can carry out under gravity: walking, falling off a ledge
+		and jumping. The reach of a jump is found by running its arc through CPhysics2D.
+ */
+#include "PlatformNavGraph.h"
+
+// Include CPhysics2D
+#include "Physics2D.h"
+// Include TileProperties
+#include "TileProperties.h"
+
+#include <cstdlib>
+using namespace std;
+
+const unsigned int CPlatformNavGraph::NO_PATH;
+
+// The extra cost of a jump, so that walking is preferred when both are as short
+static const unsigned int JUMP_COST = 1;
+// The most frames which the jump arc is run for, in case it never comes down
+static const int MAX_ARC_FRAMES = 1000;
+
+/**
+ @brief Constructor
+ */
+CPlatformNavGraph::CPlatformNavGraph(void)
+	: arrTiles(NULL)
+	, iNumRows(0)
+	, iNumCols(0)
+	, iMaxJumpRows(0)
+	, iMaxJumpCols(1)
+	, bBuilt(false)
+	, uiLevel(0)
+	, uiVersion(0)
+	, bFieldBuilt(false)
+	, uiFieldVersion(0)
+	, uiFieldTarget(0)
+{
+}
+
+/**
+ @brief Copy constructor. The copy keeps its own copy of the tiles, so it can be read on
+		another thread while the level is changed or unloaded
+ @param cSource A const CPlatformNavGraph& variable containing the graph to copy
+ */
+CPlatformNavGraph::CPlatformNavGraph(const CPlatformNavGraph& cSource)
+	: arrTiles(NULL)
+	, iNumRows(0)
+	, iNumCols(0)
+	, iMaxJumpRows(0)
+	, iMaxJumpCols(1)
+	, bBuilt(false)
+	, uiLevel(0)
+	, uiVersion(0)
+	, bFieldBuilt(false)
+	, uiFieldVersion(0)
+	, uiFieldTarget(0)
+{
+	*this = cSource;
+}
+
+/**
+ @brief Destructor
+ */
+CPlatformNavGraph::~CPlatformNavGraph(void)
+{
+}
+
+/**
+ @brief Copy another graph, its field and its tiles. The scratch data for building the
+		field is not copied, since it is filled again by every BuildField()
+ @param cSource A const CPlatformNavGraph& variable containing the graph to copy
+ */
+CPlatformNavGraph& CPlatformNavGraph::operator=(const CPlatformNavGraph& cSource)
+{
+	if (this == &cSource)
+		return *this;
+
+	iNumRows = cSource.iNumRows;
+	iNumCols = cSource.iNumCols;
+	iMaxJumpRows = cSource.iMaxJumpRows;
+	iMaxJumpCols = cSource.iMaxJumpCols;
+	bBuilt = cSource.bBuilt;
+	uiLevel = cSource.uiLevel;
+	uiVersion = cSource.uiVersion;
+	vLinks = cSource.vLinks;
+
+	bFieldBuilt = cSource.bFieldBuilt;
+	uiFieldVersion = cSource.uiFieldVersion;
+	uiFieldTarget = cSource.uiFieldTarget;
+	vFieldCosts = cSource.vFieldCosts;
+	vFieldLinks = cSource.vFieldLinks;
+
+	// Copy the tiles instead of sharing the source's pointer to them
+	if ((cSource.arrTiles != NULL) && (iNumRows > 0) && (iNumCols > 0))
+	{
+		vOwnedTiles.assign(cSource.arrTiles, cSource.arrTiles + iNumRows * iNumCols);
+		arrTiles = &vOwnedTiles[0];
+	}
+	else
+	{
+		vOwnedTiles.clear();
+		arrTiles = NULL;
+	}
+	return *this;
+}
+
+/**
+ @brief Find how high and how far a jump reaches. The arc is run through CPhysics2D frame by
+		frame, moving by micro steps the same way as the enemies' UpdateJumpFall(), until
+		the jump has fallen back to the row it started from. The jump can cross one column
+		for every iStepsPerTileX frames that it is in the air. The graph is built again on
+		its next update
+ @param v2JumpVelocity A const glm::vec2& variable containing the initial velocity of the jump
+ @param fFrameTime A const float variable containing the time of one frame, in seconds
+ @param fMicroStepY A const float variable containing the height of one micro step
+ @param iStepsPerTileX A const int variable containing the number of micro steps across a tile
+ @param iStepsPerTileY A const int variable containing the number of micro steps up a tile
+ */
+void CPlatformNavGraph::SetJumpArc(	const glm::vec2& v2JumpVelocity,
+									const float fFrameTime,
+									const float fMicroStepY,
+									const int iStepsPerTileX,
+									const int iStepsPerTileY)
+{
+	CPhysics2D cPhysics2D;
+	int iMicroSteps = 0;
+	int iRows = 0;
+	int iFrames = 0;
+
+	// Rise until the velocity reaches zero
+	cPhysics2D.SetStatus(CPhysics2D::STATUS::JUMP);
+	cPhysics2D.SetInitialVelocity(v2JumpVelocity);
+	while (iFrames < MAX_ARC_FRAMES)
+	{
+		cPhysics2D.AddElapsedTime(fFrameTime);
+		cPhysics2D.Update();
+		iFrames++;
+
+		iMicroSteps += (int)(cPhysics2D.GetDisplacement().y / fMicroStepY);
+		if (iMicroSteps > iStepsPerTileY)
+		{
+			iMicroSteps -= iStepsPerTileY;
+			if (iMicroSteps < 0)
+				iMicroSteps = 0;
+			iRows++;
+		}
+
+		if (cPhysics2D.GetInitialVelocity().y <= 0.0f)
+			break;
+	}
+
+	// Fall back down to the row which the jump started from
+	int iFallRows = 0;
+	cPhysics2D.SetStatus(CPhysics2D::STATUS::FALL);
+	while ((iFallRows < iRows) && (iFrames < MAX_ARC_FRAMES))
+	{
+		cPhysics2D.AddElapsedTime(fFrameTime);
+		cPhysics2D.Update();
+		iFrames++;
+
+		iMicroSteps -= abs((int)(cPhysics2D.GetDisplacement().y / fMicroStepY));
+		if (iMicroSteps < 0)
+		{
+			iMicroSteps = iStepsPerTileY - 1;
+			iFallRows++;
+		}
+	}
+
+	iMaxJumpRows = iRows;
+	iMaxJumpCols = (iStepsPerTileX > 0) ? iFrames / iStepsPerTileX : 1;
+	if (iMaxJumpCols < 1)
+		iMaxJumpCols = 1;
+	bBuilt = false;
+	bFieldBuilt = false;
+}
+
+/**
+ @brief Get the number of rows which a jump rises
+ */
+unsigned int CPlatformNavGraph::GetMaxJumpRows(void) const
+{
+	return iMaxJumpRows;
+}
+
+/**
+ @brief Get the number of columns which a jump crosses
+ */
+unsigned int CPlatformNavGraph::GetMaxJumpCols(void) const
+{
+	return iMaxJumpCols;
+}
+
+/**
+ @brief Check if the graph was built for a version of a level
+ */
+bool CPlatformNavGraph::IsBuiltFor(const unsigned int uiLevel, const unsigned int uiVersion) const
+{
+	return bBuilt && (this->uiLevel == uiLevel) && (this->uiVersion == uiVersion);
+}
+
+/**
+ @brief Check if the graph was built for a level, at any version
+ */
+bool CPlatformNavGraph::IsBuiltFor(const unsigned int uiLevel) const
+{
+	return bBuilt && (this->uiLevel == uiLevel);
+}
+
+/**
+ @brief Get the version of the level which the graph was built for
+ */
+unsigned int CPlatformNavGraph::GetVersion(void) const
+{
+	return uiVersion;
+}
+
+/**
+ @brief Build the graph for all the tiles of a level
+ @param arrTiles A const unsigned short* variable containing the tiles of the level
+ @param uiNumRows A const unsigned int variable containing the number of rows
+ @param uiNumCols A const unsigned int variable containing the number of columns
+ @param uiLevel A const unsigned int variable containing the level
+ @param uiVersion A const unsigned int variable containing the version of the level
+ */
+void CPlatformNavGraph::Build(	const unsigned short* arrTiles,
+								const unsigned int uiNumRows,
+								const unsigned int uiNumCols,
+								const unsigned int uiLevel,
+								const unsigned int uiVersion)
+{
+	this->arrTiles = arrTiles;
+	iNumRows = (int)uiNumRows;
+	iNumCols = (int)uiNumCols;
+	this->uiLevel = uiLevel;
+	this->uiVersion = uiVersion;
+
+	vLinks.resize(uiNumRows * uiNumCols);
+	for (int iRow = 0; iRow < iNumRows; iRow++)
+	{
+		for (int iCol = 0; iCol < iNumCols; iCol++)
+			BuildLinks(iCol, iRow);
+	}
+
+	bBuilt = true;
+	bFieldBuilt = false;
+}
+
+/**
+ @brief Build the links again around a region of tiles which has changed. A link can pass
+		through the tiles above its start, up to the top of a jump, and every tile below it
+		when it falls, so the links of the tiles beside the region, from a jump's height
+		below it to the top of the level, are built again
+ @param arrTiles A const unsigned short* variable containing the tiles of the level
+ @param uiMinRow A const unsigned int variable containing the lowest row which has changed
+ @param uiMinCol A const unsigned int variable containing the leftmost column which has changed
+ @param uiMaxCol A const unsigned int variable containing the rightmost column which has changed
+ @param uiVersion A const unsigned int variable containing the version of the level
+ */
+void CPlatformNavGraph::Update(	const unsigned short* arrTiles,
+								const unsigned int uiMinRow,
+								const unsigned int uiMinCol,
+								const unsigned int uiMaxCol,
+								const unsigned int uiVersion)
+{
+	if (!bBuilt)
+		return;
+
+	this->arrTiles = arrTiles;
+	this->uiVersion = uiVersion;
+
+	const int iMinRow = max((int)uiMinRow - iMaxJumpRows - 1, 0);
+	const int iMinCol = max((int)uiMinCol - iMaxJumpCols - 1, 0);
+	const int iMaxCol = min((int)uiMaxCol + iMaxJumpCols + 1, iNumCols - 1);
+	for (int iRow = iMinRow; iRow < iNumRows; iRow++)
+	{
+		for (int iCol = iMinCol; iCol <= iMaxCol; iCol++)
+			BuildLinks(iCol, iRow);
+	}
+
+	bFieldBuilt = false;
+}
+
+/**
+ @brief Find a path with A* Path Finding over the links. If the start or the target is in
+		the air, the drop to the tile below it is used instead
+ @param context An AStarContext& variable containing the scratch data of the search
+ @param startPos A const glm::vec2& variable containing the start position
+ @param targetPos A const glm::vec2& variable containing the target position
+ @param vPath A std::vector<glm::vec2>& variable which will store the path, from the grid
+			after startPos to the tile which the target stands on
+ @return true if a path was found, otherwise false
+ */
+bool CPlatformNavGraph::FindPath(	AStarContext& context,
+									const glm::vec2& startPos,
+									const glm::vec2& targetPos,
+									std::vector<glm::vec2>& vPath) const
+{
+	vPath.clear();
+	unsigned int uiStartIndex, uiTargetIndex;
+	if (!BeginSearch(context, startPos, targetPos, uiStartIndex, uiTargetIndex))
+		return false;
+	if (ContinueSearch(context, uiTargetIndex, NO_PATH) != SEARCH_FOUND)
+		return false;
+
+	GetSearchPath(context, startPos, uiStartIndex, uiTargetIndex, vPath);
+	return true;
+}
+
+/**
+ @brief Start a search which can be run a little at a time with ContinueSearch(). The search
+		only reads the graph, so the graph must not change until the search has finished
+ @param context An AStarContext& variable which will store the scratch data of the search
+ @param startPos A const glm::vec2& variable containing the start position
+ @param targetPos A const glm::vec2& variable containing the target position
+ @param uirStartIndex An unsigned int& variable which will store the tile the search starts from
+ @param uirTargetIndex An unsigned int& variable which will store the tile the search is for
+ @return true if the search was started, or false if the start or the target is not open
+ */
+bool CPlatformNavGraph::BeginSearch(AStarContext& context,
+									const glm::vec2& startPos,
+									const glm::vec2& targetPos,
+									unsigned int& uirStartIndex,
+									unsigned int& uirTargetIndex) const
+{
+	const int iStartCol = (int)startPos.x;
+	const int iStartRow = (int)startPos.y;
+	const int iTargetCol = (int)targetPos.x;
+	const int iTargetRow = (int)targetPos.y;
+	if (!bBuilt || !IsOpen(iStartCol, iStartRow) || !IsOpen(iTargetCol, iTargetRow))
+		return false;
+
+	uirStartIndex = GetLandingRow(iStartCol, iStartRow) * iNumCols + iStartCol;
+	uirTargetIndex = GetLandingRow(iTargetCol, iTargetRow) * iNumCols + iTargetCol;
+
+	context.Begin(iNumRows * iNumCols);
+	context.GetNode(uirStartIndex);
+	context.PushOpen(0, uirStartIndex);
+	return true;
+}
+
+/**
+ @brief Expand up to a number of nodes of a search started with BeginSearch()
+ @param context An AStarContext& variable containing the scratch data of the search
+ @param uiTargetIndex A const unsigned int variable containing the tile the search is for
+ @param uiMaxExpanded A const unsigned int variable containing the most nodes to expand
+ @return SEARCH_RUNNING if the search has not finished, SEARCH_FOUND if the target was
+		reached, or SEARCH_FAILED if it cannot be reached
+ */
+CPlatformNavGraph::SEARCH_STATUS CPlatformNavGraph::ContinueSearch(	AStarContext& context,
+																	const unsigned int uiTargetIndex,
+																	const unsigned int uiMaxExpanded) const
+{
+	const int iTargetCol = (int)(uiTargetIndex % iNumCols);
+	const int iTargetRow = (int)(uiTargetIndex / iNumCols);
+	unsigned int uiNumExpanded = 0;
+	while (!context.m_openList.empty())
+	{
+		// The target may already be in the open list, so it is checked before the budget
+		if (context.m_openList.front().uiIndex == uiTargetIndex)
+			return SEARCH_FOUND;
+		if (uiNumExpanded >= uiMaxExpanded)
+			return SEARCH_RUNNING;
+
+		const unsigned int uiCurrentIndex = context.PopOpen();
+		AStarNode& sCurrent = context.GetNode(uiCurrentIndex);
+		if (sCurrent.bClosed)
+			continue;
+		sCurrent.bClosed = true;
+		context.uiNumExpanded++;
+		uiNumExpanded++;
+
+		const vector<Link>& vTileLinks = vLinks[uiCurrentIndex];
+		for (unsigned int i = 0; i < vTileLinks.size(); i++)
+		{
+			const Link& sLink = vTileLinks[i];
+			AStarNode& sNeighbor = context.GetNode(sLink.uiTarget);
+			if (sNeighbor.bClosed)
+				continue;
+
+			// Every link costs at least the number of columns and rows it moves
+			const unsigned int gNew = context.m_nodes[uiCurrentIndex].g + sLink.usCost;
+			const unsigned int hNew = abs((int)(sLink.uiTarget % iNumCols) - iTargetCol) +
+									  abs((int)(sLink.uiTarget / iNumCols) - iTargetRow);
+			const unsigned int fNew = gNew + hNew;
+			if ((sNeighbor.f == 0) || (fNew < sNeighbor.f))
+			{
+				sNeighbor.uiParent = uiCurrentIndex;
+				sNeighbor.g = gNew;
+				sNeighbor.f = fNew;
+				context.PushOpen(fNew, sLink.uiTarget);
+			}
+		}
+	}
+	return SEARCH_FAILED;
+}
+
+/**
+ @brief Get the path of a search which has found its target
+ @param context A const AStarContext& variable containing the scratch data of the search
+ @param startPos A const glm::vec2& variable containing the start position
+ @param uiStartIndex A const unsigned int variable containing the tile the search started from
+ @param uiTargetIndex A const unsigned int variable containing the tile the search was for
+ @param vPath A std::vector<glm::vec2>& variable which will store the path, from the grid
+			after startPos to the tile which the target stands on
+ */
+void CPlatformNavGraph::GetSearchPath(	const AStarContext& context,
+										const glm::vec2& startPos,
+										const unsigned int uiStartIndex,
+										const unsigned int uiTargetIndex,
+										std::vector<glm::vec2>& vPath) const
+{
+	const int iStartCol = (int)startPos.x;
+	const int iStartLandingRow = (int)(uiStartIndex / iNumCols);
+
+	// Count the tiles first, so the path can be written in order without reversing it.
+	// The link from a parent is the cheapest one to its child, which is the one the search took
+	unsigned int uiLength = (int)startPos.y - iStartLandingRow;
+	for (unsigned int uiIndex = uiTargetIndex; uiIndex != uiStartIndex; uiIndex = context.m_nodes[uiIndex].uiParent)
+	{
+		const unsigned int uiParent = context.m_nodes[uiIndex].uiParent;
+		const Link* pLink = NULL;
+		for (unsigned int i = 0; i < vLinks[uiParent].size(); i++)
+		{
+			if ((vLinks[uiParent][i].uiTarget == uiIndex) &&
+				((pLink == NULL) || (vLinks[uiParent][i].usCost < pLink->usCost)))
+				pLink = &vLinks[uiParent][i];
+		}
+		uiLength += GetLinkLength(uiParent, *pLink);
+	}
+
+	vPath.resize(uiLength);
+	unsigned int uiPathIndex = uiLength;
+	for (unsigned int uiIndex = uiTargetIndex; uiIndex != uiStartIndex; uiIndex = context.m_nodes[uiIndex].uiParent)
+	{
+		const unsigned int uiParent = context.m_nodes[uiIndex].uiParent;
+		const Link* pLink = NULL;
+		for (unsigned int i = 0; i < vLinks[uiParent].size(); i++)
+		{
+			if ((vLinks[uiParent][i].uiTarget == uiIndex) &&
+				((pLink == NULL) || (vLinks[uiParent][i].usCost < pLink->usCost)))
+				pLink = &vLinks[uiParent][i];
+		}
+		WriteLinkBackwards(uiParent, *pLink, vPath, uiPathIndex);
+	}
+
+	// The drop from a start in the air comes first
+	for (int iRow = iStartLandingRow; uiPathIndex > 0; iRow++)
+		vPath[--uiPathIndex] = glm::vec2(iStartCol, iRow);
+}
+
+/**
+ @brief Check if the field was built towards a target in the current version of the graph
+ */
+bool CPlatformNavGraph::IsFieldBuiltFor(const glm::vec2& targetPos) const
+{
+	if (!bFieldBuilt || (uiFieldVersion != uiVersion) ||
+		(targetPos.x < 0) || (targetPos.x >= iNumCols) || (targetPos.y < 0) || (targetPos.y >= iNumRows))
+		return false;
+	return uiFieldTarget == (unsigned int)((int)targetPos.y * iNumCols + (int)targetPos.x);
+}
+
+/**
+ @brief Build the field towards a target, with one search backwards along the links from the
+		tile which the target stands on. Afterwards, every tile which can be stood on knows
+		the cost to the target and the link to take towards it
+ @param targetPos A const glm::vec2& variable containing the target position
+ */
+void CPlatformNavGraph::BuildField(const glm::vec2& targetPos)
+{
+	if (!bBuilt)
+		return;
+
+	const unsigned int uiNumTiles = iNumRows * iNumCols;
+	vFieldCosts.assign(uiNumTiles, NO_PATH);
+	vFieldLinks.assign(uiNumTiles, NO_PATH);
+	uiFieldVersion = uiVersion;
+	uiFieldTarget = (int)targetPos.y * iNumCols + (int)targetPos.x;
+	bFieldBuilt = true;
+	if (!IsOpen((int)targetPos.x, (int)targetPos.y))
+		return;
+
+	// Gather the links by the tile they end at, counting them first
+	vInOffsets.assign(uiNumTiles + 1, 0);
+	for (unsigned int uiIndex = 0; uiIndex < uiNumTiles; uiIndex++)
+	{
+		for (unsigned int i = 0; i < vLinks[uiIndex].size(); i++)
+			vInOffsets[vLinks[uiIndex][i].uiTarget + 1]++;
+	}
+	for (unsigned int uiIndex = 0; uiIndex < uiNumTiles; uiIndex++)
+		vInOffsets[uiIndex + 1] += vInOffsets[uiIndex];
+
+	vInLinks.resize(vInOffsets[uiNumTiles]);
+	for (unsigned int uiIndex = 0; uiIndex < uiNumTiles; uiIndex++)
+	{
+		for (unsigned int i = 0; i < vLinks[uiIndex].size(); i++)
+		{
+			InLink& sInLink = vInLinks[vInOffsets[vLinks[uiIndex][i].uiTarget]++];
+			sInLink.uiSource = uiIndex;
+			sInLink.uiLink = i;
+		}
+	}
+	// Filling the lists moved each offset to the start of the next list, so move them back
+	for (unsigned int uiIndex = uiNumTiles; uiIndex > 0; uiIndex--)
+		vInOffsets[uiIndex] = vInOffsets[uiIndex - 1];
+	vInOffsets[0] = 0;
+
+	// Search backwards from the target, cheapest tile first
+	const unsigned int uiTargetIndex = GetLandingRow((int)targetPos.x, (int)targetPos.y) * iNumCols + (int)targetPos.x;
+	vFieldCosts[uiTargetIndex] = 0;
+	vFieldOpen.clear();
+	vFieldOpen.push_back(AStarOpenEntry(0, uiTargetIndex));
+	while (!vFieldOpen.empty())
+	{
+		pop_heap(vFieldOpen.begin(), vFieldOpen.end());
+		const AStarOpenEntry sEntry = vFieldOpen.back();
+		vFieldOpen.pop_back();
+
+		// A tile can be in the open list more than once, so skip the copies with an old cost
+		if (sEntry.f != vFieldCosts[sEntry.uiIndex])
+			continue;
+
+		for (unsigned int i = vInOffsets[sEntry.uiIndex]; i < vInOffsets[sEntry.uiIndex + 1]; i++)
+		{
+			const InLink& sInLink = vInLinks[i];
+			const unsigned int uiCost = sEntry.f + vLinks[sInLink.uiSource][sInLink.uiLink].usCost;
+			if (uiCost < vFieldCosts[sInLink.uiSource])
+			{
+				vFieldCosts[sInLink.uiSource] = uiCost;
+				vFieldLinks[sInLink.uiSource] = sInLink.uiLink;
+				vFieldOpen.push_back(AStarOpenEntry(uiCost, sInLink.uiSource));
+				push_heap(vFieldOpen.begin(), vFieldOpen.end());
+			}
+		}
+	}
+}
+
+/**
+ @brief Get the path from a position to the target of the field, without searching. If the
+		position is in the air, the path starts with the drop to the tile below it
+ @param startPos A const glm::vec2& variable containing the start position
+ @param vPath A std::vector<glm::vec2>& variable which will store the path, from the grid
+			after startPos to the tile which the target stands on
+ @return true if a path was found, otherwise false
+ */
+bool CPlatformNavGraph::GetFieldPath(const glm::vec2& startPos, std::vector<glm::vec2>& vPath) const
+{
+	vPath.clear();
+	const int iStartCol = (int)startPos.x;
+	const int iStartRow = (int)startPos.y;
+	if (!bFieldBuilt || (uiFieldVersion != uiVersion) || !IsOpen(iStartCol, iStartRow))
+		return false;
+
+	const int iLandingRow = GetLandingRow(iStartCol, iStartRow);
+	unsigned int uiIndex = iLandingRow * iNumCols + iStartCol;
+	if (vFieldCosts[uiIndex] == NO_PATH)
+		return false;
+
+	AppendDrop(iStartCol, iStartRow, iLandingRow, vPath);
+	while (vFieldCosts[uiIndex] != 0)
+	{
+		const Link& sLink = vLinks[uiIndex][vFieldLinks[uiIndex]];
+		AppendLink(uiIndex, sLink, vPath);
+		uiIndex = sLink.uiTarget;
+	}
+	return true;
+}
+
+/**
+ @brief Check if a tile is inside the level and does not block the enemies
+ */
+bool CPlatformNavGraph::IsOpen(const int iCol, const int iRow) const
+{
+	if ((iCol < 0) || (iCol >= iNumCols) || (iRow < 0) || (iRow >= iNumRows))
+		return false;
+	return !TileProperties::IsSolid(arrTiles[iRow * iNumCols + iCol]);
+}
+
+/**
+ @brief Check if an enemy can stand on a tile, which is open and either in the bottom row
+		or above a tile which blocks the enemies
+ */
+bool CPlatformNavGraph::IsStandable(const int iCol, const int iRow) const
+{
+	if (!IsOpen(iCol, iRow))
+		return false;
+	return (iRow == 0) || !IsOpen(iCol, iRow - 1);
+}
+
+/**
+ @brief Get the row which an enemy lands on when it drops from an open tile
+ */
+int CPlatformNavGraph::GetLandingRow(const int iCol, int iRow) const
+{
+	while (!IsStandable(iCol, iRow))
+		iRow--;
+	return iRow;
+}
+
+/**
+ @brief Build the links leaving a tile
+ @param iCol A const int variable containing the column of the tile
+ @param iRow A const int variable containing the row of the tile
+ */
+void CPlatformNavGraph::BuildLinks(const int iCol, const int iRow)
+{
+	vector<Link>& vTileLinks = vLinks[iRow * iNumCols + iCol];
+	vTileLinks.clear();
+	if (!IsStandable(iCol, iRow))
+		return;
+
+	// Walk onto the next tile, or step off the ledge and fall
+	for (int iSide = -1; iSide <= 1; iSide += 2)
+	{
+		const int iNextCol = iCol + iSide;
+		if (!IsOpen(iNextCol, iRow))
+			continue;
+
+		const unsigned int uiNextIndex = iRow * iNumCols + iNextCol;
+		const int iLandingRow = GetLandingRow(iNextCol, iRow);
+		if (iLandingRow == iRow)
+			AddLink(vTileLinks, uiNextIndex, uiNextIndex, uiNextIndex, 1, LINK_WALK);
+		else
+			AddLink(vTileLinks, iLandingRow * iNumCols + iNextCol, uiNextIndex, uiNextIndex,
+					1 + iRow - iLandingRow, LINK_FALL);
+	}
+
+	// A jump always rises to the top of its arc, unless a tile above stops it first
+	int iRise = 0;
+	while ((iRise < iMaxJumpRows) && IsOpen(iCol, iRow + iRise + 1))
+		iRise++;
+	if (iRise == 0)
+		return;
+
+	const int iTopRow = iRow + iRise;
+	for (int iSide = -1; iSide <= 1; iSide += 2)
+	{
+		for (int iAcross = 1; iAcross <= iMaxJumpCols; iAcross++)
+		{
+			const int iLandingCol = iCol + iSide * iAcross;
+			if (!IsOpen(iLandingCol, iTopRow))
+				break;
+
+			// The jump only has the time to cross more than one column if it comes back down
+			const int iLandingRow = GetLandingRow(iLandingCol, iTopRow);
+			if ((iAcross > 1) && (iLandingRow > iRow))
+				continue;
+
+			AddLink(vTileLinks,
+					iLandingRow * iNumCols + iLandingCol,
+					iTopRow * iNumCols + iCol,
+					iTopRow * iNumCols + iLandingCol,
+					iRise + iAcross + (iTopRow - iLandingRow) + JUMP_COST,
+					LINK_JUMP);
+		}
+	}
+}
+
+/**
+ @brief Add a link leaving a tile. Only the cheapest link to each tile is kept
+ */
+void CPlatformNavGraph::AddLink(std::vector<Link>& vTileLinks,
+								const unsigned int uiTarget,
+								const unsigned int uiTurn1,
+								const unsigned int uiTurn2,
+								const unsigned int uiCost,
+								const LINK_TYPE eType)
+{
+	for (unsigned int i = 0; i < vTileLinks.size(); i++)
+	{
+		if (vTileLinks[i].uiTarget != uiTarget)
+			continue;
+
+		if (uiCost < vTileLinks[i].usCost)
+		{
+			vTileLinks[i].uiTurn1 = uiTurn1;
+			vTileLinks[i].uiTurn2 = uiTurn2;
+			vTileLinks[i].usCost = (unsigned short)uiCost;
+			vTileLinks[i].ucType = (unsigned char)eType;
+		}
+		return;
+	}
+
+	Link sLink;
+	sLink.uiTarget = uiTarget;
+	sLink.uiTurn1 = uiTurn1;
+	sLink.uiTurn2 = uiTurn2;
+	sLink.usCost = (unsigned short)uiCost;
+	sLink.ucType = (unsigned char)eType;
+	vTileLinks.push_back(sLink);
+}
+
+/**
+ @brief Get the number of tiles which a link passes through after its start
+ */
+unsigned int CPlatformNavGraph::GetLinkLength(const unsigned int uiSource, const Link& sLink) const
+{
+	const unsigned int arrPoints[4] = { uiSource, sLink.uiTurn1, sLink.uiTurn2, sLink.uiTarget };
+	unsigned int uiLength = 0;
+	for (unsigned int i = 1; i < 4; i++)
+	{
+		uiLength += abs((int)(arrPoints[i] % iNumCols) - (int)(arrPoints[i - 1] % iNumCols)) +
+					abs((int)(arrPoints[i] / iNumCols) - (int)(arrPoints[i - 1] / iNumCols));
+	}
+	return uiLength;
+}
+
+/**
+ @brief Write the tiles which a link passes through after its start, ending before an index of the path
+ @param uiSource A const unsigned int variable containing the 1D position of the start of the link
+ @param sLink A const Link& variable containing the link
+ @param vPath A std::vector<glm::vec2>& variable containing the path
+ @param uirIndex An unsigned int& variable containing the index after the last tile to write,
+			which will store the index of the first tile written
+ */
+void CPlatformNavGraph::WriteLinkBackwards(	const unsigned int uiSource, const Link& sLink,
+											std::vector<glm::vec2>& vPath, unsigned int& uirIndex) const
+{
+	const unsigned int arrPoints[4] = { uiSource, sLink.uiTurn1, sLink.uiTurn2, sLink.uiTarget };
+	for (unsigned int i = 3; i > 0; i--)
+	{
+		int iCol = (int)(arrPoints[i] % iNumCols);
+		int iRow = (int)(arrPoints[i] / iNumCols);
+		const int iToCol = (int)(arrPoints[i - 1] % iNumCols);
+		const int iToRow = (int)(arrPoints[i - 1] / iNumCols);
+		const int iDirX = (iToCol > iCol) ? 1 : ((iToCol < iCol) ? -1 : 0);
+		const int iDirY = (iToRow > iRow) ? 1 : ((iToRow < iRow) ? -1 : 0);
+
+		// Each part of a link is a straight line along a row or a column
+		while ((iCol != iToCol) || (iRow != iToRow))
+		{
+			vPath[--uirIndex] = glm::vec2(iCol, iRow);
+			iCol += iDirX;
+			iRow += iDirY;
+		}
+	}
+}
+
+/**
+ @brief Add the tiles which a link passes through after its start to the end of the path
+ */
+void CPlatformNavGraph::AppendLink(const unsigned int uiSource, const Link& sLink, std::vector<glm::vec2>& vPath) const
+{
+	const unsigned int arrPoints[4] = { uiSource, sLink.uiTurn1, sLink.uiTurn2, sLink.uiTarget };
+	for (unsigned int i = 1; i < 4; i++)
+	{
+		int iCol = (int)(arrPoints[i - 1] % iNumCols);
+		int iRow = (int)(arrPoints[i - 1] / iNumCols);
+		const int iToCol = (int)(arrPoints[i] % iNumCols);
+		const int iToRow = (int)(arrPoints[i] / iNumCols);
+		const int iDirX = (iToCol > iCol) ? 1 : ((iToCol < iCol) ? -1 : 0);
+		const int iDirY = (iToRow > iRow) ? 1 : ((iToRow < iRow) ? -1 : 0);
+
+		while ((iCol != iToCol) || (iRow != iToRow))
+		{
+			iCol += iDirX;
+			iRow += iDirY;
+			vPath.push_back(glm::vec2(iCol, iRow));
+		}
+	}
+}
+
+/**
+ @brief Add the tiles of a drop from a tile to the tile it lands on, to the end of the path
+ */
+void CPlatformNavGraph::AppendDrop(const int iCol, const int iFromRow, const int iToRow, std::vector<glm::vec2>& vPath) const
+{
+	for (int iRow = iFromRow - 1; iRow >= iToRow; iRow--)
+		vPath.push_back(glm::vec2(iCol, iRow));
+}
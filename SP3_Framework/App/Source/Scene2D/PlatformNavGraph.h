@@ -0,0 +1,200 @@
+/**
+ CPlatformNavGraph
+ @brief A class which stores the places where a ground enemy can stand in a level, and the
+		moves between them which it can carry out under gravity. A tile can be stood on if
+		it is not solid and the tile below it is solid, or it is in the bottom row. The links
+		between these tiles are:
+		- walk: a step to the left or right onto a tile which can be stood on
+		- fall: a step off a ledge, and then a drop until a tile which can be stood on
+		- jump: a jump straight up to the top of the jump arc, a move to the left or right,
+				and then a drop until a tile which can be stood on
+		The height and width of the jump are found by running the jump arc through CPhysics2D
+		frame by frame, the same way as the enemies do.
+
+		The graph can be searched with A* for one path, or turned into a field towards one
+		target, which every enemy chasing that target reads without searching. When tiles
+		change, only the links which could pass through them are built again.
+		Positions are (column, row), where row 0 is the bottom row. Tiles for which
+		TileProperties::IsSolid() is true block the enemies, the same as their CheckPosition().
+ */
+#pragma once
+
+// Include AStarContext
+#include "AStarContext.h"
+
+#include <vector>
+
+class CPlatformNavGraph
+{
+public:
+	// The types of the links between the tiles
+	enum LINK_TYPE
+	{
+		LINK_WALK = 0,
+		LINK_FALL,
+		LINK_JUMP,
+		NUM_LINK_TYPES
+	};
+
+	// The states of a search which is run a little at a time
+	enum SEARCH_STATUS
+	{
+		SEARCH_RUNNING = 0,
+		SEARCH_FOUND,
+		SEARCH_FAILED,
+		NUM_SEARCH_STATUS
+	};
+
+	// The cost of a tile which cannot reach the target of the field
+	static const unsigned int NO_PATH = 0xFFFFFFFF;
+
+	// Constructor
+	CPlatformNavGraph(void);
+
+	// Copy constructor, which copies the tiles so that the copy does not share them
+	CPlatformNavGraph(const CPlatformNavGraph& cSource);
+
+	// Destructor
+	virtual ~CPlatformNavGraph(void);
+
+	// Copy another graph and its tiles
+	CPlatformNavGraph& operator=(const CPlatformNavGraph& cSource);
+
+	// Find how high and how far a jump reaches, by running its arc through CPhysics2D
+	void SetJumpArc(const glm::vec2& v2JumpVelocity,
+					const float fFrameTime,
+					const float fMicroStepY,
+					const int iStepsPerTileX,
+					const int iStepsPerTileY);
+	// Get the number of rows which a jump rises
+	unsigned int GetMaxJumpRows(void) const;
+	// Get the number of columns which a jump crosses
+	unsigned int GetMaxJumpCols(void) const;
+
+	// Check if the graph was built for a version of a level
+	bool IsBuiltFor(const unsigned int uiLevel, const unsigned int uiVersion) const;
+	// Check if the graph was built for a level, at any version
+	bool IsBuiltFor(const unsigned int uiLevel) const;
+	// Get the version of the level which the graph was built for
+	unsigned int GetVersion(void) const;
+
+	// Build the graph for all the tiles of a level
+	void Build(	const unsigned short* arrTiles,
+				const unsigned int uiNumRows,
+				const unsigned int uiNumCols,
+				const unsigned int uiLevel,
+				const unsigned int uiVersion);
+	// Build the links again around a region of tiles which has changed, up to the top row
+	void Update(const unsigned short* arrTiles,
+				const unsigned int uiMinRow,
+				const unsigned int uiMinCol,
+				const unsigned int uiMaxCol,
+				const unsigned int uiVersion);
+
+	// Find a path with A* Path Finding over the links
+	bool FindPath(	AStarContext& context,
+					const glm::vec2& startPos,
+					const glm::vec2& targetPos,
+					std::vector<glm::vec2>& vPath) const;
+
+	// Start a search which can be run a little at a time with ContinueSearch()
+	bool BeginSearch(	AStarContext& context,
+						const glm::vec2& startPos,
+						const glm::vec2& targetPos,
+						unsigned int& uirStartIndex,
+						unsigned int& uirTargetIndex) const;
+	// Expand up to a number of nodes of a search
+	SEARCH_STATUS ContinueSearch(	AStarContext& context,
+									const unsigned int uiTargetIndex,
+									const unsigned int uiMaxExpanded) const;
+	// Get the path of a search which has found its target
+	void GetSearchPath(	const AStarContext& context,
+						const glm::vec2& startPos,
+						const unsigned int uiStartIndex,
+						const unsigned int uiTargetIndex,
+						std::vector<glm::vec2>& vPath) const;
+
+	// Check if the field was built towards a target in the current version of the graph
+	bool IsFieldBuiltFor(const glm::vec2& targetPos) const;
+	// Build the field towards a target
+	void BuildField(const glm::vec2& targetPos);
+	// Get the path from a position to the target of the field
+	bool GetFieldPath(const glm::vec2& startPos, std::vector<glm::vec2>& vPath) const;
+
+protected:
+	// A move from one tile which can be stood on to another. The move goes in straight
+	// lines from its start to uiTurn1, to uiTurn2 and then to uiTarget
+	struct Link
+	{
+		unsigned int uiTarget;
+		unsigned int uiTurn1;
+		unsigned int uiTurn2;
+		unsigned short usCost;
+		unsigned char ucType;
+	};
+
+	// A link seen from its end, for searching the graph backwards from a target
+	struct InLink
+	{
+		unsigned int uiSource;
+		unsigned int uiLink;
+	};
+
+	// The tiles of the level
+	const unsigned short* arrTiles;
+	// The copy of the tiles which arrTiles points to, if the graph is a copy of another
+	std::vector<unsigned short> vOwnedTiles;
+	int iNumRows;
+	int iNumCols;
+
+	// The reach of a jump
+	int iMaxJumpRows;
+	int iMaxJumpCols;
+
+	// What the graph was built for
+	bool bBuilt;
+	unsigned int uiLevel;
+	unsigned int uiVersion;
+
+	// The links leaving each tile, which is empty for the tiles which cannot be stood on
+	std::vector<std::vector<Link> > vLinks;
+
+	// What the field was built for
+	bool bFieldBuilt;
+	unsigned int uiFieldVersion;
+	unsigned int uiFieldTarget;
+	// The cost from each tile to the target, and the link to take towards it
+	std::vector<unsigned int> vFieldCosts;
+	std::vector<unsigned int> vFieldLinks;
+	// Scratch data for building the field, kept to reuse its memory
+	std::vector<unsigned int> vInOffsets;
+	std::vector<InLink> vInLinks;
+	std::vector<AStarOpenEntry> vFieldOpen;
+
+	// Check if a tile is inside the level and does not block the enemies
+	bool IsOpen(const int iCol, const int iRow) const;
+	// Check if an enemy can stand on a tile
+	bool IsStandable(const int iCol, const int iRow) const;
+	// Get the row which an enemy lands on when it drops from a tile
+	int GetLandingRow(const int iCol, int iRow) const;
+
+	// Build the links leaving a tile
+	void BuildLinks(const int iCol, const int iRow);
+	// Add a link leaving a tile
+	void AddLink(	std::vector<Link>& vTileLinks,
+					const unsigned int uiTarget,
+					const unsigned int uiTurn1,
+					const unsigned int uiTurn2,
+					const unsigned int uiCost,
+					const LINK_TYPE eType);
+
+	// Get the number of tiles which a link passes through after its start
+	unsigned int GetLinkLength(const unsigned int uiSource, const Link& sLink) const;
+	// Write the tiles which a link passes through, ending before an index of the path
+	void WriteLinkBackwards(const unsigned int uiSource, const Link& sLink,
+							std::vector<glm::vec2>& vPath, unsigned int& uirIndex) const;
+	// Add the tiles which a link passes through to the end of the path
+	void AppendLink(const unsigned int uiSource, const Link& sLink, std::vector<glm::vec2>& vPath) const;
+	// Add the tiles of a drop from a tile to the tile it lands on, to the end of the path
+	void AppendDrop(const int iCol, const int iFromRow, const int iToRow, std::vector<glm::vec2>& vPath) const;
+};
@@ -18,6 +18,8 @@ using namespace std;
 // Include the Map2D as we will use it to check the player's movements and actions
 #include "Map2D.h"
 #include "Primitives/MeshBuilder.h"
+// Include TileProperties to check what tiles can be broken
+#include "TileProperties.h"
 
 // Include Game Manager
 #include "GameManager.h"
@@ -583,20 +585,22 @@ void CPlayer2D::Update(const double dElapsedTime)
 					attackRange = 1;
 				}
 
-				enemyList = CScene2D::GetInstance()->returnEnemyVector();
-				for (int enemyIndex = 0; enemyIndex != enemyList.size(); ++enemyIndex)
+				CEntityRegistry& cEnemies = CScene2D::GetInstance()->GetEnemies();
+				// Only the enemies in the player's row and within the player's range can be hit
+				CScene2D::GetInstance()->GetEnemySpatialHash().QueryRow(vec2Index.y, vec2Index.x - attackRange, vec2Index.x + attackRange, vNearbyEnemies);
+				for (unsigned int enemyIndex = 0; enemyIndex != vNearbyEnemies.size(); ++enemyIndex)
 				{
-					if (cPhysics2D.CalculateDistance(vec2Index, enemyList[enemyIndex]->vec2Index) <= attackRange && vec2Index.y == enemyList[enemyIndex]->vec2Index.y) // Check if player and enemy are on the same level & check whether the enemy is within the player's range
+					CEntity2D* enemy = cEnemies.Get(vNearbyEnemies[enemyIndex]);
+					if (enemy)
 					{
 						//std::cout << "Hit Enemy Once\n";
 						//TO DO: REDUCE THEIR HP
-						enemyList[enemyIndex]->health -= playerInitialDamage;
-						//std::cout << enemyList[enemyIndex]->health << endl;
-						if (enemyList[enemyIndex]->health <= 0)
+						enemy->health -= playerInitialDamage;
+						//std::cout << enemy->health << endl;
+						if (enemy->health <= 0)
 						{
-							enemyList[enemyIndex]->~CEntity2D();
-							enemyList.erase(enemyList.begin() + enemyIndex);
-							CScene2D::GetInstance()->setNewEnemyVector(enemyList);
+							// The enemy is deleted at the end of the frame
+							cEnemies.Remove(vNearbyEnemies[enemyIndex]);
 							killCounter++;
 							break;
 						}
@@ -697,24 +701,23 @@ void CPlayer2D::Update(const double dElapsedTime)
 				}
 				//cout << "Shot Bullet\n";
 				
-					CBowProjectile* cBowProjectile = new CBowProjectile(); // Create new Projectile
-					if (direction == 1)
+					// Take a Projectile from the pool, unless every one is already in flight
+					CBowProjectile* cBowProjectile = CScene2D::GetInstance()->AcquireArrow();
+					if (cBowProjectile)
 					{
-						cBowProjectile->seti32vec2Direction(-1.0f);
-					}
-					else if (direction == 2)
-					{
-						cBowProjectile->seti32vec2Direction(1.0f);
-					}
+						if (direction == 1)
+						{
+							cBowProjectile->seti32vec2Direction(-1.0f);
+						}
+						else if (direction == 2)
+						{
+							cBowProjectile->seti32vec2Direction(1.0f);
+						}
 
-					cBowProjectile->SetShader("Shader2D_Colour");
-					cBowProjectile->Seti32vec2Index(vec2Index.x, vec2Index.y);
-					//cBowProjectile->setMaxDistance(charge);
-					cBowProjectile->SetPlayer2D(CPlayer2D::GetInstance());
-					CScene2D::GetInstance()->pushArrow(cBowProjectile);
-					if (cBowProjectile->Init() == true)
-					{
-						//cout << "Shot an arrow\n";
+						cBowProjectile->Seti32vec2Index(vec2Index.x, vec2Index.y);
+						//cBowProjectile->setMaxDistance(charge);
+						cBowProjectile->SetPlayer2D(CPlayer2D::GetInstance());
+						cBowProjectile->Fire();
 					}
 				
 				charge = 0.f;
@@ -907,7 +910,7 @@ bool CPlayer2D::CheckPosition(DIRECTION eDirection)
 		if (vec2NumMicroSteps.y == 0)
 		{
 			// If the grid is not accessible, then return false
-			if (cMap2D->GetMapInfo(vec2Index.y, vec2Index.x) >= 100)
+			if (cMap2D->IsSolid(vec2Index.y, vec2Index.x))
 			{
 				return false;
 			}
@@ -916,8 +919,8 @@ bool CPlayer2D::CheckPosition(DIRECTION eDirection)
 		else if (vec2NumMicroSteps.y != 0)
 		{
 			// If the 2 grids are not accessible, then return false
-			if ((cMap2D->GetMapInfo(vec2Index.y, vec2Index.x) >= 100) ||
-				(cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x) >= 100))
+			if (cMap2D->IsSolid(vec2Index.y, vec2Index.x) ||
+				cMap2D->IsSolid(vec2Index.y + 1, vec2Index.x))
 			{
 				return false;
 			}
@@ -936,7 +939,7 @@ bool CPlayer2D::CheckPosition(DIRECTION eDirection)
 		if (vec2NumMicroSteps.y == 0)
 		{
 			// If the grid is not accessible, then return false
-			if (cMap2D->GetMapInfo(vec2Index.y, vec2Index.x + 1) >= 100)
+			if (cMap2D->IsSolid(vec2Index.y, vec2Index.x + 1))
 			{
 				return false;
 			}
@@ -945,8 +948,8 @@ bool CPlayer2D::CheckPosition(DIRECTION eDirection)
 		else if (vec2NumMicroSteps.y != 0)
 		{
 			// If the 2 grids are not accessible, then return false
-			if ((cMap2D->GetMapInfo(vec2Index.y, vec2Index.x + 1) >= 100) ||
-				(cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x + 1) >= 100))
+			if (cMap2D->IsSolid(vec2Index.y, vec2Index.x + 1) ||
+				cMap2D->IsSolid(vec2Index.y + 1, vec2Index.x + 1))
 			{
 				return false;
 			}
@@ -966,7 +969,7 @@ bool CPlayer2D::CheckPosition(DIRECTION eDirection)
 		if (vec2NumMicroSteps.x == 0)
 		{
 			// If the grid is not accessible, then return false
-			if (cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x) >= 100)
+			if (cMap2D->IsSolid(vec2Index.y + 1, vec2Index.x))
 			{
 				return false;
 			}
@@ -975,8 +978,7 @@ bool CPlayer2D::CheckPosition(DIRECTION eDirection)
 		else if (vec2NumMicroSteps.x != 0)
 		{
 			// If the 2 grids are not accessible, then return false
-			if ((cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x) >= 100) ||
-				(cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x + 1) >= 100))
+			if (cMap2D->AnySolid(vec2Index.y + 1, vec2Index.x, vec2Index.x + 1))
 			{
 				return false;
 			}
@@ -988,7 +990,7 @@ bool CPlayer2D::CheckPosition(DIRECTION eDirection)
 		if (vec2NumMicroSteps.x == 0)
 		{
 			// If the grid is not accessible, then return false
-			if (cMap2D->GetMapInfo(vec2Index.y, vec2Index.x) >= 100)
+			if (cMap2D->IsSolid(vec2Index.y, vec2Index.x))
 			{
 				return false;
 			}
@@ -997,8 +999,7 @@ bool CPlayer2D::CheckPosition(DIRECTION eDirection)
 		else if (vec2NumMicroSteps.x != 0)
 		{
 			// If the 2 grids are not accessible, then return false
-			if ((cMap2D->GetMapInfo(vec2Index.y, vec2Index.x) >= 100) ||
-				(cMap2D->GetMapInfo(vec2Index.y, vec2Index.x + 1) >= 100))
+			if (cMap2D->AnySolid(vec2Index.y, vec2Index.x, vec2Index.x + 1))
 			{
 				return false;
 			}
@@ -1021,7 +1022,7 @@ bool CPlayer2D::IsMidAir(void)
 
 	// Check if the tile below the player's current position is empty
 	if ((vec2NumMicroSteps.x == 0) && 
-		(cMap2D->GetMapInfo(vec2Index.y-1, vec2Index.x) == 0))
+		TileProperties::IsEmpty(cMap2D->GetMapInfo(vec2Index.y-1, vec2Index.x)))
 	{
 		return true;
 	}
@@ -1579,23 +1580,12 @@ int CPlayer2D::RandItemGen()
 }
 
 
-vector<CEntity2D*> CPlayer2D::returnNearestEnemy(vector<CEntity2D*> enemyVector)
+CEntity2D* CPlayer2D::returnNearestEnemy(void)
 {
-	for (int i = 0; i != enemyVector.size(); ++i)
-	{
-		if (cPhysics2D.CalculateDistance(vec2Index, enemyVector.front()->vec2Index) <= (cPhysics2D.CalculateDistance(vec2Index, enemyVector[i]->vec2Index)))
-		{
-			continue;
-		}
-		else
-		{
-			CEntity2D* temp = enemyVector.front();
-			enemyVector.front() = enemyVector[i];
-			enemyVector[i] = temp;
-			
-		}
-	}
-	return enemyVector;
+	CScene2D::GetInstance()->GetEnemySpatialHash().QueryNearest(vec2Index, 1, vNearbyEnemies);
+	if (vNearbyEnemies.empty())
+		return NULL;
+	return CScene2D::GetInstance()->GetEnemies().Get(vNearbyEnemies.front());
 }
 
 void CPlayer2D::BreakBlocks(const double dElapsedTime) 
@@ -1607,7 +1597,7 @@ void CPlayer2D::BreakBlocks(const double dElapsedTime)
 		
 		if (direction == 1)
 		{
-			if (cMap2D->GetMapInfo(vec2Index.y, vec2Index.x - 1) >= 100 && cMap2D->GetMapInfo(vec2Index.y, vec2Index.x - 1) <= 103 && CGUI_Scene2D::GetInstance()->updateSelection() == SHOVEL_ID && breakinterval <= 0.33f)
+			if (TileProperties::IsDiggable(cMap2D->GetMapInfo(vec2Index.y, vec2Index.x - 1)) && CGUI_Scene2D::GetInstance()->updateSelection() == SHOVEL_ID && breakinterval <= 0.33f)
 			{
 				switch (cMap2D->GetMapInfo(vec2Index.y, vec2Index.x - 1))
 				{
@@ -1624,7 +1614,7 @@ void CPlayer2D::BreakBlocks(const double dElapsedTime)
 				}
 				breakinterval = 0.5f;
 			}
-			else if (cMap2D->GetMapInfo(vec2Index.y, vec2Index.x - 1) >= 106 && cMap2D->GetMapInfo(vec2Index.y, vec2Index.x - 1) <= 108 && CGUI_Scene2D::GetInstance()->updateSelection() == SHOVEL_ID && breakinterval <= 1.f) {
+			else if (TileProperties::IsChoppable(cMap2D->GetMapInfo(vec2Index.y, vec2Index.x - 1)) && CGUI_Scene2D::GetInstance()->updateSelection() == SHOVEL_ID && breakinterval <= 1.f) {
 				switch (cMap2D->GetMapInfo(vec2Index.y, vec2Index.x - 1))
 				{
 
@@ -1641,7 +1631,7 @@ void CPlayer2D::BreakBlocks(const double dElapsedTime)
 				breakinterval = 2.f;
 			}
 
-			if (cMap2D->GetMapInfo(vec2Index.y, vec2Index.x - 1) >= 106 && cMap2D->GetMapInfo(vec2Index.y, vec2Index.x - 1) <= 108 && CGUI_Scene2D::GetInstance()->updateSelection() == AXE_ID && breakinterval <= 0)
+			if (TileProperties::IsChoppable(cMap2D->GetMapInfo(vec2Index.y, vec2Index.x - 1)) && CGUI_Scene2D::GetInstance()->updateSelection() == AXE_ID && breakinterval <= 0)
 			{
 				switch (cMap2D->GetMapInfo(vec2Index.y, vec2Index.x - 1))
 				{
@@ -1660,7 +1650,7 @@ void CPlayer2D::BreakBlocks(const double dElapsedTime)
 				}
 				breakinterval = 0.5f;
 			}
-			else if (cMap2D->GetMapInfo(vec2Index.y, vec2Index.x - 1) >= 100 && cMap2D->GetMapInfo(vec2Index.y, vec2Index.x - 1) <= 103 && CGUI_Scene2D::GetInstance()->updateSelection() == AXE_ID && breakinterval <= 0) {
+			else if (TileProperties::IsDiggable(cMap2D->GetMapInfo(vec2Index.y, vec2Index.x - 1)) && CGUI_Scene2D::GetInstance()->updateSelection() == AXE_ID && breakinterval <= 0) {
 				switch (cMap2D->GetMapInfo(vec2Index.y, vec2Index.x - 1))
 				{
 
@@ -1677,7 +1667,7 @@ void CPlayer2D::BreakBlocks(const double dElapsedTime)
 				breakinterval = 2.f;
 			}
 
-			if (cMap2D->GetMapInfo(vec2Index.y, vec2Index.x - 1) >= 100 && cMap2D->GetMapInfo(vec2Index.y, vec2Index.x - 1) <= 108 && CGUI_Scene2D::GetInstance()->updateSelection() != SHOVEL_ID && CGUI_Scene2D::GetInstance()->updateSelection() != AXE_ID && breakinterval <= 0)
+			if (TileProperties::IsBreakable(cMap2D->GetMapInfo(vec2Index.y, vec2Index.x - 1)) && CGUI_Scene2D::GetInstance()->updateSelection() != SHOVEL_ID && CGUI_Scene2D::GetInstance()->updateSelection() != AXE_ID && breakinterval <= 0)
 			{
 				switch (cMap2D->GetMapInfo(vec2Index.y, vec2Index.x - 1))
 				{
@@ -1709,7 +1699,7 @@ void CPlayer2D::BreakBlocks(const double dElapsedTime)
 
 		}
 		if (direction == 2) {
-			if (cMap2D->GetMapInfo(vec2Index.y, vec2Index.x + 1) >= 100 && cMap2D->GetMapInfo(vec2Index.y, vec2Index.x + 1) <= 103 && CGUI_Scene2D::GetInstance()->updateSelection() == SHOVEL_ID && breakinterval <= 0.33f)
+			if (TileProperties::IsDiggable(cMap2D->GetMapInfo(vec2Index.y, vec2Index.x + 1)) && CGUI_Scene2D::GetInstance()->updateSelection() == SHOVEL_ID && breakinterval <= 0.33f)
 			{
 				switch (cMap2D->GetMapInfo(vec2Index.y, vec2Index.x + 1))
 				{
@@ -1726,7 +1716,7 @@ void CPlayer2D::BreakBlocks(const double dElapsedTime)
 				}
 				breakinterval = 0.5f;
 			}
-			else if (cMap2D->GetMapInfo(vec2Index.y, vec2Index.x + 1) >= 106 && cMap2D->GetMapInfo(vec2Index.y, vec2Index.x + 1) <= 108 && CGUI_Scene2D::GetInstance()->updateSelection() == SHOVEL_ID && breakinterval <= 1.f) {
+			else if (TileProperties::IsChoppable(cMap2D->GetMapInfo(vec2Index.y, vec2Index.x + 1)) && CGUI_Scene2D::GetInstance()->updateSelection() == SHOVEL_ID && breakinterval <= 1.f) {
 				switch (cMap2D->GetMapInfo(vec2Index.y, vec2Index.x + 1))
 				{
 
@@ -1743,7 +1733,7 @@ void CPlayer2D::BreakBlocks(const double dElapsedTime)
 				breakinterval = 2.f;
 			}
 
-			if (cMap2D->GetMapInfo(vec2Index.y, vec2Index.x + 1) >= 106 && cMap2D->GetMapInfo(vec2Index.y, vec2Index.x + 1) <= 108 && CGUI_Scene2D::GetInstance()->updateSelection() == AXE_ID && breakinterval <= 0)
+			if (TileProperties::IsChoppable(cMap2D->GetMapInfo(vec2Index.y, vec2Index.x + 1)) && CGUI_Scene2D::GetInstance()->updateSelection() == AXE_ID && breakinterval <= 0)
 			{
 				switch (cMap2D->GetMapInfo(vec2Index.y, vec2Index.x + 1))
 				{
@@ -1762,7 +1752,7 @@ void CPlayer2D::BreakBlocks(const double dElapsedTime)
 				}
 				breakinterval = 0.5f;
 			}
-			else if (cMap2D->GetMapInfo(vec2Index.y, vec2Index.x + 1) >= 100 && cMap2D->GetMapInfo(vec2Index.y, vec2Index.x + 1) <= 103 && CGUI_Scene2D::GetInstance()->updateSelection() == AXE_ID && breakinterval <= 0) {
+			else if (TileProperties::IsDiggable(cMap2D->GetMapInfo(vec2Index.y, vec2Index.x + 1)) && CGUI_Scene2D::GetInstance()->updateSelection() == AXE_ID && breakinterval <= 0) {
 				switch (cMap2D->GetMapInfo(vec2Index.y, vec2Index.x + 1))
 				{
 
@@ -1779,7 +1769,7 @@ void CPlayer2D::BreakBlocks(const double dElapsedTime)
 				breakinterval = 2.f;
 			}
 
-			if (cMap2D->GetMapInfo(vec2Index.y, vec2Index.x + 1) >= 100 && cMap2D->GetMapInfo(vec2Index.y, vec2Index.x + 1) <= 108 && CGUI_Scene2D::GetInstance()->updateSelection() != SHOVEL_ID && CGUI_Scene2D::GetInstance()->updateSelection() != AXE_ID && breakinterval <= 0)
+			if (TileProperties::IsBreakable(cMap2D->GetMapInfo(vec2Index.y, vec2Index.x + 1)) && CGUI_Scene2D::GetInstance()->updateSelection() != SHOVEL_ID && CGUI_Scene2D::GetInstance()->updateSelection() != AXE_ID && breakinterval <= 0)
 			{
 				switch (cMap2D->GetMapInfo(vec2Index.y, vec2Index.x + 1))
 				{
@@ -1812,7 +1802,7 @@ void CPlayer2D::BreakBlocks(const double dElapsedTime)
 	}
 	if (cKeyboardController->IsKeyDown(GLFW_KEY_U)) 
 	{
-		if (cMap2D->GetMapInfo(vec2Index.y - 1, vec2Index.x) >= 100 && cMap2D->GetMapInfo(vec2Index.y - 1, vec2Index.x) <= 103 && CGUI_Scene2D::GetInstance()->updateSelection() == SHOVEL_ID && breakinterval <= 0.33f)
+		if (TileProperties::IsDiggable(cMap2D->GetMapInfo(vec2Index.y - 1, vec2Index.x)) && CGUI_Scene2D::GetInstance()->updateSelection() == SHOVEL_ID && breakinterval <= 0.33f)
 		{
 			switch (cMap2D->GetMapInfo(vec2Index.y - 1, vec2Index.x))
 			{
@@ -1829,7 +1819,7 @@ void CPlayer2D::BreakBlocks(const double dElapsedTime)
 			}
 			breakinterval = 0.5f;
 		}
-		else if (cMap2D->GetMapInfo(vec2Index.y - 1, vec2Index.x) >= 106 && cMap2D->GetMapInfo(vec2Index.y - 1, vec2Index.x) <= 108 && CGUI_Scene2D::GetInstance()->updateSelection() == SHOVEL_ID && breakinterval <= 1.f) {
+		else if (TileProperties::IsChoppable(cMap2D->GetMapInfo(vec2Index.y - 1, vec2Index.x)) && CGUI_Scene2D::GetInstance()->updateSelection() == SHOVEL_ID && breakinterval <= 1.f) {
 			switch (cMap2D->GetMapInfo(vec2Index.y - 1, vec2Index.x))
 			{
 
@@ -1846,7 +1836,7 @@ void CPlayer2D::BreakBlocks(const double dElapsedTime)
 			breakinterval = 2.f;
 		}
 
-		if (cMap2D->GetMapInfo(vec2Index.y - 1, vec2Index.x) >= 106 && cMap2D->GetMapInfo(vec2Index.y - 1, vec2Index.x) <= 108 && CGUI_Scene2D::GetInstance()->updateSelection() == AXE_ID && breakinterval <= 0)
+		if (TileProperties::IsChoppable(cMap2D->GetMapInfo(vec2Index.y - 1, vec2Index.x)) && CGUI_Scene2D::GetInstance()->updateSelection() == AXE_ID && breakinterval <= 0)
 		{
 			switch (cMap2D->GetMapInfo(vec2Index.y - 1, vec2Index.x))
 			{
@@ -1865,7 +1855,7 @@ void CPlayer2D::BreakBlocks(const double dElapsedTime)
 			}
 			breakinterval = 0.5f;
 		}
-		else if (cMap2D->GetMapInfo(vec2Index.y - 1, vec2Index.x) >= 100 && cMap2D->GetMapInfo(vec2Index.y - 1, vec2Index.x) <= 103 && CGUI_Scene2D::GetInstance()->updateSelection() == AXE_ID && breakinterval <= 0) {
+		else if (TileProperties::IsDiggable(cMap2D->GetMapInfo(vec2Index.y - 1, vec2Index.x)) && CGUI_Scene2D::GetInstance()->updateSelection() == AXE_ID && breakinterval <= 0) {
 			switch (cMap2D->GetMapInfo(vec2Index.y - 1, vec2Index.x))
 			{
 
@@ -1882,7 +1872,7 @@ void CPlayer2D::BreakBlocks(const double dElapsedTime)
 			breakinterval = 2.f;
 		}
 
-		if (cMap2D->GetMapInfo(vec2Index.y - 1, vec2Index.x) >= 100 && cMap2D->GetMapInfo(vec2Index.y - 1, vec2Index.x) <= 108 && CGUI_Scene2D::GetInstance()->updateSelection() != SHOVEL_ID && CGUI_Scene2D::GetInstance()->updateSelection() != AXE_ID && breakinterval <= 0)
+		if (TileProperties::IsBreakable(cMap2D->GetMapInfo(vec2Index.y - 1, vec2Index.x)) && CGUI_Scene2D::GetInstance()->updateSelection() != SHOVEL_ID && CGUI_Scene2D::GetInstance()->updateSelection() != AXE_ID && breakinterval <= 0)
 		{
 			switch (cMap2D->GetMapInfo(vec2Index.y - 1, vec2Index.x))
 			{
@@ -1912,7 +1902,7 @@ void CPlayer2D::BreakBlocks(const double dElapsedTime)
 	if (cKeyboardController->IsKeyDown(GLFW_KEY_P)) {
 
 
-		if (cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x) >= 100 && cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x) <= 103 && CGUI_Scene2D::GetInstance()->updateSelection() == SHOVEL_ID && breakinterval <= 0.33f)
+		if (TileProperties::IsDiggable(cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x)) && CGUI_Scene2D::GetInstance()->updateSelection() == SHOVEL_ID && breakinterval <= 0.33f)
 		{
 			switch (cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x))
 			{
@@ -1929,7 +1919,7 @@ void CPlayer2D::BreakBlocks(const double dElapsedTime)
 			}
 			breakinterval = 0.5f;
 		}
-		else if (cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x) >= 106 && cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x) <= 108 && CGUI_Scene2D::GetInstance()->updateSelection() == SHOVEL_ID && breakinterval <= 1.f) {
+		else if (TileProperties::IsChoppable(cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x)) && CGUI_Scene2D::GetInstance()->updateSelection() == SHOVEL_ID && breakinterval <= 1.f) {
 			switch (cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x))
 			{
 
@@ -1946,7 +1936,7 @@ void CPlayer2D::BreakBlocks(const double dElapsedTime)
 			breakinterval = 2.f;
 		}
 
-		if (cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x) >= 106 && cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x) <= 108 && CGUI_Scene2D::GetInstance()->updateSelection() == AXE_ID && breakinterval <= 0)
+		if (TileProperties::IsChoppable(cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x)) && CGUI_Scene2D::GetInstance()->updateSelection() == AXE_ID && breakinterval <= 0)
 		{
 			switch (cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x))
 			{
@@ -1965,7 +1955,7 @@ void CPlayer2D::BreakBlocks(const double dElapsedTime)
 			}
 			breakinterval = 0.5f;
 		}
-		else if (cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x) >= 100 && cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x) <= 103 && CGUI_Scene2D::GetInstance()->updateSelection() == AXE_ID && breakinterval <= 0) {
+		else if (TileProperties::IsDiggable(cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x)) && CGUI_Scene2D::GetInstance()->updateSelection() == AXE_ID && breakinterval <= 0) {
 			switch (cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x))
 			{
 
@@ -1982,7 +1972,7 @@ void CPlayer2D::BreakBlocks(const double dElapsedTime)
 			breakinterval = 2.f;
 		}
 
-		if (cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x) >= 100 && cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x) <= 108 && CGUI_Scene2D::GetInstance()->updateSelection() != SHOVEL_ID && CGUI_Scene2D::GetInstance()->updateSelection() != AXE_ID && breakinterval <= 0)
+		if (TileProperties::IsBreakable(cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x)) && CGUI_Scene2D::GetInstance()->updateSelection() != SHOVEL_ID && CGUI_Scene2D::GetInstance()->updateSelection() != AXE_ID && breakinterval <= 0)
 		{
 			switch (cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x))
 			{
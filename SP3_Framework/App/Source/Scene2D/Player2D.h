@@ -35,6 +35,9 @@ class CMap2D;
 // Include Physics2D
 #include "Physics2D.h"
 
+// Include CEntityRegistry
+#include "EntityRegistry.h"
+
 // Include AnimatedSprites
 #include "Primitives/SpriteAnimation.h"
 
@@ -75,7 +78,8 @@ public:
 
 	void setPlayerRuntimeColor(glm::vec4 color);
 
-	vector<CEntity2D*> returnNearestEnemy(vector<CEntity2D*> enemyVector);
+	// Get the nearest enemy which has not been killed, or NULL if there are none
+	CEntity2D* returnNearestEnemy(void);
 
 	CInventoryManager* returnPlayerHealth(void);
 
@@ -142,8 +146,8 @@ protected:
 	
 	CInventoryManager* damageOnPlayer;
 
-	// List of enemies
-	vector <CEntity2D*> enemyList;
+	// The enemies which a query found, which are kept between frames to reuse the memory
+	vector<CEntityRegistry::Handle> vNearbyEnemies;
 
 	//Check whether the enemy is within range
 	bool hitEnemy;
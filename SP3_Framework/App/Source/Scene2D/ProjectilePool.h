@@ -0,0 +1,146 @@
+/**
+ CProjectilePool
+ @brief A fixed number of projectiles which are created and initialised once, when the level
+		starts, and then reused for every shot. Acquiring a projectile pops it off a free
+		list, and a projectile which has finished sets its bIsActive to false and is pushed
+		back onto the free list by ReleaseInactive(), so firing allocates nothing and creates
+		no OpenGL objects. When every projectile is in flight, no more can be acquired.
+		T must have a bool Init(void) which sets up everything which does not change between
+		shots, a SetShader() and a bIsActive flag.
+ */
+#pragma once
+
+#include <vector>
+#include <string>
+#include <iostream>
+
+template <typename T>
+class CProjectilePool
+{
+public:
+	// Constructor
+	CProjectilePool(void)
+	{
+	}
+
+	// Destructor
+	virtual ~CProjectilePool(void)
+	{
+		Destroy();
+	}
+
+	/**
+	 @brief Create and initialise the projectiles. A pool which was already created keeps its
+			projectiles, and only puts them all back on the free list
+	 @param uiCapacity A const unsigned int variable containing the number of projectiles
+	 @param sShaderName A const std::string& variable containing the shader of the projectiles
+	 @return false if a projectile could not be initialised
+	 */
+	bool Init(const unsigned int uiCapacity, const std::string& sShaderName)
+	{
+		if (vProjectiles.size() == uiCapacity)
+		{
+			ReleaseAll();
+			return true;
+		}
+
+		Destroy();
+		vProjectiles.reserve(uiCapacity);
+		vFree.reserve(uiCapacity);
+		vLive.reserve(uiCapacity);
+		for (unsigned int i = 0; i < uiCapacity; i++)
+		{
+			T* pProjectile = new T();
+			pProjectile->SetShader(sShaderName);
+			vProjectiles.push_back(pProjectile);
+			if (pProjectile->Init() == false)
+			{
+				std::cout << "CProjectilePool::Init(): Unable to initialise a projectile" << std::endl;
+				Destroy();
+				return false;
+			}
+			pProjectile->bIsActive = false;
+			vFree.push_back(pProjectile);
+		}
+		return true;
+	}
+
+	// Delete all the projectiles
+	void Destroy(void)
+	{
+		for (unsigned int i = 0; i < vProjectiles.size(); i++)
+			delete vProjectiles[i];
+		vProjectiles.clear();
+		vFree.clear();
+		vLive.clear();
+	}
+
+	/**
+	 @brief Take a projectile off the free list. The caller sets it up and activates it
+	 @return The projectile, or NULL if every projectile is in flight
+	 */
+	T* Acquire(void)
+	{
+		if (vFree.empty())
+			return NULL;
+
+		T* pProjectile = vFree.back();
+		vFree.pop_back();
+		vLive.push_back(pProjectile);
+		return pProjectile;
+	}
+
+	// Put the projectiles which are no longer active back on the free list
+	void ReleaseInactive(void)
+	{
+		unsigned int i = 0;
+		while (i < vLive.size())
+		{
+			if (vLive[i]->bIsActive)
+			{
+				i++;
+				continue;
+			}
+			// Fill the gap with the last live projectile, since the order does not matter
+			vFree.push_back(vLive[i]);
+			vLive[i] = vLive.back();
+			vLive.pop_back();
+		}
+	}
+
+	// Put every projectile back on the free list
+	void ReleaseAll(void)
+	{
+		for (unsigned int i = 0; i < vLive.size(); i++)
+		{
+			vLive[i]->bIsActive = false;
+			vFree.push_back(vLive[i]);
+		}
+		vLive.clear();
+	}
+
+	// Get the projectiles which have been acquired and not released yet
+	const std::vector<T*>& GetLive(void) const
+	{
+		return vLive;
+	}
+
+	// Get the number of projectiles in the pool
+	unsigned int GetCapacity(void) const
+	{
+		return (unsigned int)vProjectiles.size();
+	}
+
+protected:
+	// Every projectile in the pool, which the pool owns
+	std::vector<T*> vProjectiles;
+	// The projectiles which can be acquired
+	std::vector<T*> vFree;
+	// The projectiles which have been acquired
+	std::vector<T*> vLive;
+
+private:
+	// The projectiles are owned by one pool, so it cannot be copied
+	CProjectilePool(const CProjectilePool&);
+	CProjectilePool& operator=(const CProjectilePool&);
+};
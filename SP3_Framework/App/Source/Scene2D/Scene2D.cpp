@@ -56,12 +56,8 @@ CScene2D::~CScene2D(void)
 	}
 
 	// Destroy the enemies
-	for (int i = 0; i < enemyVector.size(); i++)
-	{
-		delete enemyVector[i];
-		enemyVector[i] = NULL;
-	}
-	enemyVector.clear();
+	cEnemies.Clear();
+	CEnemySimulation::Destroy();
 
 	if (cPlayer2D)
 	{
@@ -91,9 +87,9 @@ bool CScene2D::Init(void)
 	// Create and initialise the Map 2D
 	cMap2D = CMap2D::GetInstance();
 	// Set a shader to this class
-	cMap2D->SetShader("Shader2D");
+	cMap2D->SetShader("Shader2D_TileMap");
 	// Initialise the instance
-	if (cMap2D->Init(8, 24, 32) == false)
+	if (cMap2D->Init(6, 24, 32) == false)
 	{
 		cout << "Failed to load CMap2D" << endl;
 		return false;
@@ -111,37 +107,37 @@ bool CScene2D::Init(void)
 	//	return false;
 	//}
 	// Load the map into an array
-	if (cMap2D->LoadMap("Maps/DM2213_Map_Level_cave.csv", 0) == false)
+	if (cMap2D->LoadMap("Maps/DM2213_Map_Level_cave.map", 0) == false)
 	{
 		// The loading of a map has failed. Return false
 		return false;
 	}
 	// Load the map into an array
-	if (cMap2D->LoadMap("Maps/DM2213_Map_Level_forest.csv", 1) == false)
+	if (cMap2D->LoadMap("Maps/DM2213_Map_Level_forest.map", 1) == false)
 	{
 		// The loading of a map has failed. Return false
 		return false;
 	}
 	// Load the map into an array
-	if (cMap2D->LoadMap("Maps/DM2213_Map_Level_hills.csv", 2) == false)
+	if (cMap2D->LoadMap("Maps/DM2213_Map_Level_hills.map", 2) == false)
 	{
 		// The loading of a map has failed. Return false
 		return false;
 	}
 	// Load the map into an array
-	if (cMap2D->LoadMap("Maps/DM2213_Map_Level_islands.csv", 3) == false)
+	if (cMap2D->LoadMap("Maps/DM2213_Map_Level_islands.map", 3) == false)
 	{
 		// The loading of a map has failed. Return false
 		return false;
 	}
 	// Load the map into an array
-	if (cMap2D->LoadMap("Maps/DM2213_Map_Level_plains.csv", 4) == false)
+	if (cMap2D->LoadMap("Maps/DM2213_Map_Level_plains.map", 4) == false)
 	{
 		// The loading of a map has failed. Return false
 		return false;
 	}
 	// Load the map into an array
-	if (cMap2D->LoadMap("Maps/DM2213_Map_Level_valley.csv", 5) == false)
+	if (cMap2D->LoadMap("Maps/DM2213_Map_Level_valley.map", 5) == false)
 	{
 		// The loading of a map has failed. Return false
 		return false;
@@ -151,8 +147,17 @@ bool CScene2D::Init(void)
 	for (int i = 0; i < 13; i++) {
 		cMap2D->spawntree();
 	}
+	// Start preparing the next level while this one is played
+	cMap2D->PrepareLevel(cMap2D->GetCurrentLevel() + 1);
 	// Activate diagonal movement
 	cMap2D->SetDiagonalMovement(false);
+	// The ground enemies' jump from their UpdatePosition(), which decides where they can jump to
+	cMap2D->SetJumpArc(glm::vec2(0.0f, 3.5f));
+	// Limit the nodes which the enemies' queued path searches expand in one frame
+	cMap2D->SetPathBudget(256);
+	// Run the queued path searches on worker threads, leaving a core for the main thread
+	const unsigned int uiNumCores = std::thread::hardware_concurrency();
+	cMap2D->StartPathWorkers((uiNumCores > 2) ? 2 : ((uiNumCores > 1) ? 1 : 0));
 
 	// Load Scene2DColour into ShaderManager
 	CShaderManager::GetInstance()->Use("Shader2D_Colour");
@@ -169,14 +174,26 @@ bool CScene2D::Init(void)
 		return false;
 	}
 
-	//Create and initialise the CEnemyProjectile
-	liveBullets.clear();
+	//Create and initialise the CEnemyProjectiles, so that firing creates nothing
+	if (cBulletPool.Init(NUM_POOLED_BULLETS, "Shader2D_Colour") == false)
+	{
+		cout << "Failed to load CEnemyProjectile" << endl;
+		return false;
+	}
+
+	//Create and initialise the CBowProjectiles
+	if (cArrowPool.Init(NUM_POOLED_ARROWS, "Shader2D_Colour") == false)
+	{
+		cout << "Failed to load CBowProjectile" << endl;
+		return false;
+	}
 
-	//Create and initialise the CBowProjectile
-	liveArrows.clear();
+	// Sort the enemies into cells of the level, so that hits only check the enemies nearby
+	cEnemySpatialHash.Init(CSettings::GetInstance()->NUM_TILES_YAXIS, CSettings::GetInstance()->NUM_TILES_XAXIS, ENEMY_HASH_CELL_SIZE);
+	cEnemies.SetSpatialHash(&cEnemySpatialHash);
 
 	// Create and initialise the CEnemy2D
-	enemyVector.clear();
+	cEnemies.Clear();
 	while (true)
 	{
 		CEnemy2D* cEnemy2D = new CEnemy2D();
@@ -186,10 +203,12 @@ bool CScene2D::Init(void)
 		if (cEnemy2D->Init() == true)
 		{
 			cEnemy2D->SetPlayer2D(cPlayer2D);
-			enemyVector.push_back(cEnemy2D);
+			cEnemies.Add(cEnemy2D);
 		}
 		else
 		{
+			delete cEnemy2D;
+			cEnemy2D = NULL;
 			// Break out of this loop if the enemy has all been loaded
 			break;
 		}
@@ -204,7 +223,7 @@ bool CScene2D::Init(void)
 			cWoodCrawler->SetPlayer2D(cPlayer2D);
 			cWoodCrawler->setHP(10000);
 			cWoodCrawler->setMaxHP(10000);
-			enemyVector.push_back(cWoodCrawler);
+			cEnemies.Add(cWoodCrawler);
 		}
 		else
 		{
@@ -226,7 +245,7 @@ bool CScene2D::Init(void)
 			cGlutton->SetPlayer2D(cPlayer2D);
 			cGlutton->setHP(60);
 			cGlutton->setMaxHP(60);
-			enemyVector.push_back(cGlutton);
+			cEnemies.Add(cGlutton);
 		}
 		else
 		{
@@ -248,7 +267,7 @@ bool CScene2D::Init(void)
 			cBloodDeer->SetPlayer2D(cPlayer2D);
 			cBloodDeer->setHP(300);
 			cBloodDeer->setMaxHP(300);
-			enemyVector.push_back(cBloodDeer);
+			cEnemies.Add(cBloodDeer);
 		}
 		else
 		{
@@ -258,6 +277,8 @@ bool CScene2D::Init(void)
 			break;
 		}
 	}
+	// Put the enemies which were loaded into the list
+	cEnemies.Flush();
 
 	// Store the keyboard controller singleton instance here
 	cKeyboardController = CKeyboardController::GetInstance();
@@ -314,32 +335,51 @@ bool CScene2D::Init(void)
 */
 bool CScene2D::Update(const double dElapsedTime)
 {
+	// Hand the paths which the path workers finished since the last frame to the enemies
+	cMap2D->CollectPathResults();
+
 	// Call the cPlayer2D's update method before Map2D as we want to capture the inputs before map2D update
 	cPlayer2D->Update(dElapsedTime);
+
+	// Point the enemies' shared platform field at the player, before the enemies read it
+	cMap2D->UpdatePlatformField(cPlayer2D->vec2Index);
 	
 	//enemyProjectile->Update(dElapsedTime);
 	
 	// Call all the cEnemy2D's update method before Map2D 
 	// as we want to capture the updates before map2D update
-	for (int i = 0; i < enemyVector.size(); i++)
+	// The list does not change until the end of the frame, even if an enemy is killed or spawned
+	const vector<CEntity2D*>& enemies = cEnemies.GetEntities();
+	for (unsigned int i = 0; i < enemies.size(); i++)
 	{
-		enemyVector[i]->Update(dElapsedTime);
+		// Skip the enemies which were killed earlier in this frame
+		if (cEnemies.IsRemoving(i))
+			continue;
+		enemies[i]->Update(dElapsedTime);
 	}
+	// Make the enemies jump or fall, and work out where they are drawn, in one pass over all of them
+	CEnemySimulation::GetInstance()->Update(dElapsedTime);
+	// Move the enemies which have walked into another cell
+	cEnemySpatialHash.Update(cEnemies);
+
+	// Run the path searches which the enemies asked for, within this frame's budget
+	cMap2D->UpdatePathRequests(cPlayer2D->vec2Index);
 
-	if (liveBullets.size() > 0)
+	const vector<CEnemyProjectile*>& liveBullets = cBulletPool.GetLive();
+	for (unsigned int j = 0; j < liveBullets.size(); j++)
 	{
-		for (int j = 0; j < liveBullets.size(); j++)
-		{
-			liveBullets[j]->Update(dElapsedTime);
-		}
+		liveBullets[j]->Update(dElapsedTime);
 	}
-	if (liveArrows.size() > 0)
+	// Put the bullets which have stopped back in the pool
+	cBulletPool.ReleaseInactive();
+
+	const vector<CBowProjectile*>& liveArrows = cArrowPool.GetLive();
+	for (unsigned int k = 0; k < liveArrows.size(); k++)
 	{
-		for (int k = 0; k < liveArrows.size(); k++)
-		{
-			liveArrows[k]->Update(dElapsedTime);
-		}
+		liveArrows[k]->Update(dElapsedTime);
 	}
+	// Put the arrows which have stopped back in the pool
+	cArrowPool.ReleaseInactive();
 	 
 	// Call the Map2D's update method
 	cMap2D->Update(dElapsedTime);
@@ -379,12 +419,19 @@ bool CScene2D::Update(const double dElapsedTime)
 	// Check if the game should go to the next level
 	if (cGameManager->bLevelCompleted == true)
 	{
-		cMap2D->SetCurrentLevel(cMap2D->GetCurrentLevel() + 1);
-		cMap2D->spawnchest();
-		for (int i = 0; i < 13; i++) {
+		// Swap in the next level, which has been prepared in the background
+		if ((cMap2D->GetPreparedLevel() != cMap2D->GetCurrentLevel() + 1) ||
+			(cMap2D->SwitchToPreparedLevel() == false))
+		{
+			cMap2D->SetCurrentLevel(cMap2D->GetCurrentLevel() + 1);
+			cMap2D->spawnchest();
+			for (int i = 0; i < 13; i++) {
 
-			cMap2D->spawntree();
+				cMap2D->spawntree();
+			}
 		}
+		// Start preparing the level after it
+		cMap2D->PrepareLevel(cMap2D->GetCurrentLevel() + 1);
 		cPlayer2D->Reset();
 		cGameManager->bLevelCompleted = false;
 		enemySpawnRate -= 1;
@@ -396,12 +443,7 @@ bool CScene2D::Update(const double dElapsedTime)
 
 
 		// Destroy the enemies
-		for (int i = 0; i < enemyVector.size(); i++)
-		{
-			delete enemyVector[i];
-			enemyVector[i] = NULL;
-		}
-		enemyVector.clear();
+		cEnemies.Clear();
 	}
 	
 
@@ -449,93 +491,72 @@ bool CScene2D::Update(const double dElapsedTime)
 		enemySpawnTimeCounter = enemySpawnRate;
 	}
 
+	// Enemies spawn on empty tiles in the middle columns of the level
+	const unsigned int uiSpawnMinCol = (CSettings::GetInstance()->NUM_TILES_XAXIS - 1) / 3;
+	const unsigned int uiSpawnMaxCol = uiSpawnMinCol + (CSettings::GetInstance()->NUM_TILES_XAXIS - 2) / 2;
+	unsigned int uiSpawnRow, uiSpawnCol;
+
 	if (enemySpawnTimeCounter <= 0 && totalSpawned < enemiesPerLevel)
 	{ 
-		srand((unsigned)time(NULL));
-		float batches = rand() % 5 + 1;
-		float counter = 0;
-		while (true)
+		// Draw from the map's generator, which is seeded once, instead of reseeding rand() here
+		const unsigned int batches = cMap2D->GetRandom(1, 5);
+		unsigned int counter = 0;
+		while (counter < batches)
 		{
-			float randEnemy = rand() % 2 + 1;
-			float randcol = rand() % (CSettings::GetInstance()->NUM_TILES_XAXIS - 1) / 2 + (CSettings::GetInstance()->NUM_TILES_XAXIS - 1) / 3; // no of col
-			float randrow = rand() % (CSettings::GetInstance()->NUM_TILES_YAXIS - 1); // no of rows
-			//cout << randcol << " , " << randrow << endl;
-			if (cMap2D->GetMapInfo(randrow, randcol) != 0)
-			{
-				continue;
-			}
-			else
+			const unsigned int randEnemy = cMap2D->GetRandom(1, 2);
+			if (cMap2D->GetRandomSpawnCell(CSpawnCellIndex::SPAWN_EMPTY, uiSpawnMinCol, uiSpawnMaxCol, uiSpawnRow, uiSpawnCol) == false)
+				break;
+
+			//cout << randEnemy << endl;
+			if (randEnemy == 1)
 			{
-				//cout << randEnemy << endl;
-				if (randEnemy == 1)
+				CWoodCrawler* cWoodCrawler = new CWoodCrawler();
+				cWoodCrawler->SetShader("Shader2D_Colour");
+				cWoodCrawler->Seti32vec2Index(uiSpawnCol, uiSpawnRow);
+				if (cWoodCrawler->Init2() == true)
 				{
-					CWoodCrawler* cWoodCrawler = new CWoodCrawler();
-					cWoodCrawler->SetShader("Shader2D_Colour");
-					cWoodCrawler->Seti32vec2Index(randcol, randrow);
-					if (cWoodCrawler->Init2() == true)
-					{
-						cWoodCrawler->SetPlayer2D(cPlayer2D);
-						cWoodCrawler->setHP(60);
-						cWoodCrawler->setMaxHP(60);
-						enemyVector.push_back(cWoodCrawler);
-					}
+					cWoodCrawler->SetPlayer2D(cPlayer2D);
+					cWoodCrawler->setHP(60);
+					cWoodCrawler->setMaxHP(60);
+					cEnemies.Add(cWoodCrawler);
 				}
-				else if (randEnemy == 2)
+			}
+			else if (randEnemy == 2)
+			{
+				CGlutton* cGlutton = new CGlutton();
+				cGlutton->SetShader("Shader2D_Colour");
+				cGlutton->Seti32vec2Index(uiSpawnCol, uiSpawnRow);
+				if (cGlutton->Init2() == true)
 				{
-					CGlutton* cGlutton = new CGlutton();
-					cGlutton->SetShader("Shader2D_Colour");
-					cGlutton->Seti32vec2Index(randcol, randrow);
-					if (cGlutton->Init2() == true)
-					{
-						cGlutton->SetPlayer2D(cPlayer2D);
-						cGlutton->setHP(60);
-						cGlutton->setMaxHP(60);
-						enemyVector.push_back(cGlutton);
-					}
+					cGlutton->SetPlayer2D(cPlayer2D);
+					cGlutton->setHP(60);
+					cGlutton->setMaxHP(60);
+					cEnemies.Add(cGlutton);
 				}
-				counter++;
-				totalSpawned++;
-
-				if (counter == batches)
-				{
-					enemySpawnTimeCounter = enemySpawnRate;
-					break;
-				}			
 			}
+			counter++;
+			totalSpawned++;
 		}
+		enemySpawnTimeCounter = enemySpawnRate;
 	}
 	if (cPlayer2D->getPlayerKills() % enemyCheck == 0 && cPlayer2D->getPlayerKills() != 0)
 	{
 		if (!bossSpawned)
 		{
-			while (true)
+			if (cMap2D->GetRandomSpawnCell(CSpawnCellIndex::SPAWN_EMPTY, uiSpawnMinCol, uiSpawnMaxCol, uiSpawnRow, uiSpawnCol))
 			{
-				srand((unsigned)time(NULL));
-
-				float randcol = rand() % (CSettings::GetInstance()->NUM_TILES_XAXIS - 1) / 2 + (CSettings::GetInstance()->NUM_TILES_XAXIS - 1) / 3; // no of col
-				float randrow = rand() % (CSettings::GetInstance()->NUM_TILES_YAXIS - 1); // no of rows
-				//cout << randcol << " , " << randrow << endl;
-				if (cMap2D->GetMapInfo(randrow, randcol) != 0)
+				CBloodDeer* cBloodDeer = new CBloodDeer();
+				cBloodDeer->SetShader("Shader2D_Colour");
+				cBloodDeer->Seti32vec2Index(uiSpawnCol, uiSpawnRow);
+				if (cBloodDeer->Init2() == true)
 				{
-					continue;
-				}
-				else
-				{
-
-					CBloodDeer* cBloodDeer = new CBloodDeer();
-					cBloodDeer->SetShader("Shader2D_Colour");
-					cBloodDeer->Seti32vec2Index(randcol, randrow);
-					if (cBloodDeer->Init2() == true)
-					{
-						cBloodDeer->SetPlayer2D(cPlayer2D);
-						cBloodDeer->setHP(300);
-						cBloodDeer->setMaxHP(300);
-						enemyVector.push_back(cBloodDeer);
-					}
-					bossSpawned = true;
-					totalSpawned++;
-					break;
+					cBloodDeer->SetPlayer2D(cPlayer2D);
+					cBloodDeer->setHP(300);
+					cBloodDeer->setMaxHP(300);
+					cEnemies.Add(cBloodDeer);
 				}
+				bossSpawned = true;
+				totalSpawned++;
 			}
 		}
 	}
@@ -544,6 +565,9 @@ bool CScene2D::Update(const double dElapsedTime)
 		bossSpawned = false;
 	}
 
+	// Delete the enemies which were killed and list the ones which were spawned in this frame
+	cEnemies.Flush();
+
 	return true;
 }
 
@@ -574,39 +598,36 @@ void CScene2D::Render(void)
 	cMap2D->Render();
 	// Call the Map2D's PostRender()
 	cMap2D->PostRender();
-	for (int i = 0; i < enemyVector.size(); i++)
+	const vector<CEntity2D*>& enemies = cEnemies.GetEntities();
+	for (unsigned int i = 0; i < enemies.size(); i++)
 	{
 		// Call the CEnemy2D's PreRender()
-		enemyVector[i]->PreRender();
+		enemies[i]->PreRender();
 		// Call the CEnemy2D's Render()
-		enemyVector[i]->Render();
+		enemies[i]->Render();
 		// Call the CEnemy2D's PostRender()
-		enemyVector[i]->PostRender();
+		enemies[i]->PostRender();
 	}
 
-	if (liveBullets.size() > 0)
+	const vector<CEnemyProjectile*>& liveBullets = cBulletPool.GetLive();
+	for (unsigned int i = 0; i < liveBullets.size(); i++)
 	{
-		for (int i = 0; i < liveBullets.size(); i++)
-		{
-			// Call the CEnemy2D's PreRender()
-			liveBullets[i]->PreRender();
-			// Call the CEnemy2D's Render()
-			liveBullets[i]->Render();
-			// Call the CEnemy2D's PostRender()
-			liveBullets[i]->PostRender();
-		}
+		// Call the CEnemy2D's PreRender()
+		liveBullets[i]->PreRender();
+		// Call the CEnemy2D's Render()
+		liveBullets[i]->Render();
+		// Call the CEnemy2D's PostRender()
+		liveBullets[i]->PostRender();
 	}
-	if (liveArrows.size() > 0)
+	const vector<CBowProjectile*>& liveArrows = cArrowPool.GetLive();
+	for (unsigned int i = 0; i < liveArrows.size(); i++)
 	{
-		for (int i = 0; i < liveArrows.size(); i++)
-		{
-			// Call the CEnemy2D's PreRender()
-			liveArrows[i]->PreRender();
-			// Call the CEnemy2D's Render()
-			liveArrows[i]->Render();
-			// Call the CEnemy2D's PostRender()
-			liveArrows[i]->PostRender();
-		}
+		// Call the CEnemy2D's PreRender()
+		liveArrows[i]->PreRender();
+		// Call the CEnemy2D's Render()
+		liveArrows[i]->Render();
+		// Call the CEnemy2D's PostRender()
+		liveArrows[i]->PostRender();
 	}
 
 	// Call the CPlayer2D's PreRender()
@@ -661,44 +682,24 @@ void CScene2D::resetDuration(void)
 	dayCounter = 0.0f;
 }
 
-vector<CEntity2D*> CScene2D::returnEnemyVector(void)
-{
-	return enemyVector;
-}
-
-void CScene2D::setNewEnemyVector(vector<CEntity2D*> &newList)
-{
-	enemyVector = newList;
-}
-
-void CScene2D::pushArrow(CEntity2D* arrow)
-{
-	liveArrows.push_back(arrow);
-}
-
-void CScene2D::setLiveBulletVector(vector<CEntity2D*>& vectorOfBullets)
-{
-	liveBullets = vectorOfBullets;
-}
-
-void CScene2D::pushBullet(CEntity2D* bullet)
+CEntityRegistry& CScene2D::GetEnemies(void)
 {
-	liveBullets.push_back(bullet);
+	return cEnemies;
 }
 
-vector<CEntity2D*> CScene2D::getLiveBulletVector(void)
+CEntitySpatialHash& CScene2D::GetEnemySpatialHash(void)
 {
-	return liveBullets;
+	return cEnemySpatialHash;
 }
 
-void CScene2D::setLiveArrowVector(vector<CEntity2D*>& vectorOfArrows)
+CEnemyProjectile* CScene2D::AcquireBullet(void)
 {
-	liveArrows = vectorOfArrows;
+	return cBulletPool.Acquire();
 }
 
-vector<CEntity2D*> CScene2D::getLiveArrowVector(void)
+CBowProjectile* CScene2D::AcquireArrow(void)
 {
-	return liveArrows;
+	return cArrowPool.Acquire();
 }
 
 int CScene2D::getTotalEnemies(void)
@@ -56,6 +56,19 @@
 #include "..\SoundController\SoundController.h"
 
 #include "EnemyProjectile.h"
+#include "BowProjectile.h"
+// Include CProjectilePool
+#include "ProjectilePool.h"
+// Include CEntityRegistry
+#include "EntityRegistry.h"
+// Include CEntitySpatialHash
+#include "EntitySpatialHash.h"
+// Include CEnemySimulation
+#include "EnemySimulation.h"
+
+// The projectile headers include this header, so they may not be defined yet
+class CEnemyProjectile;
+class CBowProjectile;
 
 
 class CScene2D : public CSingletonTemplate<CScene2D>
@@ -89,25 +102,17 @@ public:
 	float getDuration(void); // How long has it been day / night
 
 	void resetDuration(void); //Reset the counter ^
-	vector<CEntity2D*>returnEnemyVector(void); // Returns the enemy vector 
-
-	void setNewEnemyVector(vector<CEntity2D*>& newList);// Set new enemy vector
-	// Push Bullet into the vector
-	void pushBullet(CEntity2D* bullet);
+	// Get the enemies. Killing an enemy removes it here, and it is deleted at the end of the frame
+	CEntityRegistry& GetEnemies(void);
 
-	// Push Arrow into the vector
-	void pushArrow(CEntity2D* arrow);
-	// Setter for bullet vector
-	void setLiveBulletVector(vector<CEntity2D*>& vectorOfBullets);;
+	// Get the spatial hash of the enemies, to find the enemies near a position
+	CEntitySpatialHash& GetEnemySpatialHash(void);
 
-	// Getter for Bullet Vector
-	vector<CEntity2D*> getLiveBulletVector(void);
+	// Get a bullet from the pool to fire, or NULL if every bullet is in flight
+	CEnemyProjectile* AcquireBullet(void);
 
-	// Setter for arrow vector
-	void setLiveArrowVector(vector<CEntity2D*>& vectorOfArrows);
-
-	// Getter for arrow vector
-	vector<CEntity2D*> getLiveArrowVector(void);
+	// Get an arrow from the pool to fire, or NULL if every arrow is in flight
+	CBowProjectile* AcquireArrow(void);
 
 	// Get the number of enemies per wave
 	int getTotalEnemies(void);
@@ -120,8 +125,12 @@ protected:
 	CMap2D* cMap2D;
 	// The handler containing the instance of CPlayer2Ds
 	CPlayer2D* cPlayer2D;
-	// A vector containing the instance of CEnemy2Ds
-	vector<CEntity2D*> enemyVector;
+	// The width and height, in tiles, of a cell of the enemies' spatial hash
+	static const unsigned int ENEMY_HASH_CELL_SIZE = 4;
+	// The spatial hash of the enemies, which is declared first so that it outlives cEnemies
+	CEntitySpatialHash cEnemySpatialHash;
+	// The registry which owns the instances of CEnemy2Ds
+	CEntityRegistry cEnemies;
 
 	// Keyboard Controller singleton instance
 	CKeyboardController* cKeyboardController;
@@ -129,11 +138,15 @@ protected:
 	// A transformation matrix for controlling where to render the entities
 	glm::mat4 transform;
 
+	// The number of bullets and arrows which can be in flight at the same time
+	static const unsigned int NUM_POOLED_BULLETS = 64;
+	static const unsigned int NUM_POOLED_ARROWS = 16;
+
 	// Projectile Handler
-	vector<CEntity2D*> liveBullets;
+	CProjectilePool<CEnemyProjectile> cBulletPool;
 
 	// Arrow Projectile Handler
-	vector<CEntity2D*> liveArrows;
+	CProjectilePool<CBowProjectile> cArrowPool;
 
 	// GUI_Scene2D
 	CGUI_Scene2D* cGUI_Scene2D;
@@ -0,0 +1,140 @@
+/**
+ CSolidBitboard
+ @brief A class which keeps one bit per tile of a level, set if the tile is solid, so that
+		collision checks are bit tests.
+ */
+#include "SolidBitboard.h"
+
+// Include TileProperties
+#include "TileProperties.h"
+
+/**
+ @brief Constructor
+ */
+CSolidBitboard::CSolidBitboard(void)
+	: uiNumRows(0)
+	, uiNumCols(0)
+	, uiNumWordsPerRow(0)
+{
+}
+
+/**
+ @brief Destructor
+ */
+CSolidBitboard::~CSolidBitboard(void)
+{
+}
+
+/**
+ @brief Build the bits from the tiles of a level
+ @param arrTiles A const unsigned short* variable containing the tiles of the level
+ @param uiNumRows A const unsigned int variable containing the number of rows
+ @param uiNumCols A const unsigned int variable containing the number of columns
+ */
+void CSolidBitboard::Build(const unsigned short* arrTiles, const unsigned int uiNumRows, const unsigned int uiNumCols)
+{
+	this->uiNumRows = uiNumRows;
+	this->uiNumCols = uiNumCols;
+	uiNumWordsPerRow = (uiNumCols + 31) / 32;
+
+	vWords.assign(uiNumRows * uiNumWordsPerRow, 0);
+	for (unsigned int uiRow = 0; uiRow < uiNumRows; uiRow++)
+	{
+		for (unsigned int uiCol = 0; uiCol < uiNumCols; uiCol++)
+		{
+			if (TileProperties::IsSolid(arrTiles[uiRow * uiNumCols + uiCol]))
+				vWords[uiRow * uiNumWordsPerRow + (uiCol >> 5)] |= 1u << (uiCol & 31);
+		}
+	}
+}
+
+/**
+ @brief Update the bit of a tile after its value has changed
+ @param arrTiles A const unsigned short* variable containing the tiles of the level
+ @param uiRow A const unsigned int variable containing the row of the tile
+ @param uiCol A const unsigned int variable containing the column of the tile
+ */
+void CSolidBitboard::Update(const unsigned short* arrTiles, const unsigned int uiRow, const unsigned int uiCol)
+{
+	if ((uiRow >= uiNumRows) || (uiCol >= uiNumCols))
+		return;
+
+	unsigned int& uiWord = vWords[uiRow * uiNumWordsPerRow + (uiCol >> 5)];
+	if (TileProperties::IsSolid(arrTiles[uiRow * uiNumCols + uiCol]))
+		uiWord |= 1u << (uiCol & 31);
+	else
+		uiWord &= ~(1u << (uiCol & 31));
+}
+
+/**
+ @brief Check if any tile in a span of columns of a row is solid. The span is clipped to the level
+ @param uiRow A const unsigned int variable containing the row
+ @param uiFirstCol A const unsigned int variable containing the first column of the span
+ @param uiLastCol A const unsigned int variable containing the last column of the span
+ */
+bool CSolidBitboard::AnySolid(const unsigned int uiRow, const unsigned int uiFirstCol, const unsigned int uiLastCol) const
+{
+	if ((uiRow >= uiNumRows) || (uiFirstCol >= uiNumCols) || (uiFirstCol > uiLastCol))
+		return false;
+
+	const unsigned int uiEndCol = (uiLastCol < uiNumCols) ? uiLastCol : uiNumCols - 1;
+	const unsigned int* arrRow = &vWords[uiRow * uiNumWordsPerRow];
+	for (unsigned int uiWord = uiFirstCol >> 5; uiWord <= (uiEndCol >> 5); uiWord++)
+	{
+		const unsigned int uiFirstBit = (uiWord == (uiFirstCol >> 5)) ? (uiFirstCol & 31) : 0;
+		const unsigned int uiLastBit = (uiWord == (uiEndCol >> 5)) ? (uiEndCol & 31) : 31;
+		if ((arrRow[uiWord] & SpanMask(uiFirstBit, uiLastBit)) != 0)
+			return true;
+	}
+	return false;
+}
+
+/**
+ @brief Get the number of solid tiles in a span of columns of a row. The span is clipped to the level
+ @param uiRow A const unsigned int variable containing the row
+ @param uiFirstCol A const unsigned int variable containing the first column of the span
+ @param uiLastCol A const unsigned int variable containing the last column of the span
+ */
+unsigned int CSolidBitboard::CountSolid(const unsigned int uiRow, const unsigned int uiFirstCol, const unsigned int uiLastCol) const
+{
+	if ((uiRow >= uiNumRows) || (uiFirstCol >= uiNumCols) || (uiFirstCol > uiLastCol))
+		return 0;
+
+	const unsigned int uiEndCol = (uiLastCol < uiNumCols) ? uiLastCol : uiNumCols - 1;
+	const unsigned int* arrRow = &vWords[uiRow * uiNumWordsPerRow];
+	unsigned int uiCount = 0;
+	for (unsigned int uiWord = uiFirstCol >> 5; uiWord <= (uiEndCol >> 5); uiWord++)
+	{
+		const unsigned int uiFirstBit = (uiWord == (uiFirstCol >> 5)) ? (uiFirstCol & 31) : 0;
+		const unsigned int uiLastBit = (uiWord == (uiEndCol >> 5)) ? (uiEndCol & 31) : 31;
+		// Count the set bits by clearing the lowest one until none are left
+		unsigned int uiBits = arrRow[uiWord] & SpanMask(uiFirstBit, uiLastBit);
+		while (uiBits != 0)
+		{
+			uiBits &= uiBits - 1;
+			uiCount++;
+		}
+	}
+	return uiCount;
+}
+
+/**
+ @brief Swap the contents with another bitboard
+ @param cOther A CSolidBitboard& variable containing the bitboard to swap with
+ */
+void CSolidBitboard::Swap(CSolidBitboard& cOther)
+{
+	std::swap(uiNumRows, cOther.uiNumRows);
+	std::swap(uiNumCols, cOther.uiNumCols);
+	std::swap(uiNumWordsPerRow, cOther.uiNumWordsPerRow);
+	vWords.swap(cOther.vWords);
+}
+
+/**
+ @brief Get the bits from uiFirstBit to uiLastBit inclusive, where both are from 0 to 31
+ */
+unsigned int CSolidBitboard::SpanMask(const unsigned int uiFirstBit, const unsigned int uiLastBit)
+{
+	const unsigned int uiHighMask = (uiLastBit == 31) ? 0xFFFFFFFFu : ((1u << (uiLastBit + 1)) - 1);
+	return uiHighMask & ~((1u << uiFirstBit) - 1);
+}
@@ -0,0 +1,58 @@
+/**
+ CSolidBitboard
+ @brief A class which keeps one bit per tile of a level, set if the tile is solid, packed
+		into 32-bit words along each row. Checking a tile is a single bit test, and checking
+		a span of tiles along a row is a few word operations. The bits are updated tile by
+		tile as the level changes. Positions are the row and column in the level's
+		row-major tile array, where row 0 is the bottom row. Tiles outside the level are
+		not solid.
+ */
+#pragma once
+
+#include <vector>
+
+class CSolidBitboard
+{
+public:
+	// Constructor
+	CSolidBitboard(void);
+
+	// Destructor
+	virtual ~CSolidBitboard(void);
+
+	// Build the bits from the tiles of a level
+	void Build(const unsigned short* arrTiles, const unsigned int uiNumRows, const unsigned int uiNumCols);
+
+	// Update the bit of a tile after its value has changed
+	void Update(const unsigned short* arrTiles, const unsigned int uiRow, const unsigned int uiCol);
+
+	// Check if a tile is solid
+	bool IsSolid(const unsigned int uiRow, const unsigned int uiCol) const
+	{
+		if ((uiRow >= uiNumRows) || (uiCol >= uiNumCols))
+			return false;
+		return ((vWords[uiRow * uiNumWordsPerRow + (uiCol >> 5)] >> (uiCol & 31)) & 1) != 0;
+	}
+
+	// Check if any tile in a span of columns of a row is solid
+	bool AnySolid(const unsigned int uiRow, const unsigned int uiFirstCol, const unsigned int uiLastCol) const;
+
+	// Get the number of solid tiles in a span of columns of a row
+	unsigned int CountSolid(const unsigned int uiRow, const unsigned int uiFirstCol, const unsigned int uiLastCol) const;
+
+	// Swap the contents with another bitboard
+	void Swap(CSolidBitboard& cOther);
+
+protected:
+	// The size of the level
+	unsigned int uiNumRows;
+	unsigned int uiNumCols;
+	// The number of words which store each row
+	unsigned int uiNumWordsPerRow;
+
+	// The bits of the tiles, row by row, with column 0 in the lowest bit of the first word
+	std::vector<unsigned int> vWords;
+
+	// Get the bits of a span of columns within one word of a row
+	static unsigned int SpanMask(const unsigned int uiFirstBit, const unsigned int uiLastBit);
+};
@@ -0,0 +1,268 @@
+/**
+ CSpawnCellIndex
+ @brief A class which keeps the tiles of a level where things can be spawned, sorted by
+		category and column, so that a random tile can be picked without retrying.
+		The index is updated tile by tile as the level changes.
+		Positions are the 1D index of a tile in the level's row-major tile array,
+		where row 0 is the bottom row.
+ */
+#include "SpawnCellIndex.h"
+
+// Include TileProperties
+#include "TileProperties.h"
+
+/**
+ @brief Constructor
+ */
+CSpawnCellIndex::CSpawnCellIndex(void)
+	: uiNumRows(0)
+	, uiNumCols(0)
+{
+}
+
+/**
+ @brief Destructor
+ */
+CSpawnCellIndex::~CSpawnCellIndex(void)
+{
+}
+
+/**
+ @brief Rebuild the index from the tiles of a level
+ @param arrTiles A const unsigned short* variable containing the tiles of the level
+ @param uiNumRows A const unsigned int variable containing the number of rows
+ @param uiNumCols A const unsigned int variable containing the number of columns
+ */
+void CSpawnCellIndex::Build(const unsigned short* arrTiles, const unsigned int uiNumRows, const unsigned int uiNumCols)
+{
+	this->uiNumRows = uiNumRows;
+	this->uiNumCols = uiNumCols;
+
+	for (unsigned int uiCategory = 0; uiCategory < NUM_SPAWN_CATEGORIES; uiCategory++)
+	{
+		vCellsOfColumns[uiCategory].resize(uiNumCols);
+		for (unsigned int uiCol = 0; uiCol < uiNumCols; uiCol++)
+		{
+			vCellsOfColumns[uiCategory][uiCol].clear();
+		}
+		vSlotsOfPositions[uiCategory].assign(uiNumRows * uiNumCols, 0);
+		vColumnCounts[uiCategory].assign(uiNumCols + 1, 0);
+	}
+	vCategoriesOfPositions.assign(uiNumRows * uiNumCols, 0);
+
+	for (unsigned int uiRow = 0; uiRow < uiNumRows; uiRow++)
+	{
+		for (unsigned int uiCol = 0; uiCol < uiNumCols; uiCol++)
+		{
+			Refresh(arrTiles, uiRow, uiCol);
+		}
+	}
+}
+
+/**
+ @brief Update the index after the value of a tile has changed.
+		The tile above it is updated too, since it may have gained or lost its ground
+ @param arrTiles A const unsigned short* variable containing the tiles of the level, after the change
+ @param uiRow A const unsigned int variable containing the row of the tile which changed
+ @param uiCol A const unsigned int variable containing the column of the tile which changed
+ */
+void CSpawnCellIndex::Update(const unsigned short* arrTiles, const unsigned int uiRow, const unsigned int uiCol)
+{
+	Refresh(arrTiles, uiRow, uiCol);
+	if (uiRow + 1 < uiNumRows)
+		Refresh(arrTiles, uiRow + 1, uiCol);
+}
+
+/**
+ @brief Pick a random tile of a category. Every tile of the category is equally likely
+ @param eCategory A const SPAWN_CATEGORY variable containing the category
+ @param cGenerator A std::mt19937& variable containing the random number generator to use
+ @param uirRow An unsigned int variable which will store the row of the tile
+ @param uirCol An unsigned int variable which will store the column of the tile
+ @return true if a tile was picked, otherwise false if the category has no tiles
+ */
+bool CSpawnCellIndex::Sample(	const SPAWN_CATEGORY eCategory,
+								std::mt19937& cGenerator,
+								unsigned int& uirRow,
+								unsigned int& uirCol) const
+{
+	if (uiNumCols == 0)
+		return false;
+	return Sample(eCategory, 0, uiNumCols - 1, cGenerator, uirRow, uirCol);
+}
+
+/**
+ @brief Pick a random tile of a category within a range of columns. Every tile of the
+		category in the range is equally likely
+ @param eCategory A const SPAWN_CATEGORY variable containing the category
+ @param uiMinCol A const unsigned int variable containing the first column of the range
+ @param uiMaxCol A const unsigned int variable containing the last column of the range, inclusive
+ @param cGenerator A std::mt19937& variable containing the random number generator to use
+ @param uirRow An unsigned int variable which will store the row of the tile
+ @param uirCol An unsigned int variable which will store the column of the tile
+ @return true if a tile was picked, otherwise false if the range has no tiles of the category
+ */
+bool CSpawnCellIndex::Sample(	const SPAWN_CATEGORY eCategory,
+								const unsigned int uiMinCol,
+								const unsigned int uiMaxCol,
+								std::mt19937& cGenerator,
+								unsigned int& uirRow,
+								unsigned int& uirCol) const
+{
+	if ((uiNumCols == 0) || (uiMinCol > uiMaxCol) || (uiMinCol >= uiNumCols))
+		return false;
+	const unsigned int uiLastCol = (uiMaxCol < uiNumCols) ? uiMaxCol : uiNumCols - 1;
+
+	// Count the tiles in the range
+	const int iBefore = GetColumnCountsBefore(eCategory, uiMinCol);
+	const int iTotal = GetColumnCountsBefore(eCategory, uiLastCol + 1) - iBefore;
+	if (iTotal <= 0)
+		return false;
+
+	// Pick one of them, then find which column it is in
+	const int iRank = (int)(cGenerator() % (unsigned int)iTotal);
+	const unsigned int uiCol = FindColumn(eCategory, iBefore + iRank);
+	const int iSlot = iBefore + iRank - GetColumnCountsBefore(eCategory, uiCol);
+	const unsigned int uiPosition = vCellsOfColumns[eCategory][uiCol][iSlot];
+
+	uirRow = uiPosition / uiNumCols;
+	uirCol = uiPosition % uiNumCols;
+	return true;
+}
+
+/**
+ @brief Get the number of tiles of a category
+ */
+unsigned int CSpawnCellIndex::GetCount(const SPAWN_CATEGORY eCategory) const
+{
+	return (unsigned int)GetColumnCountsBefore(eCategory, uiNumCols);
+}
+
+/**
+ @brief Swap the contents with another index
+ @param cOther A CSpawnCellIndex& variable containing the index to swap with
+ */
+void CSpawnCellIndex::Swap(CSpawnCellIndex& cOther)
+{
+	std::swap(uiNumRows, cOther.uiNumRows);
+	std::swap(uiNumCols, cOther.uiNumCols);
+	for (unsigned int uiCategory = 0; uiCategory < NUM_SPAWN_CATEGORIES; uiCategory++)
+	{
+		vCellsOfColumns[uiCategory].swap(cOther.vCellsOfColumns[uiCategory]);
+		vSlotsOfPositions[uiCategory].swap(cOther.vSlotsOfPositions[uiCategory]);
+		vColumnCounts[uiCategory].swap(cOther.vColumnCounts[uiCategory]);
+	}
+	vCategoriesOfPositions.swap(cOther.vCategoriesOfPositions);
+}
+
+/**
+ @brief Get the categories which a tile belongs to, as bit flags
+ */
+unsigned char CSpawnCellIndex::Classify(const unsigned short* arrTiles, const unsigned int uiRow, const unsigned int uiCol) const
+{
+	if (arrTiles[uiRow * uiNumCols + uiCol] != 0)
+		return 0;
+
+	unsigned char ucCategories = 1 << SPAWN_EMPTY;
+	if ((uiRow > 0) && TileProperties::IsSpawnSurface(arrTiles[(uiRow - 1) * uiNumCols + uiCol]))
+		ucCategories |= 1 << SPAWN_ON_GROUND;
+	return ucCategories;
+}
+
+/**
+ @brief Update the categories of a single tile
+ */
+void CSpawnCellIndex::Refresh(const unsigned short* arrTiles, const unsigned int uiRow, const unsigned int uiCol)
+{
+	const unsigned int uiPosition = uiRow * uiNumCols + uiCol;
+	const unsigned char ucOld = vCategoriesOfPositions[uiPosition];
+	const unsigned char ucNew = Classify(arrTiles, uiRow, uiCol);
+	if (ucOld == ucNew)
+		return;
+
+	for (unsigned int uiCategory = 0; uiCategory < NUM_SPAWN_CATEGORIES; uiCategory++)
+	{
+		const bool bWasIn = (ucOld & (1 << uiCategory)) != 0;
+		const bool bIsIn = (ucNew & (1 << uiCategory)) != 0;
+		if (bWasIn && !bIsIn)
+			Remove(uiCategory, uiPosition);
+		else if (!bWasIn && bIsIn)
+			Add(uiCategory, uiPosition);
+	}
+	vCategoriesOfPositions[uiPosition] = ucNew;
+}
+
+/**
+ @brief Add a tile to a category
+ */
+void CSpawnCellIndex::Add(const unsigned int uiCategory, const unsigned int uiPosition)
+{
+	const unsigned int uiCol = uiPosition % uiNumCols;
+	std::vector<unsigned int>& vCells = vCellsOfColumns[uiCategory][uiCol];
+	vSlotsOfPositions[uiCategory][uiPosition] = (unsigned int)vCells.size();
+	vCells.push_back(uiPosition);
+	AddColumnCount(uiCategory, uiCol, 1);
+}
+
+/**
+ @brief Remove a tile from a category, by moving the last tile of its column into its slot
+ */
+void CSpawnCellIndex::Remove(const unsigned int uiCategory, const unsigned int uiPosition)
+{
+	const unsigned int uiCol = uiPosition % uiNumCols;
+	std::vector<unsigned int>& vCells = vCellsOfColumns[uiCategory][uiCol];
+	const unsigned int uiSlot = vSlotsOfPositions[uiCategory][uiPosition];
+
+	const unsigned int uiLastPosition = vCells.back();
+	vCells[uiSlot] = uiLastPosition;
+	vSlotsOfPositions[uiCategory][uiLastPosition] = uiSlot;
+	vCells.pop_back();
+	AddColumnCount(uiCategory, uiCol, -1);
+}
+
+/**
+ @brief Add to the number of tiles in a column
+ */
+void CSpawnCellIndex::AddColumnCount(const unsigned int uiCategory, const unsigned int uiCol, const int iDelta)
+{
+	for (unsigned int i = uiCol + 1; i <= uiNumCols; i += i & (~i + 1))
+	{
+		vColumnCounts[uiCategory][i] += iDelta;
+	}
+}
+
+/**
+ @brief Get the number of tiles in the columns before a column
+ */
+int CSpawnCellIndex::GetColumnCountsBefore(const unsigned int uiCategory, const unsigned int uiCol) const
+{
+	int iCount = 0;
+	for (unsigned int i = uiCol; i > 0; i -= i & (~i + 1))
+	{
+		iCount += vColumnCounts[uiCategory][i];
+	}
+	return iCount;
+}
+
+/**
+ @brief Find the column containing the tile with a certain rank, counting from the first column
+ @param iRank An int variable containing the rank, starting from 0
+ */
+unsigned int CSpawnCellIndex::FindColumn(const unsigned int uiCategory, int iRank) const
+{
+	unsigned int uiStep = 1;
+	while (uiStep * 2 <= uiNumCols)
+		uiStep *= 2;
+
+	// Walk down the tree to the last column whose preceding count is not more than the rank
+	unsigned int uiCol = 0;
+	for (; uiStep > 0; uiStep /= 2)
+	{
+		if ((uiCol + uiStep <= uiNumCols) && (vColumnCounts[uiCategory][uiCol + uiStep] <= iRank))
+		{
+			uiCol += uiStep;
+			iRank -= vColumnCounts[uiCategory][uiCol];
+		}
+	}
+	return uiCol;
+}
@@ -0,0 +1,86 @@
+/**
+ CSpawnCellIndex
+ @brief A class which keeps the tiles of a level where things can be spawned, sorted by
+		category and column, so that a random tile can be picked without retrying.
+		The index is updated tile by tile as the level changes.
+		Positions are the 1D index of a tile in the level's row-major tile array,
+		where row 0 is the bottom row.
+ */
+#pragma once
+
+#include <vector>
+#include <random>
+
+class CSpawnCellIndex
+{
+public:
+	// The categories of spawn tiles
+	enum SPAWN_CATEGORY
+	{
+		// An empty tile anywhere
+		SPAWN_EMPTY = 0,
+		// An empty tile directly above a dirt block
+		SPAWN_ON_GROUND,
+		NUM_SPAWN_CATEGORIES
+	};
+
+	// Constructor
+	CSpawnCellIndex(void);
+
+	// Destructor
+	virtual ~CSpawnCellIndex(void);
+
+	// Rebuild the index from the tiles of a level
+	void Build(const unsigned short* arrTiles, const unsigned int uiNumRows, const unsigned int uiNumCols);
+
+	// Update the index after the value of a tile has changed
+	void Update(const unsigned short* arrTiles, const unsigned int uiRow, const unsigned int uiCol);
+
+	// Pick a random tile of a category
+	bool Sample(const SPAWN_CATEGORY eCategory,
+				std::mt19937& cGenerator,
+				unsigned int& uirRow,
+				unsigned int& uirCol) const;
+
+	// Pick a random tile of a category within a range of columns
+	bool Sample(const SPAWN_CATEGORY eCategory,
+				const unsigned int uiMinCol,
+				const unsigned int uiMaxCol,
+				std::mt19937& cGenerator,
+				unsigned int& uirRow,
+				unsigned int& uirCol) const;
+
+	// Get the number of tiles of a category
+	unsigned int GetCount(const SPAWN_CATEGORY eCategory) const;
+
+	// Swap the contents with another index
+	void Swap(CSpawnCellIndex& cOther);
+
+protected:
+	// The size of the level
+	unsigned int uiNumRows;
+	unsigned int uiNumCols;
+
+	// The tiles of each category in each column, indexed by [category][column]
+	std::vector<std::vector<unsigned int> > vCellsOfColumns[NUM_SPAWN_CATEGORIES];
+	// The slot of each tile in its column list, indexed by [category][position]
+	std::vector<unsigned int> vSlotsOfPositions[NUM_SPAWN_CATEGORIES];
+	// The categories which each tile belongs to, as bit flags, indexed by position
+	std::vector<unsigned char> vCategoriesOfPositions;
+	// A Fenwick tree of the number of tiles in each column, indexed by [category][column + 1]
+	std::vector<int> vColumnCounts[NUM_SPAWN_CATEGORIES];
+
+	// Get the categories which a tile belongs to, as bit flags
+	unsigned char Classify(const unsigned short* arrTiles, const unsigned int uiRow, const unsigned int uiCol) const;
+	// Update the categories of a single tile
+	void Refresh(const unsigned short* arrTiles, const unsigned int uiRow, const unsigned int uiCol);
+
+	// Add or remove a tile from a category
+	void Add(const unsigned int uiCategory, const unsigned int uiPosition);
+	void Remove(const unsigned int uiCategory, const unsigned int uiPosition);
+
+	// Fenwick tree operations on the column counts
+	void AddColumnCount(const unsigned int uiCategory, const unsigned int uiCol, const int iDelta);
+	int GetColumnCountsBefore(const unsigned int uiCategory, const unsigned int uiCol) const;
+	unsigned int FindColumn(const unsigned int uiCategory, int iRank) const;
+};
@@ -0,0 +1,173 @@
+/**
+ CTileMapRenderer
+ @brief A class which batches all the tiles of a level into one vertex buffer,
+		so that a whole level can be drawn with a single draw call.
+		Each tile samples its image from a layer of a texture array.
+		Every grid cell owns a fixed slot of 4 vertices in the buffer, so a
+		changed tile only needs its own rows to be uploaded again.
+ */
+#include "TileMapRenderer.h"
+
+#include <iostream>
+using namespace std;
+
+/**
+ @brief Constructor
+ */
+CTileMapRenderer::CTileMapRenderer(void)
+	: VAO(0)
+	, VBO(0)
+	, EBO(0)
+	, uiNumRows(0)
+	, uiNumCols(0)
+	, uiIndexCount(0)
+	, cSettings(NULL)
+{
+}
+
+/**
+ @brief Destructor
+ */
+CTileMapRenderer::~CTileMapRenderer(void)
+{
+	glDeleteVertexArrays(1, &VAO);
+	glDeleteBuffers(1, &VBO);
+	glDeleteBuffers(1, &EBO);
+
+	// We won't delete this since it was created elsewhere
+	cSettings = NULL;
+}
+
+/**
+ @brief Init Initialise this instance
+ @param uiNumRows A const unsigned int variable containing the number of rows in the grid
+ @param uiNumCols A const unsigned int variable containing the number of columns in the grid
+ */
+bool CTileMapRenderer::Init(const unsigned int uiNumRows, const unsigned int uiNumCols)
+{
+	// Get the handler to the CSettings instance
+	cSettings = CSettings::GetInstance();
+
+	this->uiNumRows = uiNumRows;
+	this->uiNumCols = uiNumCols;
+
+	// Start with every cell empty
+	vertex_buffer_data.assign(uiNumRows * uiNumCols * 4, TileVertex());
+
+	// The indices never change, since every cell keeps the same slot
+	std::vector<GLuint> index_buffer_data;
+	index_buffer_data.reserve(uiNumRows * uiNumCols * 6);
+	for (GLuint uiOffset = 0; uiOffset < (GLuint)vertex_buffer_data.size(); uiOffset += 4)
+	{
+		index_buffer_data.push_back(uiOffset + 3);
+		index_buffer_data.push_back(uiOffset + 0);
+		index_buffer_data.push_back(uiOffset + 2);
+		index_buffer_data.push_back(uiOffset + 1);
+		index_buffer_data.push_back(uiOffset + 2);
+		index_buffer_data.push_back(uiOffset + 0);
+	}
+	uiIndexCount = (unsigned int)index_buffer_data.size();
+
+	// Nothing to create if the grid is empty
+	if (uiIndexCount == 0)
+		return true;
+
+	glGenVertexArrays(1, &VAO);
+	glGenBuffers(1, &VBO);
+	glGenBuffers(1, &EBO);
+
+	// Record the vertex layout once into the VAO
+	glBindVertexArray(VAO);
+	glBindBuffer(GL_ARRAY_BUFFER, VBO);
+	glBufferData(GL_ARRAY_BUFFER, vertex_buffer_data.size() * sizeof(TileVertex), &vertex_buffer_data[0], GL_DYNAMIC_DRAW);
+	glEnableVertexAttribArray(0);
+	glEnableVertexAttribArray(1);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(TileVertex), (void*)0);
+	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(TileVertex), (void*)sizeof(glm::vec3));
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, index_buffer_data.size() * sizeof(GLuint), &index_buffer_data[0], GL_STATIC_DRAW);
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	return true;
+}
+
+/**
+ @brief Set the tile in a grid cell. Call Upload() to send the change to the graphics card
+ @param uiRow A const unsigned int variable containing the row index of the tile, where row 0 is the bottom row
+ @param uiCol A const unsigned int variable containing the column index of the tile
+ @param uiLayer A const unsigned int variable containing the texture array layer to draw the tile with
+ */
+void CTileMapRenderer::SetTile(const unsigned int uiRow, const unsigned int uiCol, const unsigned int uiLayer)
+{
+	const float fHalfWidth = 0.5f * cSettings->TILE_WIDTH;
+	const float fHalfHeight = 0.5f * cSettings->TILE_HEIGHT;
+	const float fLayer = (float)uiLayer;
+
+	// Calculate the centre of this tile in UV Space
+	const float fX = cSettings->ConvertIndexToUVSpace(cSettings->x, uiCol, false, 0);
+	const float fY = cSettings->ConvertIndexToUVSpace(cSettings->y, uiRow, false, 0);
+
+	TileVertex* v = &vertex_buffer_data[(uiRow * uiNumCols + uiCol) * 4];
+
+	v[0].position = glm::vec3(fX - fHalfWidth, fY - fHalfHeight, 0);
+	v[0].texCoord = glm::vec3(0, 0, fLayer);
+
+	v[1].position = glm::vec3(fX + fHalfWidth, fY - fHalfHeight, 0);
+	v[1].texCoord = glm::vec3(1.0f, 0, fLayer);
+
+	v[2].position = glm::vec3(fX + fHalfWidth, fY + fHalfHeight, 0);
+	v[2].texCoord = glm::vec3(1.0f, 1.0f, fLayer);
+
+	v[3].position = glm::vec3(fX - fHalfWidth, fY + fHalfHeight, 0);
+	v[3].texCoord = glm::vec3(0, 1.0f, fLayer);
+}
+
+/**
+ @brief Remove the tile in a grid cell. Call Upload() to send the change to the graphics card
+ @param uiRow A const unsigned int variable containing the row index of the tile, where row 0 is the bottom row
+ @param uiCol A const unsigned int variable containing the column index of the tile
+ */
+void CTileMapRenderer::ClearTile(const unsigned int uiRow, const unsigned int uiCol)
+{
+	TileVertex* v = &vertex_buffer_data[(uiRow * uiNumCols + uiCol) * 4];
+	for (unsigned int i = 0; i < 4; i++)
+	{
+		v[i] = TileVertex();
+	}
+}
+
+/**
+ @brief Upload a range of rows to the graphics card. The rows are contiguous in the buffer,
+		so this is a single transfer
+ @param uiFirstRow A const unsigned int variable containing the first row to upload
+ @param uiLastRow A const unsigned int variable containing the last row to upload, inclusive
+ */
+void CTileMapRenderer::Upload(const unsigned int uiFirstRow, const unsigned int uiLastRow)
+{
+	if ((uiIndexCount == 0) || (uiFirstRow > uiLastRow) || (uiLastRow >= uiNumRows))
+		return;
+
+	const unsigned int uiFirstVertex = uiFirstRow * uiNumCols * 4;
+	const unsigned int uiNumVertices = (uiLastRow - uiFirstRow + 1) * uiNumCols * 4;
+
+	glBindBuffer(GL_ARRAY_BUFFER, VBO);
+	glBufferSubData(GL_ARRAY_BUFFER,
+					uiFirstVertex * sizeof(TileVertex),
+					uiNumVertices * sizeof(TileVertex),
+					&vertex_buffer_data[uiFirstVertex]);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+/**
+ @brief Render the batch. The tile texture array must be bound before calling this
+ */
+void CTileMapRenderer::Render(void)
+{
+	if (uiIndexCount == 0)
+		return;
+
+	glBindVertexArray(VAO);
+	glDrawElements(GL_TRIANGLES, uiIndexCount, GL_UNSIGNED_INT, 0);
+	glBindVertexArray(0);
+}
@@ -0,0 +1,76 @@
+/**
+ CTileMapRenderer
+ @brief A class which batches all the tiles of a level into one vertex buffer,
+		so that a whole level can be drawn with a single draw call.
+		Each tile samples its image from a layer of a texture array.
+		Every grid cell owns a fixed slot of 4 vertices in the buffer, so a
+		changed tile only needs its own rows to be uploaded again.
+ */
+#pragma once
+
+// Include GLEW
+#ifndef GLEW_STATIC
+#include <GL/glew.h>
+#define GLEW_STATIC
+#endif
+
+// Include GLM
+#include <includes/glm.hpp>
+
+// Include Settings
+#include "GameControl\Settings.h"
+
+#include <vector>
+
+// A vertex of a batched tile. The z component of texCoord is the texture array layer
+struct TileVertex
+{
+	glm::vec3 position;
+	glm::vec3 texCoord;
+
+	TileVertex()
+		: position(0.0f), texCoord(0.0f) {}
+};
+
+class CTileMapRenderer
+{
+public:
+	// Constructor
+	CTileMapRenderer(void);
+
+	// Destructor
+	virtual ~CTileMapRenderer(void);
+
+	// Init
+	bool Init(const unsigned int uiNumRows, const unsigned int uiNumCols);
+
+	// Set the tile in a grid cell
+	void SetTile(const unsigned int uiRow, const unsigned int uiCol, const unsigned int uiLayer);
+
+	// Remove the tile in a grid cell
+	void ClearTile(const unsigned int uiRow, const unsigned int uiCol);
+
+	// Upload a range of rows to the graphics card
+	void Upload(const unsigned int uiFirstRow, const unsigned int uiLastRow);
+
+	// Render the batch. The tile texture array must be bound before calling this
+	void Render(void);
+
+protected:
+	// OpenGL objects
+	unsigned int VAO, VBO, EBO;
+
+	// The size of the grid
+	unsigned int uiNumRows;
+	unsigned int uiNumCols;
+
+	// The vertices of every grid cell, in row-major order.
+	// An empty cell has 4 identical vertices, which form no visible triangles
+	std::vector<TileVertex> vertex_buffer_data;
+
+	// The number of indices uploaded to the graphics card
+	unsigned int uiIndexCount;
+
+	// Settings
+	CSettings* cSettings;
+};
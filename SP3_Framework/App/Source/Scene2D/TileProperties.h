@@ -0,0 +1,123 @@
+/**
+ TileProperties
+ @brief The properties of each tile value, such as whether it is solid or can be broken, as
+		bit flags in a lookup table which is built at compile time. Checking a property is
+		a single table load and bit test, instead of comparing the value against ranges.
+		Tile values which are not in the table have no properties.
+ */
+#pragma once
+
+namespace TileProperties
+{
+	// The properties which a tile value can have
+	enum TILE_FLAG
+	{
+		// Blocks movement, paths and rays (100 to 199)
+		TILE_SOLID = 1 << 0,
+		// Can be broken by the player (dirt, the chest and trees)
+		TILE_BREAKABLE = 1 << 1,
+		// Is broken in stages by the shovel (dirt and broken dirt)
+		TILE_DIGGABLE = 1 << 2,
+		// Is broken in stages by the axe (tree stages)
+		TILE_CHOPPABLE = 1 << 3,
+		// Is picked up when the player walks into it
+		TILE_COLLECTIBLE = 1 << 4,
+		// Hurts the player while the player is inside it
+		TILE_HAZARD = 1 << 5,
+		// Things can be spawned on top of it
+		TILE_SPAWN_SURFACE = 1 << 6,
+		// Holds nothing, so entities fall through it (0)
+		TILE_EMPTY = 1 << 7
+	};
+
+	// The number of tile values in the lookup table
+	const unsigned int NUM_TILE_VALUES = 512;
+
+	/**
+	 @brief Get the properties of a tile value from its meaning in the game
+	 @param uiValue A const unsigned int variable containing the tile value
+	 @return The TILE_FLAGs of the tile value
+	 */
+	constexpr unsigned char ClassifyTile(const unsigned int uiValue)
+	{
+		unsigned char ucFlags = 0;
+		if ((uiValue >= 100) && (uiValue < 200))
+			ucFlags |= TILE_SOLID;
+		// Dirt, which breaks into 102, 103 and then a dirt pile. 101 is bedrock
+		if ((uiValue == 100) || (uiValue == 102) || (uiValue == 103))
+			ucFlags |= TILE_DIGGABLE | TILE_BREAKABLE;
+		// The chest, which breaks into a random item
+		if (uiValue == 105)
+			ucFlags |= TILE_BREAKABLE;
+		// Trees, which break into 107, 108 and then logs
+		if ((uiValue >= 106) && (uiValue <= 108))
+			ucFlags |= TILE_CHOPPABLE | TILE_BREAKABLE;
+		// Potions, lives, weapons, the shovel, armour, logs and dirt piles
+		if (((uiValue >= 2) && (uiValue <= 5)) ||
+			(uiValue == 10) ||
+			((uiValue >= 30) && (uiValue <= 33)) ||
+			((uiValue >= 40) && (uiValue <= 44)) ||
+			(uiValue == 75) || (uiValue == 76))
+			ucFlags |= TILE_COLLECTIBLE;
+		// Spikes
+		if (uiValue == 20)
+			ucFlags |= TILE_HAZARD;
+		if (uiValue == 100)
+			ucFlags |= TILE_SPAWN_SURFACE;
+		if (uiValue == 0)
+			ucFlags |= TILE_EMPTY;
+		return ucFlags;
+	}
+
+	// The lookup table from a tile value to its TILE_FLAGs
+	struct TileFlagTable
+	{
+		constexpr TileFlagTable(void)
+			: arrFlags()
+		{
+			for (unsigned int i = 0; i < NUM_TILE_VALUES; i++)
+				arrFlags[i] = ClassifyTile(i);
+		}
+
+		unsigned char arrFlags[NUM_TILE_VALUES];
+	};
+
+	constexpr TileFlagTable TILE_FLAG_TABLE;
+
+	/**
+	 @brief Get the properties of a tile value
+	 @param uiValue A const unsigned int variable containing the tile value
+	 @return The TILE_FLAGs of the tile value
+	 */
+	constexpr unsigned char GetFlags(const unsigned int uiValue)
+	{
+		return (uiValue < NUM_TILE_VALUES) ? TILE_FLAG_TABLE.arrFlags[uiValue] : 0;
+	}
+
+	/**
+	 @brief Check if a tile value has any of some properties
+	 @param uiValue A const unsigned int variable containing the tile value
+	 @param ucFlags A const unsigned char variable containing the TILE_FLAGs to check
+	 */
+	constexpr bool HasFlag(const unsigned int uiValue, const unsigned char ucFlags)
+	{
+		return (GetFlags(uiValue) & ucFlags) != 0;
+	}
+
+	// Check the common properties
+	constexpr bool IsSolid(const unsigned int uiValue) { return HasFlag(uiValue, TILE_SOLID); }
+	constexpr bool IsBreakable(const unsigned int uiValue) { return HasFlag(uiValue, TILE_BREAKABLE); }
+	constexpr bool IsDiggable(const unsigned int uiValue) { return HasFlag(uiValue, TILE_DIGGABLE); }
+	constexpr bool IsChoppable(const unsigned int uiValue) { return HasFlag(uiValue, TILE_CHOPPABLE); }
+	constexpr bool IsCollectible(const unsigned int uiValue) { return HasFlag(uiValue, TILE_COLLECTIBLE); }
+	constexpr bool IsHazard(const unsigned int uiValue) { return HasFlag(uiValue, TILE_HAZARD); }
+	constexpr bool IsSpawnSurface(const unsigned int uiValue) { return HasFlag(uiValue, TILE_SPAWN_SURFACE); }
+	constexpr bool IsEmpty(const unsigned int uiValue) { return HasFlag(uiValue, TILE_EMPTY); }
+
+	static_assert(IsSolid(100) && IsSolid(199) && !IsSolid(99) && !IsSolid(200),
+		"Tiles from 100 to 199 must be solid");
+	static_assert(IsBreakable(105) && !IsBreakable(101) && !IsDiggable(106),
+		"Bedrock must not be breakable");
+	static_assert(IsEmpty(0) && !IsEmpty(20) && !IsEmpty(75),
+		"Only tile 0 is empty");
+}
@@ -0,0 +1,158 @@
+/**
+ CTileRaycaster
+ @brief A class which casts rays through the tiles of a level with a DDA walk, stopping at
+		the first solid tile.
+ */
+#include "TileRaycaster.h"
+
+// Include TileProperties
+#include "TileProperties.h"
+
+#include <cmath>
+#include <cfloat>
+#include <cstdlib>
+using namespace std;
+
+// How close the fractions of the next borders along each axis must be for the ray to pass
+// through the corner where they meet
+static const float CORNER_TOLERANCE = 1e-5f;
+
+/**
+ @brief Constructor
+ @param arrTiles A const unsigned short* variable containing the tiles of the level
+ @param uiNumRows A const unsigned int variable containing the number of rows
+ @param uiNumCols A const unsigned int variable containing the number of columns
+ */
+CTileRaycaster::CTileRaycaster(	const unsigned short* arrTiles,
+								const unsigned int uiNumRows,
+								const unsigned int uiNumCols)
+	: arrTiles(arrTiles)
+	, iNumRows((int)uiNumRows)
+	, iNumCols((int)uiNumCols)
+{
+}
+
+/**
+ @brief Destructor
+ */
+CTileRaycaster::~CTileRaycaster(void)
+{
+}
+
+/**
+ @brief Cast a ray, stopping at the first solid tile. The tile of the start is checked as
+		well, and the walk stops if the ray leaves the level, which is not a hit
+ @param startPos A const glm::vec2& variable containing the start position, in tiles
+ @param targetPos A const glm::vec2& variable containing the target position, in tiles
+ @param sHit A RaycastHit& variable which will store what the ray hit
+ @return true if the ray hit a solid tile before reaching the tile of its target
+ */
+bool CTileRaycaster::Cast(const glm::vec2& startPos, const glm::vec2& targetPos, RaycastHit& sHit) const
+{
+	sHit = RaycastHit();
+
+	const glm::vec2 v2Delta = targetPos - startPos;
+	int iCol = (int)floor(startPos.x);
+	int iRow = (int)floor(startPos.y);
+	const int iStepX = (v2Delta.x > 0.0f) ? 1 : ((v2Delta.x < 0.0f) ? -1 : 0);
+	const int iStepY = (v2Delta.y > 0.0f) ? 1 : ((v2Delta.y < 0.0f) ? -1 : 0);
+
+	// The fraction of the ray which crosses one tile along each axis, and the fraction
+	// at which the ray crosses the next tile border along each axis
+	const float fDeltaX = (iStepX != 0) ? fabs(1.0f / v2Delta.x) : FLT_MAX;
+	const float fDeltaY = (iStepY != 0) ? fabs(1.0f / v2Delta.y) : FLT_MAX;
+	float fNextX = FLT_MAX;
+	if (iStepX > 0)
+		fNextX = (iCol + 1 - startPos.x) * fDeltaX;
+	else if (iStepX < 0)
+		fNextX = (startPos.x - iCol) * fDeltaX;
+	float fNextY = FLT_MAX;
+	if (iStepY > 0)
+		fNextY = (iRow + 1 - startPos.y) * fDeltaY;
+	else if (iStepY < 0)
+		fNextY = (startPos.y - iRow) * fDeltaY;
+
+	// The ray crosses one tile border per step until it reaches the tile of the target. A ray
+	// which passes exactly through a corner crosses two borders at once, and only squeezes
+	// between the two tiles beside the corner if at least one of them is open
+	const int iEndCol = (int)floor(targetPos.x);
+	const int iEndRow = (int)floor(targetPos.y);
+	int iNumBordersLeft = abs(iEndCol - iCol) + abs(iEndRow - iRow);
+	float fFraction = 0.0f;
+	while (true)
+	{
+		if ((iCol < 0) || (iCol >= iNumCols) || (iRow < 0) || (iRow >= iNumRows))
+			return false;
+
+		if (TileProperties::IsSolid(arrTiles[iRow * iNumCols + iCol]))
+		{
+			sHit.bHit = true;
+			sHit.i32vec2Tile = glm::i32vec2(iCol, iRow);
+			sHit.fDistance = fFraction * glm::length(v2Delta);
+			return true;
+		}
+
+		if (((iCol == iEndCol) && (iRow == iEndRow)) || (iNumBordersLeft <= 0))
+			return false;
+
+		if ((iNumBordersLeft >= 2) && (fabs(fNextX - fNextY) < CORNER_TOLERANCE))
+		{
+			if (IsSolid(iCol + iStepX, iRow) && IsSolid(iCol, iRow + iStepY))
+			{
+				sHit.bHit = true;
+				sHit.i32vec2Tile = glm::i32vec2(iCol + iStepX, iRow);
+				sHit.fDistance = fNextX * glm::length(v2Delta);
+				return true;
+			}
+			fFraction = fNextX;
+			fNextX += fDeltaX;
+			fNextY += fDeltaY;
+			iCol += iStepX;
+			iRow += iStepY;
+			iNumBordersLeft -= 2;
+		}
+		else if (fNextX < fNextY)
+		{
+			fFraction = fNextX;
+			fNextX += fDeltaX;
+			iCol += iStepX;
+			iNumBordersLeft--;
+		}
+		else
+		{
+			fFraction = fNextY;
+			fNextY += fDeltaY;
+			iRow += iStepY;
+			iNumBordersLeft--;
+		}
+	}
+}
+
+/**
+ @brief Cast many rays. The hits are stored in the same order as the rays
+ @param vRays A const std::vector<Ray>& variable containing the rays
+ @param vHits A std::vector<RaycastHit>& variable which will store what each ray hit
+ @return The number of rays which hit a solid tile
+ */
+unsigned int CTileRaycaster::Cast(const std::vector<Ray>& vRays, std::vector<RaycastHit>& vHits) const
+{
+	vHits.resize(vRays.size());
+
+	unsigned int uiNumHits = 0;
+	for (unsigned int i = 0; i < vRays.size(); i++)
+	{
+		if (Cast(vRays[i].startPos, vRays[i].targetPos, vHits[i]))
+			uiNumHits++;
+	}
+	return uiNumHits;
+}
+
+/**
+ @brief Check if a tile is inside the level and solid
+ */
+bool CTileRaycaster::IsSolid(const int iCol, const int iRow) const
+{
+	if ((iCol < 0) || (iCol >= iNumCols) || (iRow < 0) || (iRow >= iNumRows))
+		return false;
+	return TileProperties::IsSolid(arrTiles[iRow * iNumCols + iCol]);
+}
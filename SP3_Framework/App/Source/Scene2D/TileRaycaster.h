@@ -0,0 +1,65 @@
+/**
+ CTileRaycaster
+ @brief A class which casts rays through the tiles of a level with a DDA walk. The walk
+		visits every tile which a ray passes through, in order, one step per tile border,
+		and stops at the first solid tile. A ray through the corner between two solid tiles
+		is blocked, as if they were one wall. It only reads the tiles, so any number of rays
+		can be cast at the same time.
+		Positions are in tiles, as (column, row), where row 0 is the bottom row and the
+		tile (c, r) covers c <= x < c + 1 and r <= y < r + 1, so the centre of a tile is
+		its index + 0.5. Tiles with the TILE_SOLID property are solid, the same as the
+		enemies' CheckPosition().
+ */
+#pragma once
+
+// Include GLM
+#include <includes/glm.hpp>
+
+#include <vector>
+
+class CTileRaycaster
+{
+public:
+	// A ray from a start position to a target position
+	struct Ray
+	{
+		glm::vec2 startPos;
+		glm::vec2 targetPos;
+	};
+
+	// What a ray hit
+	struct RaycastHit
+	{
+		RaycastHit()
+			: bHit(false), i32vec2Tile(-1), fDistance(0.0f) {}
+
+		// true if the ray hit a solid tile before its target
+		bool bHit;
+		// The solid tile which the ray hit
+		glm::i32vec2 i32vec2Tile;
+		// The distance from the start to where the ray entered the solid tile, in tiles
+		float fDistance;
+	};
+
+	// Constructor
+	CTileRaycaster(	const unsigned short* arrTiles,
+					const unsigned int uiNumRows,
+					const unsigned int uiNumCols);
+
+	// Destructor
+	virtual ~CTileRaycaster(void);
+
+	// Cast a ray, stopping at the first solid tile
+	bool Cast(const glm::vec2& startPos, const glm::vec2& targetPos, RaycastHit& sHit) const;
+	// Cast many rays
+	unsigned int Cast(const std::vector<Ray>& vRays, std::vector<RaycastHit>& vHits) const;
+
+	// Check if a tile is solid
+	bool IsSolid(const int iCol, const int iRow) const;
+
+protected:
+	// The tiles which the rays pass through
+	const unsigned short* arrTiles;
+	int iNumRows;
+	int iNumCols;
+};
@@ -0,0 +1,107 @@
+/**
+ CTileValueIndex
+ @brief A class which keeps, for every tile value in a level, the list of tiles holding it,
+		so that tiles with a certain value can be found without scanning the whole level.
+		Empty tiles (value 0) are not indexed, since they make up most of a level.
+		Positions are the 1D index of a tile in the level's row-major tile array.
+ */
+#include "TileValueIndex.h"
+
+/**
+ @brief Constructor
+ */
+CTileValueIndex::CTileValueIndex(void)
+{
+}
+
+/**
+ @brief Destructor
+ */
+CTileValueIndex::~CTileValueIndex(void)
+{
+}
+
+/**
+ @brief Rebuild the index from the tiles of a level
+ @param arrTiles A const unsigned short* variable containing the tiles of the level
+ @param uiNumTiles A const unsigned int variable containing the number of tiles
+ */
+void CTileValueIndex::Build(const unsigned short* arrTiles, const unsigned int uiNumTiles)
+{
+	// Keep the allocated lists, since a level is usually rebuilt with similar values
+	for (unsigned int i = 0; i < vPositionsOfValues.size(); i++)
+	{
+		vPositionsOfValues[i].clear();
+	}
+	vSlotsOfPositions.assign(uiNumTiles, 0);
+
+	for (unsigned int uiPosition = 0; uiPosition < uiNumTiles; uiPosition++)
+	{
+		if (arrTiles[uiPosition] != 0)
+			Add(uiPosition, arrTiles[uiPosition]);
+	}
+}
+
+/**
+ @brief Update the index after the value of a tile has changed
+ @param uiPosition A const unsigned int variable containing the position of the tile
+ @param usOldValue A const unsigned short variable containing the value the tile held before
+ @param usNewValue A const unsigned short variable containing the value the tile holds now
+ */
+void CTileValueIndex::Set(const unsigned int uiPosition, const unsigned short usOldValue, const unsigned short usNewValue)
+{
+	if (usOldValue == usNewValue)
+		return;
+
+	if (usOldValue != 0)
+		Remove(uiPosition, usOldValue);
+	if (usNewValue != 0)
+		Add(uiPosition, usNewValue);
+}
+
+/**
+ @brief Get the positions of the tiles holding a value
+ @param usValue A const unsigned short variable containing the value
+ */
+const std::vector<unsigned int>& CTileValueIndex::Get(const unsigned short usValue) const
+{
+	if ((usValue == 0) || (usValue >= vPositionsOfValues.size()))
+		return vNoPositions;
+	return vPositionsOfValues[usValue];
+}
+
+/**
+ @brief Swap the contents with another index
+ @param cOther A CTileValueIndex& variable containing the index to swap with
+ */
+void CTileValueIndex::Swap(CTileValueIndex& cOther)
+{
+	vPositionsOfValues.swap(cOther.vPositionsOfValues);
+	vSlotsOfPositions.swap(cOther.vSlotsOfPositions);
+}
+
+/**
+ @brief Add a tile to the positions list of a value
+ */
+void CTileValueIndex::Add(const unsigned int uiPosition, const unsigned short usValue)
+{
+	if (usValue >= vPositionsOfValues.size())
+		vPositionsOfValues.resize(usValue + 1);
+
+	vSlotsOfPositions[uiPosition] = (unsigned int)vPositionsOfValues[usValue].size();
+	vPositionsOfValues[usValue].push_back(uiPosition);
+}
+
+/**
+ @brief Remove a tile from the positions list of a value, by moving the last tile in the list into its slot
+ */
+void CTileValueIndex::Remove(const unsigned int uiPosition, const unsigned short usValue)
+{
+	std::vector<unsigned int>& vPositions = vPositionsOfValues[usValue];
+	const unsigned int uiSlot = vSlotsOfPositions[uiPosition];
+
+	const unsigned int uiLastPosition = vPositions.back();
+	vPositions[uiSlot] = uiLastPosition;
+	vSlotsOfPositions[uiLastPosition] = uiSlot;
+	vPositions.pop_back();
+}
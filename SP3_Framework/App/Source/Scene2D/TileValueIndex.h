@@ -0,0 +1,45 @@
+/**
+ CTileValueIndex
+ @brief A class which keeps, for every tile value in a level, the list of tiles holding it,
+		so that tiles with a certain value can be found without scanning the whole level.
+		Empty tiles (value 0) are not indexed, since they make up most of a level.
+		Positions are the 1D index of a tile in the level's row-major tile array.
+ */
+#pragma once
+
+#include <vector>
+
+class CTileValueIndex
+{
+public:
+	// Constructor
+	CTileValueIndex(void);
+
+	// Destructor
+	virtual ~CTileValueIndex(void);
+
+	// Rebuild the index from the tiles of a level
+	void Build(const unsigned short* arrTiles, const unsigned int uiNumTiles);
+
+	// Update the index after the value of a tile has changed
+	void Set(const unsigned int uiPosition, const unsigned short usOldValue, const unsigned short usNewValue);
+
+	// Get the positions of the tiles holding a value. The order of the positions is not defined
+	const std::vector<unsigned int>& Get(const unsigned short usValue) const;
+
+	// Swap the contents with another index
+	void Swap(CTileValueIndex& cOther);
+
+protected:
+	// The positions of the tiles holding each value, indexed by the value
+	std::vector<std::vector<unsigned int> > vPositionsOfValues;
+	// The slot of each tile in the positions list of its value, indexed by the tile's position
+	std::vector<unsigned int> vSlotsOfPositions;
+	// An empty list returned for values which no tile holds
+	std::vector<unsigned int> vNoPositions;
+
+	// Add a tile to the positions list of a value
+	void Add(const unsigned int uiPosition, const unsigned short usValue);
+	// Remove a tile from the positions list of a value
+	void Remove(const unsigned int uiPosition, const unsigned short usValue);
+};
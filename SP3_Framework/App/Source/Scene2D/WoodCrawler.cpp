@@ -33,22 +33,11 @@ CWoodCrawler::CWoodCrawler(void)
 	, cMap2D(NULL)
 	, cSettings(NULL)
 	, cPlayer2D(NULL)
-	, sCurrentFSM(FSM::IDLE)
-	, iFSMCounter(0)
 	, quadMesh(NULL)
 	, woodAnimatedSprites(NULL)
 {
 	transform = glm::mat4(1.0f);	// make sure to initialize matrix to identity matrix first
 
-	// Initialise vecIndex
-	vec2Index = glm::i32vec2(0);
-
-	// Initialise vecNumMicroSteps
-	i32vec2NumMicroSteps = glm::i32vec2(0);
-
-	// Initialise vec2UVCoordinate
-	vec2UVCoordinate = glm::vec2(0.0f);
-
 	i32vec2Destination = glm::i32vec2(0, 0);	// Initialise the iDestination
 	i32vec2Direction = glm::i32vec2(0, 0);		// Initialise the iDirection
 
@@ -102,9 +91,9 @@ bool CWoodCrawler::Init(void)
 	cMap2D->SetMapInfo(uiRow, uiCol, 0);
 
 	// Set the start position of the Player to iRow and iCol
-	vec2Index = glm::i32vec2(uiCol, uiRow);
+	SetIndex(glm::vec2(uiCol, uiRow));
 	// By default, microsteps should be zero
-	i32vec2NumMicroSteps = glm::i32vec2(0, 0);
+	MicroSteps() = glm::i32vec2(0, 0);
 
 	glGenVertexArrays(1, &VAO);
 	glBindVertexArray(VAO);
@@ -131,13 +120,13 @@ bool CWoodCrawler::Init(void)
 	runtimeColour = glm::vec4(1.0, 1.0, 1.0, 1.0);
 
 	// Set the Physics to fall status by default
-	cPhysics2D.Init();
-	cPhysics2D.SetStatus(CPhysics2D::STATUS::FALL);
+	cSimulation->ResetPhysics(uiBody);
+	cSimulation->SetStatus(uiBody, CPhysics2D::STATUS::FALL);
 
 	// If this class is initialised properly, then set the bIsActive to true
 	bIsActive = true;
 
-	hitInterval = 2.0f;
+	AttackTimer() = 2.0f;
 	
 	hit = false;
 
@@ -184,13 +173,13 @@ bool CWoodCrawler::Init2(void)
 	runtimeColour = glm::vec4(1.0, 1.0, 1.0, 1.0);
 
 	// Set the Physics to fall status by default
-	cPhysics2D.Init();
-	cPhysics2D.SetStatus(CPhysics2D::STATUS::FALL);
+	cSimulation->ResetPhysics(uiBody);
+	cSimulation->SetStatus(uiBody, CPhysics2D::STATUS::FALL);
 
 	// If this class is initialised properly, then set the bIsActive to true
 	bIsActive = true;
 
-	hitInterval = 2.0f;
+	AttackTimer() = 2.0f;
 
 	hit = false;
 
@@ -211,42 +200,42 @@ void CWoodCrawler::Update(const double dElapsedTime)
 
 	if (hit)
 	{
-		hitInterval -= dElapsedTime;
-		if (hitInterval <= 0.f)
+		AttackTimer() -= dElapsedTime;
+		if (AttackTimer() <= 0.f)
 		{
-			hitInterval = 2.0f;
+			AttackTimer() = 2.0f;
 			hit = false;
 		}
 	}
 
-	switch (sCurrentFSM)
+	switch (CurrentFSM())
 	{
 	case IDLE:
 		woodAnimatedSprites->PlayAnimation("Idle", -1, 5);
-		if (iFSMCounter > iMaxFSMCounter)
+		if (FSMCounter() > iMaxFSMCounter)
 		{
-			sCurrentFSM = PATROL;
-			iFSMCounter = 0;
+			CurrentFSM() = PATROL;
+			FSMCounter() = 0;
 			cout << "Switching to Patrol State" << endl;
 		}
-		iFSMCounter++;
+		FSMCounter()++;
 		break;
 	case PATROL:
-		if (iFSMCounter > iMaxFSMCounter)
+		if (FSMCounter() > iMaxFSMCounter)
 		{
-			sCurrentFSM = IDLE;
-			iFSMCounter = 0;
+			CurrentFSM() = IDLE;
+			FSMCounter() = 0;
 			cout << "Switching to Idle State" << endl;
 		}
-		else if (cPhysics2D.CalculateDistance(vec2Index, cPlayer2D->vec2Index) < 10.0f && vec2Index.x == cPlayer2D->vec2Index.x && vec2Index.y > cPlayer2D->vec2Index.y) //Ensure that the enemy is directly above the player
+		else if (CalculateDistance(Index(), cPlayer2D->vec2Index) < 10.0f && Index().x == cPlayer2D->vec2Index.x && Index().y > cPlayer2D->vec2Index.y) //Ensure that the enemy is directly above the player
 		{
-			sCurrentFSM = PULLING;
-			iFSMCounter = 0;
+			CurrentFSM() = PULLING;
+			FSMCounter() = 0;
 		}
-		else if (cPhysics2D.CalculateDistance(vec2Index, cPlayer2D->vec2Index) < 10.0f && vec2Index.y <= cPlayer2D->vec2Index.y)
+		else if (CalculateDistance(Index(), cPlayer2D->vec2Index) < 10.0f && Index().y <= cPlayer2D->vec2Index.y)
 		{
-			sCurrentFSM = ATTACK;
-			iFSMCounter = 0;
+			CurrentFSM() = ATTACK;
+			FSMCounter() = 0;
 		}
 		else
 		{
@@ -254,10 +243,10 @@ void CWoodCrawler::Update(const double dElapsedTime)
 			// Update the Enemy2D's position for patrol
  			UpdatePosition();
 		}
-		iFSMCounter++;
+		FSMCounter()++;
 		break;
 	case PULLING:
-		if (vec2Index.y > cPlayer2D->vec2Index.y)
+		if (Index().y > cPlayer2D->vec2Index.y)
 		{
 			woodAnimatedSprites->PlayAnimation("Pull", -1, 5);
 			i32vec2Direction = glm::i32vec2(0); // Stop updating the position of the enemy
@@ -267,7 +256,7 @@ void CWoodCrawler::Update(const double dElapsedTime)
 		}
 		else
 		{
-			if (iFSMCounter < iMaxFSMCounter)
+			if (FSMCounter() < iMaxFSMCounter)
 			{
 				//Reduces health
 				damageOnPlayer = cPlayer2D->returnPlayerHealth();
@@ -275,18 +264,18 @@ void CWoodCrawler::Update(const double dElapsedTime)
 				playerHP->Remove(10);
 
 				//Switch to Attack state
-				sCurrentFSM = ATTACK;
+				CurrentFSM() = ATTACK;
 			}
 			else
 			{
-				sCurrentFSM = PATROL;
-				iFSMCounter = 0;
+				CurrentFSM() = PATROL;
+				FSMCounter() = 0;
 			}
 		}
-		iFSMCounter++;
+		FSMCounter()++;
 
 	case ATTACK:
-		if (cPhysics2D.CalculateDistance(vec2Index, cPlayer2D->vec2Index) < 5.0f)
+		if (CalculateDistance(Index(), cPlayer2D->vec2Index) < 5.0f)
 		{
 			cPlayer2D->isMoving = true;
 			// Calculate a path to the player
@@ -294,15 +283,12 @@ void CWoodCrawler::Update(const double dElapsedTime)
 			//cout << "StartPos: " << vec2Index.x << ", " << vec2Index.y << endl;
 			//cout << "TargetPos: " << cPlayer2D->vec2Index.x << ", " 
 			//		<< cPlayer2D->vec2Index.y << endl;
-			auto path = cMap2D->PathFind(	vec2Index, 
-											cPlayer2D->vec2Index, 
-											heuristic::euclidean, 
-											10);
+			cMap2D->GetPlatformPath(Index(), cSimulation->GetStatus(uiBody) != CPhysics2D::STATUS::IDLE, vPath);
 			//cout << "=== Printing out the path ===" << endl;
 
 			// Calculate new destination
 			bool bFirstPosition = true;
-			for (const auto& coord : path)
+			for (const auto& coord : vPath)
 			{
 				//std::cout << coord.x << "," << coord.y << "\n";
 				if (bFirstPosition == true)
@@ -310,7 +296,7 @@ void CWoodCrawler::Update(const double dElapsedTime)
 					// Set a destination
 					i32vec2Destination = coord;
 					// Calculate the direction between enemy2D and this destination
-					i32vec2Direction = i32vec2Destination - vec2Index;
+					i32vec2Direction = i32vec2Destination - Index();
 					bFirstPosition = false;
 				}
 				else
@@ -340,9 +326,9 @@ void CWoodCrawler::Update(const double dElapsedTime)
 		}
 		else
 		{
-			sCurrentFSM = IDLE;
-			iFSMCounter = 0;
-			cout << "ATTACK : Reset counter: " << iFSMCounter << endl;
+			CurrentFSM() = IDLE;
+			FSMCounter() = 0;
+			cout << "ATTACK : Reset counter: " << FSMCounter() << endl;
 		
 		}
 		break;
@@ -350,14 +336,9 @@ void CWoodCrawler::Update(const double dElapsedTime)
 		break;
 	}
 
-	// Update Jump or Fall
-	UpdateJumpFall(dElapsedTime);
-
 	woodAnimatedSprites->Update(dElapsedTime);
 
-	// Update the UV Coordinates
-	vec2UVCoordinate.x = cSettings->ConvertIndexToUVSpace(cSettings->x, vec2Index.x, false, i32vec2NumMicroSteps.x*cSettings->MICRO_STEP_XAXIS);
-	vec2UVCoordinate.y = cSettings->ConvertIndexToUVSpace(cSettings->y, vec2Index.y, false, i32vec2NumMicroSteps.y*cSettings->MICRO_STEP_YAXIS);
+	// The jump or fall, and the UV Coordinates, are updated by CEnemySimulation for all enemies at once
 }
 
 /**
@@ -394,8 +375,8 @@ void CWoodCrawler::Render(void)
 	glUniformMatrix4fv(transformLoc, 1, GL_FALSE, glm::value_ptr(transform));
 
 	transform = glm::mat4(1.0f); // make sure to initialize matrix to identity matrix first
-	transform = glm::translate(transform, glm::vec3(vec2UVCoordinate.x,
-		vec2UVCoordinate.y,
+	transform = glm::translate(transform, glm::vec3(UVCoordinate().x,
+		UVCoordinate().y,
 		0.0f));
 	// Update the shaders with the latest transform
 	glUniformMatrix4fv(transformLoc, 1, GL_FALSE, glm::value_ptr(transform));
@@ -433,8 +414,7 @@ void CWoodCrawler::PostRender(void)
 */
 void CWoodCrawler::Seti32vec2Index(const int iIndex_XAxis, const int iIndex_YAxis)
 {
-	this->vec2Index.x = iIndex_XAxis;
-	this->vec2Index.y = iIndex_YAxis;
+	SetIndex(glm::vec2(iIndex_XAxis, iIndex_YAxis));
 }
 
 /**
@@ -444,8 +424,7 @@ void CWoodCrawler::Seti32vec2Index(const int iIndex_XAxis, const int iIndex_YAxi
 */
 void CWoodCrawler::Seti32vec2NumMicroSteps(const int iNumMicroSteps_XAxis, const int iNumMicroSteps_YAxis)
 {
-	this->i32vec2NumMicroSteps.x = iNumMicroSteps_XAxis;
-	this->i32vec2NumMicroSteps.y = iNumMicroSteps_YAxis;
+	MicroSteps() = glm::vec2(iNumMicroSteps_XAxis, iNumMicroSteps_YAxis);
 }
 
 /**
@@ -481,291 +460,6 @@ void CWoodCrawler::setMaxHP(float maxHealth)
 }
 
 
-/**
- @brief Constraint the enemy2D's position within a boundary
- @param eDirection A DIRECTION enumerated data type which indicates the direction to check
- */
-void CWoodCrawler::Constraint(DIRECTION eDirection)
-{
-	if (eDirection == LEFT)
-	{
-		if (vec2Index.x < 0)
-		{
-			vec2Index.x = 0;
-			i32vec2NumMicroSteps.x = 0;
-		}
-	}
-	else if (eDirection == RIGHT)
-	{
-		if (vec2Index.x >= (int)cSettings->NUM_TILES_XAXIS - 1)
-		{
-			vec2Index.x = ((int)cSettings->NUM_TILES_XAXIS) - 1;
-			i32vec2NumMicroSteps.x = 0;
-		}
-	}
-	else if (eDirection == UP)
-	{
-		if (vec2Index.y >= (int)cSettings->NUM_TILES_YAXIS - 1)
-		{
-			vec2Index.y = ((int)cSettings->NUM_TILES_YAXIS) - 1;
-			i32vec2NumMicroSteps.y = 0;
-		}
-	}
-	else if (eDirection == DOWN)
-	{
-		if (vec2Index.y < 0)
-		{
-			vec2Index.y = 0;
-			i32vec2NumMicroSteps.y = 0;
-		}
-	}
-	else
-	{
-		cout << "CWoodCrawler::Constraint: Unknown direction." << endl;
-	}
-}
-
-/**
- @brief Check if a position is possible to move into
- @param eDirection A DIRECTION enumerated data type which indicates the direction to check
- */
-bool CWoodCrawler::CheckPosition(DIRECTION eDirection)
-{
-	if (eDirection == LEFT)
-	{
-		// If the new position is fully within a row, then check this row only
-		if (i32vec2NumMicroSteps.y == 0)
-		{
-			// If the grid is not accessible, then return false
-			if (cMap2D->GetMapInfo(vec2Index.y, vec2Index.x) >= 100)
-			{
-				return false;
-			}
-		}
-		// If the new position is between 2 rows, then check both rows as well
-		else if (i32vec2NumMicroSteps.y != 0)
-		{
-			// If the 2 grids are not accessible, then return false
-			if ((cMap2D->GetMapInfo(vec2Index.y, vec2Index.x) >= 100) ||
-				(cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x) >= 100))
-			{
-				return false;
-			}
-		}
-	}
-	else if (eDirection == RIGHT)
-	{
-		// If the new position is at the top row, then return true
-		if (vec2Index.x >= cSettings->NUM_TILES_XAXIS - 1)
-		{
-			i32vec2NumMicroSteps.x = 0;
-			return true;
-		}
-
-		// If the new position is fully within a row, then check this row only
-		if (i32vec2NumMicroSteps.y == 0)
-		{
-			// If the grid is not accessible, then return false
-			if (cMap2D->GetMapInfo(vec2Index.y, vec2Index.x + 1) >= 100)
-			{
-				return false;
-			}
-		}
-		// If the new position is between 2 rows, then check both rows as well
-		else if (i32vec2NumMicroSteps.y != 0)
-		{
-			// If the 2 grids are not accessible, then return false
-			if ((cMap2D->GetMapInfo(vec2Index.y, vec2Index.x + 1) >= 100) ||
-				(cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x + 1) >= 100))
-			{
-				return false;
-			}
-		}
-
-	}
-	else if (eDirection == UP)
-	{
-		// If the new position is at the top row, then return true
-		if (vec2Index.y >= cSettings->NUM_TILES_YAXIS - 1)
-		{
-			i32vec2NumMicroSteps.y = 0;
-			return true;
-		}
-
-		// If the new position is fully within a column, then check this column only
-		if (i32vec2NumMicroSteps.x == 0)
-		{
-			// If the grid is not accessible, then return false
-			if (cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x) >= 100)
-			{
-				return false;
-			}
-		}
-		// If the new position is between 2 columns, then check both columns as well
-		else if (i32vec2NumMicroSteps.x != 0)
-		{
-			// If the 2 grids are not accessible, then return false
-			if ((cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x) >= 100) ||
-				(cMap2D->GetMapInfo(vec2Index.y + 1, vec2Index.x + 1) >= 100))
-			{
-				return false;
-			}
-		}
-	}
-	else if (eDirection == DOWN)
-	{
-		// If the new position is fully within a column, then check this column only
-		if (i32vec2NumMicroSteps.x == 0)
-		{
-			// If the grid is not accessible, then return false
-			if (cMap2D->GetMapInfo(vec2Index.y, vec2Index.x) >= 100)
-			{
-				return false;
-			}
-		}
-		// If the new position is between 2 columns, then check both columns as well
-		else if (i32vec2NumMicroSteps.x != 0)
-		{
-			// If the 2 grids are not accessible, then return false
-			if ((cMap2D->GetMapInfo(vec2Index.y, vec2Index.x) >= 100) ||
-				(cMap2D->GetMapInfo(vec2Index.y, vec2Index.x + 1) >= 100))
-			{
-				return false;
-			}
-		}
-	}
-	else
-	{
-		cout << "CWoodCrawler::CheckPosition: Unknown direction." << endl;
-	}
-
-	return true;
-}
-
-// Check if the enemy2D is in mid-air
-bool CWoodCrawler::IsMidAir(void)
-{
-	// if the player is at the bottom row, then he is not in mid-air for sure
-	if (vec2Index.y == 0)
-		return false;
-
-	// Check if the tile below the player's current position is empty
-	if ((i32vec2NumMicroSteps.x == 0) &&
-		(cMap2D->GetMapInfo(vec2Index.y - 1, vec2Index.x) == 0))
-	{
-		return true;
-	}
-
-	return false;
-}
-
-// Update Jump or Fall
-void CWoodCrawler::UpdateJumpFall(const double dElapsedTime)
-{
-	if (cPhysics2D.GetStatus() == CPhysics2D::STATUS::JUMP)
-	{
-		// Update the elapsed time to the physics engine
-		cPhysics2D.AddElapsedTime((float)dElapsedTime);
-		// Call the physics engine update method to calculate the final velocity and displacement
-		cPhysics2D.Update();
-		// Get the displacement from the physics engine
-		glm::vec2 v2Displacement = cPhysics2D.GetDisplacement();
-
-		// Store the current vec2Index.y
-		int iIndex_YAxis_OLD = vec2Index.y;
-
-		int iDisplacement_MicroSteps = (int)(v2Displacement.y / cSettings->MICRO_STEP_YAXIS); //DIsplacement divide by distance for 1 microstep
-		if (vec2Index.y < (int)cSettings->NUM_TILES_YAXIS)
-		{
-			i32vec2NumMicroSteps.y += iDisplacement_MicroSteps;
-			if (i32vec2NumMicroSteps.y > cSettings->NUM_STEPS_PER_TILE_YAXIS)
-			{
-				i32vec2NumMicroSteps.y -= cSettings->NUM_STEPS_PER_TILE_YAXIS;
-				if (i32vec2NumMicroSteps.y < 0)
-					i32vec2NumMicroSteps.y = 0;
-				vec2Index.y++;
-			}
-		}
-
-		// Constraint the player's position within the screen boundary
-		Constraint(UP);
-
-		// Iterate through all rows until the proposed row
-		// Check if the player will hit a tile; stop jump if so.
-		int iIndex_YAxis_Proposed = vec2Index.y;
-		for (int i = iIndex_YAxis_OLD; i <= iIndex_YAxis_Proposed; i++)
-		{
-			// Change the player's index to the current i value
-			vec2Index.y = i;
-			// If the new position is not feasible, then revert to old position
-			if (CheckPosition(UP) == false)
-			{
-				// Align with the row
-				i32vec2NumMicroSteps.y = 0;
-				// Set the Physics to fall status
-				cPhysics2D.SetStatus(CPhysics2D::STATUS::FALL);
-				break;
-			}
-		}
-
-		// If the player is still jumping and the initial velocity has reached zero or below zero, 
-		// then it has reach the peak of its jump
-		if ((cPhysics2D.GetStatus() == CPhysics2D::STATUS::JUMP) && (cPhysics2D.GetInitialVelocity().y <= 0.0f))
-		{
-			// Set status to fall
-			cPhysics2D.SetStatus(CPhysics2D::STATUS::FALL);
-		}
-	}
-	else if (cPhysics2D.GetStatus() == CPhysics2D::STATUS::FALL)
-	{
-		// Update the elapsed time to the physics engine
-		cPhysics2D.AddElapsedTime((float)dElapsedTime);
-		// Call the physics engine update method to calculate the final velocity and displacement
-		cPhysics2D.Update();
-		// Get the displacement from the physics engine
-		glm::vec2 v2Displacement = cPhysics2D.GetDisplacement();
-
-		// Store the current vec2Index.y
-		int iIndex_YAxis_OLD = vec2Index.y;
-
-		// Translate the displacement from pixels to indices
-		int iDisplacement_MicroSteps = (int)(v2Displacement.y / cSettings->MICRO_STEP_YAXIS);
-
-		if (vec2Index.y >= 0)
-		{
-			i32vec2NumMicroSteps.y -= fabs(iDisplacement_MicroSteps);
-			if (i32vec2NumMicroSteps.y < 0)
-			{
-				i32vec2NumMicroSteps.y = ((int)cSettings->NUM_STEPS_PER_TILE_YAXIS) - 1;
-				vec2Index.y--;
-			}
-		}
-
-		// Constraint the player's position within the screen boundary
-		Constraint(DOWN);
-
-		// Iterate through all rows until the proposed row
-		// Check if the player will hit a tile; stop fall if so.
-		int iIndex_YAxis_Proposed = vec2Index.y;
-		for (int i = iIndex_YAxis_OLD; i >= iIndex_YAxis_Proposed; i--)
-		{
-			// Change the player's index to the current i value
-			vec2Index.y = i;
-			// If the new position is not feasible, then revert to old position
-			if (CheckPosition(DOWN) == false)
-			{
-				// Revert to the previous position
-				if (i != iIndex_YAxis_OLD)
-					vec2Index.y = i + 1;
-				// Set the Physics to idle status
-				cPhysics2D.SetStatus(CPhysics2D::STATUS::IDLE);
-				i32vec2NumMicroSteps.y = 0;
-				break;
-			}
-		}
-	}
-}
-
 /**
  @brief Let enemy2D interact with the player.
  */
@@ -774,11 +468,11 @@ bool CWoodCrawler::InteractWithPlayer(void)
 	glm::i32vec2 i32vec2PlayerPos = cPlayer2D->vec2Index;
 	
 	// Check if the enemy2D is within 1.5 indices of the player2D
-	if (((vec2Index.x >= i32vec2PlayerPos.x - 0.5) && 
-		(vec2Index.x <= i32vec2PlayerPos.x + 0.5))
+	if (((Index().x >= i32vec2PlayerPos.x - 0.5) && 
+		(Index().x <= i32vec2PlayerPos.x + 0.5))
 		&& 
-		((vec2Index.y >= i32vec2PlayerPos.y - 0.5) &&
-		(vec2Index.y <= i32vec2PlayerPos.y + 0.5))
+		((Index().y >= i32vec2PlayerPos.y - 0.5) &&
+		(Index().y <= i32vec2PlayerPos.y + 0.5))
 		&& !hit)
 	{
 		cout << "Attack!" << endl;
@@ -792,8 +486,8 @@ bool CWoodCrawler::InteractWithPlayer(void)
 
 	
 		// Since the player has been caught, then reset the FSM
-		sCurrentFSM = IDLE;
-		iFSMCounter = 0;
+		CurrentFSM() = IDLE;
+		FSMCounter() = 0;
 		return true;
 	}
 	return false;
@@ -808,10 +502,10 @@ void CWoodCrawler::UpdateDirection(void)
 	i32vec2Destination = cPlayer2D->vec2Index;
 
 	// Calculate the direction between enemy2D and player2D
-	i32vec2Direction = i32vec2Destination - vec2Index;
+	i32vec2Direction = i32vec2Destination - Index();
 
 	// Calculate the distance between enemy2D and player2D
-	float fDistance = cPhysics2D.CalculateDistance(vec2Index, i32vec2Destination);
+	float fDistance = CalculateDistance(Index(), i32vec2Destination);
 	if (fDistance >= 0.01f)
 	{
 		// Calculate direction vector.
@@ -840,21 +534,21 @@ void CWoodCrawler::FlipHorizontalDirection(void)
 void CWoodCrawler::UpdatePosition(void)
 {
 	// Store the old position
-	i32vec2OldIndex = vec2Index;
+	i32vec2OldIndex = Index();
 
 	// if the player is to the left or right of the enemy2D, then jump to attack
 	if (i32vec2Direction.x < 0)
 	{
 		// Move left
-		const int iOldIndex = vec2Index.x;
-		if (vec2Index.x >= 0)
+		const int iOldIndex = Index().x;
+		if (Index().x >= 0)
 		{
-			i32vec2NumMicroSteps.x -= movementSpeed;
-			if (i32vec2NumMicroSteps.x < 0)
+			MicroSteps().x -= movementSpeed;
+			if (MicroSteps().x < 0)
 			{
-				i32vec2NumMicroSteps.x = ((int)cSettings->NUM_STEPS_PER_TILE_XAXIS) - 1;
+				MicroSteps().x = ((int)cSettings->NUM_STEPS_PER_TILE_XAXIS) - 1;
 				woodAnimatedSprites->PlayAnimation("Left", -1, 5);
-				vec2Index.x--;
+				Index().x--;
 			}
 		}
 
@@ -865,14 +559,14 @@ void CWoodCrawler::UpdatePosition(void)
 		if (CheckPosition(LEFT) == false)
 		{
 			FlipHorizontalDirection();
-			vec2Index = i32vec2OldIndex;
-			i32vec2NumMicroSteps.x = 0;
+			Index() = i32vec2OldIndex;
+			MicroSteps().x = 0;
 		}
 
 		// Check if enemy2D is in mid-air, such as walking off a platform
 		if (IsMidAir() == true)
 		{
-			cPhysics2D.SetStatus(CPhysics2D::STATUS::FALL);
+			cSimulation->SetStatus(uiBody, CPhysics2D::STATUS::FALL);
 		}
 
 		// Interact with the Player
@@ -881,16 +575,16 @@ void CWoodCrawler::UpdatePosition(void)
 	else if (i32vec2Direction.x > 0)
 	{
 		// Move right
-		const int iOldIndex = vec2Index.x;
-		if (vec2Index.x < (int)cSettings->NUM_TILES_XAXIS)
+		const int iOldIndex = Index().x;
+		if (Index().x < (int)cSettings->NUM_TILES_XAXIS)
 		{
-			i32vec2NumMicroSteps.x += movementSpeed;
+			MicroSteps().x += movementSpeed;
 
-			if (i32vec2NumMicroSteps.x >= cSettings->NUM_STEPS_PER_TILE_XAXIS)
+			if (MicroSteps().x >= cSettings->NUM_STEPS_PER_TILE_XAXIS)
 			{
-				i32vec2NumMicroSteps.x = 0;
+				MicroSteps().x = 0;
 				woodAnimatedSprites->PlayAnimation("Right", -1, 5);
-				vec2Index.x++;
+				Index().x++;
 			}
 		}
 
@@ -902,13 +596,13 @@ void CWoodCrawler::UpdatePosition(void)
 		{
 			FlipHorizontalDirection();
 			//vec2Index = i32vec2OldIndex;
-			i32vec2NumMicroSteps.x = 0;
+			MicroSteps().x = 0;
 		}
 
 		// Check if enemy2D is in mid-air, such as walking off a platform
 		if (IsMidAir() == true)
 		{
-			cPhysics2D.SetStatus(CPhysics2D::STATUS::FALL);
+			cSimulation->SetStatus(uiBody, CPhysics2D::STATUS::FALL);
 		}
 
 		// Interact with the Player
@@ -916,17 +610,17 @@ void CWoodCrawler::UpdatePosition(void)
 	}
 
 	// if the player is above the enemy2D, then jump to attack
-	if (i32vec2Direction.y > 0 && cPlayer2D->vec2Index.y - vec2Index.y  < 5.f)
+	if (i32vec2Direction.y > 0 && cPlayer2D->vec2Index.y - Index().y  < 5.f)
 	{
-		if (cPhysics2D.GetStatus() == CPhysics2D::STATUS::IDLE)
+		if (cSimulation->GetStatus(uiBody) == CPhysics2D::STATUS::IDLE)
 		{
-			cPhysics2D.SetStatus(CPhysics2D::STATUS::JUMP);
-			cPhysics2D.SetInitialVelocity(glm::vec2(0.0f, 3.5f));
+			cSimulation->SetStatus(uiBody, CPhysics2D::STATUS::JUMP);
+			cSimulation->SetVelocity(uiBody, glm::vec2(0.0f, 3.5f));
 		}
 	}
 	else
 	{
-		cPhysics2D.SetStatus(CPhysics2D::STATUS::FALL);
+		cSimulation->SetStatus(uiBody, CPhysics2D::STATUS::FALL);
 
 	}
 }
@@ -53,6 +53,13 @@ CEntity2D::~CEntity2D(void)
 		delete mesh;
 		mesh = NULL;
 	}
+
+	// Release the texture, so that it is deleted once no other entity uses it
+	if (iTextureID != 0)
+	{
+		CImageLoader::GetInstance()->ReleaseTexture(iTextureID);
+		iTextureID = 0;
+	}
 }
 
 /**
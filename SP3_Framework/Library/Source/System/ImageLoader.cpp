@@ -7,6 +7,7 @@
 #include "ImageLoader.h"
 
 #include <iostream>
+#include <cstring>
 using namespace std;
 
 // Include GLEW
@@ -34,6 +35,14 @@ CImageLoader::CImageLoader(void)
  */
 CImageLoader::~CImageLoader(void)
 {
+	// Delete the textures which are still in use, so this must be destroyed before the OpenGL context
+	for (std::map<unsigned int, std::pair<std::string, bool> >::iterator it = mTextureKeys.begin(); it != mTextureKeys.end(); ++it)
+	{
+		GLuint uiTextureID = it->first;
+		glDeleteTextures(1, &uiTextureID);
+	}
+	mTextureKeys.clear();
+	mTextureCache.clear();
 }
 
 /**
@@ -66,11 +75,72 @@ unsigned char * CImageLoader::Load(const char* filename, int& width, int& height
 }
 
 /**
- @brief Load an image into the graphics card and return its ID.
+ @brief Load an image into the graphics card and return its ID. Each image is only decoded and
+		uploaded once, and every later call with the same file name and bInvert returns the same
+		texture. Each call must be matched by a call to ReleaseTexture once the texture is not needed.
  @param filename A const char* storing the name of the image file
  @param bInvert A const bool
+ @return The Texture ID, or 0 if the image could not be loaded
  */
 unsigned int CImageLoader::LoadTextureGetID(const char* filename,  const bool bInvert)
+{
+	const std::pair<std::string, bool> key(filename, bInvert);
+	std::map<std::pair<std::string, bool>, CachedTexture>::iterator it = mTextureCache.find(key);
+	if (it != mTextureCache.end())
+	{
+		it->second.uiRefCount++;
+		return it->second.uiTextureID;
+	}
+
+	const unsigned int uiTextureID = CreateTexture(filename, bInvert);
+	if (uiTextureID == 0)
+		return 0;
+
+	CachedTexture sTexture;
+	sTexture.uiTextureID = uiTextureID;
+	sTexture.uiRefCount = 1;
+	mTextureCache[key] = sTexture;
+	mTextureKeys[uiTextureID] = key;
+	return uiTextureID;
+}
+
+/**
+ @brief Release a Texture ID which was returned by LoadTextureGetID. The texture is deleted
+		when every call which returned it has released it
+ @param uiTextureID A const unsigned int variable containing the Texture ID
+ @return true if the Texture ID was in the cache, otherwise false
+ */
+bool CImageLoader::ReleaseTexture(const unsigned int uiTextureID)
+{
+	std::map<unsigned int, std::pair<std::string, bool> >::iterator itKey = mTextureKeys.find(uiTextureID);
+	if (itKey == mTextureKeys.end())
+		return false;
+
+	std::map<std::pair<std::string, bool>, CachedTexture>::iterator it = mTextureCache.find(itKey->second);
+	if (--it->second.uiRefCount == 0)
+	{
+		GLuint uiID = uiTextureID;
+		glDeleteTextures(1, &uiID);
+		mTextureCache.erase(it);
+		mTextureKeys.erase(itKey);
+	}
+	return true;
+}
+
+/**
+ @brief Get the number of textures in the cache
+ */
+unsigned int CImageLoader::GetNumCachedTextures(void) const
+{
+	return (unsigned int)mTextureCache.size();
+}
+
+/**
+ @brief Load an image into a new texture in the graphics card and return its ID
+ @param filename A const char* storing the name of the image file
+ @param bInvert A const bool
+ */
+unsigned int CImageLoader::CreateTexture(const char* filename, const bool bInvert)
 {
 	// Load from file
 	int image_width = 0;
@@ -86,7 +156,7 @@ unsigned int CImageLoader::LoadTextureGetID(const char* filename,  const bool bI
 
 	if (data == NULL)
 	{
-		cout << "CImageLoader::LoadTextureGetID(): Unable to load " << FileSystem::getPath(filename).c_str() << endl;
+		cout << "CImageLoader::CreateTexture(): Unable to load " << FileSystem::getPath(filename).c_str() << endl;
 		return 0;
 	}
 
@@ -120,3 +190,132 @@ unsigned int CImageLoader::LoadTextureGetID(const char* filename,  const bool bI
 	return image_texture;
 }
 
+
+/**
+ @brief Load a list of images into the layers of a texture array and return its ID.
+		Layer i of the texture array contains filenames[i]. Images which are not of the 
+		layer size are resampled to it.
+ @param filenames A const std::vector<std::string>& storing the names of the image files
+ @param bInvert A const bool
+ @param iLayerWidth A int variable storing the width of each layer. If 0, the width of the first image is used.
+ @param iLayerHeight A int variable storing the height of each layer. If 0, the height of the first image is used.
+ */
+unsigned int CImageLoader::LoadTextureArrayGetID(	const std::vector<std::string>& filenames, const bool bInvert,
+													int iLayerWidth, int iLayerHeight)
+{
+	if (filenames.empty())
+	{
+		cout << "CImageLoader::LoadTextureArrayGetID(): No images to load" << endl;
+		return 0;
+	}
+
+	// tell stb_image.h to flip loaded texture's on the y-axis.
+	stbi_set_flip_vertically_on_load(bInvert);
+
+	// Decode every image as RGBA so that all the layers share one format
+	std::vector<unsigned char> layer_data;
+	for (unsigned int i = 0; i < filenames.size(); i++)
+	{
+		int image_width = 0;
+		int image_height = 0;
+		int nrChannels = 0;
+		unsigned char* data = stbi_load(FileSystem::getPath(filenames[i]).c_str(),
+			&image_width, &image_height, &nrChannels, 4);
+
+		if (data == NULL)
+		{
+			cout << "CImageLoader::LoadTextureArrayGetID(): Unable to load " << FileSystem::getPath(filenames[i]).c_str() << endl;
+			return 0;
+		}
+
+		// The first image decides the layer size if it was not specified
+		if ((iLayerWidth <= 0) || (iLayerHeight <= 0))
+		{
+			iLayerWidth = image_width;
+			iLayerHeight = image_height;
+			layer_data.resize((size_t)iLayerWidth * iLayerHeight * 4 * filenames.size());
+		}
+		else if (layer_data.empty())
+		{
+			layer_data.resize((size_t)iLayerWidth * iLayerHeight * 4 * filenames.size());
+		}
+
+		unsigned char* layer = &layer_data[(size_t)iLayerWidth * iLayerHeight * 4 * i];
+		if ((image_width == iLayerWidth) && (image_height == iLayerHeight))
+			memcpy(layer, data, (size_t)iLayerWidth * iLayerHeight * 4);
+		else
+			ResampleRGBA(data, image_width, image_height, layer, iLayerWidth, iLayerHeight);
+
+		stbi_image_free(data);
+	}
+
+	// Create a OpenGL texture array identifier
+	GLuint image_texture;
+	glGenTextures(1, &image_texture);
+	glBindTexture(GL_TEXTURE_2D_ARRAY, image_texture);
+
+	// Setup filtering parameters for display
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+	// Upload all the layers into the texture array
+#if defined(GL_UNPACK_ROW_LENGTH) && !defined(__EMSCRIPTEN__)
+	glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+#endif
+	glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA, iLayerWidth, iLayerHeight, (GLsizei)filenames.size(),
+				0, GL_RGBA, GL_UNSIGNED_BYTE, &layer_data[0]);
+
+	// Generate mipmaps
+	glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+	glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+	return image_texture;
+}
+
+/**
+ @brief Resample an RGBA image into another size using a box filter.
+		Each destination pixel is the average of the source pixels which it covers.
+ */
+void CImageLoader::ResampleRGBA(const unsigned char* src, const int iSrcWidth, const int iSrcHeight,
+								unsigned char* dst, const int iDstWidth, const int iDstHeight) const
+{
+	for (int y = 0; y < iDstHeight; y++)
+	{
+		// The rows of the source image covered by this destination row
+		int iSrcY0 = (y * iSrcHeight) / iDstHeight;
+		int iSrcY1 = ((y + 1) * iSrcHeight) / iDstHeight;
+		if (iSrcY1 <= iSrcY0)
+			iSrcY1 = iSrcY0 + 1;
+
+		for (int x = 0; x < iDstWidth; x++)
+		{
+			// The columns of the source image covered by this destination column
+			int iSrcX0 = (x * iSrcWidth) / iDstWidth;
+			int iSrcX1 = ((x + 1) * iSrcWidth) / iDstWidth;
+			if (iSrcX1 <= iSrcX0)
+				iSrcX1 = iSrcX0 + 1;
+
+			unsigned int uiSum[4] = { 0, 0, 0, 0 };
+			for (int sy = iSrcY0; sy < iSrcY1; sy++)
+			{
+				for (int sx = iSrcX0; sx < iSrcX1; sx++)
+				{
+					const unsigned char* pixel = &src[((size_t)sy * iSrcWidth + sx) * 4];
+					uiSum[0] += pixel[0];
+					uiSum[1] += pixel[1];
+					uiSum[2] += pixel[2];
+					uiSum[3] += pixel[3];
+				}
+			}
+
+			const unsigned int uiCount = (iSrcY1 - iSrcY0) * (iSrcX1 - iSrcX0);
+			unsigned char* pixel = &dst[((size_t)y * iDstWidth + x) * 4];
+			pixel[0] = (unsigned char)(uiSum[0] / uiCount);
+			pixel[1] = (unsigned char)(uiSum[1] / uiCount);
+			pixel[2] = (unsigned char)(uiSum[2] / uiCount);
+			pixel[3] = (unsigned char)(uiSum[3] / uiCount);
+		}
+	}
+}
@@ -15,6 +15,10 @@
 #define GLEW_STATIC
 #endif
 
+#include <string>
+#include <vector>
+#include <map>
+
 class CImageLoader : public CSingletonTemplate<CImageLoader>
 {
 	friend CSingletonTemplate<CImageLoader>;
@@ -27,9 +31,37 @@ public:
 							int& width, int& height, 
 							int& nrChannels, const bool bInvert = false);
 
-	// Load an image and return as a Texture ID
+	// Load an image and return as a Texture ID, sharing the texture if the image is already loaded
 	unsigned int LoadTextureGetID(const char* filename, const bool bInvert);
+	// Release a Texture ID from LoadTextureGetID, deleting the texture when nothing uses it
+	bool ReleaseTexture(const unsigned int uiTextureID);
+	// Get the number of textures in the cache
+	unsigned int GetNumCachedTextures(void) const;
+
+	// Load a list of images into the layers of a texture array and return its Texture ID
+	unsigned int LoadTextureArrayGetID(	const std::vector<std::string>& filenames, const bool bInvert,
+										int iLayerWidth = 0, int iLayerHeight = 0);
+
 protected:
+	// A texture in the cache, and the number of LoadTextureGetID calls which have not released it
+	struct CachedTexture
+	{
+		unsigned int uiTextureID;
+		unsigned int uiRefCount;
+	};
+
+	// The cached textures, keyed by the image file name and whether it is inverted
+	std::map<std::pair<std::string, bool>, CachedTexture> mTextureCache;
+	// The key of each cached texture, to find it from its Texture ID
+	std::map<unsigned int, std::pair<std::string, bool> > mTextureKeys;
+
+	// Load an image into a new texture and return its Texture ID
+	unsigned int CreateTexture(const char* filename, const bool bInvert);
+
+	// Resample an RGBA image into another size using a box filter
+	void ResampleRGBA(	const unsigned char* src, const int iSrcWidth, const int iSrcHeight,
+						unsigned char* dst, const int iDstWidth, const int iDstHeight) const;
+
 	// Constructor
 	CImageLoader(void);
 
@@ -0,0 +1,58 @@
+/**
+ LevelFormat
+ @brief The layout of a cooked binary level file (.map).
+		A file starts with a LevelFileHeader, followed by uiNumSections sections.
+		Each section is a LevelSectionHeader followed by uiSize bytes of data,
+		padded to a multiple of 4 bytes. Readers skip sections they do not know.
+		All values are little-endian.
+ */
+#pragma once
+
+#include <cstdint>
+
+namespace LevelFormat
+{
+	// The first 4 bytes of every level file
+	const char MAGIC[4] = { 'S', 'P', '3', 'L' };
+	// The version of the layout written by the cooker
+	const uint16_t VERSION = 1;
+
+	// The types of sections
+	enum SECTION_TYPE
+	{
+		// The tile values, as uiNumRows * uiNumCols uint16_t in row-major order.
+		// Row 0 is the bottom row, which is the same layout as CMap2D's arrMapInfo
+		SECTION_TILES = 1,
+		// The positions of the spawn markers (tile values 200 and above), as LevelSpawn entries
+		SECTION_SPAWNS = 2,
+	};
+
+	struct LevelFileHeader
+	{
+		char cMagic[4];
+		uint16_t uiVersion;
+		uint16_t uiNumSections;
+		uint32_t uiNumRows;
+		uint32_t uiNumCols;
+	};
+
+	struct LevelSectionHeader
+	{
+		uint32_t uiType;
+		uint32_t uiSize;
+	};
+
+	struct LevelSpawn
+	{
+		uint16_t uiValue;
+		uint16_t uiRow;
+		uint16_t uiCol;
+		uint16_t uiPadding;
+	};
+
+	// Round a section size up to the alignment of the next section
+	inline uint32_t AlignSize(const uint32_t uiSize)
+	{
+		return (uiSize + 3) & ~3u;
+	}
+}
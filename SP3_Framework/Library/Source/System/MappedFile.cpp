@@ -0,0 +1,137 @@
+/**
+ CMappedFile
+ @brief A class which maps a file into memory for reading, so its contents
+		can be used directly without copying them into a buffer first
+ */
+#include "MappedFile.h"
+
+#ifndef _WIN32
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
+#include <iostream>
+using namespace std;
+
+/**
+ @brief Constructor
+ */
+CMappedFile::CMappedFile(void)
+	: pData(NULL)
+	, uiSize(0)
+#ifdef _WIN32
+	, hFile(INVALID_HANDLE_VALUE)
+	, hMapping(NULL)
+#endif
+{
+}
+
+/**
+ @brief Destructor
+ */
+CMappedFile::~CMappedFile(void)
+{
+	Close();
+}
+
+/**
+ @brief Map a file into memory. Any file mapped previously is unmapped first
+ @param filename A const std::string& variable containing the full path of the file
+ @return true if the file was mapped, otherwise false
+ */
+bool CMappedFile::Open(const std::string& filename)
+{
+	Close();
+
+#ifdef _WIN32
+	hFile = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+						OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (hFile == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER liSize;
+	if ((GetFileSizeEx(hFile, &liSize) == FALSE) || (liSize.QuadPart == 0))
+	{
+		Close();
+		return false;
+	}
+
+	hMapping = CreateFileMappingA(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (hMapping == NULL)
+	{
+		Close();
+		return false;
+	}
+
+	pData = (const unsigned char*)MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+	if (pData == NULL)
+	{
+		Close();
+		return false;
+	}
+	uiSize = (size_t)liSize.QuadPart;
+#else
+	int iFile = open(filename.c_str(), O_RDONLY);
+	if (iFile < 0)
+		return false;
+
+	struct stat sStat;
+	if ((fstat(iFile, &sStat) != 0) || (sStat.st_size == 0))
+	{
+		close(iFile);
+		return false;
+	}
+
+	void* pMapping = mmap(NULL, (size_t)sStat.st_size, PROT_READ, MAP_PRIVATE, iFile, 0);
+	// The mapping stays valid after the file is closed
+	close(iFile);
+	if (pMapping == MAP_FAILED)
+		return false;
+
+	pData = (const unsigned char*)pMapping;
+	uiSize = (size_t)sStat.st_size;
+#endif
+
+	return true;
+}
+
+/**
+ @brief Unmap the file
+ */
+void CMappedFile::Close(void)
+{
+#ifdef _WIN32
+	if (pData)
+		UnmapViewOfFile(pData);
+	if (hMapping)
+		CloseHandle(hMapping);
+	if (hFile != INVALID_HANDLE_VALUE)
+		CloseHandle(hFile);
+	hMapping = NULL;
+	hFile = INVALID_HANDLE_VALUE;
+#else
+	if (pData)
+		munmap((void*)pData, uiSize);
+#endif
+
+	pData = NULL;
+	uiSize = 0;
+}
+
+/**
+ @brief Get the start of the file's contents, or NULL if no file is mapped
+ */
+const unsigned char* CMappedFile::GetData(void) const
+{
+	return pData;
+}
+
+/**
+ @brief Get the size of the file in bytes
+ */
+size_t CMappedFile::GetSize(void) const
+{
+	return uiSize;
+}
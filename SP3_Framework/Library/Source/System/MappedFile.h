@@ -0,0 +1,49 @@
+/**
+ CMappedFile
+ @brief A class which maps a file into memory for reading, so its contents
+		can be used directly without copying them into a buffer first
+ */
+#pragma once
+
+#include <string>
+
+#ifdef _WIN32
+	#include <windows.h>
+#endif
+
+class CMappedFile
+{
+public:
+	// Constructor
+	CMappedFile(void);
+
+	// Destructor
+	~CMappedFile(void);
+
+	// Map a file into memory
+	bool Open(const std::string& filename);
+
+	// Unmap the file
+	void Close(void);
+
+	// Get the start of the file's contents
+	const unsigned char* GetData(void) const;
+
+	// Get the size of the file in bytes
+	size_t GetSize(void) const;
+
+protected:
+	// The start and size of the mapped contents
+	const unsigned char* pData;
+	size_t uiSize;
+
+#ifdef _WIN32
+	HANDLE hFile;
+	HANDLE hMapping;
+#endif
+
+private:
+	// A mapping cannot be shared, so copying is not allowed
+	CMappedFile(const CMappedFile&);
+	CMappedFile& operator=(const CMappedFile&);
+};
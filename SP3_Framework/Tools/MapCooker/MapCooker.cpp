@@ -0,0 +1,161 @@
+/**
+ MapCooker
+ @brief A command line tool which converts CSV maps into cooked binary maps (.map),
+		which CMap2D::LoadMap() loads without any parsing.
+		The layout of a cooked map is described in Library/Source/System/LevelFormat.h.
+
+		Usage: MapCooker <map.csv> [<map.csv> ...]
+		Each map is written next to its CSV file, with the extension changed to .map.
+
+		The tool is a single source file. It can be built with any C++11 compiler,
+		for example from this directory:
+			cl /EHsc /I..\..\Library\Source MapCooker.cpp
+			g++ -std=c++11 -I../../Library/Source MapCooker.cpp -o MapCooker
+ */
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <limits>
+using namespace std;
+
+// Include the RapidCSV
+#include "System/rapidcsv.h"
+// Include the binary level format
+#include "System/LevelFormat.h"
+
+using namespace LevelFormat;
+
+/**
+ @brief Write a section to a cooked map, padded to the section alignment
+ */
+static void WriteSection(ofstream& file, const uint32_t uiType, const void* pData, const uint32_t uiSize)
+{
+	LevelSectionHeader sSection;
+	sSection.uiType = uiType;
+	sSection.uiSize = uiSize;
+	file.write((const char*)&sSection, sizeof(sSection));
+	if (uiSize > 0)
+		file.write((const char*)pData, uiSize);
+
+	const char cPadding[4] = { 0, 0, 0, 0 };
+	file.write(cPadding, AlignSize(uiSize) - uiSize);
+}
+
+/**
+ @brief Convert a CSV map into a cooked map
+ @param strInput A const string& variable containing the path of the CSV map
+ @param strOutput A const string& variable containing the path of the cooked map to write
+ */
+static bool CookMap(const string& strInput, const string& strOutput)
+{
+	rapidcsv::Document doc;
+	try
+	{
+		doc.Load(strInput);
+	}
+	catch (exception& e)
+	{
+		cout << "Unable to read " << strInput << ": " << e.what() << endl;
+		return false;
+	}
+
+	const uint32_t uiNumRows = (uint32_t)doc.GetRowCount();
+	const uint32_t uiNumCols = (uint32_t)doc.GetColumnCount();
+	if ((uiNumRows == 0) || (uiNumCols == 0))
+	{
+		cout << strInput << " has no tiles" << endl;
+		return false;
+	}
+
+	// Read the tiles. The CSV file lists the top row first, while the cooked map starts from the bottom row
+	vector<uint16_t> vTiles(uiNumRows * uiNumCols, 0);
+	vector<LevelSpawn> vSpawns;
+	for (uint32_t uiRow = 0; uiRow < uiNumRows; uiRow++)
+	{
+		std::vector<std::string> row = doc.GetRow<std::string>(uiRow);
+		if (row.size() != uiNumCols)
+		{
+			cout << strInput << " row " << uiRow << " has " << row.size() << " columns instead of " << uiNumCols << endl;
+			return false;
+		}
+
+		const uint32_t uiMapRow = uiNumRows - uiRow - 1;
+		for (uint32_t uiCol = 0; uiCol < uiNumCols; uiCol++)
+		{
+			const int iValue = stoi(row[uiCol]);
+			if ((iValue < 0) || (iValue > 0xFFFF))
+			{
+				cout << strInput << " has an invalid value " << iValue << endl;
+				return false;
+			}
+			vTiles[uiMapRow * uiNumCols + uiCol] = (uint16_t)iValue;
+
+			// Record the spawn markers
+			if (iValue >= 200)
+			{
+				LevelSpawn sSpawn;
+				sSpawn.uiValue = (uint16_t)iValue;
+				sSpawn.uiRow = (uint16_t)uiMapRow;
+				sSpawn.uiCol = (uint16_t)uiCol;
+				sSpawn.uiPadding = 0;
+				vSpawns.push_back(sSpawn);
+			}
+		}
+	}
+
+	ofstream file(strOutput.c_str(), ios::binary);
+	if (!file.is_open())
+	{
+		cout << "Unable to write " << strOutput << endl;
+		return false;
+	}
+
+	LevelFileHeader sHeader;
+	memcpy(sHeader.cMagic, MAGIC, sizeof(MAGIC));
+	sHeader.uiVersion = VERSION;
+	sHeader.uiNumSections = 2;
+	sHeader.uiNumRows = uiNumRows;
+	sHeader.uiNumCols = uiNumCols;
+	file.write((const char*)&sHeader, sizeof(sHeader));
+
+	WriteSection(file, SECTION_TILES, &vTiles[0], (uint32_t)(vTiles.size() * sizeof(uint16_t)));
+	WriteSection(file, SECTION_SPAWNS, vSpawns.empty() ? NULL : &vSpawns[0], (uint32_t)(vSpawns.size() * sizeof(LevelSpawn)));
+
+	if (!file.good())
+	{
+		cout << "Unable to write " << strOutput << endl;
+		return false;
+	}
+
+	cout << strInput << " -> " << strOutput << " (" << uiNumCols << "x" << uiNumRows << ", "
+		<< vSpawns.size() << " spawn markers)" << endl;
+	return true;
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc < 2)
+	{
+		cout << "Usage: MapCooker <map.csv> [<map.csv> ...]" << endl;
+		return 1;
+	}
+
+	int iResult = 0;
+	for (int i = 1; i < argc; i++)
+	{
+		// Replace the extension with .map
+		string strInput = argv[i];
+		string strOutput = strInput;
+		const size_t uiDot = strOutput.find_last_of('.');
+		const size_t uiSlash = strOutput.find_last_of("/\\");
+		if ((uiDot != string::npos) && ((uiSlash == string::npos) || (uiDot > uiSlash)))
+			strOutput.erase(uiDot);
+		strOutput += ".map";
+
+		if (!CookMap(strInput, strOutput))
+			iResult = 1;
+	}
+	return iResult;
+}
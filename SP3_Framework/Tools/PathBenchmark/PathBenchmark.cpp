@@ -0,0 +1,310 @@
+/**
+ PathBenchmark
+ @brief A command line tool which compares A* Path Finding with Jump Point Search and
+		Hierarchical Path Finding on cooked binary maps (.map). For each map, it searches
+		between the same random pairs of walkable tiles with each search, in 4 and 8
+		directional modes, and prints the number of nodes expanded, the time taken and the
+		total path length.
+
+		Usage: PathBenchmark [-n <pairs>] <map.map> [<map.map> ...]
+		For example, to run it on a shipped map:
+			PathBenchmark ../../App/Maps/DM2213_Map_Level_cave.map
+
+		The tool is built from this file, CGridSearch and CHierarchicalMap, for example from this directory:
+			cl /std:c++14 /EHsc /O2 /I..\..\Library\Source /I..\..\App\Source\Scene2D /I..\..\glm PathBenchmark.cpp ..\..\App\Source\Scene2D\GridSearch.cpp ..\..\App\Source\Scene2D\HierarchicalMap.cpp
+			g++ -std=c++14 -O2 -I../../Library/Source -I../../App/Source/Scene2D -I../../glm PathBenchmark.cpp ../../App/Source/Scene2D/GridSearch.cpp ../../App/Source/Scene2D/HierarchicalMap.cpp -o PathBenchmark
+ */
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <cstdlib>
+#include <chrono>
+#include <random>
+using namespace std;
+
+// Include the binary level format
+#include "System/LevelFormat.h"
+// Include CGridSearch
+#include "GridSearch.h"
+// Include CHierarchicalMap
+#include "HierarchicalMap.h"
+
+using namespace LevelFormat;
+
+// The number of tiles along each side of a cluster, the same as the chunks of CMap2D
+static const unsigned int CLUSTER_SIZE = 8;
+
+// The results of one search over all the pairs of a map
+struct BenchmarkResult
+{
+	BenchmarkResult()
+		: uiNumFound(0), ullNumExpanded(0), ullPathLength(0), dMilliseconds(0.0) {}
+
+	unsigned int uiNumFound;
+	unsigned long long ullNumExpanded;
+	unsigned long long ullPathLength;
+	double dMilliseconds;
+};
+
+/**
+ @brief Load the tiles of a cooked map
+ @param strFilename A const string& variable containing the path of the cooked map
+ @param vTiles A vector<unsigned short>& variable which will store the tiles, where row 0 is the bottom row
+ @param uirNumRows An unsigned int variable which will store the number of rows
+ @param uirNumCols An unsigned int variable which will store the number of columns
+ */
+static bool LoadMap(const string& strFilename, vector<unsigned short>& vTiles, unsigned int& uirNumRows, unsigned int& uirNumCols)
+{
+	ifstream file(strFilename.c_str(), ios::binary);
+	if (!file.is_open())
+	{
+		cout << "Unable to read " << strFilename << endl;
+		return false;
+	}
+
+	LevelFileHeader sHeader;
+	file.read((char*)&sHeader, sizeof(sHeader));
+	if (!file.good() || (memcmp(sHeader.cMagic, MAGIC, sizeof(MAGIC)) != 0) || (sHeader.uiVersion != VERSION))
+	{
+		cout << strFilename << " is not a cooked map" << endl;
+		return false;
+	}
+
+	// Skip the sections until the tiles are found
+	for (unsigned int i = 0; i < sHeader.uiNumSections; i++)
+	{
+		LevelSectionHeader sSection;
+		file.read((char*)&sSection, sizeof(sSection));
+		if (!file.good())
+			break;
+
+		if ((sSection.uiType == SECTION_TILES) &&
+			(sSection.uiSize == sHeader.uiNumRows * sHeader.uiNumCols * sizeof(uint16_t)))
+		{
+			vTiles.resize(sHeader.uiNumRows * sHeader.uiNumCols);
+			file.read((char*)&vTiles[0], sSection.uiSize);
+			uirNumRows = sHeader.uiNumRows;
+			uirNumCols = sHeader.uiNumCols;
+			return file.good();
+		}
+		file.seekg(AlignSize(sSection.uiSize), ios::cur);
+	}
+
+	cout << strFilename << " has no tiles" << endl;
+	return false;
+}
+
+/**
+ @brief Search between every pair with one search
+ */
+template <typename Heuristic>
+static BenchmarkResult RunSearch(	const CGridSearch& cGridSearch,
+									const bool bJumpPoint,
+									const vector<glm::vec2>& vStarts,
+									const vector<glm::vec2>& vTargets,
+									vector<vector<glm::vec2> >& vPaths)
+{
+	BenchmarkResult sResult;
+	AStarContext context;
+	vPaths.resize(vStarts.size());
+
+	const chrono::high_resolution_clock::time_point cStart = chrono::high_resolution_clock::now();
+	for (size_t i = 0; i < vStarts.size(); i++)
+	{
+		const bool bFound = bJumpPoint ?
+			cGridSearch.JumpPoint<Heuristic>(context, vStarts[i], vTargets[i], vPaths[i]) :
+			cGridSearch.AStar<Heuristic>(context, vStarts[i], vTargets[i], vPaths[i]);
+		if (bFound)
+		{
+			sResult.uiNumFound++;
+			sResult.ullPathLength += vPaths[i].size();
+		}
+		sResult.ullNumExpanded += context.uiNumExpanded;
+	}
+	const chrono::high_resolution_clock::time_point cEnd = chrono::high_resolution_clock::now();
+	sResult.dMilliseconds = chrono::duration<double, milli>(cEnd - cStart).count();
+	return sResult;
+}
+
+/**
+ @brief Search between every pair with Hierarchical Path Finding. Building the clusters is
+		included in the time, since CMap2D builds them on the first search of a level
+ */
+static BenchmarkResult RunHierarchicalSearch(	const vector<unsigned short>& vTiles,
+												const unsigned int uiNumRows,
+												const unsigned int uiNumCols,
+												const unsigned int uiNumDirections,
+												const vector<glm::vec2>& vStarts,
+												const vector<glm::vec2>& vTargets,
+												vector<vector<glm::vec2> >& vPaths)
+{
+	BenchmarkResult sResult;
+	CHierarchicalMap cHierarchicalMap;
+	const unsigned int uiNumClusters = ((uiNumRows + CLUSTER_SIZE - 1) / CLUSTER_SIZE) * ((uiNumCols + CLUSTER_SIZE - 1) / CLUSTER_SIZE);
+	const vector<unsigned int> vClusterVersions(uiNumClusters, 1);
+	vPaths.resize(vStarts.size());
+
+	const chrono::high_resolution_clock::time_point cStart = chrono::high_resolution_clock::now();
+	for (size_t i = 0; i < vStarts.size(); i++)
+	{
+		cHierarchicalMap.Update(&vTiles[0], uiNumRows, uiNumCols, CLUSTER_SIZE, uiNumDirections, 0, &vClusterVersions[0]);
+		if (cHierarchicalMap.FindPath(vStarts[i], vTargets[i], vPaths[i]))
+		{
+			sResult.uiNumFound++;
+			sResult.ullPathLength += vPaths[i].size();
+		}
+		sResult.ullNumExpanded += cHierarchicalMap.GetNumExpanded();
+	}
+	const chrono::high_resolution_clock::time_point cEnd = chrono::high_resolution_clock::now();
+	sResult.dMilliseconds = chrono::duration<double, milli>(cEnd - cStart).count();
+	return sResult;
+}
+
+/**
+ @brief Check that a path only takes single steps through walkable tiles, and ends at the target
+ */
+static bool IsPathValid(const CGridSearch& cGridSearch,
+						const unsigned int uiNumDirections,
+						const glm::vec2& startPos,
+						const glm::vec2& targetPos,
+						const vector<glm::vec2>& vPath)
+{
+	if (vPath.empty())
+		return startPos == targetPos;
+
+	glm::vec2 previousPos = startPos;
+	for (size_t i = 0; i < vPath.size(); i++)
+	{
+		const int iDistX = abs((int)(vPath[i].x - previousPos.x));
+		const int iDistY = abs((int)(vPath[i].y - previousPos.y));
+		if ((iDistX > 1) || (iDistY > 1) || (iDistX + iDistY == 0) ||
+			((uiNumDirections == 4) && (iDistX + iDistY != 1)))
+			return false;
+		if (!cGridSearch.IsWalkable((int)vPath[i].x, (int)vPath[i].y))
+			return false;
+		previousPos = vPath[i];
+	}
+	return previousPos == targetPos;
+}
+
+/**
+ @brief Print the results of one search
+ */
+static void PrintResult(const string& strName, const BenchmarkResult& sResult, const size_t uiNumPairs)
+{
+	cout << "    " << left << setw(12) << strName << right
+		<< " found " << setw(5) << sResult.uiNumFound << "/" << uiNumPairs
+		<< "  expanded " << setw(9) << sResult.ullNumExpanded
+		<< "  length " << setw(7) << sResult.ullPathLength
+		<< "  time " << fixed << setprecision(2) << setw(8) << sResult.dMilliseconds << " ms" << endl;
+}
+
+/**
+ @brief Compare the searches on one map
+ */
+template <typename Heuristic>
+static bool BenchmarkMap(	const vector<unsigned short>& vTiles,
+							const unsigned int uiNumRows,
+							const unsigned int uiNumCols,
+							const unsigned int uiNumDirections,
+							const vector<glm::vec2>& vStarts,
+							const vector<glm::vec2>& vTargets)
+{
+	const CGridSearch cGridSearch(&vTiles[0], uiNumRows, uiNumCols, uiNumDirections);
+
+	vector<vector<glm::vec2> > vAStarPaths, vJumpPointPaths, vHierarchicalPaths;
+	const BenchmarkResult sAStar = RunSearch<Heuristic>(cGridSearch, false, vStarts, vTargets, vAStarPaths);
+	const BenchmarkResult sJumpPoint = RunSearch<Heuristic>(cGridSearch, true, vStarts, vTargets, vJumpPointPaths);
+	const BenchmarkResult sHierarchical = RunHierarchicalSearch(vTiles, uiNumRows, uiNumCols, uiNumDirections, vStarts, vTargets, vHierarchicalPaths);
+
+	// All the searches must agree on which pairs are connected, and output paths of single steps.
+	// A* and Jump Point Search are both optimal, so their paths must also be as long as each other
+	unsigned int uiNumErrors = 0;
+	for (size_t i = 0; i < vStarts.size(); i++)
+	{
+		if ((vAStarPaths[i].empty() != vJumpPointPaths[i].empty()) ||
+			(vAStarPaths[i].empty() != vHierarchicalPaths[i].empty()))
+			uiNumErrors++;
+		else if (vAStarPaths[i].size() != vJumpPointPaths[i].size())
+			uiNumErrors++;
+		else if (!vJumpPointPaths[i].empty() &&
+				!IsPathValid(cGridSearch, uiNumDirections, vStarts[i], vTargets[i], vJumpPointPaths[i]))
+			uiNumErrors++;
+		else if (!vHierarchicalPaths[i].empty() &&
+				!IsPathValid(cGridSearch, uiNumDirections, vStarts[i], vTargets[i], vHierarchicalPaths[i]))
+			uiNumErrors++;
+	}
+
+	cout << "  " << uiNumDirections << " directions" << endl;
+	PrintResult("A*", sAStar, vStarts.size());
+	PrintResult("Jump Point", sJumpPoint, vStarts.size());
+	PrintResult("HPA*", sHierarchical, vStarts.size());
+	if (sJumpPoint.ullNumExpanded > 0)
+		cout << "    Jump Point expanded " << fixed << setprecision(1)
+			<< (double)sAStar.ullNumExpanded / (double)sJumpPoint.ullNumExpanded << "x fewer nodes, "
+			<< "and ran " << setprecision(1) << (sAStar.dMilliseconds / (sJumpPoint.dMilliseconds > 0.0 ? sJumpPoint.dMilliseconds : 1.0))
+			<< "x as fast" << endl;
+	if (uiNumErrors > 0)
+		cout << "    " << uiNumErrors << " paths did not match" << endl;
+	return uiNumErrors == 0;
+}
+
+int main(int argc, char* argv[])
+{
+	unsigned int uiNumPairs = 2000;
+	int iFirstMap = 1;
+	if ((argc > 2) && (strcmp(argv[1], "-n") == 0))
+	{
+		uiNumPairs = (unsigned int)atoi(argv[2]);
+		iFirstMap = 3;
+	}
+	if (iFirstMap >= argc)
+	{
+		cout << "Usage: PathBenchmark [-n <pairs>] <map.map> [<map.map> ...]" << endl;
+		return 1;
+	}
+
+	int iResult = 0;
+	for (int i = iFirstMap; i < argc; i++)
+	{
+		vector<unsigned short> vTiles;
+		unsigned int uiNumRows = 0, uiNumCols = 0;
+		if (!LoadMap(argv[i], vTiles, uiNumRows, uiNumCols))
+		{
+			iResult = 1;
+			continue;
+		}
+
+		// Pick the same random pairs of walkable tiles for every search
+		const CGridSearch cGridSearch(&vTiles[0], uiNumRows, uiNumCols, 4);
+		vector<glm::vec2> vWalkable;
+		for (unsigned int uiRow = 0; uiRow < uiNumRows; uiRow++)
+		{
+			for (unsigned int uiCol = 0; uiCol < uiNumCols; uiCol++)
+			{
+				if (cGridSearch.IsWalkable(uiCol, uiRow))
+					vWalkable.push_back(glm::vec2(uiCol, uiRow));
+			}
+		}
+		if (vWalkable.empty())
+			continue;
+
+		mt19937 cGenerator(1);
+		vector<glm::vec2> vStarts(uiNumPairs), vTargets(uiNumPairs);
+		for (unsigned int j = 0; j < uiNumPairs; j++)
+		{
+			vStarts[j] = vWalkable[cGenerator() % vWalkable.size()];
+			vTargets[j] = vWalkable[cGenerator() % vWalkable.size()];
+		}
+
+		cout << argv[i] << " (" << uiNumCols << "x" << uiNumRows << ", " << uiNumPairs << " pairs)" << endl;
+		if (!BenchmarkMap<heuristic::Manhattan>(vTiles, uiNumRows, uiNumCols, 4, vStarts, vTargets))
+			iResult = 1;
+		if (!BenchmarkMap<heuristic::Chebyshev>(vTiles, uiNumRows, uiNumCols, 8, vStarts, vTargets))
+			iResult = 1;
+	}
+	return iResult;
+}